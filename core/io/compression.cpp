@@ -32,6 +32,8 @@
 
 #include "core/config/project_settings.h"
 #include "core/io/zip_io.h"
+#include "core/io/zstd_dictionary.h"
+#include "core/object/worker_thread_pool.h"
 
 #include "thirdparty/misc/fastlz.h"
 
@@ -41,13 +43,36 @@
 #include <brotli/decode.h>
 #endif
 
-// Caches for zstd.
-static BinaryMutex mutex;
-static ZSTD_DCtx *current_zstd_d_ctx = nullptr;
-static bool current_zstd_long_distance_matching;
-static int current_zstd_window_log_size;
+// Caches for zstd, one per thread so block decompression can run in parallel.
+struct ZstdDecompressionCache {
+	ZSTD_DCtx *ctx = nullptr;
+	bool long_distance_matching = false;
+	int window_log_size = 0;
 
-int64_t Compression::compress(uint8_t *p_dst, const uint8_t *p_src, int64_t p_src_size, Mode p_mode) {
+	~ZstdDecompressionCache() {
+		if (ctx) {
+			ZSTD_freeDCtx(ctx);
+		}
+	}
+};
+
+static thread_local ZstdDecompressionCache zstd_d_cache;
+
+// Dictionary compression is mostly used for many small payloads, so its context is reused too.
+struct ZstdCompressionCache {
+	ZSTD_CCtx *ctx = nullptr;
+
+	~ZstdCompressionCache() {
+		if (ctx) {
+			ZSTD_freeCCtx(ctx);
+		}
+	}
+};
+
+static thread_local ZstdCompressionCache zstd_c_cache;
+
+int64_t Compression::compress(uint8_t *p_dst, const uint8_t *p_src, int64_t p_src_size, Mode p_mode, const ZSTDDictionary *p_dictionary) {
+	ERR_FAIL_COND_V_MSG(p_dictionary && p_mode != MODE_ZSTD, -1, "Dictionaries can only be used with Zstd compression.");
 	switch (p_mode) {
 		case MODE_BROTLI: {
 			ERR_FAIL_V_MSG(-1, "Only brotli decompression is supported.");
@@ -91,6 +116,18 @@ int64_t Compression::compress(uint8_t *p_dst, const uint8_t *p_src, int64_t p_sr
 
 		} break;
 		case MODE_ZSTD: {
+			if (p_dictionary) {
+				const Ref<ZSTDCompressionDictionary> cdict = p_dictionary->get_compression_dictionary();
+				ERR_FAIL_COND_V(cdict.is_null(), -1);
+				ZstdCompressionCache &cache = zstd_c_cache;
+				if (!cache.ctx) {
+					cache.ctx = ZSTD_createCCtx();
+				}
+				const size_t ret = ZSTD_compress_usingCDict(cache.ctx, p_dst, ZSTD_compressBound(p_src_size), p_src, p_src_size, cdict->get());
+				ERR_FAIL_COND_V(ZSTD_isError(ret), -1);
+				return (int64_t)ret;
+			}
+
 			ZSTD_CCtx *cctx = ZSTD_createCCtx();
 			ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, zstd_level);
 			if (zstd_long_distance_matching) {
@@ -146,7 +183,8 @@ int64_t Compression::get_max_compressed_buffer_size(int64_t p_src_size, Mode p_m
 	ERR_FAIL_V(-1);
 }
 
-int64_t Compression::decompress(uint8_t *p_dst, int64_t p_dst_max_size, const uint8_t *p_src, int64_t p_src_size, Mode p_mode) {
+int64_t Compression::decompress(uint8_t *p_dst, int64_t p_dst_max_size, const uint8_t *p_src, int64_t p_src_size, Mode p_mode, const ZSTDDictionary *p_dictionary) {
+	ERR_FAIL_COND_V_MSG(p_dictionary && p_mode != MODE_ZSTD, -1, "Dictionaries can only be used with Zstd compression.");
 	switch (p_mode) {
 		case MODE_BROTLI: {
 #ifdef BROTLI_ENABLED
@@ -198,22 +236,28 @@ int64_t Compression::decompress(uint8_t *p_dst, int64_t p_dst_max_size, const ui
 			return total;
 		} break;
 		case MODE_ZSTD: {
-			MutexLock lock(mutex);
-
-			if (!current_zstd_d_ctx || current_zstd_long_distance_matching != zstd_long_distance_matching || current_zstd_window_log_size != zstd_window_log_size) {
-				if (current_zstd_d_ctx) {
-					ZSTD_freeDCtx(current_zstd_d_ctx);
+			ZstdDecompressionCache &cache = zstd_d_cache;
+			if (!cache.ctx || cache.long_distance_matching != zstd_long_distance_matching || cache.window_log_size != zstd_window_log_size) {
+				if (cache.ctx) {
+					ZSTD_freeDCtx(cache.ctx);
 				}
 
-				current_zstd_d_ctx = ZSTD_createDCtx();
+				cache.ctx = ZSTD_createDCtx();
 				if (zstd_long_distance_matching) {
-					ZSTD_DCtx_setParameter(current_zstd_d_ctx, ZSTD_d_windowLogMax, zstd_window_log_size);
+					ZSTD_DCtx_setParameter(cache.ctx, ZSTD_d_windowLogMax, zstd_window_log_size);
 				}
-				current_zstd_long_distance_matching = zstd_long_distance_matching;
-				current_zstd_window_log_size = zstd_window_log_size;
+				cache.long_distance_matching = zstd_long_distance_matching;
+				cache.window_log_size = zstd_window_log_size;
+			}
+
+			if (p_dictionary) {
+				const Ref<ZSTDDecompressionDictionary> ddict = p_dictionary->get_decompression_dictionary();
+				ERR_FAIL_COND_V(ddict.is_null(), -1);
+				const size_t ret = ZSTD_decompress_usingDDict(cache.ctx, p_dst, p_dst_max_size, p_src, p_src_size, ddict->get());
+				return ZSTD_isError(ret) ? -1 : (int64_t)ret;
 			}
 
-			size_t ret = ZSTD_decompressDCtx(current_zstd_d_ctx, p_dst, p_dst_max_size, p_src, p_src_size);
+			size_t ret = ZSTD_decompressDCtx(cache.ctx, p_dst, p_dst_max_size, p_src, p_src_size);
 			return (int64_t)ret;
 		} break;
 	}
@@ -221,6 +265,118 @@ int64_t Compression::decompress(uint8_t *p_dst, int64_t p_dst_max_size, const ui
 	ERR_FAIL_V(-1);
 }
 
+struct CompressionBlocksTask {
+	uint8_t *dst = nullptr;
+	const uint8_t *src = nullptr;
+	const uint64_t *offsets = nullptr; // Compressed slot or block start, per block.
+	uint32_t *sizes = nullptr;
+	int64_t total_size = 0;
+	int64_t slot_size = 0;
+	uint32_t block_size = 0;
+	uint32_t block_count = 0;
+	Compression::Mode mode = Compression::MODE_ZSTD;
+	SafeFlag failed;
+
+	_FORCE_INLINE_ int64_t get_block_length(uint32_t p_block) const {
+		return p_block == block_count - 1 ? total_size - int64_t(p_block) * block_size : block_size;
+	}
+
+	static void compress_block(void *p_userdata, uint32_t p_block) {
+		CompressionBlocksTask *task = (CompressionBlocksTask *)p_userdata;
+		const int64_t ret = Compression::compress(task->dst + task->slot_size * p_block, task->src + int64_t(p_block) * task->block_size, task->get_block_length(p_block), task->mode);
+		if (ret < 0 || ret > task->slot_size) {
+			task->failed.set();
+			return;
+		}
+		task->sizes[p_block] = ret;
+	}
+
+	static void decompress_block(void *p_userdata, uint32_t p_block) {
+		CompressionBlocksTask *task = (CompressionBlocksTask *)p_userdata;
+		const int64_t length = task->get_block_length(p_block);
+		const int64_t ret = Compression::decompress(task->dst + int64_t(p_block) * task->block_size, length, task->src + task->offsets[p_block], task->sizes[p_block], task->mode);
+		if (ret != length) {
+			task->failed.set();
+		}
+	}
+
+	void run(void (*p_func)(void *, uint32_t), const String &p_description) {
+		WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+		// Pool threads run the blocks themselves, waiting there for other pool tasks could deadlock.
+		if (pool && pool->get_thread_count() > 1 && pool->get_thread_index() == -1 && block_count >= (uint32_t)Compression::parallel_min_blocks) {
+			WorkerThreadPool::GroupID group = pool->add_native_group_task(p_func, this, block_count, -1, true, p_description);
+			pool->wait_for_group_task_completion(group);
+		} else {
+			for (uint32_t i = 0; i < block_count && !failed.is_set(); i++) {
+				p_func(this, i);
+			}
+		}
+	}
+};
+
+int64_t Compression::get_max_compressed_blocks_size(int64_t p_src_size, uint32_t p_block_size, uint32_t p_block_count, Mode p_mode) {
+	ERR_FAIL_COND_V(p_block_size == 0 || p_block_count == 0, -1);
+	const int64_t slot_size = get_max_compressed_buffer_size(MIN(int64_t(p_block_size), p_src_size), p_mode);
+	ERR_FAIL_COND_V(slot_size < 0, -1);
+	return slot_size * p_block_count;
+}
+
+int64_t Compression::compress_blocks(uint8_t *p_dst, uint32_t *r_block_sizes, const uint8_t *p_src, int64_t p_src_size, uint32_t p_block_size, uint32_t p_block_count, Mode p_mode) {
+	ERR_FAIL_COND_V(p_block_size == 0 || p_block_count == 0, -1);
+	ERR_FAIL_COND_V_MSG(p_src_size < int64_t(p_block_count - 1) * p_block_size || p_src_size > int64_t(p_block_count) * p_block_size, -1, "Block count doesn't match the source size.");
+
+	CompressionBlocksTask task;
+	task.dst = p_dst;
+	task.src = p_src;
+	task.sizes = r_block_sizes;
+	task.total_size = p_src_size;
+	task.slot_size = get_max_compressed_buffer_size(MIN(int64_t(p_block_size), p_src_size), p_mode);
+	task.block_size = p_block_size;
+	task.block_count = p_block_count;
+	task.mode = p_mode;
+	ERR_FAIL_COND_V(task.slot_size < 0, -1);
+
+	// Every block is compressed into its own worst-case slot, then the slots are packed back to back.
+	task.run(&CompressionBlocksTask::compress_block, "Compress blocks");
+	ERR_FAIL_COND_V_MSG(task.failed.is_set(), -1, "Error compressing data blocks.");
+
+	int64_t total = 0;
+	for (uint32_t i = 0; i < p_block_count; i++) {
+		if (total != task.slot_size * i) {
+			memmove(p_dst + total, p_dst + task.slot_size * i, r_block_sizes[i]);
+		}
+		total += r_block_sizes[i];
+	}
+	return total;
+}
+
+int64_t Compression::decompress_blocks(uint8_t *p_dst, int64_t p_dst_size, const uint8_t *p_src, const uint32_t *p_block_sizes, uint32_t p_block_size, uint32_t p_block_count, Mode p_mode) {
+	ERR_FAIL_COND_V(p_block_size == 0 || p_block_count == 0, -1);
+	ERR_FAIL_COND_V_MSG(p_dst_size < int64_t(p_block_count - 1) * p_block_size || p_dst_size > int64_t(p_block_count) * p_block_size, -1, "Block count doesn't match the destination size.");
+
+	LocalVector<uint64_t> offsets;
+	offsets.resize(p_block_count);
+	uint64_t offset = 0;
+	for (uint32_t i = 0; i < p_block_count; i++) {
+		offsets[i] = offset;
+		offset += p_block_sizes[i];
+	}
+
+	CompressionBlocksTask task;
+	task.dst = p_dst;
+	task.src = p_src;
+	task.offsets = offsets.ptr();
+	task.sizes = const_cast<uint32_t *>(p_block_sizes);
+	task.total_size = p_dst_size;
+	task.block_size = p_block_size;
+	task.block_count = p_block_count;
+	task.mode = p_mode;
+
+	task.run(&CompressionBlocksTask::decompress_block, "Decompress blocks");
+	ERR_FAIL_COND_V_MSG(task.failed.is_set(), -1, "Error decompressing data blocks.");
+	return p_dst_size;
+}
+
 /**
 	This will handle both Gzip and Deflate streams. It will automatically allocate the output buffer into the provided p_dst_vect Vector.
 	This is required for compressed data whose final uncompressed size is unknown, as is the case for HTTP response bodies.
@@ -35,6 +35,8 @@
 
 #include <zlib.h>
 
+class ZSTDDictionary;
+
 class Compression {
 public:
 	static inline int zlib_level = Z_DEFAULT_COMPRESSION;
@@ -43,6 +45,8 @@ public:
 	static inline bool zstd_long_distance_matching = false;
 	static inline int zstd_window_log_size = 27; // ZSTD_WINDOWLOG_LIMIT_DEFAULT
 	static inline int gzip_chunk = 16384;
+	// Fewer blocks than this are (de)compressed on the calling thread.
+	static inline int parallel_min_blocks = 4;
 
 	enum Mode : int32_t {
 		MODE_FASTLZ,
@@ -52,8 +56,16 @@ public:
 		MODE_BROTLI
 	};
 
-	static int64_t compress(uint8_t *p_dst, const uint8_t *p_src, int64_t p_src_size, Mode p_mode = MODE_ZSTD);
+	// A dictionary can only be used with MODE_ZSTD, and data compressed with one needs the same one to be decompressed.
+	static int64_t compress(uint8_t *p_dst, const uint8_t *p_src, int64_t p_src_size, Mode p_mode = MODE_ZSTD, const ZSTDDictionary *p_dictionary = nullptr);
 	static int64_t get_max_compressed_buffer_size(int64_t p_src_size, Mode p_mode = MODE_ZSTD);
-	static int64_t decompress(uint8_t *p_dst, int64_t p_dst_max_size, const uint8_t *p_src, int64_t p_src_size, Mode p_mode = MODE_ZSTD);
+	static int64_t decompress(uint8_t *p_dst, int64_t p_dst_max_size, const uint8_t *p_src, int64_t p_src_size, Mode p_mode = MODE_ZSTD, const ZSTDDictionary *p_dictionary = nullptr);
+
+	// Independent block (de)compression, spread over the WorkerThreadPool.
+	// The source is split in `p_block_count` blocks of `p_block_size` bytes, the last one holding the remainder (which may be empty).
+	static int64_t get_max_compressed_blocks_size(int64_t p_src_size, uint32_t p_block_size, uint32_t p_block_count, Mode p_mode = MODE_ZSTD);
+	static int64_t compress_blocks(uint8_t *p_dst, uint32_t *r_block_sizes, const uint8_t *p_src, int64_t p_src_size, uint32_t p_block_size, uint32_t p_block_count, Mode p_mode = MODE_ZSTD);
+	static int64_t decompress_blocks(uint8_t *p_dst, int64_t p_dst_size, const uint8_t *p_src, const uint32_t *p_block_sizes, uint32_t p_block_size, uint32_t p_block_count, Mode p_mode = MODE_ZSTD);
+
 	static int decompress_dynamic(Vector<uint8_t> *p_dst_vect, int64_t p_max_dst_size, const uint8_t *p_src, int64_t p_src_size, Mode p_mode);
 };
@@ -37,6 +37,8 @@
 #define open_encrypted _id_acbbc349c1f67
 #define open_encrypted_pass _id_fh7833k39s
 void ConfigFile::set_value(const String &p_section, const String &p_key, const Variant &p_value) {
+	_erase_pending(p_section, p_key);
+
 	if (p_value.get_type() == Variant::NIL) { // Erase key.
 		if (!values.has(p_section)) {
 			return;
@@ -57,13 +59,44 @@ void ConfigFile::set_value(const String &p_section, const String &p_key, const V
 }
 
 Variant ConfigFile::get_value(const String &p_section, const String &p_key, const Variant &p_default) const {
-	if (!values.has(p_section) || !values[p_section].has(p_key)) {
+	const HashMap<String, Variant> *section = values.getptr(p_section);
+	const Variant *value = section ? section->getptr(p_key) : nullptr;
+	if (!value) {
 		ERR_FAIL_COND_V_MSG(p_default.get_type() == Variant::NIL, Variant(),
 				vformat("Couldn't find the given section \"%s\" and key \"%s\", and no default was given.", p_section, p_key));
 		return p_default;
 	}
 
-	return values[p_section][p_key];
+	if (value->get_type() != Variant::NIL) {
+		return *value;
+	}
+
+	// Only values located by load_lazy() are stored as null.
+	PendingValue *pending = _get_pending(p_section, p_key);
+	ERR_FAIL_NULL_V(pending, p_default);
+
+	MutexLock lock(pending_mutex);
+	if (!pending->parsed) {
+		const LazySource &source = lazy_sources[pending->source];
+		VariantParser::StreamString stream;
+		stream.s = String::utf8((const char *)source.data.ptr() + pending->offset, pending->length);
+
+		String error_text;
+		int line = pending->line;
+		Error err = VariantParser::parse(&stream, pending->value, error_text, line);
+		if (err != OK) {
+			pending->value = Variant();
+			ERR_PRINT(vformat("ConfigFile parse error at %s:%d: %s.", source.path, line, error_text));
+			return p_default;
+		}
+		pending->parsed = true;
+	}
+
+	if (pending->value.get_type() == Variant::NIL) {
+		// load() doesn't keep null values either.
+		return p_default;
+	}
+	return pending->value;
 }
 
 bool ConfigFile::has_section(const String &p_section) const {
@@ -109,18 +142,50 @@ Vector<String> ConfigFile::get_section_keys(const String &p_section) const {
 void ConfigFile::erase_section(const String &p_section) {
 	ERR_FAIL_COND_MSG(!values.has(p_section), vformat("Cannot erase nonexistent section \"%s\".", p_section));
 	values.erase(p_section);
+	pending_values.erase(p_section);
 }
 
 void ConfigFile::erase_section_key(const String &p_section, const String &p_key) {
 	ERR_FAIL_COND_MSG(!values.has(p_section), vformat("Cannot erase key \"%s\" from nonexistent section \"%s\".", p_key, p_section));
 	ERR_FAIL_COND_MSG(!values[p_section].has(p_key), vformat("Cannot erase nonexistent key \"%s\" from section \"%s\".", p_key, p_section));
 
+	_erase_pending(p_section, p_key);
 	values[p_section].erase(p_key);
 	if (values[p_section].is_empty()) {
 		values.erase(p_section);
 	}
 }
 
+ConfigFile::PendingValue *ConfigFile::_get_pending(const String &p_section, const String &p_key) const {
+	HashMap<String, PendingValue> *section = pending_values.getptr(p_section);
+	return section ? section->getptr(p_key) : nullptr;
+}
+
+void ConfigFile::_erase_pending(const String &p_section, const String &p_key) {
+	HashMap<String, PendingValue> *section = pending_values.getptr(p_section);
+	if (section && section->erase(p_key) && section->is_empty()) {
+		pending_values.erase(p_section);
+	}
+}
+
+String ConfigFile::_encode_value(const String &p_section, const String &p_key, const Variant &p_value) const {
+	const PendingValue *pending = p_value.get_type() == Variant::NIL ? _get_pending(p_section, p_key) : nullptr;
+	if (pending) {
+		MutexLock lock(pending_mutex);
+		if (!pending->parsed) {
+			// Never parsed, write it back exactly as it was read.
+			return String::utf8((const char *)lazy_sources[pending->source].data.ptr() + pending->offset, pending->length);
+		}
+		String vstr;
+		VariantWriter::write_to_string(pending->value, vstr);
+		return vstr;
+	}
+
+	String vstr;
+	VariantWriter::write_to_string(p_value, vstr);
+	return vstr;
+}
+
 String ConfigFile::encode_to_text() const {
 	StringBuilder sb;
 	bool first = true;
@@ -135,9 +200,7 @@ String ConfigFile::encode_to_text() const {
 		}
 
 		for (const KeyValue<String, Variant> &F : E.value) {
-			String vstr;
-			VariantWriter::write_to_string(F.value, vstr);
-			sb.append(F.key.property_name_encode() + "=" + vstr + "\n");
+			sb.append(F.key.property_name_encode() + "=" + _encode_value(E.key, F.key, F.value) + "\n");
 		}
 	}
 	return sb.as_string();
@@ -202,9 +265,7 @@ Error ConfigFile::_internal_save(Ref<FileAccess> file) {
 		}
 
 		for (const KeyValue<String, Variant> &F : E.value) {
-			String vstr;
-			VariantWriter::write_to_string(F.value, vstr);
-			file->store_string(F.key.property_name_encode() + "=" + vstr + "\n");
+			file->store_string(F.key.property_name_encode() + "=" + _encode_value(E.key, F.key, F.value) + "\n");
 		}
 	}
 
@@ -222,6 +283,19 @@ Error ConfigFile::load(const String &p_path) {
 	return _internal_load(p_path, f);
 }
 
+Error ConfigFile::load_lazy(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+
+	if (f.is_null()) {
+		return err;
+	}
+
+	const uint64_t len = f->get_length();
+	ERR_FAIL_COND_V_MSG(len >= UINT32_MAX, ERR_OUT_OF_MEMORY, vformat("ConfigFile '%s' is too large to load lazily.", p_path));
+	return _parse_lazy(p_path, f->get_buffer(len));
+}
+
 Error ConfigFile::load_encrypted(const String &p_path, const Vector<uint8_t> &p_key) {
 	Error err;
 	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
@@ -305,8 +379,240 @@ Error ConfigFile::_parse(const String &p_path, VariantParser::Stream *p_stream)
 	return OK;
 }
 
+// Finds where the value starting at r_pos ends without parsing it, following the token
+// rules of VariantParser::get_token(): a string (also &"", ^"" and @""), a bracket group,
+// or a bare word (number, color, identifier) optionally followed by a constructor's
+// (...) group, with a [...] group in between for typed containers.
+static Error _skip_config_value(const uint8_t *p_src, uint32_t p_len, uint32_t &r_pos, int &r_line, uint32_t &r_start, int &r_start_line, String &r_err_str) {
+	uint32_t pos = r_pos;
+	while (pos < p_len && (p_src[pos] <= 32 || p_src[pos] == ';')) {
+		if (p_src[pos] == ';') {
+			while (pos < p_len && p_src[pos] != '\n') {
+				pos++;
+			}
+			continue;
+		}
+		if (p_src[pos] == '\n') {
+			r_line++;
+		}
+		pos++;
+	}
+	if (pos == p_len) {
+		r_err_str = "Expected value, got EOF";
+		return ERR_PARSE_ERROR;
+	}
+	r_start = pos;
+	r_start_line = r_line;
+
+	int depth = 0;
+	bool after_word = false;
+	bool typed_group = false;
+	while (true) {
+		if (pos == p_len) {
+			r_err_str = "Unexpected EOF while parsing value";
+			return ERR_PARSE_ERROR;
+		}
+
+		const uint8_t c = p_src[pos];
+		bool word = false;
+		if (c == '"' || ((c == '&' || c == '^' || c == '@') && pos + 1 < p_len && p_src[pos + 1] == '"')) {
+			pos += c == '"' ? 1 : 2;
+			while (pos < p_len && p_src[pos] != '"') {
+				if (p_src[pos] == '\\') {
+					pos++;
+				} else if (p_src[pos] == '\n') {
+					r_line++;
+				}
+				pos++;
+			}
+			if (pos >= p_len) {
+				r_err_str = "Unterminated string";
+				return ERR_PARSE_ERROR;
+			}
+			pos++;
+		} else if (c == '(' || c == '[' || c == '{') {
+			if (depth == 0) {
+				typed_group = c == '[' && after_word;
+			}
+			depth++;
+			pos++;
+		} else if (c == ')' || c == ']' || c == '}') {
+			depth = MAX(depth - 1, 0);
+			pos++;
+			if (depth == 0 && c != ']') {
+				typed_group = false;
+			}
+		} else if (c == ';') {
+			// Comment inside a group.
+			while (pos < p_len && p_src[pos] != '\n') {
+				pos++;
+			}
+		} else if (c <= 32 || c == ',' || c == ':' || c == '=') {
+			if (c == '\n') {
+				r_line++;
+			}
+			pos++;
+		} else {
+			word = true;
+			while (pos < p_len && p_src[pos] > 32 && !strchr("()[]{}\",;:=", p_src[pos])) {
+				pos++;
+			}
+		}
+
+		if (depth > 0) {
+			continue;
+		}
+
+		// At the top level the value ends here, unless this was a word or a typed
+		// container's element type and a constructor follows.
+		if (word && pos < p_len && p_src[pos] == '[') {
+			after_word = true;
+			continue;
+		}
+		if (word || typed_group) {
+			uint32_t next = pos;
+			while (next < p_len && (p_src[next] == ' ' || p_src[next] == '\t')) {
+				next++;
+			}
+			if (next < p_len && p_src[next] == '(') {
+				pos = next;
+				after_word = false;
+				typed_group = false;
+				continue;
+			}
+		}
+		break;
+	}
+
+	r_pos = pos;
+	return OK;
+}
+
+Error ConfigFile::_parse_lazy(const String &p_path, const Vector<uint8_t> &p_source) {
+	const uint32_t source_index = lazy_sources.size();
+	lazy_sources.push_back({ p_path, p_source });
+
+	const uint8_t *src = p_source.ptr();
+	const uint32_t len = p_source.size();
+	uint32_t pos = 0;
+
+	int lines = 0;
+	String error_text;
+
+	String section;
+	String what;
+
+	// Same grammar as VariantParser::parse_tag_assign_eof() with simple tags, but values
+	// are only located and kept as text until they are read.
+	while (pos < len) {
+		const uint8_t c = src[pos++];
+
+		if (c == ';') {
+			while (pos < len && src[pos] != '\n') {
+				pos++;
+			}
+			continue;
+		}
+
+		if (c == '[' && what.is_empty()) {
+			const uint32_t start = pos;
+			bool escaping = false;
+			while (true) {
+				if (pos == len) {
+					ERR_PRINT(vformat("ConfigFile parse error at %s:%d: %s.", p_path, lines, "Unexpected EOF while parsing simple tag"));
+					return ERR_PARSE_ERROR;
+				}
+				const uint8_t t = src[pos++];
+				if (t == ']') {
+					if (!escaping) {
+						break;
+					}
+					escaping = false;
+				} else {
+					escaping = t == '\\';
+				}
+			}
+			section = String::utf8((const char *)src + start, pos - 1 - start).strip_edges().replace("\\]", "]");
+			continue;
+		}
+
+		if (c <= 32) {
+			if (c == '\n') {
+				lines++;
+			}
+			continue;
+		}
+
+		if (c == '"') {
+			// Quoted key, let the tokenizer deal with the escapes.
+			const uint32_t start = pos - 1;
+			while (pos < len && src[pos] != '"') {
+				if (src[pos] == '\\') {
+					pos++;
+				} else if (src[pos] == '\n') {
+					lines++;
+				}
+				pos++;
+			}
+			pos = MIN(pos + 1, len);
+
+			VariantParser::StreamString stream;
+			stream.s = String::utf8((const char *)src + start, pos - start);
+			VariantParser::Token token;
+			int token_line = 0;
+			Error err = VariantParser::get_token(&stream, token, token_line, error_text);
+			if (err != OK || token.type != VariantParser::TK_STRING) {
+				if (err == OK) {
+					error_text = "Error reading quoted string";
+				}
+				ERR_PRINT(vformat("ConfigFile parse error at %s:%d: %s.", p_path, lines, error_text));
+				return ERR_INVALID_DATA;
+			}
+			what = token.value;
+			continue;
+		}
+
+		if (c != '=') {
+			// Unquoted keys are taken byte by byte, like the regular parser does.
+			what += char32_t(c);
+			continue;
+		}
+
+		uint32_t start = 0;
+		int start_line = 0;
+		Error err = _skip_config_value(src, len, pos, lines, start, start_line, error_text);
+		if (err != OK) {
+			ERR_PRINT(vformat("ConfigFile parse error at %s:%d: %s.", p_path, lines, error_text));
+			return err;
+		}
+
+		if (pos - start == 4 && memcmp(src + start, "null", 4) == 0) {
+			// Erases the key, like load() does.
+			set_value(section, what, Variant());
+		} else {
+			if (!values.has(section)) {
+				// Insert section-less keys at the beginning.
+				values.insert(section, HashMap<String, Variant>(), section.is_empty());
+			}
+			values[section][what] = Variant();
+
+			PendingValue pending;
+			pending.source = source_index;
+			pending.offset = start;
+			pending.length = pos - start;
+			pending.line = start_line;
+			pending_values[section][what] = pending;
+		}
+		what = String();
+	}
+
+	return OK;
+}
+
 void ConfigFile::clear() {
 	values.clear();
+	pending_values.clear();
+	lazy_sources.clear();
 }
 
 void ConfigFile::_bind_methods() {
@@ -323,12 +629,14 @@ void ConfigFile::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("erase_section_key", "section", "key"), &ConfigFile::erase_section_key);
 
 	ClassDB::bind_method(D_METHOD("load", "path"), &ConfigFile::load);
+	ClassDB::bind_method(D_METHOD("load_lazy", "path"), &ConfigFile::load_lazy);
 	ClassDB::bind_method(D_METHOD("parse", "data"), &ConfigFile::parse);
 	ClassDB::bind_method(D_METHOD("save", "path"), &ConfigFile::save);
 
 	ClassDB::bind_method(D_METHOD("encode_to_text"), &ConfigFile::encode_to_text);
 
 	BIND_METHOD_ERR_RETURN_DOC("load", ERR_FILE_CANT_OPEN);
+	BIND_METHOD_ERR_RETURN_DOC("load_lazy", ERR_FILE_CANT_OPEN);
 
 	ClassDB::bind_method(D_METHOD("load_encrypted", "path", "key"), &ConfigFile::load_encrypted);
 	ClassDB::bind_method(D_METHOD("load_encrypted_pass", "path", "password"), &ConfigFile::load_encrypted_pass);
@@ -32,7 +32,9 @@
 
 #include "core/io/file_access.h"
 #include "core/object/ref_counted.h"
+#include "core/os/mutex.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/variant/variant_parser.h"
 
 #define open_encrypted _id_acbbc349c1f67
@@ -42,10 +44,36 @@ class ConfigFile : public RefCounted {
 
 	HashMap<String, HashMap<String, Variant>> values;
 
+	// A value that load_lazy() only located in the file, parsed on first access.
+	// Its entry in `values` stays null until then.
+	struct PendingValue {
+		uint32_t source = 0; // Index in lazy_sources.
+		uint32_t offset = 0;
+		uint32_t length = 0;
+		int line = 0;
+		bool parsed = false; // Set with pending_mutex held.
+		Variant value;
+	};
+
+	struct LazySource {
+		String path;
+		Vector<uint8_t> data;
+	};
+
+	LocalVector<LazySource> lazy_sources;
+	// Only the records are mutable, get_value() never adds or removes entries.
+	mutable HashMap<String, HashMap<String, PendingValue>> pending_values;
+	mutable BinaryMutex pending_mutex;
+
+	PendingValue *_get_pending(const String &p_section, const String &p_key) const;
+	void _erase_pending(const String &p_section, const String &p_key);
+	String _encode_value(const String &p_section, const String &p_key, const Variant &p_value) const;
+
 	Error _internal_load(const String &p_path, Ref<FileAccess> f);
 	Error _internal_save(Ref<FileAccess> file);
 
 	Error _parse(const String &p_path, VariantParser::Stream *p_stream);
+	Error _parse_lazy(const String &p_path, const Vector<uint8_t> &p_source);
 
 protected:
 	static void _bind_methods();
@@ -65,6 +93,7 @@ public:
 
 	Error save(const String &p_path);
 	Error load(const String &p_path);
+	Error load_lazy(const String &p_path);
 	Error parse(const String &p_data);
 
 	String encode_to_text() const; // used by exporter
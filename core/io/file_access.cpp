@@ -66,19 +66,19 @@ void FileAccess::_set_access_type(AccessType p_access) {
 	_access_type = p_access;
 }
 
-Ref<FileAccess> FileAccess::create_for_path(const String &p_path) {
-	Ref<FileAccess> ret;
+FileAccess::AccessType FileAccess::_get_access_type_for_path(const String &p_path) {
 	if (p_path.begins_with("res://") || p_path.begins_with("uid://")) {
-		ret = create(ACCESS_RESOURCES);
+		return ACCESS_RESOURCES;
 	} else if (p_path.begins_with("user://")) {
-		ret = create(ACCESS_USERDATA);
+		return ACCESS_USERDATA;
 	} else if (p_path.begins_with("pipe://")) {
-		ret = create(ACCESS_PIPE);
-	} else {
-		ret = create(ACCESS_FILESYSTEM);
+		return ACCESS_PIPE;
 	}
+	return ACCESS_FILESYSTEM;
+}
 
-	return ret;
+Ref<FileAccess> FileAccess::create_for_path(const String &p_path) {
+	return create(_get_access_type_for_path(p_path));
 }
 String FileAccess::_fix_path(const String &p_path) {
 	Ref<FileAccess> f = create_for_path(p_path);
@@ -176,8 +176,14 @@ Ref<FileAccess> FileAccess::open(const String &p_path, int p_mode_flags, Error *
 		}
 	}
 
-	ret = create_for_path(p_path);
-	Error err = ret->open_internal(p_path, p_mode_flags & ~SKIP_PACK);
+	AccessType access = _get_access_type_for_path(p_path);
+	if ((p_mode_flags & MMAP) && !(p_mode_flags & WRITE) && mapped_create_func[access]) {
+		ret = mapped_create_func[access]();
+		ret->_set_access_type(access);
+	} else {
+		ret = create(access);
+	}
+	Error err = ret->open_internal(p_path, p_mode_flags & ~(SKIP_PACK | MMAP));
 
 	if (r_error) {
 		*r_error = err;
@@ -925,18 +931,11 @@ bool FileAccess::store_buffer(const uint8_t *p_src, uint64_t p_length) {
 }
 
 bool FileAccess::store_var(const Variant &p_var, bool p_full_objects) {
-	int len;
-	Error err = encode_variant(p_var, nullptr, len, p_full_objects);
-	ERR_FAIL_COND_V_MSG(err != OK, false, "Error when trying to encode Variant.");
-
-	Vector<uint8_t> buff;
-	buff.resize(len);
-
-	uint8_t *w = buff.ptrw();
-	err = encode_variant(p_var, &w[0], len, p_full_objects);
+	VariantEncodeBuffer buff;
+	Error err = buff.encode(p_var, p_full_objects);
 	ERR_FAIL_COND_V_MSG(err != OK, false, "Error when trying to encode Variant.");
 
-	return store_32(uint32_t(len)) && store_buffer(buff);
+	return store_32(uint32_t(buff.size())) && store_buffer(buff.ptr(), buff.size());
 }
 
 Vector<uint8_t> FileAccess::get_file_as_bytes(const String &p_path, Error *r_error) {
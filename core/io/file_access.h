@@ -35,6 +35,7 @@
 #include "core/object/ref_counted.h"
 #include "core/os/memory.h"
 #include "core/string/ustring.h"
+#include "core/templates/span.h"
 #include "core/typedefs.h"
 
 /**
@@ -60,6 +61,7 @@ public:
 		READ_WRITE = 3,
 		WRITE_READ = 7,
 		SKIP_PACK = 16,
+		MMAP = 32, // Read-only hint: map the file into memory when the platform supports it, see get_buffer_view().
 	};
 
 	enum UnixPermissionFlags : int32_t {
@@ -150,12 +152,14 @@ private:
 
 	AccessType _access_type = ACCESS_FILESYSTEM;
 	static inline CreateFunc create_func[ACCESS_MAX]; /** default file access creation function for a platform */
+	static inline CreateFunc mapped_create_func[ACCESS_MAX]; /** memory-mapped variant used for MMAP reads, if the platform has one */
 	template <typename T>
 	static Ref<FileAccess> _create_builtin() {
 		return memnew(T);
 	}
 
 	static Ref<FileAccess> _open(const String &p_path, ModeFlags p_mode_flags);
+	static AccessType _get_access_type_for_path(const String &p_path);
 
 	bool _is_temp_file = false;
 	bool _temp_keep_after_use = false;
@@ -193,6 +197,11 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const = 0; ///< get an array of bytes, needs to be overwritten by children.
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	// Returns a read-only view of the next p_length bytes and advances past them, without copying.
+	// Returns an empty span and leaves the position untouched when the file can't provide one
+	// (not memory-mapped, or fewer than p_length bytes left); use get_buffer() then.
+	// The view is only valid until the file is closed.
+	virtual Span<uint8_t> get_buffer_view(uint64_t p_length) const { return Span<uint8_t>(); }
 
 	String get_utf8_string_buffer() {
 		uint64_t len = get_32();
@@ -300,6 +309,13 @@ public:
 	template <typename T>
 	static void make_default(AccessType p_access) {
 		create_func[p_access] = _create_builtin<T>;
+		mapped_create_func[p_access] = nullptr;
+	}
+
+	// Must be called after make_default() for the same access type.
+	template <typename T>
+	static void make_mapped_default(AccessType p_access) {
+		mapped_create_func[p_access] = _create_builtin<T>;
 	}
 
 public:
@@ -30,6 +30,8 @@
 
 #include "file_access_compressed.h"
 
+#include "core/object/worker_thread_pool.h"
+
 void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size) {
 	magic = p_magic.ascii().get_data();
 	magic = (magic + "    ").substr(0, 4);
@@ -130,24 +132,28 @@ void FileAccessCompressed::_close() {
 			f->store_32(0); //compressed sizes, will update later
 		}
 
-		uint32_t last_block_size = write_max % block_size;
+		// Blocks are independent, so they're compressed in parallel a batch at a time, with a few
+		// blocks per worker thread. Only one batch of compressed data is held in memory at once.
+		WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+		const uint32_t batch_blocks = MAX((uint32_t)Compression::parallel_min_blocks, (pool ? (uint32_t)pool->get_thread_count() : 1u) * 4);
+		LocalVector<uint8_t> cblocks;
+		LocalVector<uint32_t> block_sizes;
+		block_sizes.resize(bc);
 
-		// Temporary buffer for compressed data blocks.
-		LocalVector<uint8_t> temp_cblock;
-		temp_cblock.resize(Compression::get_max_compressed_buffer_size(bc == 1 ? last_block_size : block_size, cmode));
-		uint8_t *temp_cblock_ptr = temp_cblock.ptr();
+		for (uint32_t first = 0; first < bc; first += batch_blocks) {
+			const uint32_t count = MIN(batch_blocks, bc - first);
+			const uint64_t src_offset = (uint64_t)first * block_size;
+			const int64_t src_size = MIN((int64_t)(write_max - src_offset), (int64_t)count * block_size);
 
-		// Compress and store the blocks.
-		LocalVector<uint32_t> block_sizes;
-		for (uint32_t i = 0; i < bc; i++) {
-			uint32_t bl = i == (bc - 1) ? last_block_size : block_size;
-			uint8_t *bp = &write_ptr[i * block_size];
+			const int64_t max_size = Compression::get_max_compressed_blocks_size(src_size, block_size, count, cmode);
+			ERR_FAIL_COND_MSG(max_size < 0, "FileAccessCompressed: Error compressing data.");
+			if (cblocks.size() < (uint64_t)max_size) {
+				cblocks.resize(max_size);
+			}
 
-			const int64_t compressed_size = Compression::compress(temp_cblock_ptr, bp, bl, cmode);
+			const int64_t compressed_size = Compression::compress_blocks(cblocks.ptr(), block_sizes.ptr() + first, write_ptr + src_offset, src_size, block_size, count, cmode);
 			ERR_FAIL_COND_MSG(compressed_size < 0, "FileAccessCompressed: Error compressing data.");
-
-			f->store_buffer(temp_cblock_ptr, (uint64_t)compressed_size);
-			block_sizes.push_back(compressed_size);
+			f->store_buffer(cblocks.ptr(), (uint64_t)compressed_size);
 		}
 
 		f->seek(16); //ok write block sizes
@@ -158,6 +164,7 @@ void FileAccessCompressed::_close() {
 		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //magic at the end too
 	} else {
 		comp_buffer.clear();
+		direct_buffer.clear();
 		read_blocks.clear();
 	}
 	buffer.clear();
@@ -290,6 +297,31 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 			return dst_idx;
 		}
 
+		// Whole blocks the caller asked for are decompressed straight into the destination, in parallel.
+		const uint32_t direct_blocks = MIN((p_length - dst_idx) / block_size, uint64_t(read_block_count - 1 - read_block));
+		if (direct_blocks >= (uint32_t)Compression::parallel_min_blocks) {
+			uint64_t csize = 0;
+			for (uint32_t i = 0; i < direct_blocks; i++) {
+				direct_sizes.push_back(read_blocks[read_block + i].csize);
+				csize += read_blocks[read_block + i].csize;
+			}
+			direct_buffer.resize(csize);
+			f->get_buffer(direct_buffer.ptr(), csize);
+
+			const uint64_t direct_length = (uint64_t)direct_blocks * block_size;
+			const int64_t ret = Compression::decompress_blocks(p_dst + dst_idx, direct_length, direct_buffer.ptr(), direct_sizes.ptr(), block_size, direct_blocks, cmode);
+			direct_sizes.clear();
+			ERR_FAIL_COND_V_MSG(ret == -1, -1, "Compressed file is corrupt.");
+			dst_idx += direct_length;
+
+			// Keep the last block as the current one, so seeking inside it doesn't need to decompress it again.
+			read_block += direct_blocks - 1;
+			memcpy(buffer.ptrw(), p_dst + dst_idx - block_size, block_size);
+			read_block_size = block_size;
+			read_pos = block_size;
+			continue;
+		}
+
 		// Read the next block of compressed data.
 		f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
 		const int64_t ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
@@ -54,6 +54,8 @@ class FileAccessCompressed : public FileAccess {
 	};
 
 	mutable Vector<uint8_t> comp_buffer;
+	mutable LocalVector<uint8_t> direct_buffer;
+	mutable LocalVector<uint32_t> direct_sizes;
 	uint8_t *read_ptr = nullptr;
 	mutable uint32_t read_block = 0;
 	uint32_t read_block_count = 0;
@@ -484,6 +484,23 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return to_read;
 }
 
+Span<uint8_t> FileAccessPack::get_buffer_view(uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(f.is_null(), Span<uint8_t>(), "File must be opened before use.");
+
+	if (eof || pos > pf.size || p_length > pf.size - pos) {
+		return Span<uint8_t>();
+	}
+
+	// Encrypted files never provide a view, since the underlying FileAccessEncrypted doesn't.
+	Span<uint8_t> view = f->get_buffer_view(p_length);
+	if (view.size() != p_length) {
+		return Span<uint8_t>();
+	}
+
+	pos += p_length;
+	return view;
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
 	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
 
@@ -520,14 +537,14 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 	if (pf.bundle) {
 		String simplified_path = p_path.simplify_path();
 		if (pf.salt.is_empty()) {
-			f = FileAccess::open(simplified_path, FileAccess::READ | FileAccess::SKIP_PACK);
+			f = FileAccess::open(simplified_path, FileAccess::READ | FileAccess::SKIP_PACK | FileAccess::MMAP);
 		} else {
-			f = FileAccess::open("res://" + (simplified_path + pf.salt).sha256_text(), FileAccess::READ | FileAccess::SKIP_PACK);
+			f = FileAccess::open("res://" + (simplified_path + pf.salt).sha256_text(), FileAccess::READ | FileAccess::SKIP_PACK | FileAccess::MMAP);
 		}
 		ERR_FAIL_COND_MSG(f.is_null(), vformat(R"(Can't open pack-referenced file "%s" from sparse pack "%s".)", simplified_path, pf.pack));
 		off = 0; // For the sparse pack offset is always zero.
 	} else {
-		f = FileAccess::open(pf.pack, FileAccess::READ);
+		f = FileAccess::open(pf.pack, FileAccess::READ | FileAccess::MMAP);
 		ERR_FAIL_COND_MSG(f.is_null(), vformat(R"(Can't open pack-referenced file "%s" from pack "%s".)", p_path, pf.pack));
 		f->seek(pf.offset);
 		off = pf.offset;
@@ -86,7 +86,7 @@ Error ImageLoader::load_image(const String &p_file, Ref<Image> p_image, Ref<File
 	Ref<FileAccess> f = p_custom;
 	if (f.is_null()) {
 		Error err;
-		f = FileAccess::open(file, FileAccess::READ, &err);
+		f = FileAccess::open(file, FileAccess::READ | FileAccess::MMAP, &err);
 		ERR_FAIL_COND_V_MSG(f.is_null(), err, vformat("Error opening file '%s'.", file));
 	}
 
@@ -0,0 +1,133 @@
+/**************************************************************************/
+/*  json_document.cpp                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "json_document.h"
+
+Error JSONDocument::_index(const uint8_t *p_utf8, uint64_t p_len) {
+	Error err = reader.index(p_utf8, p_len);
+	err_str = reader.get_error_message();
+	err_line = reader.get_error_line();
+	if (err != OK) {
+		data.clear();
+	}
+	return err;
+}
+
+Error JSONDocument::_find(const String &p_pointer, uint32_t &r_node, bool p_report_missing) {
+	ERR_FAIL_COND_V_MSG(!reader.is_indexed(), ERR_UNCONFIGURED, "No JSON document was loaded or parsed.");
+
+	Error err = reader.find(p_pointer, r_node);
+	if (err == ERR_DOES_NOT_EXIST) {
+		err_str = p_report_missing ? vformat("No value at JSON pointer \"%s\"", p_pointer) : String();
+		err_line = 0;
+	} else {
+		err_str = reader.get_error_message();
+		err_line = reader.get_error_line();
+	}
+	return err;
+}
+
+Error JSONDocument::load(const String &p_path) {
+	clear();
+
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, vformat("Cannot open file '%s'.", p_path));
+
+	data = f->get_buffer(f->get_length());
+	return _index(data.ptr(), data.size());
+}
+
+Error JSONDocument::parse(const String &p_text) {
+	clear();
+	data = p_text.to_utf8_buffer();
+	return _index(data.ptr(), data.size());
+}
+
+void JSONDocument::clear() {
+	reader.clear();
+	data.clear();
+	err_str = String();
+	err_line = 0;
+}
+
+bool JSONDocument::has_value(const String &p_pointer) {
+	uint32_t node = 0;
+	return reader.is_indexed() && _find(p_pointer, node, false) == OK;
+}
+
+Variant JSONDocument::get_value(const String &p_pointer, const Variant &p_default) {
+	uint32_t node = 0;
+	if (_find(p_pointer, node, true) != OK) {
+		return p_default;
+	}
+
+	Variant value;
+	Error err = reader.parse_node(node, value);
+	err_str = reader.get_error_message();
+	err_line = reader.get_error_line();
+	return err == OK ? value : p_default;
+}
+
+PackedStringArray JSONDocument::get_keys(const String &p_pointer) {
+	PackedStringArray keys;
+	uint32_t node = 0;
+	if (_find(p_pointer, node, true) == OK) {
+		reader.get_node_keys(node, keys);
+		err_str = reader.get_error_message();
+		err_line = reader.get_error_line();
+	}
+	return keys;
+}
+
+int JSONDocument::get_size(const String &p_pointer) {
+	int size = 0;
+	uint32_t node = 0;
+	if (_find(p_pointer, node, true) == OK) {
+		reader.get_node_size(node, size);
+		err_str = reader.get_error_message();
+		err_line = reader.get_error_line();
+	}
+	return size;
+}
+
+void JSONDocument::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("load", "path"), &JSONDocument::load);
+	ClassDB::bind_method(D_METHOD("parse", "text"), &JSONDocument::parse);
+	ClassDB::bind_method(D_METHOD("clear"), &JSONDocument::clear);
+
+	ClassDB::bind_method(D_METHOD("has_value", "pointer"), &JSONDocument::has_value);
+	ClassDB::bind_method(D_METHOD("get_value", "pointer", "default"), &JSONDocument::get_value, DEFVAL(Variant()));
+	ClassDB::bind_method(D_METHOD("get_keys", "pointer"), &JSONDocument::get_keys, DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("get_size", "pointer"), &JSONDocument::get_size, DEFVAL(String()));
+
+	ClassDB::bind_method(D_METHOD("get_error_line"), &JSONDocument::get_error_line);
+	ClassDB::bind_method(D_METHOD("get_error_message"), &JSONDocument::get_error_message);
+}
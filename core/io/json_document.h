@@ -0,0 +1,70 @@
+/**************************************************************************/
+/*  json_document.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/file_access.h"
+#include "core/io/json_reader.h"
+#include "core/object/ref_counted.h"
+
+// Looks values up in a JSON document by JSON pointer without building the whole
+// Variant tree: the document is only indexed once, and each lookup parses just the
+// requested subtree. Files are read through a memory map when the platform supports it.
+class JSONDocument : public RefCounted {
+	GDCLASS(JSONDocument, RefCounted);
+
+	// The reader's source. Always a copy: a mapping kept alive for the document's lifetime would
+	// fault as soon as the file is truncated or rewritten on disk.
+	Vector<uint8_t> data;
+
+	JSONReader reader;
+
+	String err_str;
+	int err_line = 0;
+
+	Error _index(const uint8_t *p_utf8, uint64_t p_len);
+	Error _find(const String &p_pointer, uint32_t &r_node, bool p_report_missing);
+
+protected:
+	static void _bind_methods();
+
+public:
+	Error load(const String &p_path);
+	Error parse(const String &p_text);
+	void clear();
+
+	bool has_value(const String &p_pointer);
+	Variant get_value(const String &p_pointer, const Variant &p_default = Variant());
+	PackedStringArray get_keys(const String &p_pointer = String());
+	int get_size(const String &p_pointer = String());
+
+	int get_error_line() const { return err_line; }
+	String get_error_message() const { return err_str; }
+};
@@ -0,0 +1,908 @@
+/**************************************************************************/
+/*  json_reader.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "json_reader.h"
+
+#include "core/templates/hash_set.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define JSON_READER_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define JSON_READER_NEON
+#include <arm_neon.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+
+// One bit per byte of a 64 byte block, lowest byte first.
+struct BlockMasks {
+	uint64_t quote = 0;
+	uint64_t backslash = 0;
+	uint64_t op = 0; // { } [ ] : ,
+	uint64_t whitespace = 0; // Anything up to 32, like the String parser.
+};
+
+_FORCE_INLINE_ uint32_t _ctz64(uint64_t p_bits) {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctzll(p_bits);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+	unsigned long index;
+	_BitScanForward64(&index, p_bits);
+	return index;
+#else
+	uint32_t index = 0;
+	while (!((p_bits >> index) & 1)) {
+		index++;
+	}
+	return index;
+#endif
+}
+
+_FORCE_INLINE_ uint32_t _popcount64(uint64_t p_bits) {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_popcountll(p_bits);
+#else
+	uint32_t count = 0;
+	while (p_bits) {
+		p_bits &= p_bits - 1;
+		count++;
+	}
+	return count;
+#endif
+}
+
+// Bit i of the result is the XOR of bits 0..i, which turns quote positions into
+// "inside a string" ranges (opening quote included, closing quote excluded).
+_FORCE_INLINE_ uint64_t _prefix_xor(uint64_t p_bits) {
+	p_bits ^= p_bits << 1;
+	p_bits ^= p_bits << 2;
+	p_bits ^= p_bits << 4;
+	p_bits ^= p_bits << 8;
+	p_bits ^= p_bits << 16;
+	p_bits ^= p_bits << 32;
+	return p_bits;
+}
+
+// Returns the characters preceded by an odd run of backslashes. r_carry tells the next
+// block whether its first character is escaped.
+_FORCE_INLINE_ uint64_t _find_escaped(uint64_t p_backslash, uint64_t &r_carry) {
+	const uint64_t even_bits = 0x5555555555555555ull;
+
+	p_backslash &= ~r_carry; // An escaped backslash doesn't escape anything.
+	const uint64_t follows_escape = (p_backslash << 1) | r_carry;
+
+	// Adding the starts of runs that begin on an odd bit to the backslashes carries
+	// past the end of each run, which flips the parity for those runs.
+	const uint64_t odd_sequence_starts = p_backslash & ~even_bits & ~follows_escape;
+	const uint64_t sequences_starting_on_even_bits = odd_sequence_starts + p_backslash;
+	r_carry = sequences_starting_on_even_bits < p_backslash ? 1 : 0;
+	const uint64_t invert_mask = sequences_starting_on_even_bits << 1;
+
+	return (even_bits ^ invert_mask) & follows_escape;
+}
+
+#if defined(JSON_READER_NEON)
+_FORCE_INLINE_ uint64_t _neon_bitmask(uint8x16_t p_0, uint8x16_t p_1, uint8x16_t p_2, uint8x16_t p_3) {
+	const uint8x16_t bit = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+	uint8x16_t sum0 = vpaddq_u8(vandq_u8(p_0, bit), vandq_u8(p_1, bit));
+	uint8x16_t sum1 = vpaddq_u8(vandq_u8(p_2, bit), vandq_u8(p_3, bit));
+	sum0 = vpaddq_u8(sum0, sum1);
+	sum0 = vpaddq_u8(sum0, sum0);
+	return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+}
+#endif
+
+_FORCE_INLINE_ void _classify_block(const uint8_t *p_block, BlockMasks &r_masks) {
+#if defined(JSON_READER_SSE2)
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i backslash = _mm_set1_epi8('\\');
+	const __m128i curly_open = _mm_set1_epi8('{');
+	const __m128i curly_close = _mm_set1_epi8('}');
+	const __m128i comma = _mm_set1_epi8(',');
+	const __m128i colon = _mm_set1_epi8(':');
+	const __m128i space = _mm_set1_epi8(0x20);
+
+	for (int i = 0; i < 4; i++) {
+		const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_block + i * 16));
+		// Setting bit 5 folds '[' into '{' and ']' into '}', nothing else maps onto those.
+		const __m128i folded = _mm_or_si128(chars, space);
+		const __m128i op = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(folded, curly_open), _mm_cmpeq_epi8(folded, curly_close)),
+				_mm_or_si128(_mm_cmpeq_epi8(chars, comma), _mm_cmpeq_epi8(chars, colon)));
+		const __m128i whitespace = _mm_cmpeq_epi8(_mm_max_epu8(chars, space), space);
+
+		const int shift = i * 16;
+		r_masks.quote |= uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, quote)))) << shift;
+		r_masks.backslash |= uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, backslash)))) << shift;
+		r_masks.op |= uint64_t(uint32_t(_mm_movemask_epi8(op))) << shift;
+		r_masks.whitespace |= uint64_t(uint32_t(_mm_movemask_epi8(whitespace))) << shift;
+	}
+#elif defined(JSON_READER_NEON)
+	uint8x16_t chars[4];
+	uint8x16_t quote[4];
+	uint8x16_t backslash[4];
+	uint8x16_t op[4];
+	uint8x16_t whitespace[4];
+	for (int i = 0; i < 4; i++) {
+		chars[i] = vld1q_u8(p_block + i * 16);
+		const uint8x16_t folded = vorrq_u8(chars[i], vdupq_n_u8(0x20));
+		quote[i] = vceqq_u8(chars[i], vdupq_n_u8('"'));
+		backslash[i] = vceqq_u8(chars[i], vdupq_n_u8('\\'));
+		op[i] = vorrq_u8(
+				vorrq_u8(vceqq_u8(folded, vdupq_n_u8('{')), vceqq_u8(folded, vdupq_n_u8('}'))),
+				vorrq_u8(vceqq_u8(chars[i], vdupq_n_u8(',')), vceqq_u8(chars[i], vdupq_n_u8(':'))));
+		whitespace[i] = vcleq_u8(chars[i], vdupq_n_u8(0x20));
+	}
+	r_masks.quote = _neon_bitmask(quote[0], quote[1], quote[2], quote[3]);
+	r_masks.backslash = _neon_bitmask(backslash[0], backslash[1], backslash[2], backslash[3]);
+	r_masks.op = _neon_bitmask(op[0], op[1], op[2], op[3]);
+	r_masks.whitespace = _neon_bitmask(whitespace[0], whitespace[1], whitespace[2], whitespace[3]);
+#else
+	for (int i = 0; i < 64; i++) {
+		const uint8_t c = p_block[i];
+		const uint64_t bit = uint64_t(1) << i;
+		if (c == '"') {
+			r_masks.quote |= bit;
+		} else if (c == '\\') {
+			r_masks.backslash |= bit;
+		} else if (c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',') {
+			r_masks.op |= bit;
+		} else if (c <= 0x20) {
+			r_masks.whitespace |= bit;
+		}
+	}
+#endif
+}
+
+_FORCE_INLINE_ bool _is_scalar_end(uint8_t p_char) {
+	return p_char <= 0x20 || p_char == '"' || p_char == ',' || p_char == ':' || p_char == '[' || p_char == ']' || p_char == '{' || p_char == '}';
+}
+
+_FORCE_INLINE_ int _hex_value(uint8_t p_char) {
+	if (p_char >= '0' && p_char <= '9') {
+		return p_char - '0';
+	} else if (p_char >= 'a' && p_char <= 'f') {
+		return p_char - 'a' + 10;
+	} else if (p_char >= 'A' && p_char <= 'F') {
+		return p_char - 'A' + 10;
+	}
+	return -1;
+}
+
+} // namespace
+
+void JSONReader::_index() {
+	structurals.clear();
+
+	uint64_t escaped_carry = 0;
+	uint64_t in_string_carry = 0;
+	uint64_t scalar_carry = 0;
+	uint8_t tail[64];
+
+	for (uint64_t base = 0; base < src_len; base += 64) {
+		const uint8_t *block = src + base;
+		if (src_len - base < 64) {
+			// Pad the last block with whitespace, which never starts a token.
+			memset(tail, 0x20, 64);
+			memcpy(tail, block, src_len - base);
+			block = tail;
+		}
+
+		BlockMasks masks;
+		_classify_block(block, masks);
+
+		const uint64_t quote = masks.quote & ~_find_escaped(masks.backslash, escaped_carry);
+		const uint64_t in_string = _prefix_xor(quote) ^ in_string_carry;
+		in_string_carry = uint64_t(int64_t(in_string) >> 63);
+		// Everything inside strings, including the closing quote but not the opening one.
+		const uint64_t string_tail = in_string ^ quote;
+
+		// A scalar (number, literal or opening quote) starts wherever a non-whitespace,
+		// non-operator byte doesn't directly follow another one.
+		const uint64_t scalar = ~(masks.op | masks.whitespace);
+		const uint64_t nonquote_scalar = scalar & ~quote;
+		const uint64_t follows_scalar = (nonquote_scalar << 1) | scalar_carry;
+		scalar_carry = nonquote_scalar >> 63;
+
+		uint64_t starts = (masks.op | (scalar & ~follows_scalar)) & ~string_tail;
+		if (!starts) {
+			continue;
+		}
+
+		uint32_t at = structurals.size();
+		structurals.resize(at + _popcount64(starts));
+		while (starts) {
+			structurals[at++] = uint32_t(base + _ctz64(starts));
+			starts &= starts - 1;
+		}
+	}
+}
+
+Error JSONReader::_error(uint64_t p_offset, const String &p_message) {
+	err_str = p_message;
+	err_line = 0;
+	for (uint64_t i = 0; i < p_offset && i < src_len; i++) {
+		if (src[i] == '\n') {
+			err_line++;
+		}
+	}
+	return ERR_PARSE_ERROR;
+}
+
+Error JSONReader::_parse_value(Variant &r_value, int p_depth) {
+	if (p_depth > Variant::MAX_RECURSION_DEPTH) {
+		err_str = "JSON structure is too deep";
+		return ERR_OUT_OF_MEMORY;
+	}
+
+	if (!_has_next()) {
+		return _error(src_len, "Expected value, got 'EOF'");
+	}
+
+	const uint8_t c = _peek();
+	switch (c) {
+		case '{': {
+			Dictionary d;
+			Error err = _parse_object(d, p_depth + 1);
+			if (err) {
+				return err;
+			}
+			r_value = d;
+		} break;
+		case '[': {
+			Array a;
+			Error err = _parse_array(a, p_depth + 1);
+			if (err) {
+				return err;
+			}
+			r_value = a;
+		} break;
+		case '"': {
+			String s;
+			Error err = _parse_string(s);
+			if (err) {
+				return err;
+			}
+			r_value = s;
+		} break;
+		case '}':
+		case ']':
+		case ':':
+		case ',': {
+			return _error(structurals[current], vformat("Expected value, got '%s'", String::chr(c)));
+		}
+		default: {
+			if (c == '-' || is_digit(c)) {
+				return _parse_number(r_value);
+			} else if (is_ascii_alphabet_char(c)) {
+				return _parse_literal(r_value);
+			}
+			return _error(structurals[current], "Unexpected character");
+		}
+	}
+
+	return OK;
+}
+
+Error JSONReader::_parse_object(Dictionary &r_object, int p_depth) {
+	current++; // '{'
+
+	while (true) {
+		if (!_has_next()) {
+			return _error(src_len, "Expected '}'");
+		}
+		if (_peek() == '}') {
+			// Also accepts a trailing comma, like the String parser.
+			current++;
+			return OK;
+		}
+		if (_peek() != '"') {
+			return _error(structurals[current], "Expected key");
+		}
+
+		String key;
+		Error err = _parse_string(key);
+		if (err) {
+			return err;
+		}
+		if (!_has_next() || _peek() != ':') {
+			return _error(_has_next() ? structurals[current] : src_len, "Expected ':'");
+		}
+		current++;
+
+		Variant v;
+		err = _parse_value(v, p_depth);
+		if (err) {
+			return err;
+		}
+		r_object[key] = v;
+
+		if (!_has_next()) {
+			return _error(src_len, "Expected '}'");
+		}
+		const uint8_t c = _peek();
+		current++;
+		if (c == '}') {
+			return OK;
+		}
+		if (c != ',') {
+			return _error(structurals[current - 1], "Expected '}' or ','");
+		}
+	}
+}
+
+Error JSONReader::_parse_array(Array &r_array, int p_depth) {
+	current++; // '['
+
+	while (true) {
+		if (!_has_next()) {
+			return _error(src_len, "Expected ']'");
+		}
+		if (_peek() == ']') {
+			// Also accepts a trailing comma, like the String parser.
+			current++;
+			return OK;
+		}
+
+		Variant v;
+		Error err = _parse_value(v, p_depth);
+		if (err) {
+			return err;
+		}
+		r_array.push_back(v);
+
+		if (!_has_next()) {
+			return _error(src_len, "Expected ']'");
+		}
+		const uint8_t c = _peek();
+		current++;
+		if (c == ']') {
+			return OK;
+		}
+		if (c != ',') {
+			return _error(structurals[current - 1], "Expected ','");
+		}
+	}
+}
+
+Error JSONReader::_parse_string(String &r_string) {
+	const uint64_t open = structurals[current++];
+	const uint8_t *start = src + open + 1;
+	const uint8_t *end = src + src_len;
+
+	const uint8_t *c = start;
+	while (c < end && *c != '"' && *c != '\\') {
+		c++;
+	}
+	if (c == end) {
+		return _error(src_len, "Unterminated string");
+	}
+	if (*c == '"') {
+		// No escapes, decode straight from the source.
+		r_string = String::utf8((const char *)start, c - start);
+		return OK;
+	}
+
+	// Unescape into the scratch buffer, copying unescaped runs in one go.
+	scratch.clear();
+	const uint8_t *run = start;
+	while (true) {
+		while (c < end && *c != '"' && *c != '\\') {
+			c++;
+		}
+		if (c == end) {
+			return _error(src_len, "Unterminated string");
+		}
+		if (c > run) {
+			const uint32_t at = scratch.size();
+			scratch.resize(at + (c - run));
+			memcpy(scratch.ptr() + at, run, c - run);
+		}
+		if (*c == '"') {
+			break;
+		}
+
+		c++; // '\\'
+		if (c == end) {
+			return _error(src_len, "Unterminated string");
+		}
+
+		char32_t res = 0;
+		switch (*c) {
+			case 'b':
+				res = 8;
+				break;
+			case 't':
+				res = 9;
+				break;
+			case 'n':
+				res = 10;
+				break;
+			case 'f':
+				res = 12;
+				break;
+			case 'r':
+				res = 13;
+				break;
+			case '"':
+			case '\\':
+			case '/':
+				res = *c;
+				break;
+			case 'u': {
+				for (int j = 0; j < 4; j++) {
+					if (c + 1 == end) {
+						return _error(src_len, "Unterminated string");
+					}
+					const int v = _hex_value(*++c);
+					if (v < 0) {
+						return _error(c - src, "Malformed hex constant in string");
+					}
+					res = (res << 4) | v;
+				}
+
+				if ((res & 0xfffffc00) == 0xd800) {
+					if (end - c < 3 || c[1] != '\\' || c[2] != 'u') {
+						return _error(c - src, "Invalid UTF-16 sequence in string, unpaired lead surrogate");
+					}
+					c += 2;
+					char32_t trail = 0;
+					for (int j = 0; j < 4; j++) {
+						if (c + 1 == end) {
+							return _error(src_len, "Unterminated string");
+						}
+						const int v = _hex_value(*++c);
+						if (v < 0) {
+							return _error(c - src, "Malformed hex constant in string");
+						}
+						trail = (trail << 4) | v;
+					}
+					if ((trail & 0xfffffc00) != 0xdc00) {
+						return _error(c - src, "Invalid UTF-16 sequence in string, unpaired lead surrogate");
+					}
+					res = (res << 10UL) + trail - ((0xd800 << 10UL) + 0xdc00 - 0x10000);
+				} else if ((res & 0xfffffc00) == 0xdc00) {
+					return _error(c - src, "Invalid UTF-16 sequence in string, unpaired trail surrogate");
+				}
+			} break;
+			default: {
+				return _error(c - src, "Invalid escape sequence");
+			}
+		}
+
+		// Re-encode as UTF-8 so the whole string is decoded once at the end.
+		if (res < 0x80) {
+			scratch.push_back(char(res));
+		} else if (res < 0x800) {
+			scratch.push_back(char(0xc0 | (res >> 6)));
+			scratch.push_back(char(0x80 | (res & 0x3f)));
+		} else if (res < 0x10000) {
+			scratch.push_back(char(0xe0 | (res >> 12)));
+			scratch.push_back(char(0x80 | ((res >> 6) & 0x3f)));
+			scratch.push_back(char(0x80 | (res & 0x3f)));
+		} else {
+			scratch.push_back(char(0xf0 | (res >> 18)));
+			scratch.push_back(char(0x80 | ((res >> 12) & 0x3f)));
+			scratch.push_back(char(0x80 | ((res >> 6) & 0x3f)));
+			scratch.push_back(char(0x80 | (res & 0x3f)));
+		}
+
+		c++;
+		run = c;
+	}
+
+	r_string = String::utf8(scratch.ptr(), scratch.size());
+	return OK;
+}
+
+Error JSONReader::_parse_number(Variant &r_value) {
+	const uint64_t offset = structurals[current++];
+	uint64_t len = 0;
+	while (offset + len < src_len && !_is_scalar_end(src[offset + len])) {
+		len++;
+	}
+
+	// The source isn't null-terminated, so copy the token out before converting it.
+	char local[64];
+	char *token = local;
+	if (len >= sizeof(local)) {
+		scratch.resize(len + 1);
+		token = scratch.ptr();
+	}
+	memcpy(token, src + offset, len);
+	token[len] = 0;
+
+	const char *token_end = nullptr;
+	const double number = String::to_float(token, &token_end);
+	if (token_end == token || uint64_t(token_end - token) != len) {
+		return _error(offset + (token_end - token), "Unexpected character");
+	}
+
+	r_value = number;
+	return OK;
+}
+
+Error JSONReader::_parse_literal(Variant &r_value) {
+	const uint64_t offset = structurals[current++];
+	uint64_t len = 0;
+	while (offset + len < src_len && is_ascii_alphabet_char(src[offset + len])) {
+		len++;
+	}
+
+	const char *literal = (const char *)src + offset;
+	if (len == 4 && memcmp(literal, "true", 4) == 0) {
+		r_value = true;
+	} else if (len == 5 && memcmp(literal, "false", 5) == 0) {
+		r_value = false;
+	} else if (len == 4 && memcmp(literal, "null", 4) == 0) {
+		r_value = Variant();
+	} else {
+		return _error(offset, vformat("Expected 'true', 'false', or 'null', got '%s'", String::utf8(literal, len)));
+	}
+
+	if (offset + len < src_len && !_is_scalar_end(src[offset + len])) {
+		return _error(offset + len, "Unexpected character");
+	}
+	return OK;
+}
+
+Error JSONReader::_begin(const uint8_t *p_utf8, uint64_t p_len) {
+	err_str = String();
+	err_line = 0;
+	current = 0;
+	closing.clear();
+
+	// Skip the UTF-8 byte order mark, String::utf8() drops it too.
+	if (p_len >= 3 && p_utf8[0] == 0xef && p_utf8[1] == 0xbb && p_utf8[2] == 0xbf) {
+		p_utf8 += 3;
+		p_len -= 3;
+	}
+	src = p_utf8;
+	src_len = p_len;
+
+	if (p_len >= UINT32_MAX) {
+		err_str = "JSON document is too large";
+		return ERR_OUT_OF_MEMORY;
+	}
+
+	_index();
+	return OK;
+}
+
+Error JSONReader::parse(const uint8_t *p_utf8, uint64_t p_len, Variant &r_value) {
+	r_value = Variant();
+
+	Error err = _begin(p_utf8, p_len);
+	if (err == OK) {
+		err = _parse_value(r_value, 0);
+	}
+	if (err == OK && _has_next()) {
+		err = _error(structurals[current], "Expected 'EOF'");
+	}
+	if (err != OK) {
+		r_value = Variant();
+	}
+
+	src = nullptr;
+	src_len = 0;
+	return err;
+}
+
+Error JSONReader::_match_brackets() {
+	closing.resize(structurals.size());
+
+	LocalVector<uint32_t> open;
+	for (uint32_t i = 0; i < structurals.size(); i++) {
+		const uint8_t c = src[structurals[i]];
+		if (c == '{' || c == '[') {
+			open.push_back(i);
+		} else if (c == '}' || c == ']') {
+			if (open.is_empty()) {
+				return _error(structurals[i], vformat("Expected value, got '%s'", String::chr(c)));
+			}
+			const uint32_t o = open[open.size() - 1];
+			if (src[structurals[o]] != (c == '}' ? '{' : '[')) {
+				return _error(structurals[i], c == '}' ? "Expected ']'" : "Expected '}'");
+			}
+			closing[o] = i;
+			open.resize(open.size() - 1);
+		}
+	}
+
+	if (!open.is_empty()) {
+		return _error(src_len, src[structurals[open[open.size() - 1]]] == '{' ? "Expected '}'" : "Expected ']'");
+	}
+	return OK;
+}
+
+uint32_t JSONReader::_skip_value(uint32_t p_node) const {
+	const uint8_t c = src[structurals[p_node]];
+	return (c == '{' || c == '[') ? closing[p_node] + 1 : p_node + 1;
+}
+
+Error JSONReader::_entry_value(uint32_t p_container, uint32_t p_key, uint32_t &r_value) {
+	const uint32_t end = closing[p_container];
+	if (src[structurals[p_key]] != '"') {
+		return _error(structurals[p_key], "Expected key");
+	}
+	if (p_key + 1 >= end || src[structurals[p_key + 1]] != ':') {
+		return _error(structurals[MIN(p_key + 1, end)], "Expected ':'");
+	}
+	r_value = p_key + 2;
+	const uint8_t c = src[structurals[r_value]];
+	if (r_value >= end || c == ',' || c == ':') {
+		return _error(structurals[r_value], vformat("Expected value, got '%s'", String::chr(c)));
+	}
+	return OK;
+}
+
+Error JSONReader::_next_entry(uint32_t p_container, uint32_t &r_node) {
+	const bool object = src[structurals[p_container]] == '{';
+	uint32_t value = r_node;
+	if (object) {
+		Error err = _entry_value(p_container, r_node, value);
+		if (err) {
+			return err;
+		}
+	} else {
+		const uint8_t c = src[structurals[value]];
+		if (c == ',' || c == ':') {
+			return _error(structurals[value], vformat("Expected value, got '%s'", String::chr(c)));
+		}
+	}
+
+	uint32_t next = _skip_value(value);
+	if (next < closing[p_container]) {
+		if (src[structurals[next]] != ',') {
+			return _error(structurals[next], object ? "Expected '}' or ','" : "Expected ','");
+		}
+		// May land on the closing bracket, trailing commas are accepted.
+		next++;
+	}
+	r_node = next;
+	return OK;
+}
+
+bool JSONReader::_key_equals(uint32_t p_node, const String &p_key, const CharString &p_key_utf8) {
+	const uint8_t *start = src + structurals[p_node] + 1;
+	const uint8_t *end = src + src_len;
+	const uint8_t *c = start;
+	while (c < end && *c != '"' && *c != '\\') {
+		c++;
+	}
+	if (c == end) {
+		return false;
+	}
+	if (*c == '"') {
+		// Most keys have no escapes, compare the raw bytes.
+		return c - start == p_key_utf8.length() && memcmp(start, p_key_utf8.get_data(), c - start) == 0;
+	}
+
+	current = p_node;
+	String key;
+	return _parse_string(key) == OK && key == p_key;
+}
+
+Error JSONReader::_find_child(uint32_t p_container, const String &p_token, uint32_t &r_node) {
+	const uint8_t c = src[structurals[p_container]];
+	if (c == '{') {
+		const CharString key_utf8 = p_token.utf8();
+		bool found = false;
+		for (uint32_t i = p_container + 1; i < closing[p_container];) {
+			uint32_t value = 0;
+			Error err = _entry_value(p_container, i, value);
+			if (err) {
+				return err;
+			}
+			if (_key_equals(i, p_token, key_utf8)) {
+				// Keep going, the last duplicate wins like in a parsed Dictionary.
+				r_node = value;
+				found = true;
+			}
+			err = _next_entry(p_container, i);
+			if (err) {
+				return err;
+			}
+		}
+		return found ? OK : ERR_DOES_NOT_EXIST;
+	}
+
+	if (c == '[') {
+		// RFC 6901 array indices are plain decimal numbers.
+		if (p_token.is_empty() || p_token.length() > 10 || (p_token.length() > 1 && p_token[0] == '0')) {
+			return ERR_DOES_NOT_EXIST;
+		}
+		for (int i = 0; i < p_token.length(); i++) {
+			if (!is_digit(p_token[i])) {
+				return ERR_DOES_NOT_EXIST;
+			}
+		}
+
+		int64_t index = p_token.to_int();
+		for (uint32_t i = p_container + 1; i < closing[p_container];) {
+			if (index == 0) {
+				const uint8_t e = src[structurals[i]];
+				if (e == ',' || e == ':') {
+					return _error(structurals[i], vformat("Expected value, got '%s'", String::chr(e)));
+				}
+				r_node = i;
+				return OK;
+			}
+			index--;
+			Error err = _next_entry(p_container, i);
+			if (err) {
+				return err;
+			}
+		}
+	}
+
+	return ERR_DOES_NOT_EXIST;
+}
+
+Error JSONReader::index(const uint8_t *p_utf8, uint64_t p_len) {
+	Error err = _begin(p_utf8, p_len);
+	if (err == OK) {
+		err = _match_brackets();
+	}
+	if (err == OK && structurals.is_empty()) {
+		err = _error(src_len, "Expected value, got 'EOF'");
+	}
+	if (err == OK && _skip_value(0) < structurals.size()) {
+		err = _error(structurals[_skip_value(0)], "Expected 'EOF'");
+	}
+
+	if (err != OK) {
+		const String message = err_str;
+		const int line = err_line;
+		clear();
+		err_str = message;
+		err_line = line;
+	}
+	return err;
+}
+
+void JSONReader::clear() {
+	src = nullptr;
+	src_len = 0;
+	current = 0;
+	structurals.clear();
+	closing.clear();
+	scratch.clear();
+	err_str = String();
+	err_line = 0;
+}
+
+Error JSONReader::find(const String &p_pointer, uint32_t &r_node) {
+	ERR_FAIL_COND_V_MSG(!is_indexed(), ERR_UNCONFIGURED, "No JSON document is indexed.");
+	err_str = String();
+	err_line = 0;
+
+	r_node = 0;
+	if (p_pointer.is_empty()) {
+		return OK;
+	}
+	if (p_pointer[0] != '/') {
+		err_str = "JSON pointer must be empty or start with '/'";
+		return ERR_INVALID_PARAMETER;
+	}
+
+	const Vector<String> tokens = p_pointer.substr(1).split("/");
+	for (const String &token : tokens) {
+		Error err = _find_child(r_node, token.replace("~1", "/").replace("~0", "~"), r_node);
+		if (err) {
+			return err;
+		}
+	}
+	return OK;
+}
+
+Error JSONReader::parse_node(uint32_t p_node, Variant &r_value) {
+	ERR_FAIL_COND_V_MSG(!is_indexed(), ERR_UNCONFIGURED, "No JSON document is indexed.");
+	ERR_FAIL_UNSIGNED_INDEX_V(p_node, structurals.size(), ERR_INVALID_PARAMETER);
+	err_str = String();
+	err_line = 0;
+
+	current = p_node;
+	Error err = _parse_value(r_value, 0);
+	if (err != OK) {
+		r_value = Variant();
+	}
+	return err;
+}
+
+Error JSONReader::get_node_keys(uint32_t p_node, PackedStringArray &r_keys) {
+	ERR_FAIL_COND_V_MSG(!is_indexed(), ERR_UNCONFIGURED, "No JSON document is indexed.");
+	ERR_FAIL_UNSIGNED_INDEX_V(p_node, structurals.size(), ERR_INVALID_PARAMETER);
+	err_str = String();
+	err_line = 0;
+
+	r_keys.clear();
+	if (src[structurals[p_node]] != '{') {
+		err_str = "Value is not an object";
+		return ERR_INVALID_PARAMETER;
+	}
+
+	HashSet<String> seen;
+	for (uint32_t i = p_node + 1; i < closing[p_node];) {
+		uint32_t value = 0;
+		Error err = _entry_value(p_node, i, value);
+		if (err) {
+			return err;
+		}
+		current = i;
+		String key;
+		err = _parse_string(key);
+		if (err) {
+			return err;
+		}
+		if (!seen.has(key)) {
+			seen.insert(key);
+			r_keys.push_back(key);
+		}
+		err = _next_entry(p_node, i);
+		if (err) {
+			return err;
+		}
+	}
+	return OK;
+}
+
+Error JSONReader::get_node_size(uint32_t p_node, int &r_size) {
+	ERR_FAIL_COND_V_MSG(!is_indexed(), ERR_UNCONFIGURED, "No JSON document is indexed.");
+	ERR_FAIL_UNSIGNED_INDEX_V(p_node, structurals.size(), ERR_INVALID_PARAMETER);
+	err_str = String();
+	err_line = 0;
+
+	r_size = 0;
+	const uint8_t c = src[structurals[p_node]];
+	if (c == '{') {
+		PackedStringArray keys;
+		Error err = get_node_keys(p_node, keys);
+		r_size = keys.size();
+		return err;
+	}
+	if (c != '[') {
+		err_str = "Value is not an array or an object";
+		return ERR_INVALID_PARAMETER;
+	}
+
+	for (uint32_t i = p_node + 1; i < closing[p_node]; r_size++) {
+		Error err = _next_entry(p_node, i);
+		if (err) {
+			return err;
+		}
+	}
+	return OK;
+}
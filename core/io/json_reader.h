@@ -0,0 +1,100 @@
+/**************************************************************************/
+/*  json_reader.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/local_vector.h"
+#include "core/variant/variant.h"
+
+// Parses UTF-8 JSON straight into Variants, without converting the whole document
+// to a String first.
+// Like simdjson, it runs in two passes: the first one scans 64 bytes at a time (with
+// SSE2 or NEON when available) and records the offset of every structural character
+// and scalar start outside of strings; the second one walks that index and builds the
+// Variant tree. Accepts the same input as the String parser in JSON (all numbers become
+// floats, any byte up to 32 counts as whitespace) and reports errors the same way.
+class JSONReader {
+	const uint8_t *src = nullptr;
+	uint64_t src_len = 0;
+
+	LocalVector<uint32_t> structurals;
+	// Only filled by index(): for every '{' and '[', the structural index of the matching
+	// closing bracket, so lookups can step over whole subtrees.
+	LocalVector<uint32_t> closing;
+	uint32_t current = 0;
+
+	LocalVector<char> scratch;
+
+	String err_str;
+	int err_line = 0;
+
+	Error _begin(const uint8_t *p_utf8, uint64_t p_len);
+	void _index();
+
+	Error _error(uint64_t p_offset, const String &p_message);
+	_FORCE_INLINE_ bool _has_next() const { return current < structurals.size(); }
+	_FORCE_INLINE_ uint8_t _peek() const { return src[structurals[current]]; }
+
+	Error _parse_value(Variant &r_value, int p_depth);
+	Error _parse_object(Dictionary &r_object, int p_depth);
+	Error _parse_array(Array &r_array, int p_depth);
+	Error _parse_string(String &r_string);
+	Error _parse_number(Variant &r_value);
+	Error _parse_literal(Variant &r_value);
+
+	Error _match_brackets();
+	uint32_t _skip_value(uint32_t p_node) const;
+	Error _entry_value(uint32_t p_container, uint32_t p_key, uint32_t &r_value);
+	Error _next_entry(uint32_t p_container, uint32_t &r_node);
+	bool _key_equals(uint32_t p_node, const String &p_key, const CharString &p_key_utf8);
+	Error _find_child(uint32_t p_container, const String &p_token, uint32_t &r_node);
+
+public:
+	Error parse(const uint8_t *p_utf8, uint64_t p_len, Variant &r_value);
+
+	// On-demand mode. index() only checks that brackets are balanced; the source must
+	// outlive the reader (or the next call to index() or clear()), and syntax errors
+	// inside a subtree are only reported once that subtree is looked up or parsed.
+	Error index(const uint8_t *p_utf8, uint64_t p_len);
+	void clear();
+	bool is_indexed() const { return src != nullptr; }
+
+	// Resolves an RFC 6901 JSON pointer ("" is the whole document, "/a/0" the first
+	// element of the array under "a") to a node. Returns ERR_DOES_NOT_EXIST if there
+	// is no such value.
+	Error find(const String &p_pointer, uint32_t &r_node);
+	Error parse_node(uint32_t p_node, Variant &r_value);
+	Error get_node_keys(uint32_t p_node, PackedStringArray &r_keys);
+	Error get_node_size(uint32_t p_node, int &r_size);
+
+	String get_error_message() const { return err_str; }
+	// Counted the same way as the String parser: the number of line breaks before the error.
+	int get_error_line() const { return err_line; }
+};
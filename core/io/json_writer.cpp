@@ -0,0 +1,345 @@
+/**************************************************************************/
+/*  json_writer.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "json_writer.h"
+
+void JSONWriter::_append_ascii(const String &p_string) {
+	const int len = p_string.length();
+	uint8_t *dst = _grow(len);
+	const char32_t *src = p_string.ptr();
+	for (int i = 0; i < len; i++) {
+		dst[i] = uint8_t(src[i]);
+	}
+}
+
+void JSONWriter::_append_indent(int p_size) {
+	if (indent.length() == 0) {
+		return;
+	}
+	for (int i = 0; i < p_size; i++) {
+		_append(indent.get_data(), indent.length());
+	}
+}
+
+void JSONWriter::_append_int(int64_t p_int) {
+	char digits[24];
+	int at = sizeof(digits);
+	// Work on the unsigned magnitude so INT64_MIN doesn't overflow.
+	uint64_t magnitude = p_int < 0 ? uint64_t(0) - uint64_t(p_int) : uint64_t(p_int);
+	do {
+		digits[--at] = char('0' + magnitude % 10);
+		magnitude /= 10;
+	} while (magnitude);
+	if (p_int < 0) {
+		digits[--at] = '-';
+	}
+	_append(digits + at, sizeof(digits) - at);
+}
+
+void JSONWriter::_append_float(double p_float) {
+	// JSON does not support NaN or Infinity, so use extremely large numbers for infinity.
+	if (!Math::is_finite(p_float)) {
+		if (p_float == Math::INF) {
+			_append("1e99999", 7);
+		} else if (p_float == -Math::INF) {
+			_append("-1e99999", 8);
+		} else {
+			WARN_PRINT_ONCE("`NaN` (\"Not a Number\") found in argument passed to JSON.stringify(). `NaN` cannot be represented in JSON, so the value has been replaced with `null`. This warning will not be printed for any later NaN occurrences.");
+			_append("null", 4);
+		}
+		return;
+	}
+	// Only for exactly 0. If we have approximately 0 let the user decide how much
+	// precision they want.
+	if (p_float == double(0.0)) {
+		_append("0.0", 3);
+		return;
+	}
+
+	if (full_precision) {
+		const String num_sci = String::num_scientific(p_float);
+		_append_ascii(num_sci);
+		if (!num_sci.contains_char('.') && !num_sci.contains_char('e')) {
+			_append(".0", 2);
+		}
+	} else {
+		const double magnitude = std::log10(Math::abs(p_float));
+		const int precision = MAX(1, 14 - (int)Math::floor(magnitude));
+		_append_ascii(String::num(p_float, precision));
+	}
+}
+
+void JSONWriter::_append_string(const String &p_string) {
+	// Same escapes as String::json_escape(), encoded as UTF-8 on the fly.
+	_append('"');
+	const char32_t *src = p_string.ptr();
+	const int len = p_string.length();
+	for (int i = 0; i < len; i++) {
+		const char32_t c = src[i];
+		if (c < 0x80) {
+			switch (c) {
+				case '\\':
+					_append("\\\\", 2);
+					break;
+				case '"':
+					_append("\\\"", 2);
+					break;
+				case '\b':
+					_append("\\b", 2);
+					break;
+				case '\f':
+					_append("\\f", 2);
+					break;
+				case '\n':
+					_append("\\n", 2);
+					break;
+				case '\r':
+					_append("\\r", 2);
+					break;
+				case '\t':
+					_append("\\t", 2);
+					break;
+				case '\v':
+					_append("\\v", 2);
+					break;
+				default:
+					_append(char(c));
+			}
+		} else if (c < 0x800) {
+			uint8_t *dst = _grow(2);
+			dst[0] = uint8_t(0xc0 | (c >> 6));
+			dst[1] = uint8_t(0x80 | (c & 0x3f));
+		} else if (c < 0x10000) {
+			uint8_t *dst = _grow(3);
+			dst[0] = uint8_t(0xe0 | (c >> 12));
+			dst[1] = uint8_t(0x80 | ((c >> 6) & 0x3f));
+			dst[2] = uint8_t(0x80 | (c & 0x3f));
+		} else if (c < 0x110000) {
+			uint8_t *dst = _grow(4);
+			dst[0] = uint8_t(0xf0 | (c >> 18));
+			dst[1] = uint8_t(0x80 | ((c >> 12) & 0x3f));
+			dst[2] = uint8_t(0x80 | ((c >> 6) & 0x3f));
+			dst[3] = uint8_t(0x80 | (c & 0x3f));
+		} else {
+			_append("\xef\xbf\xbd", 3); // Not representable, use the replacement character.
+		}
+	}
+	_append('"');
+}
+
+void JSONWriter::_flush_to_file() {
+	if (buffer.is_empty()) {
+		return;
+	}
+	if (!file->store_buffer(buffer.ptr(), buffer.size()) && file_error == OK) {
+		file_error = ERR_FILE_CANT_WRITE;
+	}
+	buffer.clear();
+}
+
+void JSONWriter::_write(const Variant &p_var, int p_cur_indent) {
+	if (p_cur_indent > Variant::MAX_RECURSION_DEPTH) {
+		_append("...", 3);
+		ERR_FAIL_MSG("JSON structure is too deep. Bailing.");
+	}
+
+	const bool pretty = indent.length() > 0;
+
+	switch (p_var.get_type()) {
+		case Variant::NIL:
+			_append("null", 4);
+			return;
+		case Variant::BOOL:
+			if (p_var.operator bool()) {
+				_append("true", 4);
+			} else {
+				_append("false", 5);
+			}
+			return;
+		case Variant::INT:
+			_append_int(p_var);
+			return;
+		case Variant::FLOAT:
+			_append_float(p_var);
+			return;
+		case Variant::STRING:
+			_append_string(p_var);
+			return;
+		case Variant::PACKED_INT32_ARRAY:
+		case Variant::PACKED_INT64_ARRAY:
+		case Variant::PACKED_FLOAT32_ARRAY:
+		case Variant::PACKED_FLOAT64_ARRAY:
+		case Variant::PACKED_STRING_ARRAY:
+		case Variant::ARRAY: {
+			Array a = p_var;
+			if (markers.has(a.id())) {
+				_append("\"[...]\"", 7);
+				ERR_FAIL_MSG("Converting circular structure to JSON.");
+			}
+
+			if (a.is_empty()) {
+				_append("[]", 2);
+				return;
+			}
+
+			_append('[');
+			if (pretty) {
+				_append('\n');
+			}
+
+			markers.insert(a.id());
+
+			bool first = true;
+			for (const Variant &var : a) {
+				if (first) {
+					first = false;
+				} else {
+					_append(',');
+					if (pretty) {
+						_append('\n');
+					}
+				}
+				_append_indent(p_cur_indent + 1);
+				_write(var, p_cur_indent + 1);
+			}
+			if (pretty) {
+				_append('\n');
+			}
+			_append_indent(p_cur_indent);
+			_append(']');
+			markers.erase(a.id());
+			return;
+		}
+		case Variant::DICTIONARY: {
+			Dictionary d = p_var;
+			if (markers.has(d.id())) {
+				_append("\"{...}\"", 7);
+				ERR_FAIL_MSG("Converting circular structure to JSON.");
+			}
+
+			if (d.is_empty()) {
+				_append("{}", 2);
+				return;
+			}
+
+			_append('{');
+			if (pretty) {
+				_append('\n');
+			}
+			markers.insert(d.id());
+
+			LocalVector<Variant> keys = d.get_key_list();
+
+			if (sort_keys) {
+				keys.sort_custom<StringLikeVariantOrder>();
+			}
+
+			bool first_key = true;
+			for (const Variant &key : keys) {
+				if (first_key) {
+					first_key = false;
+				} else {
+					_append(',');
+					if (pretty) {
+						_append('\n');
+					}
+				}
+				_append_indent(p_cur_indent + 1);
+				_append_string(String(key));
+				if (pretty) {
+					_append(": ", 2);
+				} else {
+					_append(':');
+				}
+				_write(d[key], p_cur_indent + 1);
+			}
+
+			if (pretty) {
+				_append('\n');
+			}
+			_append_indent(p_cur_indent);
+			_append('}');
+			markers.erase(d.id());
+			return;
+		}
+		default:
+			_append_string(String(p_var));
+			return;
+	}
+}
+
+void JSONWriter::write(const Variant &p_var) {
+	markers.clear();
+	_write(p_var, 0);
+}
+
+Error JSONWriter::flush() {
+	if (file.is_null()) {
+		return OK;
+	}
+	_flush_to_file();
+	file->flush();
+	if (file_error == OK && file->get_error() != OK && file->get_error() != ERR_FILE_EOF) {
+		file_error = ERR_FILE_CANT_WRITE;
+	}
+	return file_error;
+}
+
+void JSONWriter::clear() {
+	buffer.clear();
+	markers.clear();
+}
+
+String JSONWriter::get_as_string() const {
+	if (buffer.is_empty()) {
+		return String();
+	}
+	return String::utf8((const char *)buffer.ptr(), buffer.size());
+}
+
+void JSONWriter::set_file(const Ref<FileAccess> &p_file) {
+	if (file.is_valid()) {
+		flush();
+	}
+	file = p_file;
+	file_error = OK;
+}
+
+JSONWriter::JSONWriter(const String &p_indent, bool p_sort_keys, bool p_full_precision) {
+	indent = p_indent.utf8();
+	sort_keys = p_sort_keys;
+	full_precision = p_full_precision;
+}
+
+JSONWriter::~JSONWriter() {
+	if (file.is_valid()) {
+		_flush_to_file();
+	}
+}
@@ -0,0 +1,92 @@
+/**************************************************************************/
+/*  json_writer.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/file_access.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/variant.h"
+
+// Serializes Variants to UTF-8 JSON, producing the same text as JSON::stringify().
+// Output is appended to a growable byte buffer; when a file is set, the buffer is
+// written out whenever it reaches FILE_CHUNK_SIZE, so large documents are streamed
+// instead of being built as one String.
+class JSONWriter {
+	LocalVector<uint8_t> buffer;
+	Ref<FileAccess> file;
+	Error file_error = OK;
+
+	CharString indent;
+	bool sort_keys = true;
+	bool full_precision = false;
+	HashSet<const void *> markers;
+
+	_FORCE_INLINE_ uint8_t *_grow(uint32_t p_size) {
+		if (file.is_valid() && buffer.size() + p_size > FILE_CHUNK_SIZE) {
+			_flush_to_file();
+		}
+		const uint32_t at = buffer.size();
+		buffer.resize(at + p_size);
+		return buffer.ptr() + at;
+	}
+	_FORCE_INLINE_ void _append(const char *p_data, uint32_t p_size) {
+		memcpy(_grow(p_size), p_data, p_size);
+	}
+	_FORCE_INLINE_ void _append(char p_char) {
+		*_grow(1) = uint8_t(p_char);
+	}
+	void _append_ascii(const String &p_string);
+	void _append_indent(int p_size);
+	void _append_int(int64_t p_int);
+	void _append_float(double p_float);
+	void _append_string(const String &p_string);
+	void _flush_to_file();
+
+	void _write(const Variant &p_var, int p_cur_indent);
+
+public:
+	static constexpr uint32_t FILE_CHUNK_SIZE = 64 * 1024;
+
+	void write(const Variant &p_var);
+
+	// Writes everything buffered so far to the file, if any.
+	Error flush();
+	void clear();
+
+	const uint8_t *get_data() const { return buffer.ptr(); }
+	uint32_t get_size() const { return buffer.size(); }
+	String get_as_string() const;
+
+	void set_file(const Ref<FileAccess> &p_file);
+
+	JSONWriter(const String &p_indent = "", bool p_sort_keys = true, bool p_full_precision = false);
+	~JSONWriter();
+};
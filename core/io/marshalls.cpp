@@ -928,10 +928,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			if (count) {
 				data.resize(count);
-				uint8_t *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = buf[i];
-				}
+				memcpy(data.ptrw(), buf, count);
 			}
 
 			r_variant = data;
@@ -958,9 +955,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				//const int *rbuf = (const int *)buf;
 				data.resize(count);
 				int32_t *w = data.ptrw();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_uint32(&buf[i * 4]);
 				}
+#else
+				// Same layout as the little-endian wire format.
+				memcpy(w, buf, count * sizeof(int32_t));
+#endif
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -982,9 +984,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				//const int *rbuf = (const int *)buf;
 				data.resize(count);
 				int64_t *w = data.ptrw();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int64_t i = 0; i < count; i++) {
 					w[i] = decode_uint64(&buf[i * 8]);
 				}
+#else
+				// Same layout as the little-endian wire format.
+				memcpy(w, buf, count * sizeof(int64_t));
+#endif
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -1006,9 +1013,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				//const float *rbuf = (const float *)buf;
 				data.resize(count);
 				float *w = data.ptrw();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_float(&buf[i * 4]);
 				}
+#else
+				// Same layout as the little-endian wire format.
+				memcpy(w, buf, count * sizeof(float));
+#endif
 			}
 			r_variant = data;
 
@@ -1030,9 +1042,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			if (count) {
 				data.resize(count);
 				double *w = data.ptrw();
+#ifdef BIG_ENDIAN_ENABLED
 				for (int64_t i = 0; i < count; i++) {
 					w[i] = decode_double(&buf[i * 8]);
 				}
+#else
+				// Same layout as the little-endian wire format.
+				memcpy(w, buf, count * sizeof(double));
+#endif
 			}
 			r_variant = data;
 
@@ -1086,10 +1103,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector2 *w = varray.ptrw();
 
+#if !defined(BIG_ENDIAN_ENABLED) && defined(REAL_T_IS_DOUBLE)
+					memcpy(w, buf, count * sizeof(Vector2));
+#else
 					for (int32_t i = 0; i < count; i++) {
 						w[i].x = decode_double(buf + i * sizeof(double) * 2 + sizeof(double) * 0);
 						w[i].y = decode_double(buf + i * sizeof(double) * 2 + sizeof(double) * 1);
 					}
+#endif
 
 					int adv = sizeof(double) * 2 * count;
 
@@ -1111,10 +1132,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector2 *w = varray.ptrw();
 
+#if !defined(BIG_ENDIAN_ENABLED) && !defined(REAL_T_IS_DOUBLE)
+					memcpy(w, buf, count * sizeof(Vector2));
+#else
 					for (int32_t i = 0; i < count; i++) {
 						w[i].x = decode_float(buf + i * sizeof(float) * 2 + sizeof(float) * 0);
 						w[i].y = decode_float(buf + i * sizeof(float) * 2 + sizeof(float) * 1);
 					}
+#endif
 
 					int adv = sizeof(float) * 2 * count;
 
@@ -1146,11 +1171,15 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector3 *w = varray.ptrw();
 
+#if !defined(BIG_ENDIAN_ENABLED) && defined(REAL_T_IS_DOUBLE)
+					memcpy(w, buf, count * sizeof(Vector3));
+#else
 					for (int32_t i = 0; i < count; i++) {
 						w[i].x = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 0);
 						w[i].y = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 1);
 						w[i].z = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 2);
 					}
+#endif
 
 					int adv = sizeof(double) * 3 * count;
 
@@ -1172,11 +1201,15 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector3 *w = varray.ptrw();
 
+#if !defined(BIG_ENDIAN_ENABLED) && !defined(REAL_T_IS_DOUBLE)
+					memcpy(w, buf, count * sizeof(Vector3));
+#else
 					for (int32_t i = 0; i < count; i++) {
 						w[i].x = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 0);
 						w[i].y = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 1);
 						w[i].z = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 2);
 					}
+#endif
 
 					int adv = sizeof(float) * 3 * count;
 
@@ -1209,6 +1242,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				carray.resize(count);
 				Color *w = carray.ptrw();
 
+#ifdef BIG_ENDIAN_ENABLED
 				for (int32_t i = 0; i < count; i++) {
 					// Colors should always be in single-precision.
 					w[i].r = decode_float(buf + i * 4 * 4 + 4 * 0);
@@ -1216,6 +1250,9 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					w[i].b = decode_float(buf + i * 4 * 4 + 4 * 2);
 					w[i].a = decode_float(buf + i * 4 * 4 + 4 * 3);
 				}
+#else
+				memcpy(w, buf, count * sizeof(Color));
+#endif
 
 				int adv = 4 * 4 * count;
 
@@ -1248,12 +1285,16 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector4 *w = varray.ptrw();
 
+#if !defined(BIG_ENDIAN_ENABLED) && defined(REAL_T_IS_DOUBLE)
+					memcpy(w, buf, count * sizeof(Vector4));
+#else
 					for (int32_t i = 0; i < count; i++) {
 						w[i].x = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 0);
 						w[i].y = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 1);
 						w[i].z = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 2);
 						w[i].w = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 3);
 					}
+#endif
 
 					int adv = sizeof(double) * 4 * count;
 
@@ -1275,12 +1316,16 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector4 *w = varray.ptrw();
 
+#if !defined(BIG_ENDIAN_ENABLED) && !defined(REAL_T_IS_DOUBLE)
+					memcpy(w, buf, count * sizeof(Vector4));
+#else
 					for (int32_t i = 0; i < count; i++) {
 						w[i].x = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 0);
 						w[i].y = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 1);
 						w[i].z = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 2);
 						w[i].w = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 3);
 					}
+#endif
 
 					int adv = sizeof(float) * 4 * count;
 
@@ -1358,12 +1403,7 @@ static Error _encode_container_type(const ContainerType &p_type, uint8_t *&buf,
 	return OK;
 }
 
-Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects, int p_depth) {
-	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Potential infinite recursion detected. Bailing.");
-	uint8_t *buf = r_buffer;
-
-	r_len = 0;
-
+static uint32_t _encode_variant_header(const Variant &p_variant, bool p_full_objects) {
 	uint32_t header = p_variant.get_type();
 
 	switch (p_variant.get_type()) {
@@ -1381,17 +1421,6 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			}
 		} break;
 		case Variant::OBJECT: {
-			// Test for potential wrong values sent by the debugger when it breaks.
-			Object *obj = p_variant.get_validated_object();
-			if (!obj) {
-				// Object is invalid, send a nullptr instead.
-				if (buf) {
-					encode_uint32(Variant::NIL, buf);
-				}
-				r_len += 4;
-				return OK;
-			}
-
 			if (!p_full_objects) {
 				header |= HEADER_DATA_FLAG_OBJECT_AS_ID;
 			}
@@ -1428,6 +1457,27 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 		} break;
 	}
 
+	return header;
+}
+
+Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects, int p_depth) {
+	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Potential infinite recursion detected. Bailing.");
+	uint8_t *buf = r_buffer;
+
+	r_len = 0;
+
+	// Test for potential wrong values sent by the debugger when it breaks.
+	if (p_variant.get_type() == Variant::OBJECT && !p_variant.get_validated_object()) {
+		// Object is invalid, send a nullptr instead.
+		if (buf) {
+			encode_uint32(Variant::NIL, buf);
+		}
+		r_len += 4;
+		return OK;
+	}
+
+	const uint32_t header = _encode_variant_header(p_variant, p_full_objects);
+
 	if (buf) {
 		encode_uint32(header, buf);
 		buf += 4;
@@ -2132,6 +2182,197 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 	return OK;
 }
 
+static _FORCE_INLINE_ uint8_t *_append_bytes(LocalVector<uint8_t> &r_buffer, uint32_t p_size) {
+	const uint32_t ofs = r_buffer.size();
+	r_buffer.resize(ofs + p_size);
+	return r_buffer.ptr() + ofs;
+}
+
+static _FORCE_INLINE_ void _append_uint32(LocalVector<uint8_t> &r_buffer, uint32_t p_value) {
+	encode_uint32(p_value, _append_bytes(r_buffer, 4));
+}
+
+// Pads a payload of p_len bytes to a multiple of 4, like the regular encoder. The padding depends on
+// the payload only, the buffer may already hold unaligned data in front of the encoded variant.
+static _FORCE_INLINE_ void _append_padding(LocalVector<uint8_t> &r_buffer, uint32_t p_len) {
+	const uint32_t pad = (4 - p_len % 4) % 4;
+	if (pad) {
+		memset(_append_bytes(r_buffer, pad), 0, pad);
+	}
+}
+
+// Fails before growing the buffer when the encoded array wouldn't fit in p_max_size.
+template <typename T>
+static Error _append_packed_array(LocalVector<uint8_t> &r_buffer, uint32_t p_header, const Variant &p_variant, uint32_t p_max_size) {
+	const Vector<T> data = p_variant;
+	const uint64_t bytes = uint64_t(data.size()) * sizeof(T);
+	const uint32_t pad = (4 - bytes % 4) % 4;
+	if (unlikely(r_buffer.size() + 8 + bytes + pad > p_max_size)) {
+		return ERR_OUT_OF_MEMORY;
+	}
+	_append_uint32(r_buffer, p_header);
+	_append_uint32(r_buffer, data.size());
+	if (!data.is_empty()) {
+		memcpy(_append_bytes(r_buffer, bytes), data.ptr(), bytes);
+	}
+	_append_padding(r_buffer, bytes);
+	return OK;
+}
+
+static Error _encode_variant_append(const Variant &p_variant, LocalVector<uint8_t> &r_buffer, bool p_full_objects, int p_depth, uint32_t p_max_size) {
+	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Potential infinite recursion detected. Bailing.");
+
+	// Strings, containers and packed arrays are written directly, the rest takes the sizing pass
+	// (which is trivial for them) and the regular encoder.
+	switch (p_variant.get_type()) {
+		case Variant::STRING:
+		case Variant::STRING_NAME: {
+			const CharString utf8 = p_variant.operator String().utf8();
+			if (unlikely(r_buffer.size() + 8 + uint64_t(utf8.length()) + (4 - utf8.length() % 4) % 4 > p_max_size)) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			_append_uint32(r_buffer, p_variant.get_type());
+			_append_uint32(r_buffer, utf8.length());
+			memcpy(_append_bytes(r_buffer, utf8.length()), utf8.get_data(), utf8.length());
+			_append_padding(r_buffer, utf8.length());
+			return OK;
+		}
+		case Variant::DICTIONARY: {
+			const Dictionary dict = p_variant;
+			_append_uint32(r_buffer, _encode_variant_header(p_variant, p_full_objects));
+			for (const ContainerType &type : { dict.get_key_type(), dict.get_value_type() }) {
+				int len = 0;
+				uint8_t *buf = nullptr;
+				Error err = _encode_container_type(type, buf, len, p_full_objects);
+				ERR_FAIL_COND_V(err, err);
+				buf = _append_bytes(r_buffer, len);
+				len = 0;
+				_encode_container_type(type, buf, len, p_full_objects);
+			}
+			_append_uint32(r_buffer, dict.size());
+			for (const KeyValue<Variant, Variant> &kv : dict) {
+				Error err = _encode_variant_append(kv.key, r_buffer, p_full_objects, p_depth + 1, p_max_size);
+				if (err == OK) {
+					err = _encode_variant_append(kv.value, r_buffer, p_full_objects, p_depth + 1, p_max_size);
+				}
+				if (err != OK) {
+					return err;
+				}
+			}
+			return OK;
+		}
+		case Variant::ARRAY: {
+			const Array array = p_variant;
+			_append_uint32(r_buffer, _encode_variant_header(p_variant, p_full_objects));
+			int len = 0;
+			uint8_t *buf = nullptr;
+			Error err = _encode_container_type(array.get_element_type(), buf, len, p_full_objects);
+			ERR_FAIL_COND_V(err, err);
+			buf = _append_bytes(r_buffer, len);
+			len = 0;
+			_encode_container_type(array.get_element_type(), buf, len, p_full_objects);
+
+			_append_uint32(r_buffer, array.size());
+			for (const Variant &elem : array) {
+				err = _encode_variant_append(elem, r_buffer, p_full_objects, p_depth + 1, p_max_size);
+				if (err != OK) {
+					return err;
+				}
+			}
+			return OK;
+		}
+		case Variant::PACKED_BYTE_ARRAY: {
+			return _append_packed_array<uint8_t>(r_buffer, p_variant.get_type(), p_variant, p_max_size);
+		}
+#ifndef BIG_ENDIAN_ENABLED
+		// The wire format is little-endian, so these are copied as-is.
+		case Variant::PACKED_INT32_ARRAY: {
+			return _append_packed_array<int32_t>(r_buffer, p_variant.get_type(), p_variant, p_max_size);
+		}
+		case Variant::PACKED_INT64_ARRAY: {
+			return _append_packed_array<int64_t>(r_buffer, p_variant.get_type(), p_variant, p_max_size);
+		}
+		case Variant::PACKED_FLOAT32_ARRAY: {
+			return _append_packed_array<float>(r_buffer, p_variant.get_type(), p_variant, p_max_size);
+		}
+		case Variant::PACKED_FLOAT64_ARRAY: {
+			return _append_packed_array<double>(r_buffer, p_variant.get_type(), p_variant, p_max_size);
+		}
+		case Variant::PACKED_VECTOR2_ARRAY: {
+			return _append_packed_array<Vector2>(r_buffer, _encode_variant_header(p_variant, p_full_objects), p_variant, p_max_size);
+		}
+		case Variant::PACKED_VECTOR3_ARRAY: {
+			return _append_packed_array<Vector3>(r_buffer, _encode_variant_header(p_variant, p_full_objects), p_variant, p_max_size);
+		}
+		case Variant::PACKED_VECTOR4_ARRAY: {
+			return _append_packed_array<Vector4>(r_buffer, _encode_variant_header(p_variant, p_full_objects), p_variant, p_max_size);
+		}
+		case Variant::PACKED_COLOR_ARRAY: {
+			return _append_packed_array<Color>(r_buffer, p_variant.get_type(), p_variant, p_max_size);
+		}
+#endif // !BIG_ENDIAN_ENABLED
+		default: {
+			int len = 0;
+			Error err = encode_variant(p_variant, nullptr, len, p_full_objects, p_depth);
+			ERR_FAIL_COND_V(err, err);
+			if (unlikely(r_buffer.size() + uint64_t(len) > p_max_size)) {
+				return ERR_OUT_OF_MEMORY;
+			}
+			return encode_variant(p_variant, _append_bytes(r_buffer, len), len, p_full_objects, p_depth);
+		}
+	}
+}
+
+Error encode_variant(const Variant &p_variant, LocalVector<uint8_t> &r_buffer, bool p_full_objects, int p_depth, uint32_t p_max_size) {
+	const uint32_t start = r_buffer.size();
+	Error err = _encode_variant_append(p_variant, r_buffer, p_full_objects, p_depth, p_max_size);
+	if (err == OK && r_buffer.size() > p_max_size) {
+		// Container headers aren't checked on their own, they're small.
+		err = ERR_OUT_OF_MEMORY;
+	}
+	if (err != OK) {
+		r_buffer.resize(start);
+	}
+	return err;
+}
+
+static thread_local LocalVector<uint8_t> encode_scratch;
+static thread_local bool encode_scratch_in_use = false;
+
+VariantEncodeBuffer::VariantEncodeBuffer() {
+	if (encode_scratch_in_use) {
+		buffer = &local;
+	} else {
+		encode_scratch_in_use = true;
+		buffer = &encode_scratch;
+		buffer->clear();
+	}
+}
+
+VariantEncodeBuffer::~VariantEncodeBuffer() {
+	if (buffer == &encode_scratch) {
+		// Don't keep the memory of an occasional huge encode around.
+		if (encode_scratch.get_capacity() > MAX_KEPT_CAPACITY) {
+			encode_scratch.reset();
+		}
+		encode_scratch_in_use = false;
+	}
+}
+
+Error VariantEncodeBuffer::encode(const Variant &p_variant, bool p_full_objects) {
+	buffer->clear();
+	return encode_variant(p_variant, *buffer, p_full_objects);
+}
+
+Vector<uint8_t> VariantEncodeBuffer::to_bytes() const {
+	Vector<uint8_t> bytes;
+	bytes.resize(buffer->size());
+	if (buffer->size()) {
+		memcpy(bytes.ptrw(), buffer->ptr(), buffer->size());
+	}
+	return bytes;
+}
+
 Vector<float> vector3_to_float32_array(const Vector3 *vecs, size_t count) {
 	// We always allocate a new array, and we don't `memcpy()`.
 	// We also don't consider returning a pointer to the passed vectors when `sizeof(real_t) == 4`.
@@ -32,6 +32,7 @@
 
 #include "core/math/math_defs.h"
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 #include "core/variant/variant.h"
 
@@ -269,5 +270,29 @@ public:
 
 Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = nullptr, bool p_allow_objects = false, int p_depth = 0);
 Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false, int p_depth = 0);
+// Appends the encoded variant to r_buffer in a single pass, growing it as needed. Reusing the same buffer
+// across calls avoids allocating per call. On error, r_buffer is left as it was.
+// Returns ERR_OUT_OF_MEMORY without growing r_buffer much past p_max_size when the result would not fit in it.
+Error encode_variant(const Variant &p_variant, LocalVector<uint8_t> &r_buffer, bool p_full_objects = false, int p_depth = 0, uint32_t p_max_size = UINT32_MAX);
+
+// Encodes a variant into a buffer owned by the calling thread, which is reused by later encodes so
+// one-off ones (var_to_bytes, store_var...) don't allocate once it has grown. Nested encodes on the
+// same thread (e.g. from a script getter) fall back to a buffer of their own.
+class VariantEncodeBuffer {
+	static constexpr uint32_t MAX_KEPT_CAPACITY = 1 << 20;
+
+	LocalVector<uint8_t> local;
+	LocalVector<uint8_t> *buffer = nullptr;
+
+public:
+	Error encode(const Variant &p_variant, bool p_full_objects = false);
+
+	const uint8_t *ptr() const { return buffer->ptr(); }
+	int size() const { return buffer->size(); }
+	Vector<uint8_t> to_bytes() const;
+
+	VariantEncodeBuffer();
+	~VariantEncodeBuffer();
+};
 
 Vector<float> vector3_to_float32_array(const Vector3 *vecs, size_t count);
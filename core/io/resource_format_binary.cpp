@@ -33,7 +33,10 @@
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access_compressed.h"
+#include "core/io/file_access_memory.h"
+#include "core/io/marshalls.h"
 #include "core/io/missing_resource.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/object/script_language.h"
 #include "core/version.h"
 #include "scene/property_utils.h"
@@ -125,8 +128,15 @@ static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 #endif
 		} else if constexpr (sizeof(real_t) == 4) {
 			// May be slower, but this is for compatibility. Eventually the data should be converted.
-			for (size_t i = 0; i < count; ++i) {
-				dst[i] = f->get_double();
+			Span<uint8_t> view = f->is_big_endian() ? Span<uint8_t>() : f->get_buffer_view(count * sizeof(double));
+			if (view.size() == count * sizeof(double)) {
+				for (size_t i = 0; i < count; ++i) {
+					dst[i] = decode_double(view.ptr() + i * sizeof(double));
+				}
+			} else {
+				for (size_t i = 0; i < count; ++i) {
+					dst[i] = f->get_double();
+				}
 			}
 		} else {
 			ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "real_t size is neither 4 nor 8!");
@@ -144,8 +154,15 @@ static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 			}
 #endif
 		} else if constexpr (sizeof(real_t) == 8) {
-			for (size_t i = 0; i < count; ++i) {
-				dst[i] = f->get_float();
+			Span<uint8_t> view = f->is_big_endian() ? Span<uint8_t>() : f->get_buffer_view(count * sizeof(float));
+			if (view.size() == count * sizeof(float)) {
+				for (size_t i = 0; i < count; ++i) {
+					dst[i] = decode_float(view.ptr() + i * sizeof(float));
+				}
+			} else {
+				for (size_t i = 0; i < count; ++i) {
+					dst[i] = f->get_float();
+				}
 			}
 		} else {
 			ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "real_t size is neither 4 nor 8!");
@@ -164,6 +181,10 @@ StringName ResourceLoaderBinary::_get_string() {
 		if (len == 0) {
 			return StringName();
 		}
+		Span<uint8_t> view = f->get_buffer_view(len);
+		if (view.size() == len) {
+			return String::utf8((const char *)view.ptr(), len);
+		}
 		f->get_buffer((uint8_t *)&str_buf[0], len);
 		return String::utf8(&str_buf[0], len);
 	}
@@ -399,7 +420,9 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 				} break;
 				case OBJECT_REFCOUNDED_OBJECT: {
 					String class_name = get_unicode_string();
-					Object *obj = ClassDB::instantiate(class_name);
+					// Its setters must run on the loading thread, only skip over it when decoding in parallel.
+					Object *obj = defer_objects ? nullptr : ClassDB::instantiate(class_name);
+					has_deferred_objects = has_deferred_objects || defer_objects;
 					r_v = obj;
 
 					uint32_t len = f->get_32();
@@ -414,7 +437,9 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 						err = parse_variant(value);
 						ERR_FAIL_COND_V_MSG(err, ERR_FILE_CORRUPT, "Error when trying to parse Variant.");
 
-						obj->set(key, value);
+						if (obj) {
+							obj->set(key, value);
+						}
 					}
 
 				} break;
@@ -430,11 +455,12 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 					}
 
 					//always use internal cache for loading internal resources
-					if (!internal_index_cache.has(path)) {
+					const Ref<Resource> *cached = (parent ? parent : this)->internal_index_cache.getptr(path);
+					if (!cached) {
 						WARN_PRINT(vformat("Couldn't load resource (no cache): %s.", path));
 						r_v = Variant();
 					} else {
-						r_v = internal_index_cache[path];
+						r_v = *cached;
 					}
 				} break;
 				case OBJECT_EXTERNAL_RESOURCE: {
@@ -443,6 +469,11 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 					String exttype = get_unicode_string();
 					String path = get_unicode_string();
 
+					if (defer_objects) {
+						has_deferred_objects = true;
+						break;
+					}
+
 					if (!path.contains("://") && path.is_relative_path()) {
 						// path is relative to file being loaded, so convert to a resource path
 						path = ProjectSettings::get_singleton()->localize_path(res_path.get_base_dir().path_join(path));
@@ -467,23 +498,19 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 					if (erindex < 0 || erindex >= external_resources.size()) {
 						WARN_PRINT("Broken external resource! (index out of size)");
 						r_v = Variant();
+					} else if (parent) {
+						// Already completed by the parent loader.
+						if (external_resources[erindex].resource.is_valid()) {
+							r_v = external_resources[erindex].resource;
+						}
 					} else {
-						Ref<ResourceLoader::LoadToken> &load_token = external_resources.write[erindex].load_token;
-						if (load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
-							Error err;
-							Ref<Resource> res = ResourceLoader::_load_complete(*load_token.ptr(), &err);
-							if (res.is_null()) {
-								if (!ResourceLoader::is_cleaning_tasks()) {
-									if (!ResourceLoader::get_abort_on_missing_resources()) {
-										ResourceLoader::notify_dependency_error(local_path, external_resources[erindex].path, external_resources[erindex].type);
-									} else {
-										error = ERR_FILE_MISSING_DEPENDENCIES;
-										ERR_FAIL_V_MSG(error, vformat("Can't load dependency: '%s'.", external_resources[erindex].path));
-									}
-								}
-							} else {
-								r_v = res;
-							}
+						Ref<Resource> res;
+						Error err = _complete_external_resource(erindex, res);
+						if (err != OK) {
+							return err;
+						}
+						if (res.is_valid()) {
+							r_v = res;
 						}
 					}
 				} break;
@@ -729,200 +756,404 @@ Error ResourceLoaderBinary::load() {
 		}
 	}
 
+	if (use_sub_threads && using_named_scene_ids && internal_resources.size() > parallel_min_sub_resources && WorkerThreadPool::get_singleton()->get_thread_count() > 1) {
+		return _load_sub_resources_parallel();
+	}
+
 	for (int i = 0; i < internal_resources.size(); i++) {
 		bool main = i == (internal_resources.size() - 1);
 
-		//maybe it is loaded already
-		String path;
-		String id;
+		Ref<Resource> res;
+		MissingResource *missing_resource = nullptr;
+		bool cached = false;
+		Error err = _instantiate_internal_resource(i, res, missing_resource, cached);
+		if (err != OK) {
+			return err;
+		}
+		if (cached) {
+			continue;
+		}
 
-		if (!main) {
-			path = internal_resources[i].path;
+		int pc = f->get_32();
 
-			if (path.begins_with("local://")) {
-				path = path.replace_first("local://", "");
-				id = path;
-				path = res_path + "::" + path;
+		//set properties
 
-				internal_resources.write[i].path = path; // Update path.
-			}
+		Dictionary missing_resource_properties;
 
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached.is_valid()) {
-					//already loaded, don't do anything
-					error = OK;
-					internal_index_cache[path] = cached;
-					continue;
-				}
+		for (int j = 0; j < pc; j++) {
+			StringName name = _get_string();
+
+			if (name == StringName()) {
+				error = ERR_FILE_CORRUPT;
+				ERR_FAIL_V(ERR_FILE_CORRUPT);
 			}
-		} else {
-			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
-				path = res_path;
+
+			Variant value;
+
+			error = parse_variant(value);
+			if (error) {
+				return error;
 			}
+
+			_set_resource_property(res, missing_resource, name, value, missing_resource_properties);
 		}
 
-		uint64_t offset = internal_resources[i].offset;
+		_finish_resource(res, missing_resource, missing_resource_properties);
 
-		f->seek(offset);
+		if (progress) {
+			*progress = (i + 1) / float(internal_resources.size());
+		}
 
-		String t = get_unicode_string();
+		//resource_cache.push_back(res);
 
-		Ref<Resource> res;
-		Resource *r = nullptr;
+		if (main) {
+			f.unref();
+			resource = res;
+			resource->set_as_translation_remapped(translation_remapped);
+			error = OK;
+			return OK;
+		}
+	}
 
-		MissingResource *missing_resource = nullptr;
+	return ERR_FILE_EOF;
+}
 
-		if (main) {
-			res = ResourceLoader::get_resource_ref_override(local_path);
-			r = res.ptr();
+Error ResourceLoaderBinary::_complete_external_resource(int p_index, Ref<Resource> &r_res) {
+	Ref<ResourceLoader::LoadToken> &load_token = external_resources.write[p_index].load_token;
+	if (load_token.is_null()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
+		return OK;
+	}
+
+	Error err;
+	r_res = ResourceLoader::_load_complete(*load_token.ptr(), &err);
+	if (r_res.is_null() && !ResourceLoader::is_cleaning_tasks()) {
+		if (!ResourceLoader::get_abort_on_missing_resources()) {
+			ResourceLoader::notify_dependency_error(local_path, external_resources[p_index].path, external_resources[p_index].type);
+		} else {
+			error = ERR_FILE_MISSING_DEPENDENCIES;
+			ERR_FAIL_V_MSG(error, vformat("Can't load dependency: '%s'.", external_resources[p_index].path));
 		}
-		if (!r) {
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
-				//use the existing one
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached->get_class() == t) {
-					cached->reset_state();
-					res = cached;
-				}
+	}
+	return OK;
+}
+
+// Creates (or reuses) the resource, registers it in the internal index and leaves the file at its property count.
+Error ResourceLoaderBinary::_instantiate_internal_resource(int p_index, Ref<Resource> &r_res, MissingResource *&r_missing_resource, bool &r_cached) {
+	bool main = p_index == (internal_resources.size() - 1);
+
+	//maybe it is loaded already
+	String path;
+	String id;
+
+	if (!main) {
+		path = internal_resources[p_index].path;
+
+		if (path.begins_with("local://")) {
+			path = path.replace_first("local://", "");
+			id = path;
+			path = res_path + "::" + path;
+
+			internal_resources.write[p_index].path = path; // Update path.
+		}
+
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached.is_valid()) {
+				//already loaded, don't do anything
+				error = OK;
+				internal_index_cache[path] = cached;
+				r_res = cached;
+				r_cached = true;
+				return OK;
 			}
+		}
+	} else {
+		if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
+			path = res_path;
+		}
+	}
 
-			if (res.is_null()) {
-				//did not replace
-
-				Object *obj = ClassDB::instantiate(t);
-				if (!obj) {
-					if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-						//create a missing resource
-						missing_resource = memnew(MissingResource);
-						missing_resource->set_original_class(t);
-						missing_resource->set_recording_properties(true);
-						obj = missing_resource;
-					} else {
-						error = ERR_FILE_CORRUPT;
-						ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("'%s': Resource of unrecognized type in file: '%s'.", local_path, t));
-					}
-				}
+	uint64_t offset = internal_resources[p_index].offset;
 
-				r = Object::cast_to<Resource>(obj);
-				if (!r) {
-					String obj_class = obj->get_class();
-					error = ERR_FILE_CORRUPT;
-					memdelete(obj); //bye
-					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("'%s': Resource type in resource field not a resource, type is: %s.", local_path, obj_class));
-				}
+	f->seek(offset);
+
+	String t = get_unicode_string();
+
+	Ref<Resource> res;
+	Resource *r = nullptr;
 
-				res = Ref<Resource>(r);
+	MissingResource *missing_resource = nullptr;
+
+	if (main) {
+		res = ResourceLoader::get_resource_ref_override(local_path);
+		r = res.ptr();
+	}
+	if (!r) {
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
+			//use the existing one
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached->get_class() == t) {
+				cached->reset_state();
+				res = cached;
 			}
 		}
 
-		if (r) {
-			if (!path.is_empty()) {
-				if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
-					r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
+		if (res.is_null()) {
+			//did not replace
+
+			Object *obj = ClassDB::instantiate(t);
+			if (!obj) {
+				if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+					//create a missing resource
+					missing_resource = memnew(MissingResource);
+					missing_resource->set_original_class(t);
+					missing_resource->set_recording_properties(true);
+					obj = missing_resource;
 				} else {
-					r->set_path_cache(path);
+					error = ERR_FILE_CORRUPT;
+					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("'%s': Resource of unrecognized type in file: '%s'.", local_path, t));
 				}
 			}
-			r->set_scene_unique_id(id);
+
+			r = Object::cast_to<Resource>(obj);
+			if (!r) {
+				String obj_class = obj->get_class();
+				error = ERR_FILE_CORRUPT;
+				memdelete(obj); //bye
+				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("'%s': Resource type in resource field not a resource, type is: %s.", local_path, obj_class));
+			}
+
+			res = Ref<Resource>(r);
 		}
+	}
 
-		if (!main) {
-			internal_index_cache[path] = res;
+	if (r) {
+		if (!path.is_empty()) {
+			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
+				r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
+			} else {
+				r->set_path_cache(path);
+			}
 		}
+		r->set_scene_unique_id(id);
+	}
 
-		int pc = f->get_32();
+	if (!main) {
+		internal_index_cache[path] = res;
+	}
 
-		//set properties
+	r_res = res;
+	r_missing_resource = missing_resource;
+	r_cached = false;
+	return OK;
+}
 
-		Dictionary missing_resource_properties;
+void ResourceLoaderBinary::_set_resource_property(const Ref<Resource> &p_res, MissingResource *p_missing_resource, const StringName &p_name, Variant &p_value, Dictionary &r_missing_resource_properties) {
+	bool set_valid = true;
+	if (p_value.get_type() == Variant::OBJECT && p_missing_resource == nullptr && ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+		// If the property being set is a missing resource (and the parent is not),
+		// then setting it will most likely not work.
+		// Instead, save it as metadata.
+
+		Ref<MissingResource> mr = p_value;
+		if (mr.is_valid()) {
+			r_missing_resource_properties[p_name] = mr;
+			set_valid = false;
+		}
+	}
 
-		for (int j = 0; j < pc; j++) {
-			StringName name = _get_string();
+	if (p_value.get_type() == Variant::ARRAY) {
+		Array set_array = p_value;
+		bool is_get_valid = false;
+		Variant get_value = p_res->get(p_name, &is_get_valid);
+		if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+			Array get_array = get_value;
+			if (!set_array.is_same_typed(get_array)) {
+				p_value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
+			}
+		}
+	}
 
-			if (name == StringName()) {
-				error = ERR_FILE_CORRUPT;
-				ERR_FAIL_V(ERR_FILE_CORRUPT);
+	if (p_value.get_type() == Variant::DICTIONARY) {
+		Dictionary set_dict = p_value;
+		bool is_get_valid = false;
+		Variant get_value = p_res->get(p_name, &is_get_valid);
+		if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
+			Dictionary get_dict = get_value;
+			if (!set_dict.is_same_typed(get_dict)) {
+				p_value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
+						get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
 			}
+		}
+	}
 
-			Variant value;
+	if (set_valid) {
+		p_res->set(p_name, p_value);
+	}
+}
 
-			error = parse_variant(value);
-			if (error) {
-				return error;
-			}
+void ResourceLoaderBinary::_finish_resource(const Ref<Resource> &p_res, MissingResource *p_missing_resource, const Dictionary &p_missing_resource_properties) {
+	if (p_missing_resource) {
+		p_missing_resource->set_recording_properties(false);
+	}
 
-			bool set_valid = true;
-			if (value.get_type() == Variant::OBJECT && missing_resource == nullptr && ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-				// If the property being set is a missing resource (and the parent is not),
-				// then setting it will most likely not work.
-				// Instead, save it as metadata.
+	if (!p_missing_resource_properties.is_empty()) {
+		p_res->set_meta(META_MISSING_RESOURCES, p_missing_resource_properties);
+	}
 
-				Ref<MissingResource> mr = value;
-				if (mr.is_valid()) {
-					missing_resource_properties[name] = mr;
-					set_valid = false;
-				}
-			}
+#ifdef TOOLS_ENABLED
+	p_res->set_edited(false);
+#endif
+}
 
-			if (value.get_type() == Variant::ARRAY) {
-				Array set_array = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
-					Array get_array = get_value;
-					if (!set_array.is_same_typed(get_array)) {
-						value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
-					}
-				}
-			}
+void ResourceLoaderBinary::_parse_sub_resource(uint32_t p_index, bool p_defer_objects) {
+	SubResource &sub = sub_resources[p_index];
 
-			if (value.get_type() == Variant::DICTIONARY) {
-				Dictionary set_dict = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
-					Dictionary get_dict = get_value;
-					if (!set_dict.is_same_typed(get_dict)) {
-						value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
-								get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
-					}
-				}
-			}
+	Ref<FileAccessMemory> fa;
+	fa.instantiate();
+	fa->open_custom(sub.data.ptr(), sub.data.size());
+	fa->set_big_endian(f->is_big_endian());
+	fa->real_is_double = f->real_is_double;
 
-			if (set_valid) {
-				res->set(name, value);
-			}
+	ResourceLoaderBinary loader;
+	loader.parent = this;
+	loader.defer_objects = p_defer_objects;
+	loader.f = fa;
+	loader.ver_format = ver_format;
+	loader.using_named_scene_ids = using_named_scene_ids;
+	loader.local_path = local_path;
+	loader.res_path = res_path;
+	loader.string_map = string_map;
+	loader.external_resources = external_resources;
+	loader.internal_resources = internal_resources;
+	loader.remaps = remaps;
+	loader.cache_mode_for_external = cache_mode_for_external;
+
+	sub.properties.reset();
+	int pc = fa->get_32();
+	sub.properties.reserve(pc);
+	for (int j = 0; j < pc; j++) {
+		StringName name = loader._get_string();
+		if (name == StringName()) {
+			sub.error = ERR_FILE_CORRUPT;
+			ERR_FAIL();
 		}
 
-		if (missing_resource) {
-			missing_resource->set_recording_properties(false);
+		Variant value;
+		sub.error = loader.parse_variant(value);
+		if (sub.error) {
+			return;
 		}
+		sub.properties.push_back(Pair<StringName, Variant>(name, value));
+	}
+
+	sub.deferred = loader.has_deferred_objects;
+	if (sub.deferred) {
+		// Parsed again on the loading thread, keep the data.
+		sub.properties.reset();
+		return;
+	}
+	loader.f.unref();
+	fa.unref();
+	sub.data = Vector<uint8_t>();
+}
 
-		if (!missing_resource_properties.is_empty()) {
-			res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+void ResourceLoaderBinary::_decode_sub_resource(uint32_t p_index, void *p_userdata) {
+	if (!sub_resources[p_index].cached) {
+		_parse_sub_resource(p_index, true);
+	}
+}
+
+void ResourceLoaderBinary::_set_sub_resource(uint32_t p_index) {
+	SubResource &sub = sub_resources[p_index];
+
+	Dictionary missing_resource_properties;
+	for (Pair<StringName, Variant> &property : sub.properties) {
+		_set_resource_property(sub.resource, sub.missing_resource, property.first, property.second, missing_resource_properties);
+	}
+	_finish_resource(sub.resource, sub.missing_resource, missing_resource_properties);
+	sub.properties.reset();
+}
+
+Error ResourceLoaderBinary::_load_sub_resources_parallel() {
+	// Workers can't wait for loads, complete the external dependencies first.
+	for (int i = 0; i < external_resources.size(); i++) {
+		Ref<Resource> res;
+		Error err = _complete_external_resource(i, res);
+		if (err != OK) {
+			return err;
 		}
+		external_resources.write[i].resource = res;
+	}
 
-#ifdef TOOLS_ENABLED
-		res->set_edited(false);
-#endif
+	// Create every sub-resource first, so references between them resolve in any order,
+	// and copy out the data of each one. It ends where the next one (by offset) starts.
+	Vector<uint64_t> offsets;
+	offsets.resize(internal_resources.size());
+	for (int i = 0; i < internal_resources.size(); i++) {
+		offsets.write[i] = internal_resources[i].offset;
+	}
+	offsets.sort();
+	const uint64_t file_end = f->get_length();
 
-		if (progress) {
-			*progress = (i + 1) / float(internal_resources.size());
+	sub_resources.resize(internal_resources.size());
+	for (int i = 0; i < internal_resources.size(); i++) {
+		SubResource &sub = sub_resources[i];
+		Error err = _instantiate_internal_resource(i, sub.resource, sub.missing_resource, sub.cached);
+		if (err != OK) {
+			sub_resources.reset();
+			return err;
+		}
+		if (sub.cached) {
+			continue;
 		}
 
-		//resource_cache.push_back(res);
+		const uint64_t start = f->get_position();
+		const int next = offsets.bsearch(internal_resources[i].offset, false);
+		const uint64_t end = next < offsets.size() ? offsets[next] : file_end;
+		if (end < start) {
+			sub_resources.reset();
+			error = ERR_FILE_CORRUPT;
+			ERR_FAIL_V(ERR_FILE_CORRUPT);
+		}
+		sub.data.resize(end - start);
+		f->get_buffer(sub.data.ptrw(), sub.data.size());
+	}
 
-		if (main) {
-			f.unref();
-			resource = res;
-			resource->set_as_translation_remapped(translation_remapped);
-			error = OK;
-			return OK;
+	// Only the property values are decoded in parallel, nothing runs setters or scripts there.
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	WorkerThreadPool::GroupID group = pool->add_template_group_task(this, &ResourceLoaderBinary::_decode_sub_resource, (void *)nullptr, sub_resources.size(), -1, true, "ResourceLoaderBinary: decode sub-resources");
+	pool->wait_for_group_task_completion(group);
+
+	// Properties are set here, in file order like when loading sequentially, as setters and scripts
+	// may rely on the state of the load on this thread.
+	for (uint32_t i = 0; i < sub_resources.size(); i++) {
+		SubResource &sub = sub_resources[i];
+		if (sub.cached) {
+			continue;
+		}
+		if (sub.error == OK && sub.deferred) {
+			// Values holding objects with setters of their own.
+			_parse_sub_resource(i, false);
+		}
+		if (sub.error != OK) {
+			error = sub.error;
+			sub_resources.reset();
+			return error;
+		}
+		_set_sub_resource(i);
+
+		if (progress) {
+			*progress = (i + 1) / float(sub_resources.size());
 		}
 	}
 
-	return ERR_FILE_EOF;
+	f.unref();
+	resource = sub_resources[sub_resources.size() - 1].resource;
+	resource->set_as_translation_remapped(translation_remapped);
+	sub_resources.reset();
+	error = OK;
+	return OK;
 }
 
 void ResourceLoaderBinary::set_translation_remapped(bool p_remapped) {
@@ -951,6 +1182,10 @@ String ResourceLoaderBinary::get_unicode_string() {
 	if (len == 0) {
 		return String();
 	}
+	Span<uint8_t> view = f->get_buffer_view(len);
+	if (view.size() == uint64_t(len)) {
+		return String::utf8((const char *)view.ptr(), len);
+	}
 	f->get_buffer((uint8_t *)&str_buf[0], len);
 	return String::utf8(&str_buf[0], len);
 }
@@ -1237,7 +1472,7 @@ Ref<Resource> ResourceFormatLoaderBinary::load(const String &p_path, const Strin
 	}
 
 	Error err;
-	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ | FileAccess::MMAP, &err);
 
 	ERR_FAIL_COND_V_MSG(err != OK, Ref<Resource>(), vformat("Cannot open file '%s'.", p_path));
 	Ref<Resource> ret;
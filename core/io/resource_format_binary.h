@@ -33,8 +33,12 @@
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
 #include "core/templates/rb_map.h"
 
+class MissingResource;
+
 class ResourceLoaderBinary {
 	bool translation_remapped = false;
 	String local_path;
@@ -61,6 +65,7 @@ class ResourceLoaderBinary {
 		String type;
 		ResourceUID::ID uid = ResourceUID::INVALID_ID;
 		Ref<ResourceLoader::LoadToken> load_token;
+		Ref<Resource> resource; // Completed before decoding sub-resources in parallel.
 	};
 
 	bool using_named_scene_ids = false;
@@ -93,7 +98,37 @@ class ResourceLoaderBinary {
 
 	HashMap<String, Ref<Resource>> dependency_cache;
 
+	// Sub-resources are decoded in parallel by loaders reading a copy of their data,
+	// which resolve internal resources from the index of the main (parent) loader.
+	struct SubResource {
+		Ref<Resource> resource;
+		MissingResource *missing_resource = nullptr;
+		bool cached = false;
+		bool deferred = false; // Holds objects that are only created on the loading thread.
+		Vector<uint8_t> data;
+		LocalVector<Pair<StringName, Variant>> properties;
+		Error error = OK;
+	};
+
+	const ResourceLoaderBinary *parent = nullptr;
+	bool defer_objects = false;
+	bool has_deferred_objects = false;
+	LocalVector<SubResource> sub_resources;
+
+	Error _complete_external_resource(int p_index, Ref<Resource> &r_res);
+	Error _instantiate_internal_resource(int p_index, Ref<Resource> &r_res, MissingResource *&r_missing_resource, bool &r_cached);
+	static void _set_resource_property(const Ref<Resource> &p_res, MissingResource *p_missing_resource, const StringName &p_name, Variant &p_value, Dictionary &r_missing_resource_properties);
+	static void _finish_resource(const Ref<Resource> &p_res, MissingResource *p_missing_resource, const Dictionary &p_missing_resource_properties);
+
+	Error _load_sub_resources_parallel();
+	void _parse_sub_resource(uint32_t p_index, bool p_defer_objects);
+	void _decode_sub_resource(uint32_t p_index, void *p_userdata);
+	void _set_sub_resource(uint32_t p_index);
+
 public:
+	// Minimum number of internal resources to decode them in parallel, when loading with sub-threads.
+	static inline int parallel_min_sub_resources = 8;
+
 	Ref<Resource> get_resource();
 	Error load();
 	void set_translation_remapped(bool p_remapped);
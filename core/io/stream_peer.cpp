@@ -283,12 +283,9 @@ void StreamPeer::put_utf8_string(const String &p_string) {
 }
 
 void StreamPeer::put_var(const Variant &p_variant, bool p_full_objects) {
-	int len = 0;
-	Vector<uint8_t> buf;
-	encode_variant(p_variant, nullptr, len, p_full_objects);
-	buf.resize(len);
-	put_32(len);
-	encode_variant(p_variant, buf.ptrw(), len, p_full_objects);
+	VariantEncodeBuffer buf;
+	buf.encode(p_variant, p_full_objects);
+	put_32(buf.size());
 	put_data(buf.ptr(), buf.size());
 }
 
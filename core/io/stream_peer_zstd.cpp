@@ -0,0 +1,219 @@
+/**************************************************************************/
+/*  stream_peer_zstd.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "stream_peer_zstd.h"
+
+#include "core/io/compression.h"
+
+#include <zstd.h>
+
+void StreamPeerZSTD::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("start_compression", "dictionary", "buffer_size"), &StreamPeerZSTD::start_compression, DEFVAL(Ref<ZSTDDictionary>()), DEFVAL(65535));
+	ClassDB::bind_method(D_METHOD("start_decompression", "dictionary", "buffer_size"), &StreamPeerZSTD::start_decompression, DEFVAL(Ref<ZSTDDictionary>()), DEFVAL(65535));
+	ClassDB::bind_method(D_METHOD("finish"), &StreamPeerZSTD::finish);
+	ClassDB::bind_method(D_METHOD("clear"), &StreamPeerZSTD::clear);
+}
+
+StreamPeerZSTD::~StreamPeerZSTD() {
+	_close();
+}
+
+void StreamPeerZSTD::_close() {
+	if (ctx) {
+		if (compressing) {
+			ZSTD_freeCCtx((ZSTD_CCtx *)ctx);
+		} else {
+			ZSTD_freeDCtx((ZSTD_DCtx *)ctx);
+		}
+		ctx = nullptr;
+	}
+	dictionary.unref();
+}
+
+void StreamPeerZSTD::clear() {
+	_close();
+	rb.clear();
+	buffer.clear();
+}
+
+Error StreamPeerZSTD::start_compression(const Ref<ZSTDDictionary> &p_dictionary, int buffer_size) {
+	return _start(true, p_dictionary, buffer_size);
+}
+
+Error StreamPeerZSTD::start_decompression(const Ref<ZSTDDictionary> &p_dictionary, int buffer_size) {
+	return _start(false, p_dictionary, buffer_size);
+}
+
+Error StreamPeerZSTD::_start(bool p_compress, const Ref<ZSTDDictionary> &p_dictionary, int buffer_size) {
+	ERR_FAIL_COND_V(ctx != nullptr, ERR_ALREADY_IN_USE);
+	ERR_FAIL_COND_V_MSG(buffer_size <= 0, ERR_INVALID_PARAMETER, "Invalid buffer size. It should be a positive integer.");
+	ERR_FAIL_COND_V_MSG(p_dictionary.is_valid() && p_dictionary->is_empty(), ERR_INVALID_PARAMETER, "The dictionary is empty.");
+	clear();
+	compressing = p_compress;
+	rb.resize(Math::nearest_shift(uint32_t(buffer_size - 1)));
+	buffer.resize(1024);
+
+	size_t err = 0;
+	if (compressing) {
+		ZSTD_CCtx *cctx = ZSTD_createCCtx();
+		ctx = cctx;
+		if (p_dictionary.is_valid()) {
+			Ref<ZSTDCompressionDictionary> cdict = p_dictionary->get_compression_dictionary();
+			ERR_FAIL_COND_V(cdict.is_null(), FAILED);
+			dictionary = cdict;
+			err = ZSTD_CCtx_refCDict(cctx, cdict->get());
+		} else {
+			err = ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, Compression::zstd_level);
+			if (!ZSTD_isError(err) && Compression::zstd_long_distance_matching) {
+				ZSTD_CCtx_setParameter(cctx, ZSTD_c_enableLongDistanceMatching, 1);
+				err = ZSTD_CCtx_setParameter(cctx, ZSTD_c_windowLog, Compression::zstd_window_log_size);
+			}
+		}
+	} else {
+		ZSTD_DCtx *dctx = ZSTD_createDCtx();
+		ctx = dctx;
+		if (Compression::zstd_long_distance_matching) {
+			ZSTD_DCtx_setParameter(dctx, ZSTD_d_windowLogMax, Compression::zstd_window_log_size);
+		}
+		if (p_dictionary.is_valid()) {
+			Ref<ZSTDDecompressionDictionary> ddict = p_dictionary->get_decompression_dictionary();
+			ERR_FAIL_COND_V(ddict.is_null(), FAILED);
+			dictionary = ddict;
+			err = ZSTD_DCtx_refDDict(dctx, ddict->get());
+		}
+	}
+	ERR_FAIL_COND_V(ctx == nullptr || ZSTD_isError(err), FAILED);
+	return OK;
+}
+
+Error StreamPeerZSTD::_process(uint8_t *p_dst, int p_dst_size, const uint8_t *p_src, int p_src_size, int &r_consumed, int &r_out) {
+	ERR_FAIL_NULL_V(ctx, ERR_UNCONFIGURED);
+	ZSTD_inBuffer in = { p_src, size_t(p_src_size), 0 };
+	ZSTD_outBuffer out = { p_dst, size_t(p_dst_size), 0 };
+	size_t err = 0;
+	if (compressing) {
+		err = ZSTD_compressStream2((ZSTD_CCtx *)ctx, &out, &in, ZSTD_e_continue);
+	} else {
+		err = ZSTD_decompressStream((ZSTD_DCtx *)ctx, &out, &in);
+	}
+	ERR_FAIL_COND_V_MSG(ZSTD_isError(err), FAILED, ZSTD_getErrorName(err));
+	r_out = out.pos;
+	r_consumed = in.pos;
+	return OK;
+}
+
+Error StreamPeerZSTD::put_data(const uint8_t *p_data, int p_bytes) {
+	int wrote = 0;
+	Error err = put_partial_data(p_data, p_bytes, wrote);
+	if (err != OK) {
+		return err;
+	}
+	ERR_FAIL_COND_V(p_bytes != wrote, ERR_OUT_OF_MEMORY);
+	return OK;
+}
+
+Error StreamPeerZSTD::put_partial_data(const uint8_t *p_data, int p_bytes, int &r_sent) {
+	ERR_FAIL_NULL_V(ctx, ERR_UNCONFIGURED);
+	ERR_FAIL_COND_V(p_bytes < 0, ERR_INVALID_PARAMETER);
+
+	// Ensure we have enough space in temporary buffer.
+	if (buffer.size() < p_bytes) {
+		buffer.resize(p_bytes);
+	}
+
+	r_sent = 0;
+	while (r_sent < p_bytes && rb.space_left() > 1024) { // Keep the ring buffer size meaningful.
+		int sent = 0;
+		int to_write = 0;
+		// Compress or decompress
+		Error err = _process(buffer.ptrw(), MIN(buffer.size(), rb.space_left()), p_data + r_sent, p_bytes - r_sent, sent, to_write);
+		if (err != OK) {
+			return err;
+		}
+		r_sent += sent;
+
+		// We can't write more than this buffer is full.
+		if (sent == 0 && to_write == 0) {
+			return OK;
+		}
+		if (to_write) {
+			// Copy to ring buffer.
+			int wrote = rb.write(buffer.ptr(), to_write);
+			ERR_FAIL_COND_V(wrote != to_write, ERR_BUG);
+		}
+	}
+	return OK;
+}
+
+Error StreamPeerZSTD::get_data(uint8_t *p_buffer, int p_bytes) {
+	int received = 0;
+	Error err = get_partial_data(p_buffer, p_bytes, received);
+	if (err != OK) {
+		return err;
+	}
+	ERR_FAIL_COND_V(p_bytes != received, ERR_UNAVAILABLE);
+	return OK;
+}
+
+Error StreamPeerZSTD::get_partial_data(uint8_t *p_buffer, int p_bytes, int &r_received) {
+	ERR_FAIL_COND_V(p_bytes < 0, ERR_INVALID_PARAMETER);
+
+	r_received = MIN(p_bytes, rb.data_left());
+	if (r_received == 0) {
+		return OK;
+	}
+	int received = rb.read(p_buffer, r_received);
+	ERR_FAIL_COND_V(received != r_received, ERR_BUG);
+	return OK;
+}
+
+int StreamPeerZSTD::get_available_bytes() const {
+	return rb.data_left();
+}
+
+Error StreamPeerZSTD::finish() {
+	ERR_FAIL_COND_V(!ctx || !compressing, ERR_UNAVAILABLE);
+	// Unlike zlib, zstd may need several calls to flush the end of the frame.
+	size_t remaining = 0;
+	do {
+		const int space = rb.space_left();
+		ERR_FAIL_COND_V_MSG(space == 0, ERR_OUT_OF_MEMORY, "Not enough space left in the buffer to finish the stream.");
+		if (buffer.size() < space) {
+			buffer.resize(space);
+		}
+		ZSTD_inBuffer in = { nullptr, 0, 0 };
+		ZSTD_outBuffer out = { buffer.ptrw(), size_t(space), 0 };
+		remaining = ZSTD_compressStream2((ZSTD_CCtx *)ctx, &out, &in, ZSTD_e_end);
+		ERR_FAIL_COND_V_MSG(ZSTD_isError(remaining), FAILED, ZSTD_getErrorName(remaining));
+		int wrote = rb.write(buffer.ptr(), out.pos);
+		ERR_FAIL_COND_V(wrote != int(out.pos), ERR_OUT_OF_MEMORY);
+	} while (remaining > 0);
+	return OK;
+}
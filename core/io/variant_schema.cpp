@@ -0,0 +1,596 @@
+/**************************************************************************/
+/*  variant_schema.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "variant_schema.h"
+
+#include "core/io/marshalls.h"
+#include "core/variant/variant_internal.h"
+
+// Bumped when the encoded layout changes.
+static constexpr uint32_t FORMAT_VERSION = 1;
+
+// Calls m_macro(type, getter) for every fixed-size type.
+#define FOR_EACH_FIXED_TYPE(m_macro)        \
+	m_macro(BOOL, get_bool)                 \
+	m_macro(INT, get_int)                   \
+	m_macro(FLOAT, get_float)               \
+	m_macro(VECTOR2, get_vector2)           \
+	m_macro(VECTOR2I, get_vector2i)         \
+	m_macro(RECT2, get_rect2)               \
+	m_macro(RECT2I, get_rect2i)             \
+	m_macro(VECTOR3, get_vector3)           \
+	m_macro(VECTOR3I, get_vector3i)         \
+	m_macro(TRANSFORM2D, get_transform2d)   \
+	m_macro(VECTOR4, get_vector4)           \
+	m_macro(VECTOR4I, get_vector4i)         \
+	m_macro(PLANE, get_plane)               \
+	m_macro(QUATERNION, get_quaternion)     \
+	m_macro(AABB, get_aabb)                 \
+	m_macro(BASIS, get_basis)               \
+	m_macro(TRANSFORM3D, get_transform)     \
+	m_macro(PROJECTION, get_projection)     \
+	m_macro(COLOR, get_color)
+
+uint32_t VariantSchema::get_fixed_size(Variant::Type p_type) {
+	switch (p_type) {
+#define FIXED_SIZE(m_type, m_getter) \
+	case Variant::m_type:            \
+		return sizeof(*VariantInternal::m_getter((const Variant *)nullptr));
+		FOR_EACH_FIXED_TYPE(FIXED_SIZE)
+#undef FIXED_SIZE
+		default:
+			return 0;
+	}
+}
+
+static uint32_t _get_packed_element_size(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::PACKED_BYTE_ARRAY:
+			return sizeof(uint8_t);
+		case Variant::PACKED_INT32_ARRAY:
+			return sizeof(int32_t);
+		case Variant::PACKED_INT64_ARRAY:
+			return sizeof(int64_t);
+		case Variant::PACKED_FLOAT32_ARRAY:
+			return sizeof(float);
+		case Variant::PACKED_FLOAT64_ARRAY:
+			return sizeof(double);
+		case Variant::PACKED_VECTOR2_ARRAY:
+			return sizeof(Vector2);
+		case Variant::PACKED_VECTOR3_ARRAY:
+			return sizeof(Vector3);
+		case Variant::PACKED_COLOR_ARRAY:
+			return sizeof(Color);
+		case Variant::PACKED_VECTOR4_ARRAY:
+			return sizeof(Vector4);
+		default:
+			// Packed string arrays aren't fixed-size.
+			return 0;
+	}
+}
+
+// Raw storage of a packed array, and its element count.
+static const void *_get_packed_data(const Variant &p_value, int &r_count) {
+	switch (p_value.get_type()) {
+#define PACKED_DATA(m_type, m_getter)                           \
+	case Variant::m_type: {                                     \
+		const auto *array = VariantInternal::m_getter(&p_value); \
+		r_count = array->size();                                \
+		return array->ptr();                                    \
+	}
+		PACKED_DATA(PACKED_BYTE_ARRAY, get_byte_array)
+		PACKED_DATA(PACKED_INT32_ARRAY, get_int32_array)
+		PACKED_DATA(PACKED_INT64_ARRAY, get_int64_array)
+		PACKED_DATA(PACKED_FLOAT32_ARRAY, get_float32_array)
+		PACKED_DATA(PACKED_FLOAT64_ARRAY, get_float64_array)
+		PACKED_DATA(PACKED_VECTOR2_ARRAY, get_vector2_array)
+		PACKED_DATA(PACKED_VECTOR3_ARRAY, get_vector3_array)
+		PACKED_DATA(PACKED_COLOR_ARRAY, get_color_array)
+		PACKED_DATA(PACKED_VECTOR4_ARRAY, get_vector4_array)
+#undef PACKED_DATA
+		default:
+			r_count = 0;
+			return nullptr;
+	}
+}
+
+template <typename T>
+static Variant _make_packed(const uint8_t *p_src, int p_count) {
+	Vector<T> array;
+	array.resize(p_count);
+	if (p_count) {
+		memcpy(array.ptrw(), p_src, p_count * sizeof(T));
+	}
+	return array;
+}
+
+static Variant _make_packed(Variant::Type p_type, const uint8_t *p_src, int p_count) {
+	switch (p_type) {
+		case Variant::PACKED_BYTE_ARRAY:
+			return _make_packed<uint8_t>(p_src, p_count);
+		case Variant::PACKED_INT32_ARRAY:
+			return _make_packed<int32_t>(p_src, p_count);
+		case Variant::PACKED_INT64_ARRAY:
+			return _make_packed<int64_t>(p_src, p_count);
+		case Variant::PACKED_FLOAT32_ARRAY:
+			return _make_packed<float>(p_src, p_count);
+		case Variant::PACKED_FLOAT64_ARRAY:
+			return _make_packed<double>(p_src, p_count);
+		case Variant::PACKED_VECTOR2_ARRAY:
+			return _make_packed<Vector2>(p_src, p_count);
+		case Variant::PACKED_VECTOR3_ARRAY:
+			return _make_packed<Vector3>(p_src, p_count);
+		case Variant::PACKED_COLOR_ARRAY:
+			return _make_packed<Color>(p_src, p_count);
+		case Variant::PACKED_VECTOR4_ARRAY:
+			return _make_packed<Vector4>(p_src, p_count);
+		default:
+			ERR_FAIL_V(Variant());
+	}
+}
+
+static _FORCE_INLINE_ uint8_t *_grow(LocalVector<uint8_t> &r_buffer, uint32_t p_size) {
+	const uint32_t pos = r_buffer.size();
+	r_buffer.resize(pos + p_size);
+	return r_buffer.ptr() + pos;
+}
+
+static _FORCE_INLINE_ void _put_u32(LocalVector<uint8_t> &r_buffer, uint32_t p_value) {
+	encode_uint32(p_value, _grow(r_buffer, 4));
+}
+
+static _FORCE_INLINE_ bool _get_u32(const uint8_t *&r_buffer, const uint8_t *p_end, uint32_t &r_value) {
+	if (p_end - r_buffer < 4) {
+		return false;
+	}
+	r_value = decode_uint32(r_buffer);
+	r_buffer += 4;
+	return true;
+}
+
+static bool _is_record(const Dictionary &p_dictionary) {
+	for (const KeyValue<Variant, Variant> &kv : p_dictionary) {
+		if (kv.key.get_type() != Variant::STRING) {
+			return false;
+		}
+	}
+	return true;
+}
+
+int VariantSchema::_compile_type(Variant::Type p_type, const Variant &p_sample, int p_depth) {
+	int node;
+	if (p_type == Variant::NIL) {
+		node = nodes.size();
+		nodes.push_back(Node());
+	} else if (p_sample.get_type() == p_type) {
+		node = _compile(p_sample, p_depth);
+	} else {
+		// No sample of this type (e.g. an empty container), use the default value.
+		Variant value;
+		Callable::CallError ce;
+		Variant::construct(p_type, value, nullptr, 0, ce);
+		node = _compile(value, p_depth);
+	}
+	if (node >= 0 && nodes[node].kind == KIND_VARIANT) {
+		// Container elements must still be of the container's type.
+		nodes[node].type = p_type;
+	}
+	return node;
+}
+
+int VariantSchema::_compile(const Variant &p_sample, int p_depth) {
+	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, -1, "Variant is too deep. Bailing.");
+
+	Node node;
+	const Variant::Type type = p_sample.get_type();
+	node.type = type;
+
+	if (get_fixed_size(type)) {
+		node.kind = KIND_FIXED;
+		node.size = get_fixed_size(type);
+	} else if (type == Variant::STRING || type == Variant::STRING_NAME) {
+		node.kind = KIND_STRING;
+	} else if (_get_packed_element_size(type)) {
+		node.kind = KIND_PACKED_ARRAY;
+		node.size = _get_packed_element_size(type);
+	} else if (type == Variant::ARRAY) {
+		const Array array = p_sample;
+		const Variant::Type element_type = Variant::Type(array.get_typed_builtin());
+		if (array.is_typed() && element_type != Variant::OBJECT) {
+			node.kind = KIND_ARRAY;
+			node.element = _compile_type(element_type, array.is_empty() ? Variant() : array[0], p_depth + 1);
+			ERR_FAIL_COND_V(node.element < 0, -1);
+		} else {
+			node.type = Variant::NIL;
+		}
+	} else if (type == Variant::DICTIONARY) {
+		const Dictionary dictionary = p_sample;
+		const Variant::Type key_type = Variant::Type(dictionary.get_typed_key_builtin());
+		const Variant::Type value_type = Variant::Type(dictionary.get_typed_value_builtin());
+		if (dictionary.is_typed() && key_type != Variant::OBJECT && value_type != Variant::OBJECT) {
+			node.kind = KIND_DICTIONARY;
+			const Variant *key = dictionary.next();
+			node.key = _compile_type(key_type, key ? *key : Variant(), p_depth + 1);
+			ERR_FAIL_COND_V(node.key < 0, -1);
+			node.element = _compile_type(value_type, key ? dictionary[*key] : Variant(), p_depth + 1);
+			ERR_FAIL_COND_V(node.element < 0, -1);
+		} else if (!dictionary.is_typed() && !dictionary.is_empty() && _is_record(dictionary)) {
+			node.kind = KIND_RECORD;
+			for (const KeyValue<Variant, Variant> &kv : dictionary) {
+				const int field = _compile(kv.value, p_depth + 1);
+				ERR_FAIL_COND_V(field < 0, -1);
+				node.field_names.push_back(kv.key);
+				node.fields.push_back(field);
+			}
+		} else {
+			node.type = Variant::NIL;
+		}
+	} else {
+		// Objects, node paths, callables... are written as they are by encode_variant().
+		node.type = Variant::NIL;
+	}
+
+	nodes.push_back(node);
+	return nodes.size() - 1;
+}
+
+uint32_t VariantSchema::_hash_node(int p_node, uint32_t p_hash) const {
+	const Node &node = nodes[p_node];
+	p_hash = hash_murmur3_one_32(node.kind, p_hash);
+	p_hash = hash_murmur3_one_32(node.type, p_hash);
+	p_hash = hash_murmur3_one_32(node.size, p_hash);
+	if (node.key >= 0) {
+		p_hash = _hash_node(node.key, p_hash);
+	}
+	if (node.element >= 0) {
+		p_hash = _hash_node(node.element, p_hash);
+	}
+	for (uint32_t i = 0; i < node.fields.size(); i++) {
+		p_hash = hash_murmur3_one_32(node.field_names[i].hash(), p_hash);
+		p_hash = _hash_node(node.fields[i], p_hash);
+	}
+	return p_hash;
+}
+
+Error VariantSchema::compile(const Variant &p_sample) {
+	nodes.clear();
+	hash = 0;
+	root = _compile(p_sample, 0);
+	if (root < 0) {
+		nodes.clear();
+		ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, "Can't compile a schema from this sample.");
+	}
+
+	// The layout depends on the precision of real_t and the byte order.
+	uint32_t h = hash_murmur3_one_32(FORMAT_VERSION);
+	h = hash_murmur3_one_32(sizeof(real_t), h);
+#ifdef BIG_ENDIAN_ENABLED
+	h = hash_murmur3_one_32(1, h);
+#endif
+	hash = hash_fmix32(_hash_node(root, h));
+	return OK;
+}
+
+Error VariantSchema::_encode(int p_node, const Variant &p_value, LocalVector<uint8_t> &r_buffer) const {
+	const Node &node = nodes[p_node];
+	if (node.kind != KIND_VARIANT || node.type != Variant::NIL) {
+		ERR_FAIL_COND_V_MSG(p_value.get_type() != node.type, ERR_INVALID_DATA, vformat("Expected a value of type %s, got %s.", Variant::get_type_name(node.type), Variant::get_type_name(p_value.get_type())));
+	}
+
+	switch (node.kind) {
+		case KIND_VARIANT: {
+			// The stream isn't aligned here. encode_variant() pads by payload length, like decode_variant() expects.
+			return encode_variant(p_value, r_buffer);
+		}
+		case KIND_FIXED: {
+			memcpy(_grow(r_buffer, node.size), VariantInternal::get_opaque_pointer(&p_value), node.size);
+		} break;
+		case KIND_STRING: {
+			const CharString utf8 = node.type == Variant::STRING ? VariantInternal::get_string(&p_value)->utf8() : String(*VariantInternal::get_string_name(&p_value)).utf8();
+			_put_u32(r_buffer, utf8.length());
+			memcpy(_grow(r_buffer, utf8.length()), utf8.get_data(), utf8.length());
+		} break;
+		case KIND_PACKED_ARRAY: {
+			int count;
+			const void *data = _get_packed_data(p_value, count);
+			_put_u32(r_buffer, count);
+			if (count) {
+				memcpy(_grow(r_buffer, count * node.size), data, count * node.size);
+			}
+		} break;
+		case KIND_ARRAY: {
+			const Array &array = *VariantInternal::get_array(&p_value);
+			const Node &element = nodes[node.element];
+			ERR_FAIL_COND_V_MSG(Variant::Type(array.get_typed_builtin()) != element.type, ERR_INVALID_DATA, "The array isn't typed like the schema.");
+			const int count = array.size();
+			_put_u32(r_buffer, count);
+			if (count == 0) {
+				break;
+			}
+			const Variant *src = &array[0];
+			if (element.kind == KIND_FIXED) {
+				// Typed arrays only hold values of their type, no need to check each one.
+				uint8_t *dst = _grow(r_buffer, count * element.size);
+				switch (element.type) {
+#define ENCODE_FIXED(m_type, m_getter)                                   \
+	case Variant::m_type: {                                              \
+		constexpr uint32_t size = sizeof(*VariantInternal::m_getter(src)); \
+		for (int i = 0; i < count; i++) {                                \
+			memcpy(dst, VariantInternal::m_getter(&src[i]), size);        \
+			dst += size;                                                 \
+		}                                                                \
+	} break;
+					FOR_EACH_FIXED_TYPE(ENCODE_FIXED)
+#undef ENCODE_FIXED
+					default:
+						ERR_FAIL_V(ERR_BUG);
+				}
+			} else {
+				for (int i = 0; i < count; i++) {
+					const Error err = _encode(node.element, src[i], r_buffer);
+					if (err != OK) {
+						return err;
+					}
+				}
+			}
+		} break;
+		case KIND_DICTIONARY: {
+			const Dictionary &dictionary = *VariantInternal::get_dictionary(&p_value);
+			ERR_FAIL_COND_V_MSG(Variant::Type(dictionary.get_typed_key_builtin()) != nodes[node.key].type || Variant::Type(dictionary.get_typed_value_builtin()) != nodes[node.element].type, ERR_INVALID_DATA, "The dictionary isn't typed like the schema.");
+			_put_u32(r_buffer, dictionary.size());
+			for (const KeyValue<Variant, Variant> &kv : dictionary) {
+				Error err = _encode(node.key, kv.key, r_buffer);
+				if (err == OK) {
+					err = _encode(node.element, kv.value, r_buffer);
+				}
+				if (err != OK) {
+					return err;
+				}
+			}
+		} break;
+		case KIND_RECORD: {
+			const Dictionary &dictionary = *VariantInternal::get_dictionary(&p_value);
+			ERR_FAIL_COND_V_MSG(dictionary.is_typed() || dictionary.size() != (int)node.fields.size(), ERR_INVALID_DATA, "The dictionary doesn't have the fields of the schema.");
+			for (uint32_t i = 0; i < node.fields.size(); i++) {
+				const Variant *value = dictionary.getptr(node.field_names[i]);
+				ERR_FAIL_NULL_V_MSG(value, ERR_INVALID_DATA, vformat("The dictionary has no \"%s\" field.", node.field_names[i]));
+				const Error err = _encode(node.fields[i], *value, r_buffer);
+				if (err != OK) {
+					return err;
+				}
+			}
+		} break;
+	}
+	return OK;
+}
+
+Error VariantSchema::encode(const Variant &p_value, LocalVector<uint8_t> &r_buffer) const {
+	ERR_FAIL_COND_V_MSG(!is_compiled(), ERR_UNCONFIGURED, "The schema must be compiled first.");
+	const uint32_t start = r_buffer.size();
+	_put_u32(r_buffer, hash);
+	const Error err = _encode(root, p_value, r_buffer);
+	if (err != OK) {
+		r_buffer.resize(start);
+	}
+	return err;
+}
+
+Error VariantSchema::_decode(int p_node, const uint8_t *&r_buffer, const uint8_t *p_end, Variant &r_value) const {
+	const Node &node = nodes[p_node];
+	switch (node.kind) {
+		case KIND_VARIANT: {
+			int len = 0;
+			const Error err = decode_variant(r_value, r_buffer, p_end - r_buffer, &len);
+			if (err != OK) {
+				return err;
+			}
+			ERR_FAIL_COND_V(node.type != Variant::NIL && r_value.get_type() != node.type, ERR_INVALID_DATA);
+			r_buffer += len;
+		} break;
+		case KIND_FIXED: {
+			ERR_FAIL_COND_V(p_end - r_buffer < node.size, ERR_INVALID_DATA);
+			if (r_value.get_type() != node.type) {
+				r_value = Variant();
+				VariantInternal::initialize(&r_value, node.type);
+			}
+			memcpy(VariantInternal::get_opaque_pointer(&r_value), r_buffer, node.size);
+			r_buffer += node.size;
+		} break;
+		case KIND_STRING: {
+			uint32_t length;
+			ERR_FAIL_COND_V(!_get_u32(r_buffer, p_end, length) || p_end - r_buffer < length, ERR_INVALID_DATA);
+			const String string = String::utf8((const char *)r_buffer, length);
+			if (node.type == Variant::STRING) {
+				r_value = string;
+			} else {
+				r_value = StringName(string);
+			}
+			r_buffer += length;
+		} break;
+		case KIND_PACKED_ARRAY: {
+			uint32_t count;
+			ERR_FAIL_COND_V(!_get_u32(r_buffer, p_end, count) || uint64_t(p_end - r_buffer) < uint64_t(count) * node.size, ERR_INVALID_DATA);
+			r_value = _make_packed(node.type, r_buffer, count);
+			r_buffer += count * node.size;
+		} break;
+		case KIND_ARRAY: {
+			const Node &element = nodes[node.element];
+			uint32_t count;
+			ERR_FAIL_COND_V(!_get_u32(r_buffer, p_end, count), ERR_INVALID_DATA);
+			// Every element takes at least a byte (packed arrays their count), don't allocate for
+			// bogus counts. The size of packed array nodes is their item size, not their own.
+			const uint32_t element_min_size = element.kind == KIND_PACKED_ARRAY ? sizeof(uint32_t) : MAX(element.size, 1u);
+			ERR_FAIL_COND_V(uint64_t(p_end - r_buffer) < uint64_t(count) * element_min_size, ERR_INVALID_DATA);
+
+			Array array;
+			array.set_typed(element.type, StringName(), Variant());
+			array.resize(count);
+			r_value = array;
+			if (count == 0) {
+				break;
+			}
+			// The array was just made, writing to its storage directly is safe. Elements are
+			// already initialized to the array's type.
+			Variant *dst = &array[0];
+			if (element.kind == KIND_FIXED) {
+				switch (element.type) {
+#define DECODE_FIXED(m_type, m_getter)                                   \
+	case Variant::m_type: {                                              \
+		constexpr uint32_t size = sizeof(*VariantInternal::m_getter(dst)); \
+		for (uint32_t i = 0; i < count; i++) {                           \
+			memcpy(VariantInternal::m_getter(&dst[i]), r_buffer, size);   \
+			r_buffer += size;                                            \
+		}                                                                \
+	} break;
+					FOR_EACH_FIXED_TYPE(DECODE_FIXED)
+#undef DECODE_FIXED
+					default:
+						ERR_FAIL_V(ERR_BUG);
+				}
+			} else {
+				for (uint32_t i = 0; i < count; i++) {
+					const Error err = _decode(node.element, r_buffer, p_end, dst[i]);
+					if (err != OK) {
+						return err;
+					}
+				}
+			}
+		} break;
+		case KIND_DICTIONARY: {
+			const Node &key_node = nodes[node.key];
+			const Node &value_node = nodes[node.element];
+			uint32_t count;
+			ERR_FAIL_COND_V(!_get_u32(r_buffer, p_end, count) || uint64_t(p_end - r_buffer) < count, ERR_INVALID_DATA);
+
+			Dictionary dictionary;
+			dictionary.set_typed(key_node.type, StringName(), Variant(), value_node.type, StringName(), Variant());
+			dictionary.reserve(count);
+			Variant key;
+			Variant value;
+			for (uint32_t i = 0; i < count; i++) {
+				Error err = _decode(node.key, r_buffer, p_end, key);
+				if (err == OK) {
+					err = _decode(node.element, r_buffer, p_end, value);
+				}
+				if (err != OK) {
+					return err;
+				}
+				dictionary.set(key, value);
+			}
+			r_value = dictionary;
+		} break;
+		case KIND_RECORD: {
+			Dictionary dictionary;
+			dictionary.reserve(node.fields.size());
+			for (uint32_t i = 0; i < node.fields.size(); i++) {
+				Variant value;
+				const Error err = _decode(node.fields[i], r_buffer, p_end, value);
+				if (err != OK) {
+					return err;
+				}
+				dictionary[node.field_names[i]] = value;
+			}
+			r_value = dictionary;
+		} break;
+	}
+	return OK;
+}
+
+Error VariantSchema::decode(const uint8_t *p_buffer, int p_len, Variant &r_value, int *r_len) const {
+	ERR_FAIL_COND_V_MSG(!is_compiled(), ERR_UNCONFIGURED, "The schema must be compiled first.");
+	const uint8_t *ptr = p_buffer;
+	const uint8_t *end = p_buffer + p_len;
+	uint32_t data_hash;
+	ERR_FAIL_COND_V(!_get_u32(ptr, end, data_hash), ERR_INVALID_DATA);
+	ERR_FAIL_COND_V_MSG(data_hash != hash, ERR_INVALID_DATA, "The data was encoded with a different schema.");
+
+	Variant value;
+	const Error err = _decode(root, ptr, end, value);
+	if (err != OK) {
+		return err;
+	}
+	r_value = value;
+	if (r_len) {
+		*r_len = ptr - p_buffer;
+	}
+	return OK;
+}
+
+String VariantSchema::_describe(int p_node) const {
+	const Node &node = nodes[p_node];
+	switch (node.kind) {
+		case KIND_VARIANT:
+			return node.type == Variant::NIL ? String("Variant") : vformat("Variant(%s)", Variant::get_type_name(node.type));
+		case KIND_ARRAY:
+			return vformat("Array[%s]", _describe(node.element));
+		case KIND_DICTIONARY:
+			return vformat("Dictionary[%s, %s]", _describe(node.key), _describe(node.element));
+		case KIND_RECORD: {
+			String fields;
+			for (uint32_t i = 0; i < node.fields.size(); i++) {
+				fields += vformat("%s%s: %s", i ? ", " : "", node.field_names[i], _describe(node.fields[i]));
+			}
+			return "{ " + fields + " }";
+		}
+		default:
+			return Variant::get_type_name(node.type);
+	}
+}
+
+String VariantSchema::get_layout() const {
+	return is_compiled() ? _describe(root) : String();
+}
+
+Vector<uint8_t> VariantSchema::_encode_bind(const Variant &p_value) const {
+	LocalVector<uint8_t> buffer;
+	if (encode(p_value, buffer) != OK) {
+		return Vector<uint8_t>();
+	}
+	Vector<uint8_t> bytes;
+	bytes.resize(buffer.size());
+	memcpy(bytes.ptrw(), buffer.ptr(), buffer.size());
+	return bytes;
+}
+
+Variant VariantSchema::_decode_bind(const Vector<uint8_t> &p_bytes) const {
+	Variant value;
+	ERR_FAIL_COND_V(decode(p_bytes.ptr(), p_bytes.size(), value) != OK, Variant());
+	return value;
+}
+
+void VariantSchema::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("compile", "sample"), &VariantSchema::compile);
+	ClassDB::bind_method(D_METHOD("is_compiled"), &VariantSchema::is_compiled);
+	ClassDB::bind_method(D_METHOD("get_hash"), &VariantSchema::get_hash);
+	ClassDB::bind_method(D_METHOD("get_layout"), &VariantSchema::get_layout);
+
+	ClassDB::bind_method(D_METHOD("encode", "value"), &VariantSchema::_encode_bind);
+	ClassDB::bind_method(D_METHOD("decode", "bytes"), &VariantSchema::_decode_bind);
+}
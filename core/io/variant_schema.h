@@ -0,0 +1,100 @@
+/**************************************************************************/
+/*  variant_schema.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
+
+// A fixed binary layout derived once from a sample value, for serializing large
+// typed data sets faster and smaller than encode_variant().
+// Typed arrays of fixed-size types are stored as packed raw data, with no per-element
+// type tag or dispatch. Dictionaries with String keys are compiled as records, with the
+// field names stored in the schema instead of the data (like the members of a typed script).
+// Values the schema can't describe (objects, untyped arrays) fall back to encode_variant().
+// The layout is native: data is only meant to be read back by the same build on the same
+// kind of host (a schema hash is stored in front of the data to catch mismatches).
+class VariantSchema : public RefCounted {
+	GDCLASS(VariantSchema, RefCounted);
+
+public:
+	enum NodeKind {
+		KIND_VARIANT,
+		KIND_FIXED,
+		KIND_STRING,
+		KIND_PACKED_ARRAY,
+		KIND_ARRAY,
+		KIND_DICTIONARY,
+		KIND_RECORD,
+	};
+
+private:
+	struct Node {
+		NodeKind kind = KIND_VARIANT;
+		Variant::Type type = Variant::NIL;
+		uint32_t size = 0; // For fixed types, or the element size of packed arrays.
+		int element = -1; // Array elements, or dictionary values.
+		int key = -1; // Dictionary keys.
+		LocalVector<Variant> field_names; // Record fields, as Strings.
+		LocalVector<int> fields;
+	};
+
+	LocalVector<Node> nodes; // Children are compiled before their parents.
+	int root = -1;
+	uint32_t hash = 0;
+
+	int _compile_type(Variant::Type p_type, const Variant &p_sample, int p_depth);
+	int _compile(const Variant &p_sample, int p_depth);
+	uint32_t _hash_node(int p_node, uint32_t p_hash) const;
+
+	Error _encode(int p_node, const Variant &p_value, LocalVector<uint8_t> &r_buffer) const;
+	Error _decode(int p_node, const uint8_t *&r_buffer, const uint8_t *p_end, Variant &r_value) const;
+
+	String _describe(int p_node) const;
+
+protected:
+	static void _bind_methods();
+
+	Vector<uint8_t> _encode_bind(const Variant &p_value) const;
+	Variant _decode_bind(const Vector<uint8_t> &p_bytes) const;
+
+public:
+	// Fixed-size types, which typed arrays store as packed raw data.
+	static uint32_t get_fixed_size(Variant::Type p_type);
+
+	Error compile(const Variant &p_sample);
+	bool is_compiled() const { return root >= 0; }
+	uint32_t get_hash() const { return hash; }
+	String get_layout() const;
+
+	// Appends the schema hash and p_value to r_buffer. On error, r_buffer is left as it was.
+	Error encode(const Variant &p_value, LocalVector<uint8_t> &r_buffer) const;
+	Error decode(const uint8_t *p_buffer, int p_len, Variant &r_value, int *r_len = nullptr) const;
+};
@@ -0,0 +1,276 @@
+/**************************************************************************/
+/*  zstd_dictionary.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "zstd_dictionary.h"
+
+#include "core/io/compression.h"
+#include "core/io/marshalls.h"
+#include "core/templates/hash_map.h"
+
+#include <zstd.h>
+
+ZSTDCompressionDictionary::~ZSTDCompressionDictionary() {
+	ZSTD_freeCDict(cdict);
+}
+
+ZSTDDecompressionDictionary::~ZSTDDecompressionDictionary() {
+	ZSTD_freeDDict(ddict);
+}
+
+static _FORCE_INLINE_ uint64_t _read_dmer(const uint8_t *p_src) {
+	uint64_t dmer;
+	memcpy(&dmer, p_src, sizeof(uint64_t));
+	return dmer;
+}
+
+Error ZSTDDictionary::train(const Vector<Vector<uint8_t>> &p_samples, int p_max_size) {
+	static_assert(TRAIN_DMER_SIZE == sizeof(uint64_t));
+	ERR_FAIL_COND_V_MSG(p_samples.is_empty(), ERR_INVALID_PARAMETER, "At least one sample is needed to train a dictionary.");
+	ERR_FAIL_COND_V_MSG(p_max_size < TRAIN_SEGMENT_SIZE, ERR_INVALID_PARAMETER, vformat("The dictionary size must be at least %d bytes.", TRAIN_SEGMENT_SIZE));
+
+	// This follows the idea of zstd's COVER trainer (which isn't part of the bundled zstd):
+	// rank windows of the samples by how many other samples share their substrings ("dmers"),
+	// and build a raw content dictionary out of the best ones.
+	struct DmerCount {
+		uint32_t samples = 0;
+		uint32_t last_sample = UINT32_MAX;
+	};
+	HashMap<uint64_t, DmerCount> counts;
+	for (int i = 0; i < p_samples.size(); i++) {
+		const Vector<uint8_t> &sample = p_samples[i];
+		for (int j = 0; j + TRAIN_DMER_SIZE <= sample.size(); j++) {
+			DmerCount &count = counts[_read_dmer(sample.ptr() + j)];
+			if (count.last_sample != uint32_t(i)) {
+				count.last_sample = i;
+				count.samples++;
+			}
+		}
+	}
+	ERR_FAIL_COND_V_MSG(counts.is_empty(), ERR_INVALID_DATA, "The samples are too small to train a dictionary.");
+
+	// Substrings found in a single sample don't help compressing anything else.
+	auto score_of = [&counts](uint64_t p_dmer) -> uint64_t {
+		const uint32_t samples = counts[p_dmer].samples;
+		return samples > 1 ? samples - 1 : 0;
+	};
+
+	struct Segment {
+		int sample = 0;
+		int offset = 0;
+		int length = 0;
+	};
+	LocalVector<Segment> picked;
+	int dict_size = 0;
+
+	// The samples are split into epochs and each one contributes its best window in turn, so the
+	// dictionary covers all of them. The dmers of a picked window stop counting towards later ones.
+	const int epochs = CLAMP(p_max_size / TRAIN_SEGMENT_SIZE, 1, p_samples.size());
+	HashMap<uint64_t, uint32_t> window;
+	bool progress = true;
+	while (progress && dict_size < p_max_size) {
+		progress = false;
+		for (int epoch = 0; epoch < epochs && dict_size < p_max_size; epoch++) {
+			Segment best;
+			uint64_t best_score = 0;
+			for (int i = epoch * p_samples.size() / epochs; i < (epoch + 1) * p_samples.size() / epochs; i++) {
+				const Vector<uint8_t> &sample = p_samples[i];
+				const int length = MIN(sample.size(), TRAIN_SEGMENT_SIZE);
+				const int window_dmers = length - TRAIN_DMER_SIZE + 1;
+				if (window_dmers <= 0) {
+					continue;
+				}
+
+				window.clear();
+				uint64_t score = 0;
+				for (int j = 0; j + TRAIN_DMER_SIZE <= sample.size(); j++) {
+					const uint64_t dmer = _read_dmer(sample.ptr() + j);
+					if (window[dmer]++ == 0) {
+						score += score_of(dmer);
+					}
+					if (j >= window_dmers) {
+						const uint64_t old_dmer = _read_dmer(sample.ptr() + j - window_dmers);
+						if (--window[old_dmer] == 0) {
+							score -= score_of(old_dmer);
+						}
+					}
+					if (j >= window_dmers - 1 && score > best_score) {
+						best_score = score;
+						best.sample = i;
+						best.offset = j - window_dmers + 1;
+						best.length = length;
+					}
+				}
+			}
+
+			if (best_score == 0) {
+				continue;
+			}
+			const uint8_t *segment = p_samples[best.sample].ptr() + best.offset;
+			for (int j = 0; j + TRAIN_DMER_SIZE <= best.length; j++) {
+				counts[_read_dmer(segment + j)].samples = 0;
+			}
+			picked.push_back(best);
+			dict_size += best.length;
+			progress = true;
+		}
+	}
+	ERR_FAIL_COND_V_MSG(picked.is_empty(), ERR_INVALID_DATA, "The samples have no content in common to train a dictionary from.");
+
+	// zstd references recent content more cheaply, so the first (best) picks go at the end.
+	Vector<uint8_t> dict;
+	dict.resize(MIN(dict_size, p_max_size));
+	int end = dict.size();
+	for (const Segment &segment : picked) {
+		const int length = MIN(segment.length, end);
+		memcpy(dict.ptrw() + end - length, p_samples[segment.sample].ptr() + segment.offset, length);
+		end -= length;
+		if (end == 0) {
+			break;
+		}
+	}
+
+	set_data(dict);
+	return OK;
+}
+
+Error ZSTDDictionary::_train_bind(const TypedArray<PackedByteArray> &p_samples, int p_max_size) {
+	Vector<Vector<uint8_t>> samples;
+	samples.resize(p_samples.size());
+	for (int i = 0; i < p_samples.size(); i++) {
+		samples.write[i] = p_samples[i];
+	}
+	return train(samples, p_max_size);
+}
+
+void ZSTDDictionary::set_data(const Vector<uint8_t> &p_data) {
+	{
+		MutexLock lock(mutex);
+		cdict.unref();
+		ddict.unref();
+		data = p_data;
+	}
+	emit_changed();
+}
+
+uint32_t ZSTDDictionary::get_id() const {
+	return data.is_empty() ? 0 : ZSTD_getDictID_fromDict(data.ptr(), data.size());
+}
+
+void ZSTDDictionary::set_compression_level(int p_level) {
+	MutexLock lock(mutex);
+	if (p_level != compression_level) {
+		cdict.unref();
+	}
+	compression_level = p_level;
+}
+
+Ref<ZSTDCompressionDictionary> ZSTDDictionary::get_compression_dictionary() const {
+	MutexLock lock(mutex);
+	if (cdict.is_null() && !data.is_empty()) {
+		ZSTD_CDict *digested = ZSTD_createCDict(data.ptr(), data.size(), compression_level);
+		ERR_FAIL_NULL_V_MSG(digested, Ref<ZSTDCompressionDictionary>(), "Invalid Zstd dictionary.");
+		cdict = Ref<ZSTDCompressionDictionary>(memnew(ZSTDCompressionDictionary(digested)));
+	}
+	return cdict;
+}
+
+Ref<ZSTDDecompressionDictionary> ZSTDDictionary::get_decompression_dictionary() const {
+	MutexLock lock(mutex);
+	if (ddict.is_null() && !data.is_empty()) {
+		ZSTD_DDict *digested = ZSTD_createDDict(data.ptr(), data.size());
+		ERR_FAIL_NULL_V_MSG(digested, Ref<ZSTDDecompressionDictionary>(), "Invalid Zstd dictionary.");
+		ddict = Ref<ZSTDDecompressionDictionary>(memnew(ZSTDDecompressionDictionary(digested)));
+	}
+	return ddict;
+}
+
+Vector<uint8_t> ZSTDDictionary::_compress(const uint8_t *p_src, int p_size) const {
+	ERR_FAIL_COND_V_MSG(data.is_empty(), Vector<uint8_t>(), "The dictionary is empty.");
+	Vector<uint8_t> compressed;
+	compressed.resize(Compression::get_max_compressed_buffer_size(p_size, Compression::MODE_ZSTD));
+	const int64_t ret = Compression::compress(compressed.ptrw(), p_src, p_size, Compression::MODE_ZSTD, this);
+	ERR_FAIL_COND_V(ret < 0, Vector<uint8_t>());
+	compressed.resize(ret);
+	return compressed;
+}
+
+Vector<uint8_t> ZSTDDictionary::compress(const Vector<uint8_t> &p_data) const {
+	return _compress(p_data.ptr(), p_data.size());
+}
+
+Vector<uint8_t> ZSTDDictionary::decompress(const Vector<uint8_t> &p_data, int64_t p_max_output_size) const {
+	ERR_FAIL_COND_V_MSG(data.is_empty(), Vector<uint8_t>(), "The dictionary is empty.");
+	// Frames compressed with a dictionary always store their size.
+	const unsigned long long size = ZSTD_getFrameContentSize(p_data.ptr(), p_data.size());
+	ERR_FAIL_COND_V_MSG(size == ZSTD_CONTENTSIZE_ERROR || size == ZSTD_CONTENTSIZE_UNKNOWN, Vector<uint8_t>(), "Invalid Zstd frame.");
+	ERR_FAIL_COND_V_MSG(size > INT32_MAX || (p_max_output_size >= 0 && size > (unsigned long long)p_max_output_size), Vector<uint8_t>(), vformat("Decompressed size (%d bytes) exceeds the limit.", (uint64_t)size));
+
+	Vector<uint8_t> decompressed;
+	decompressed.resize(size);
+	const int64_t ret = Compression::decompress(decompressed.ptrw(), size, p_data.ptr(), p_data.size(), Compression::MODE_ZSTD, this);
+	ERR_FAIL_COND_V_MSG(ret != (int64_t)size, Vector<uint8_t>(), "Decompression failed, the data may have been compressed with another dictionary.");
+	return decompressed;
+}
+
+Vector<uint8_t> ZSTDDictionary::encode_var(const Variant &p_variant, bool p_full_objects) const {
+	VariantEncodeBuffer buffer;
+	Error err = buffer.encode(p_variant, p_full_objects);
+	ERR_FAIL_COND_V_MSG(err != OK, Vector<uint8_t>(), "Unexpected error encoding variable to bytes, likely unserializable type found (Object or RID).");
+
+	return _compress(buffer.ptr(), buffer.size());
+}
+
+Variant ZSTDDictionary::decode_var(const Vector<uint8_t> &p_data, bool p_allow_objects, int64_t p_max_output_size) const {
+	ERR_FAIL_COND_V(p_max_output_size < 0, Variant());
+	const Vector<uint8_t> bytes = decompress(p_data, p_max_output_size);
+	ERR_FAIL_COND_V(bytes.is_empty(), Variant());
+
+	Variant ret;
+	Error err = decode_variant(ret, bytes.ptr(), bytes.size(), nullptr, p_allow_objects);
+	ERR_FAIL_COND_V_MSG(err != OK, Variant(), "Error when trying to decode Variant.");
+	return ret;
+}
+
+void ZSTDDictionary::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("train", "samples", "max_size"), &ZSTDDictionary::_train_bind, DEFVAL(16384));
+	ClassDB::bind_method(D_METHOD("set_data", "data"), &ZSTDDictionary::set_data);
+	ClassDB::bind_method(D_METHOD("get_data"), &ZSTDDictionary::get_data);
+	ClassDB::bind_method(D_METHOD("get_id"), &ZSTDDictionary::get_id);
+	ClassDB::bind_method(D_METHOD("set_compression_level", "level"), &ZSTDDictionary::set_compression_level);
+	ClassDB::bind_method(D_METHOD("get_compression_level"), &ZSTDDictionary::get_compression_level);
+
+	ClassDB::bind_method(D_METHOD("compress", "data"), &ZSTDDictionary::compress);
+	ClassDB::bind_method(D_METHOD("decompress", "data", "max_output_size"), &ZSTDDictionary::decompress, DEFVAL(-1));
+	ClassDB::bind_method(D_METHOD("encode_var", "variable", "full_objects"), &ZSTDDictionary::encode_var, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("decode_var", "bytes", "allow_objects", "max_output_size"), &ZSTDDictionary::decode_var, DEFVAL(false), DEFVAL(8 * 1024 * 1024));
+
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_BYTE_ARRAY, "data"), "set_data", "get_data");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "compression_level", PROPERTY_HINT_RANGE, "1,22,1"), "set_compression_level", "get_compression_level");
+}
@@ -0,0 +1,112 @@
+/**************************************************************************/
+/*  zstd_dictionary.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/resource.h"
+#include "core/os/mutex.h"
+#include "core/variant/typed_array.h"
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+// Digested dictionaries are refcounted, so a compression or decompression using one keeps it
+// alive while ZSTDDictionary replaces it (new data or compression level) on another thread.
+class ZSTDCompressionDictionary : public RefCounted {
+	GDSOFTCLASS(ZSTDCompressionDictionary, RefCounted);
+
+	ZSTD_CDict_s *cdict = nullptr;
+
+public:
+	const ZSTD_CDict_s *get() const { return cdict; }
+
+	ZSTDCompressionDictionary(ZSTD_CDict_s *p_cdict) :
+			cdict(p_cdict) {}
+	~ZSTDCompressionDictionary();
+};
+
+class ZSTDDecompressionDictionary : public RefCounted {
+	GDSOFTCLASS(ZSTDDecompressionDictionary, RefCounted);
+
+	ZSTD_DDict_s *ddict = nullptr;
+
+public:
+	const ZSTD_DDict_s *get() const { return ddict; }
+
+	ZSTDDecompressionDictionary(ZSTD_DDict_s *p_ddict) :
+			ddict(p_ddict) {}
+	~ZSTDDecompressionDictionary();
+};
+
+// A zstd dictionary, for compressing many small payloads that share structure
+// (network snapshots, small sub-resources) far better than each one alone.
+// The data is either a dictionary trained with `zstd --train` or one built by train().
+// The digested zstd dictionaries are created on first use and shared by all threads.
+class ZSTDDictionary : public Resource {
+	GDCLASS(ZSTDDictionary, Resource);
+
+	Vector<uint8_t> data;
+	int compression_level = 3;
+
+	mutable Mutex mutex;
+	mutable Ref<ZSTDCompressionDictionary> cdict;
+	mutable Ref<ZSTDDecompressionDictionary> ddict;
+
+	Vector<uint8_t> _compress(const uint8_t *p_src, int p_size) const;
+
+protected:
+	static void _bind_methods();
+
+	Error _train_bind(const TypedArray<PackedByteArray> &p_samples, int p_max_size);
+
+public:
+	// Size of the windows picked from the samples, and of the substrings that rank them.
+	static constexpr int TRAIN_SEGMENT_SIZE = 256;
+	static constexpr int TRAIN_DMER_SIZE = 8;
+
+	Error train(const Vector<Vector<uint8_t>> &p_samples, int p_max_size = 16384);
+
+	void set_data(const Vector<uint8_t> &p_data);
+	Vector<uint8_t> get_data() const { return data; }
+	bool is_empty() const { return data.is_empty(); }
+	uint32_t get_id() const;
+
+	void set_compression_level(int p_level);
+	int get_compression_level() const { return compression_level; }
+
+	// Keep the returned reference for as long as the digested dictionary is used.
+	Ref<ZSTDCompressionDictionary> get_compression_dictionary() const;
+	Ref<ZSTDDecompressionDictionary> get_decompression_dictionary() const;
+
+	Vector<uint8_t> compress(const Vector<uint8_t> &p_data) const;
+	Vector<uint8_t> decompress(const Vector<uint8_t> &p_data, int64_t p_max_output_size = -1) const;
+	Vector<uint8_t> encode_var(const Variant &p_variant, bool p_full_objects = false) const;
+	Variant decode_var(const Vector<uint8_t> &p_data, bool p_allow_objects = false, int64_t p_max_output_size = 8 * 1024 * 1024) const;
+};
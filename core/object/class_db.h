@@ -39,6 +39,7 @@
 // Needs to come after method_bind and object have been included.
 #include "core/object/callable_method_pointer.h"
 #include "core/templates/a_hash_map.h"
+#include "core/templates/group_hash_map.h"
 #include "core/templates/hash_set.h"
 
 #include <type_traits>
@@ -127,7 +128,7 @@ public:
 
 		ObjectGDExtension *gdextension = nullptr;
 
-		HashMap<StringName, MethodBind *> method_map;
+		GroupHashMap<StringName, MethodBind *> method_map;
 		HashMap<StringName, LocalVector<MethodBind *>> method_map_compatibility;
 		AHashMap<StringName, int64_t> constant_map;
 		struct EnumInfo {
@@ -154,7 +155,7 @@ public:
 		List<StringName> dependency_list;
 #endif
 
-		AHashMap<StringName, PropertySetGet> property_setget;
+		GroupHashMap<StringName, PropertySetGet> property_setget;
 		HashMap<StringName, Vector<uint32_t>> virtual_methods_compat;
 
 		StringName inherits;
@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/object/class_db.h"
 #include "core/object/script_language.h"
+#include "core/os/thread.h"
 
 #include <cstdio>
 
@@ -59,12 +60,12 @@
 	}
 
 void CallQueue::_add_page() {
-	if (pages_used == page_bytes.size()) {
+	if (pages_used.get() == page_bytes.size()) {
 		pages.push_back(allocator->alloc());
 		page_bytes.push_back(0);
 	}
-	page_bytes[pages_used] = 0;
-	pages_used++;
+	page_bytes[pages_used.get()] = 0;
+	pages_used.increment();
 }
 
 Error CallQueue::push_callp(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
@@ -83,17 +84,220 @@ Error CallQueue::push_set(Object *p_object, const StringName &p_prop, const Vari
 	return push_set(p_object->get_instance_id(), p_prop, p_value);
 }
 
+void CallQueue::_write_call(uint8_t *p_buffer, const Callable &p_callable, const Variant **p_args, int p_argcount, bool p_show_error) {
+	Message *msg = memnew_placement(p_buffer, Message);
+	msg->args = p_argcount;
+	msg->callable = p_callable;
+	msg->type = TYPE_CALL;
+	if (p_show_error) {
+		msg->type |= FLAG_SHOW_ERROR;
+	}
+	// Support callables of static methods.
+	if (p_callable.get_object_id().is_null() && p_callable.is_valid()) {
+		msg->type |= FLAG_NULL_IS_OK;
+	}
+
+	uint8_t *buffer_end = p_buffer + sizeof(Message);
+
+	for (int i = 0; i < p_argcount; i++) {
+		Variant *v = memnew_placement(buffer_end, Variant);
+		buffer_end += sizeof(Variant);
+		*v = *p_args[i];
+	}
+}
+
+void CallQueue::_write_set(uint8_t *p_buffer, ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
+	Message *msg = memnew_placement(p_buffer, Message);
+	msg->args = 1;
+	msg->callable = Callable(p_id, p_prop);
+	msg->type = TYPE_SET;
+
+	Variant *v = memnew_placement(p_buffer + sizeof(Message), Variant);
+	*v = p_value;
+}
+
+void CallQueue::_write_notification(uint8_t *p_buffer, ObjectID p_id, int p_notification) {
+	Message *msg = memnew_placement(p_buffer, Message);
+
+	msg->type = TYPE_NOTIFICATION;
+	msg->callable = Callable(p_id, CoreStringName(notification)); //name is meaningless but callable needs it
+	//msg->target;
+	msg->notification = p_notification;
+}
+
+static thread_local struct CallQueueThreadBufferHolder {
+	CallQueue *queue = nullptr;
+	void *buffer = nullptr;
+	void (*release_func)(void *) = nullptr;
+
+	~CallQueueThreadBufferHolder() {
+		if (buffer) {
+			release_func(buffer);
+		}
+	}
+} call_queue_thread_buffer;
+
+bool CallQueue::_use_thread_buffer() const {
+	return use_thread_buffers && !Thread::is_main_thread();
+}
+
+CallQueue::ThreadBuffer *CallQueue::_get_thread_buffer() {
+	CallQueueThreadBufferHolder &holder = call_queue_thread_buffer;
+	if (likely(holder.queue == this && ((ThreadBuffer *)holder.buffer)->owner == this)) {
+		return (ThreadBuffer *)holder.buffer;
+	}
+
+	if (holder.buffer) {
+		holder.release_func(holder.buffer);
+	}
+
+	ThreadBuffer *buffer = memnew(ThreadBuffer);
+	buffer->owner = this;
+	buffer->refcount.init(2);
+
+	mutex.lock();
+	thread_buffers.push_back(buffer);
+	mutex.unlock();
+
+	holder.queue = this;
+	holder.buffer = buffer;
+	// Called on thread exit. If the queue is gone already, the thread frees the buffer,
+	// otherwise the queue does once the buffer has been flushed.
+	holder.release_func = [](void *p_buffer) {
+		ThreadBuffer *tb = (ThreadBuffer *)p_buffer;
+		if (tb->refcount.unref()) {
+			memdelete(tb);
+		}
+	};
+	return buffer;
+}
+
+uint8_t *CallQueue::_thread_buffer_alloc(ThreadBuffer *p_buffer, uint32_t p_room_needed) {
+	// Must be called with the buffer mutex held.
+	if (p_buffer->pages_used == 0 || (p_buffer->page_bytes[p_buffer->pages_used - 1] + p_room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+		// Pages held by producer threads count against the same limit as the main list.
+		if (thread_pages_used.get() + pages_used.get() >= max_pages) {
+			return nullptr;
+		}
+		thread_pages_used.increment();
+		if (p_buffer->pages_used == p_buffer->pages.size()) {
+			p_buffer->pages.push_back(allocator->alloc());
+			p_buffer->page_bytes.push_back(0);
+		}
+		p_buffer->page_bytes[p_buffer->pages_used] = 0;
+		p_buffer->pages_used++;
+	}
+
+	uint32_t page_index = p_buffer->pages_used - 1;
+	uint8_t *buffer_end = &p_buffer->pages[page_index]->data[p_buffer->page_bytes[page_index]];
+	p_buffer->page_bytes[page_index] += p_room_needed;
+	return buffer_end;
+}
+
+void CallQueue::_merge_thread_buffers() {
+	// Must be called with the queue mutex held.
+	for (uint32_t b = 0; b < thread_buffers.size(); b++) {
+		ThreadBuffer *tb = thread_buffers[b];
+		tb->mutex.lock();
+
+		if (tb->pages_used > 0) {
+			_ensure_first_page();
+		}
+
+		for (uint32_t i = 0; i < tb->pages_used; i++) {
+			// Swap the filled page into the main list, giving a spare page (if any) back to the thread.
+			uint32_t dst;
+			if (page_bytes[pages_used.get() - 1] == 0) {
+				dst = pages_used.get() - 1;
+			} else {
+				dst = pages_used.get();
+				if (pages_used.get() == pages.size()) {
+					pages.push_back(nullptr);
+					page_bytes.push_back(0);
+				}
+				pages_used.increment();
+			}
+			Page *spare = pages[dst];
+			pages[dst] = tb->pages[i];
+			page_bytes[dst] = tb->page_bytes[i];
+			tb->pages[i] = spare;
+			tb->page_bytes[i] = 0;
+		}
+
+		if (tb->pages_used > 0) {
+			thread_pages_used.sub(tb->pages_used);
+			tb->pages_used = 0;
+			// Drop the slots left empty by pages the main list had no spare for.
+			uint32_t kept = 0;
+			for (uint32_t i = 0; i < tb->pages.size(); i++) {
+				if (tb->pages[i]) {
+					tb->pages[kept++] = tb->pages[i];
+				}
+			}
+			tb->pages.resize(kept);
+			tb->page_bytes.resize(kept);
+		}
+
+		bool thread_exited = tb->refcount.get() == 1;
+		tb->mutex.unlock();
+
+		if (thread_exited) {
+			// Nothing else can push to it anymore.
+			for (Page *page : tb->pages) {
+				allocator->free(page);
+			}
+			tb->refcount.unref();
+			memdelete(tb);
+			thread_buffers.remove_at_unordered(b);
+			b--;
+		}
+	}
+}
+
+void CallQueue::_free_thread_buffers() {
+	// Must be called with the queue mutex held, and thread buffers already merged.
+	for (ThreadBuffer *tb : thread_buffers) {
+		tb->mutex.lock();
+		for (Page *page : tb->pages) {
+			allocator->free(page);
+		}
+		tb->pages.clear();
+		tb->page_bytes.clear();
+		tb->owner = nullptr;
+		tb->mutex.unlock();
+		if (tb->refcount.unref()) {
+			memdelete(tb);
+		}
+	}
+	thread_buffers.clear();
+}
+
 Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_args, int p_argcount, bool p_show_error) {
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
 
 	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
 
+	if (_use_thread_buffer()) {
+		ThreadBuffer *tb = _get_thread_buffer();
+		tb->mutex.lock();
+		uint8_t *buffer_end = _thread_buffer_alloc(tb, room_needed);
+		if (likely(buffer_end)) {
+			_write_call(buffer_end, p_callable, p_args, p_argcount, p_show_error);
+		}
+		tb->mutex.unlock();
+		if (unlikely(!buffer_end)) {
+			fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
+			return ERR_OUT_OF_MEMORY;
+		}
+		return OK;
+	}
+
 	LOCK_MUTEX;
 
 	_ensure_first_page();
 
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
+	if ((page_bytes[pages_used.get() - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+		if (pages_used.get() >= max_pages) {
 			fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
 			statistics();
 			UNLOCK_MUTEX;
@@ -102,31 +306,14 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 		_add_page();
 	}
 
-	Page *page = pages[pages_used - 1];
-
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
-	Message *msg = memnew_placement(buffer_end, Message);
-	msg->args = p_argcount;
-	msg->callable = p_callable;
-	msg->type = TYPE_CALL;
-	if (p_show_error) {
-		msg->type |= FLAG_SHOW_ERROR;
-	}
-	// Support callables of static methods.
-	if (p_callable.get_object_id().is_null() && p_callable.is_valid()) {
-		msg->type |= FLAG_NULL_IS_OK;
-	}
+	const uint32_t page_index = pages_used.get() - 1;
+	Page *page = pages[page_index];
 
-	buffer_end += sizeof(Message);
+	uint8_t *buffer_end = &page->data[page_bytes[page_index]];
 
-	for (int i = 0; i < p_argcount; i++) {
-		Variant *v = memnew_placement(buffer_end, Variant);
-		buffer_end += sizeof(Variant);
-		*v = *p_args[i];
-	}
+	_write_call(buffer_end, p_callable, p_args, p_argcount, p_show_error);
 
-	page_bytes[pages_used - 1] += room_needed;
+	page_bytes[page_index] += room_needed;
 
 	UNLOCK_MUTEX;
 
@@ -134,13 +321,29 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 }
 
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
+	if (_use_thread_buffer()) {
+		ThreadBuffer *tb = _get_thread_buffer();
+		tb->mutex.lock();
+		uint8_t *buffer_end = _thread_buffer_alloc(tb, room_needed);
+		if (likely(buffer_end)) {
+			_write_set(buffer_end, p_id, p_prop, p_value);
+		}
+		tb->mutex.unlock();
+		if (unlikely(!buffer_end)) {
+			fprintf(stderr, "Failed set: %s target ID: %s. Message queue out of memory. %s\n", String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+			return ERR_OUT_OF_MEMORY;
+		}
+		return OK;
+	}
+
+	LOCK_MUTEX;
+
 	_ensure_first_page();
 
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
+	if ((page_bytes[pages_used.get() - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+		if (pages_used.get() >= max_pages) {
 			String type;
 			if (ObjectDB::get_instance(p_id)) {
 				type = ObjectDB::get_instance(p_id)->get_class();
@@ -154,20 +357,13 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 		_add_page();
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
-	Message *msg = memnew_placement(buffer_end, Message);
-	msg->args = 1;
-	msg->callable = Callable(p_id, p_prop);
-	msg->type = TYPE_SET;
-
-	buffer_end += sizeof(Message);
+	const uint32_t page_index = pages_used.get() - 1;
+	Page *page = pages[page_index];
+	uint8_t *buffer_end = &page->data[page_bytes[page_index]];
 
-	Variant *v = memnew_placement(buffer_end, Variant);
-	*v = p_value;
+	_write_set(buffer_end, p_id, p_prop, p_value);
 
-	page_bytes[pages_used - 1] += room_needed;
+	page_bytes[page_index] += room_needed;
 	UNLOCK_MUTEX;
 
 	return OK;
@@ -175,13 +371,29 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 
 Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message);
 
+	if (_use_thread_buffer()) {
+		ThreadBuffer *tb = _get_thread_buffer();
+		tb->mutex.lock();
+		uint8_t *buffer_end = _thread_buffer_alloc(tb, room_needed);
+		if (likely(buffer_end)) {
+			_write_notification(buffer_end, p_id, p_notification);
+		}
+		tb->mutex.unlock();
+		if (unlikely(!buffer_end)) {
+			fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+			return ERR_OUT_OF_MEMORY;
+		}
+		return OK;
+	}
+
+	LOCK_MUTEX;
+
 	_ensure_first_page();
 
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
+	if ((page_bytes[pages_used.get() - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+		if (pages_used.get() >= max_pages) {
 			fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
 			statistics();
 			UNLOCK_MUTEX;
@@ -190,17 +402,13 @@ Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 		_add_page();
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
+	const uint32_t page_index = pages_used.get() - 1;
+	Page *page = pages[page_index];
+	uint8_t *buffer_end = &page->data[page_bytes[page_index]];
 
-	Message *msg = memnew_placement(buffer_end, Message);
+	_write_notification(buffer_end, p_id, p_notification);
 
-	msg->type = TYPE_NOTIFICATION;
-	msg->callable = Callable(p_id, CoreStringName(notification)); //name is meaningless but callable needs it
-	//msg->target;
-	msg->notification = p_notification;
-
-	page_bytes[pages_used - 1] += room_needed;
+	page_bytes[page_index] += room_needed;
 	UNLOCK_MUTEX;
 
 	return OK;
@@ -226,15 +434,19 @@ void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args
 Error CallQueue::flush() {
 	LOCK_MUTEX;
 
-	if (pages.is_empty()) {
-		// Never allocated
+	if (flushing) {
 		UNLOCK_MUTEX;
-		return OK; // Do nothing.
+		return ERR_BUSY;
 	}
 
-	if (flushing) {
+	if (thread_pages_used.get() > 0) {
+		_merge_thread_buffers();
+	}
+
+	if (pages.is_empty()) {
+		// Never allocated
 		UNLOCK_MUTEX;
-		return ERR_BUSY;
+		return OK; // Do nothing.
 	}
 
 	flushing = true;
@@ -242,7 +454,18 @@ Error CallQueue::flush() {
 	uint32_t i = 0;
 	uint32_t offset = 0;
 
-	while (i < pages_used && offset < page_bytes[i]) {
+	while (true) {
+		if (!(i < pages_used.get() && offset < page_bytes[i])) {
+			// Pick up what other threads pushed in the meantime, after everything already in the list.
+			if (thread_pages_used.get() == 0) {
+				break;
+			}
+			_merge_thread_buffers();
+			if (!(i < pages_used.get() && offset < page_bytes[i])) {
+				break;
+			}
+		}
+
 		Page *page = pages[i];
 
 		//lock on each iteration, so a call can re-add itself to the message queue
@@ -298,7 +521,7 @@ Error CallQueue::flush() {
 	}
 
 	page_bytes[0] = 0;
-	pages_used = 1;
+	pages_used.set(1);
 
 	flushing = false;
 	UNLOCK_MUTEX;
@@ -308,12 +531,16 @@ Error CallQueue::flush() {
 void CallQueue::clear() {
 	LOCK_MUTEX;
 
+	if (thread_pages_used.get() > 0) {
+		_merge_thread_buffers();
+	}
+
 	if (pages.is_empty()) {
 		UNLOCK_MUTEX;
 		return; // Nothing to clear.
 	}
 
-	for (uint32_t i = 0; i < pages_used; i++) {
+	for (uint32_t i = 0; i < pages_used.get(); i++) {
 		uint32_t offset = 0;
 		while (offset < page_bytes[i]) {
 			Page *page = pages[i];
@@ -340,7 +567,7 @@ void CallQueue::clear() {
 		}
 	}
 
-	pages_used = 1;
+	pages_used.set(1);
 	page_bytes[0] = 0;
 
 	UNLOCK_MUTEX;
@@ -353,7 +580,7 @@ void CallQueue::statistics() {
 	HashMap<Callable, int> call_count;
 	int null_count = 0;
 
-	for (uint32_t i = 0; i < pages_used; i++) {
+	for (uint32_t i = 0; i < pages_used.get(); i++) {
 		uint32_t offset = 0;
 		while (offset < page_bytes[i]) {
 			Page *page = pages[i];
@@ -423,7 +650,7 @@ void CallQueue::statistics() {
 		}
 	}
 
-	fprintf(stdout, "TOTAL PAGES: %d (%d bytes).\n", pages_used, pages_used * PAGE_SIZE_BYTES);
+	fprintf(stdout, "TOTAL PAGES: %d (%d bytes).\n", pages_used.get(), pages_used.get() * PAGE_SIZE_BYTES);
 	fprintf(stdout, "NULL count: %d.\n", null_count);
 
 	for (const KeyValue<StringName, int> &E : set_count) {
@@ -446,10 +673,13 @@ bool CallQueue::is_flushing() const {
 }
 
 bool CallQueue::has_messages() const {
-	if (pages_used == 0) {
+	if (thread_pages_used.get() > 0) {
+		return true;
+	}
+	if (pages_used.get() == 0) {
 		return false;
 	}
-	if (pages_used == 1 && page_bytes[0] == 0) {
+	if (pages_used.get() == 1 && page_bytes[0] == 0) {
 		return false;
 	}
 
@@ -474,6 +704,9 @@ CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const
 
 CallQueue::~CallQueue() {
 	clear();
+	mutex.lock();
+	_free_thread_buffers();
+	mutex.unlock();
 	// Let go of pages.
 	for (uint32_t i = 0; i < pages.size(); i++) {
 		allocator->free(pages[i]);
@@ -509,6 +742,8 @@ MessageQueue::MessageQueue() :
 				"Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_mb' in project settings.") {
 	ERR_FAIL_COND_MSG(main_singleton != nullptr, "A MessageQueue singleton already exists.");
 	main_singleton = this;
+	// Deferred calls from worker threads go to per-thread buffers, merged when the main thread flushes.
+	use_thread_buffers = true;
 }
 
 MessageQueue::~MessageQueue() {
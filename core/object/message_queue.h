@@ -34,6 +34,7 @@
 #include "core/os/thread_safe.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 
 class Object;
@@ -73,7 +74,7 @@ private:
 	LocalVector<Page *> pages;
 	LocalVector<uint32_t> page_bytes;
 	uint32_t max_pages = 0;
-	uint32_t pages_used = 0;
+	SafeNumeric<uint32_t> pages_used; // Also read by producer threads, to check the page limit.
 	bool flushing = false;
 
 #ifdef DEV_ENABLED
@@ -93,12 +94,38 @@ private:
 		if (unlikely(pages.is_empty())) {
 			pages.push_back(allocator->alloc());
 			page_bytes.push_back(0);
-			pages_used = 1;
+			pages_used.set(1);
 		}
 	}
 
 	void _add_page();
 
+	// Producer buffers for threads other than the main one, only used by the main message queue.
+	// Each thread appends to its own pages, which are moved to the main list when flushing,
+	// so pushes from many threads don't contend on `mutex`, and per-thread order is kept.
+	struct ThreadBuffer {
+		BinaryMutex mutex;
+		LocalVector<Page *> pages;
+		LocalVector<uint32_t> page_bytes;
+		uint32_t pages_used = 0;
+		CallQueue *owner = nullptr;
+		SafeRefCount refcount; // One reference for the queue, one for the producer thread.
+	};
+
+	bool use_thread_buffers = false;
+	LocalVector<ThreadBuffer *> thread_buffers; // Guarded by `mutex`.
+	SafeNumeric<uint32_t> thread_pages_used;
+
+	bool _use_thread_buffer() const;
+	ThreadBuffer *_get_thread_buffer();
+	uint8_t *_thread_buffer_alloc(ThreadBuffer *p_buffer, uint32_t p_room_needed);
+	void _merge_thread_buffers();
+	void _free_thread_buffers();
+
+	static void _write_call(uint8_t *p_buffer, const Callable &p_callable, const Variant **p_args, int p_argcount, bool p_show_error);
+	static void _write_set(uint8_t *p_buffer, ObjectID p_id, const StringName &p_prop, const Variant &p_value);
+	static void _write_notification(uint8_t *p_buffer, ObjectID p_id, int p_notification);
+
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
 
 	String error_text;
@@ -2548,9 +2548,11 @@ void postinitialize_handler(Object *p_object) {
 void ObjectDB::debug_objects(DebugFunc p_func, void *p_user_data) {
 	spin_lock.lock();
 
-	for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-		if (object_slots[i].validator) {
-			p_func(object_slots[i].object, p_user_data);
+	uint32_t max = slot_max.load(std::memory_order_acquire);
+	for (uint32_t i = 0, count = slot_count.get(); i < max && count != 0; i++) {
+		ObjectSlot &object_slot = _get_slot(i);
+		if (object_slot.validator.load(std::memory_order_acquire)) {
+			p_func(object_slot.object.load(std::memory_order_acquire), p_user_data);
 			count--;
 		}
 	}
@@ -2604,45 +2606,97 @@ void Object::get_argument_options(const StringName &p_function, int p_idx, List<
 #endif
 
 SpinLock ObjectDB::spin_lock;
-uint32_t ObjectDB::slot_count = 0;
-uint32_t ObjectDB::slot_max = 0;
-ObjectDB::ObjectSlot *ObjectDB::object_slots = nullptr;
-uint64_t ObjectDB::validator_counter = 0;
+SafeNumeric<uint32_t> ObjectDB::slot_count;
+std::atomic<uint32_t> ObjectDB::slot_max = 0;
+std::atomic<ObjectDB::ObjectSlot *> ObjectDB::object_slot_pages[OBJECTDB_SLOT_PAGE_MAX_COUNT] = {};
+uint32_t ObjectDB::free_slot_head = 0;
+uint32_t ObjectDB::free_slot_count = 0;
+SafeNumeric<uint64_t> ObjectDB::validator_counter;
+bool ObjectDB::active = true;
+thread_local ObjectDB::SlotCache ObjectDB::slot_cache;
+
+ObjectDB::SlotCache::~SlotCache() {
+	// Give cached slots back so other threads can reuse them.
+	if (count > 0) {
+		_flush_slot_cache(*this, 0);
+	}
+}
 
 int ObjectDB::get_object_count() {
-	return slot_count;
+	return slot_count.get();
 }
 
-ObjectID ObjectDB::add_instance(Object *p_object) {
+void ObjectDB::_refill_slot_cache(SlotCache &p_cache) {
 	spin_lock.lock();
-	if (unlikely(slot_count == slot_max)) {
-		CRASH_COND(slot_count == (1 << OBJECTDB_SLOT_MAX_COUNT_BITS));
+	uint32_t wanted = OBJECTDB_SLOT_CACHE_SIZE / 2;
+	if (unlikely(free_slot_count < wanted)) {
+		// Add a new page. Existing pages never move, so lookups don't need the lock.
+		uint32_t max = slot_max.load(std::memory_order_relaxed);
+		CRASH_COND(max == (1 << OBJECTDB_SLOT_MAX_COUNT_BITS));
+
+		ObjectSlot *page = (ObjectSlot *)memalloc(sizeof(ObjectSlot) * OBJECTDB_SLOT_PAGE_SIZE);
+		for (uint32_t i = 0; i < OBJECTDB_SLOT_PAGE_SIZE; i++) {
+			memnew_placement(&page[i], ObjectSlot);
+			page[i].validator.store(0, std::memory_order_relaxed);
+			page[i].object.store(nullptr, std::memory_order_relaxed);
+			page[i].is_ref_counted = false;
+		}
+		// Link the new slots in ascending order in front of the remaining free ones.
+		for (uint32_t i = 0; i < OBJECTDB_SLOT_PAGE_SIZE; i++) {
+			page[i].next_free = i + 1 < OBJECTDB_SLOT_PAGE_SIZE ? max + i + 1 : free_slot_head;
+		}
+		object_slot_pages[max >> OBJECTDB_SLOT_PAGE_BITS].store(page, std::memory_order_release);
+		slot_max.store(max + OBJECTDB_SLOT_PAGE_SIZE, std::memory_order_release);
+		free_slot_head = max;
+		free_slot_count += OBJECTDB_SLOT_PAGE_SIZE;
+	}
+
+	while (p_cache.count < wanted) {
+		uint32_t slot = free_slot_head;
+		free_slot_head = _get_slot(slot).next_free;
+		free_slot_count--;
+		// The cache is a stack, so store in reverse to hand out the lowest slots first.
+		p_cache.slots[wanted - 1 - p_cache.count] = slot;
+		p_cache.count++;
+	}
+	spin_lock.unlock();
+}
 
-		uint32_t new_slot_max = slot_max > 0 ? slot_max * 2 : 1;
-		object_slots = (ObjectSlot *)memrealloc(object_slots, sizeof(ObjectSlot) * new_slot_max);
-		for (uint32_t i = slot_max; i < new_slot_max; i++) {
-			object_slots[i].object = nullptr;
-			object_slots[i].is_ref_counted = false;
-			object_slots[i].next_free = i;
-			object_slots[i].validator = 0;
+void ObjectDB::_flush_slot_cache(SlotCache &p_cache, uint32_t p_keep) {
+	spin_lock.lock();
+	if (likely(active)) {
+		while (p_cache.count > p_keep) {
+			uint32_t slot = p_cache.slots[--p_cache.count];
+			_get_slot(slot).next_free = free_slot_head;
+			free_slot_head = slot;
+			free_slot_count++;
 		}
-		slot_max = new_slot_max;
 	}
+	p_cache.count = p_keep;
+	spin_lock.unlock();
+}
 
-	uint32_t slot = object_slots[slot_count].next_free;
-	if (object_slots[slot].object != nullptr) {
-		spin_lock.unlock();
-		ERR_FAIL_COND_V(object_slots[slot].object != nullptr, ObjectID());
+ObjectID ObjectDB::add_instance(Object *p_object) {
+	SlotCache &cache = slot_cache;
+	if (unlikely(cache.count == 0)) {
+		_refill_slot_cache(cache);
 	}
-	object_slots[slot].object = p_object;
-	object_slots[slot].is_ref_counted = p_object->is_ref_counted();
-	validator_counter = (validator_counter + 1) & OBJECTDB_VALIDATOR_MASK;
-	if (unlikely(validator_counter == 0)) {
-		validator_counter = 1;
+
+	uint32_t slot = cache.slots[--cache.count];
+	ObjectSlot &object_slot = _get_slot(slot);
+	ERR_FAIL_COND_V(object_slot.object.load(std::memory_order_relaxed) != nullptr, ObjectID());
+
+	uint64_t validator = validator_counter.increment() & OBJECTDB_VALIDATOR_MASK;
+	if (unlikely(validator == 0)) {
+		validator = validator_counter.increment() & OBJECTDB_VALIDATOR_MASK;
 	}
-	object_slots[slot].validator = validator_counter;
 
-	uint64_t id = validator_counter;
+	object_slot.is_ref_counted = p_object->is_ref_counted();
+	object_slot.object.store(p_object, std::memory_order_release);
+	// Publish last, lookups treat the slot as valid as soon as the validator matches.
+	object_slot.validator.store(validator, std::memory_order_release);
+
+	uint64_t id = validator;
 	id <<= OBJECTDB_SLOT_MAX_COUNT_BITS;
 	id |= uint64_t(slot);
 
@@ -2650,59 +2704,51 @@ ObjectID ObjectDB::add_instance(Object *p_object) {
 		id |= OBJECTDB_REFERENCE_BIT;
 	}
 
-	slot_count++;
-
-	spin_lock.unlock();
+	slot_count.increment();
 
 	return ObjectID(id);
 }
 
 void ObjectDB::remove_instance(Object *p_object) {
-	if (object_slots == nullptr) {
+	if (unlikely(!active)) {
 		return;
 	}
 	uint64_t t = p_object->get_instance_id();
 	uint32_t slot = t & OBJECTDB_SLOT_MAX_COUNT_MASK; //slot is always valid on valid object
-
-	spin_lock.lock();
-	if (object_slots == nullptr) {
-		return;
-	}
+	ObjectSlot &object_slot = _get_slot(slot);
 
 #ifdef DEBUG_ENABLED
-	if (object_slots[slot].object != p_object) {
-		spin_lock.unlock();
-		ERR_FAIL_COND(object_slots[slot].object != p_object);
-	}
+	ERR_FAIL_COND(object_slot.object.load(std::memory_order_acquire) != p_object);
 	{
 		uint64_t validator = (t >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
-		if (object_slots[slot].validator != validator) {
-			spin_lock.unlock();
-			ERR_FAIL_COND(object_slots[slot].validator != validator);
-		}
+		ERR_FAIL_COND(object_slot.validator.load(std::memory_order_acquire) != validator);
 	}
-
 #endif
-	//decrease slot count
-	slot_count--;
-	//set the free slot properly
-	object_slots[slot_count].next_free = slot;
+
+	// Clear the object before the validator, so a lookup can never pair a stale object with a valid check.
+	object_slot.object.store(nullptr, std::memory_order_release);
 	//invalidate, so checks against it fail
-	object_slots[slot].validator = 0;
-	object_slots[slot].is_ref_counted = false;
-	object_slots[slot].object = nullptr;
+	object_slot.validator.store(0, std::memory_order_release);
+	object_slot.is_ref_counted = false;
 
-	spin_lock.unlock();
+	slot_count.decrement();
+
+	SlotCache &cache = slot_cache;
+	if (unlikely(cache.count == OBJECTDB_SLOT_CACHE_SIZE)) {
+		_flush_slot_cache(cache, OBJECTDB_SLOT_CACHE_SIZE / 2);
+	}
+	cache.slots[cache.count++] = slot;
 }
 
 void ObjectDB::setup() {
-	//nothing to do now
+	// In case the engine is set up again after a previous cleanup.
+	active = true;
 }
 
 void ObjectDB::cleanup() {
 	spin_lock.lock();
 
-	if (slot_count > 0) {
+	if (slot_count.get() > 0) {
 		WARN_PRINT("ObjectDB instances leaked at exit (run with --verbose for details).");
 		if (OS::get_singleton()->is_stdout_verbose()) {
 			// Ensure calling the native classes because if a leaked instance has a script
@@ -2712,9 +2758,11 @@ void ObjectDB::cleanup() {
 			MethodBind *resource_get_path = ClassDB::get_method("Resource", "get_path");
 			Callable::CallError call_error;
 
-			for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-				if (object_slots[i].validator) {
-					Object *obj = object_slots[i].object;
+			uint32_t max = slot_max.load(std::memory_order_acquire);
+			for (uint32_t i = 0, count = slot_count.get(); i < max && count != 0; i++) {
+				ObjectSlot &object_slot = _get_slot(i);
+				if (object_slot.validator.load(std::memory_order_acquire)) {
+					Object *obj = object_slot.object.load(std::memory_order_acquire);
 
 					String extra_info;
 					if (obj->is_class("Node")) {
@@ -2727,7 +2775,7 @@ void ObjectDB::cleanup() {
 						extra_info = " - Reference count: " + itos((static_cast<RefCounted *>(obj))->get_reference_count());
 					}
 
-					uint64_t id = uint64_t(i) | (uint64_t(object_slots[i].validator) << OBJECTDB_SLOT_MAX_COUNT_BITS) | (object_slots[i].is_ref_counted ? OBJECTDB_REFERENCE_BIT : 0);
+					uint64_t id = uint64_t(i) | (object_slot.validator.load(std::memory_order_acquire) << OBJECTDB_SLOT_MAX_COUNT_BITS) | (object_slot.is_ref_counted ? OBJECTDB_REFERENCE_BIT : 0);
 					DEV_ASSERT(id == (uint64_t)obj->get_instance_id()); // We could just use the id from the object, but this check may help catching memory corruption catastrophes.
 					print_line("Leaked instance: " + String(obj->get_class()) + ":" + uitos(id) + extra_info);
 
@@ -2738,10 +2786,17 @@ void ObjectDB::cleanup() {
 		}
 	}
 
-	if (object_slots) {
-		memfree(object_slots);
-		object_slots = nullptr;
+	// Objects freed after this point (and thread slot caches flushed at exit) must not touch the pages.
+	active = false;
+	slot_cache.count = 0;
+	uint32_t max = slot_max.load(std::memory_order_relaxed);
+	for (uint32_t i = 0; i < max; i += OBJECTDB_SLOT_PAGE_SIZE) {
+		memfree(object_slot_pages[i >> OBJECTDB_SLOT_PAGE_BITS].load(std::memory_order_relaxed));
+		object_slot_pages[i >> OBJECTDB_SLOT_PAGE_BITS].store(nullptr, std::memory_order_relaxed);
 	}
+	slot_max.store(0, std::memory_order_release);
+	free_slot_head = 0;
+	free_slot_count = 0;
 
 	spin_lock.unlock();
 }
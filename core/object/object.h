@@ -1224,18 +1224,38 @@ class ObjectDB {
 #define OBJECTDB_SLOT_MAX_COUNT_MASK ((uint64_t(1) << OBJECTDB_SLOT_MAX_COUNT_BITS) - 1)
 #define OBJECTDB_REFERENCE_BIT (uint64_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS + OBJECTDB_VALIDATOR_BITS))
 
-	struct ObjectSlot { // 128 bits per slot.
-		uint64_t validator : OBJECTDB_VALIDATOR_BITS;
-		uint64_t next_free : OBJECTDB_SLOT_MAX_COUNT_BITS;
-		uint64_t is_ref_counted : 1;
-		Object *object = nullptr;
+	// Slots live in fixed-size pages that are never moved or freed until cleanup,
+	// so lookups can read them without locking while other threads allocate.
+#define OBJECTDB_SLOT_PAGE_BITS 12
+#define OBJECTDB_SLOT_PAGE_SIZE (uint32_t(1) << OBJECTDB_SLOT_PAGE_BITS)
+#define OBJECTDB_SLOT_PAGE_MASK (OBJECTDB_SLOT_PAGE_SIZE - 1)
+#define OBJECTDB_SLOT_PAGE_MAX_COUNT (uint32_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS - OBJECTDB_SLOT_PAGE_BITS))
+
+	struct ObjectSlot {
+		std::atomic<uint64_t> validator; // Zero when the slot is free.
+		std::atomic<Object *> object;
+		uint32_t next_free : OBJECTDB_SLOT_MAX_COUNT_BITS; // Only used while in the global free list.
+		uint32_t is_ref_counted : 1;
 	};
 
+	// Slots are handed to threads in batches, and freed slots are kept in a small per-thread cache,
+	// so the spin lock is only taken once every few dozen allocations.
+#define OBJECTDB_SLOT_CACHE_SIZE 64
+	struct SlotCache {
+		uint32_t slots[OBJECTDB_SLOT_CACHE_SIZE];
+		uint32_t count = 0;
+		~SlotCache();
+	};
+	static thread_local SlotCache slot_cache;
+
 	static SpinLock spin_lock;
-	static uint32_t slot_count;
-	static uint32_t slot_max;
-	static ObjectSlot *object_slots;
-	static uint64_t validator_counter;
+	static SafeNumeric<uint32_t> slot_count;
+	static std::atomic<uint32_t> slot_max;
+	static std::atomic<ObjectSlot *> object_slot_pages[OBJECTDB_SLOT_PAGE_MAX_COUNT];
+	static uint32_t free_slot_head; // Guarded by spin_lock.
+	static uint32_t free_slot_count; // Guarded by spin_lock.
+	static SafeNumeric<uint64_t> validator_counter;
+	static bool active;
 
 	friend class Object;
 	friend void unregister_core_types();
@@ -1244,6 +1264,13 @@ class ObjectDB {
 	static ObjectID add_instance(Object *p_object);
 	static void remove_instance(Object *p_object);
 
+	static void _refill_slot_cache(SlotCache &p_cache);
+	static void _flush_slot_cache(SlotCache &p_cache, uint32_t p_keep);
+
+	_ALWAYS_INLINE_ static ObjectSlot &_get_slot(uint32_t p_slot) {
+		return object_slot_pages[p_slot >> OBJECTDB_SLOT_PAGE_BITS].load(std::memory_order_acquire)[p_slot & OBJECTDB_SLOT_PAGE_MASK];
+	}
+
 	friend void register_core_types();
 	static void setup();
 
@@ -1254,22 +1281,24 @@ public:
 		uint64_t id = p_instance_id;
 		uint32_t slot = id & OBJECTDB_SLOT_MAX_COUNT_MASK;
 
-		if (slot >= slot_max) { // This should never happen unless RID is corrupted.
+		if (slot >= slot_max.load(std::memory_order_acquire)) { // This should never happen unless RID is corrupted.
 			return nullptr;
 		}
 
-		spin_lock.lock();
-
 		uint64_t validator = (id >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
+		ObjectSlot &object_slot = _get_slot(slot);
 
-		if (unlikely(object_slots[slot].validator != validator)) {
-			spin_lock.unlock();
+		if (unlikely(object_slot.validator.load(std::memory_order_acquire) != validator)) {
 			return nullptr;
 		}
 
-		Object *object = object_slots[slot].object;
+		Object *object = object_slot.object.load(std::memory_order_acquire);
 
-		spin_lock.unlock();
+		// The slot may have been freed and reused between both loads. The validator is
+		// always published after the object, so checking it again catches that case.
+		if (unlikely(object_slot.validator.load(std::memory_order_acquire) != validator)) {
+			return nullptr;
+		}
 
 		return object;
 	}
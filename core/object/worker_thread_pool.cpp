@@ -30,11 +30,13 @@
 
 #include "worker_thread_pool.h"
 
+#include "core/io/file_access.h"
 #include "core/object/message_queue.h"
 #include "core/object/script_language.h"
 #include "core/os/os.h"
 #include "core/os/safe_binary_mutex.h"
 #include "core/os/thread_safe.h"
+#include "core/templates/sort_array.h"
 
 WorkerThreadPool::Task *const WorkerThreadPool::ThreadData::YIELDING = (Task *)1;
 
@@ -73,15 +75,12 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		// about to be run uses scripting, guarantees are held.
 		ScriptServer::thread_enter();
 
-		task_mutex.lock();
-		p_task->pool_thread_index = pool_thread_index;
-		prev_task = curr_thread.current_task;
-		curr_thread.current_task = p_task;
+		// Only this thread's data and the task are written, so this doesn't need the lock.
+		// A yield-over notified before this is kept in the task's pending flag, which yield() checks.
+		p_task->pool_thread_index.set(pool_thread_index);
+		prev_task = curr_thread.current_task.load();
+		curr_thread.current_task.store(p_task);
 		curr_thread.has_pump_task = p_task->is_pump_task;
-		if (p_task->pending_notify_yield_over) {
-			curr_thread.yield_is_over = true;
-		}
-		task_mutex.unlock();
 	}
 #endif
 
@@ -136,6 +135,9 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 
 		task_mutex.lock();
 		task_allocator.free(p_task);
+#ifdef THREADS_ENABLED
+		curr_thread.current_task.store(prev_task);
+#endif
 	} else {
 		if (p_task->native_func) {
 			p_task->native_func(p_task->native_func_userdata);
@@ -146,24 +148,40 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			p_task->callable.call();
 		}
 
-		task_mutex.lock();
-		p_task->completed = true;
-		p_task->pool_thread_index = -1;
-		if (p_task->waiting_user) {
-			p_task->done_semaphore.post(p_task->waiting_user);
+#ifdef THREADS_ENABLED
+		// Restored before completing, since a waiter may free the task as soon as it's completed.
+		curr_thread.current_task.store(prev_task);
+#endif
+		p_task->pool_thread_index.set(-1);
+		// Without waiters, the task must not be touched anymore after this.
+		uint32_t waiters = p_task->complete();
+
+#ifdef THREADS_ENABLED
+		if (waiters == 0 && !low_priority) {
+			// Nobody to wake up and no shared bookkeeping to do, so the lock isn't needed at all.
+			set_current_thread_safe_for_nodes(safe_for_nodes_backup);
+			MessageQueue::set_thread_singleton_override(call_queue_backup);
+			return;
 		}
-		// Let awaiters know.
-		for (uint32_t i = 0; i < threads.size(); i++) {
-			if (threads[i].awaited_task == p_task) {
-				threads[i].cond_var.notify_one();
-				threads[i].signaled = true;
+#endif
+
+		task_mutex.lock();
+		if (waiters) {
+			if (p_task->waiting_user) {
+				p_task->done_semaphore.post(p_task->waiting_user);
+			}
+			// Let awaiters know.
+			for (uint32_t i = 0; i < threads.size(); i++) {
+				if (threads[i].awaited_task == p_task) {
+					threads[i].cond_var.notify_one();
+					threads[i].signaled = true;
+				}
 			}
 		}
 	}
 
 #ifdef THREADS_ENABLED
 	{
-		curr_thread.current_task = prev_task;
 		if (low_priority) {
 			low_priority_threads_used--;
 
@@ -187,8 +205,9 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 	Thread::set_name(vformat("WorkerThread %d", thread_data->index));
 
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		// Fast path: tasks posted by this thread, or by a sibling pool thread, don't need the lock.
+		Task *task_to_process = thread_data->pool->_pop_local_or_steal(thread_data);
+		if (!task_to_process) {
 			// Create the lock outside the inner loop so it isn't needlessly unlocked and relocked
 			//  when no task was found to process, and the loop is re-entered.
 			MutexLock lock(thread_data->pool->task_mutex);
@@ -201,17 +220,22 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 
 				thread_data->signaled = false;
 
-				if (!thread_data->pool->task_queue.first()) {
-					// There wasn't a task available yet.
-					// Let's wait for the next notification, then recheck.
-					thread_data->cond_var.wait(lock);
-					continue;
+				if (thread_data->pool->task_queue.first()) {
+					// Got a task to process! Remove it from the queue, then break into the task handling section.
+					task_to_process = thread_data->pool->task_queue.first()->self();
+					thread_data->pool->task_queue.remove(thread_data->pool->task_queue.first());
+					break;
 				}
 
-				// Got a task to process! Remove it from the queue, then break into the task handling section.
-				task_to_process = thread_data->pool->task_queue.first()->self();
-				thread_data->pool->task_queue.remove(thread_data->pool->task_queue.first());
-				break;
+				task_to_process = thread_data->pool->_pop_before_sleeping(thread_data);
+				if (task_to_process) {
+					break;
+				}
+
+				// There wasn't a task available yet.
+				// Let's wait for the next notification, then recheck.
+				thread_data->cond_var.wait(lock);
+				thread_data->pool->sleeping_threads.decrement();
 			}
 		}
 
@@ -263,6 +287,52 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 	_notify_threads(caller_pool_thread, to_process, to_promote);
 }
 
+// Tasks spawned at high priority from a pool thread go to its own queue, where idle threads can steal them.
+// Pump tasks, external submissions and low priority tasks go through _post_tasks() instead.
+// Must be called with the lock held.
+WorkerThreadPool::ThreadData *WorkerThreadPool::_get_local_post_thread(bool p_high_priority, bool p_pump_task) {
+	if (!p_high_priority || p_pump_task || runlevel != RUNLEVEL_NORMAL) {
+		return nullptr;
+	}
+	HashMap<Thread::ID, int>::Iterator E = thread_ids.find(Thread::get_caller_id());
+	return E ? &threads[E->value] : nullptr;
+}
+
+// Called without the lock, which is only taken for overflow or to wake up sleeping threads.
+void WorkerThreadPool::_post_local_tasks(ThreadData *p_thread_data, Task **p_tasks, uint32_t p_count) {
+	uint32_t pushed = 0;
+	while (pushed < p_count) {
+		p_tasks[pushed]->low_priority = false;
+		if (!p_thread_data->local_queue.push(p_tasks[pushed])) {
+			break;
+		}
+		pushed++;
+	}
+
+	// Pairs with the fence in _pop_before_sleeping(): either the sleeping thread is seen here, or it sees the tasks.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (pushed == p_count && sleeping_threads.get() == 0) {
+		return;
+	}
+
+	MutexLock lock(task_mutex);
+	for (uint32_t i = pushed; i < p_count; i++) {
+		task_queue.add_last(&p_tasks[i]->task_elem);
+	}
+	_notify_threads(p_thread_data, p_count, 0);
+}
+
+// Called with the lock held, right before waiting. On failure, the caller must decrement sleeping_threads once awaken.
+WorkerThreadPool::Task *WorkerThreadPool::_pop_before_sleeping(ThreadData *p_thread_data) {
+	sleeping_threads.increment();
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	Task *task = _pop_local_or_steal(p_thread_data);
+	if (task) {
+		sleeping_threads.decrement();
+	}
+	return task;
+}
+
 void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count) {
 	uint32_t to_process = p_process_count;
 	uint32_t to_promote = p_promote_count;
@@ -287,9 +357,11 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 		if (th.signaled) {
 			continue;
 		}
-		if (th.current_task) {
+		// Tasks are only freed with the lock held, so the task can be read even if the thread is finishing it.
+		const Task *current_task = th.current_task.load();
+		if (current_task) {
 			// Good thread for promoting low-prio?
-			if (to_promote && th.awaited_task && th.current_task->low_priority) {
+			if (to_promote && th.awaited_task && current_task->low_priority) {
 				if (likely(&th != p_current_thread_data)) {
 					th.cond_var.notify_one();
 				}
@@ -327,6 +399,31 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 	}
 }
 
+WorkerThreadPool::Task *WorkerThreadPool::_pop_local_or_steal(ThreadData *p_thread_data) {
+	Task *task = nullptr;
+	if (p_thread_data->local_queue.pop(task)) {
+		return task;
+	}
+
+	uint32_t thread_count = threads.size();
+	for (uint32_t i = 1; i < thread_count; i++) {
+		ThreadData &victim = threads[(p_thread_data->index + i) % thread_count];
+		if (victim.local_queue.steal(task)) {
+			return task;
+		}
+	}
+	return nullptr;
+}
+
+bool WorkerThreadPool::_has_local_tasks() const {
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		if (!threads[i].local_queue.is_empty()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 bool WorkerThreadPool::_try_promote_low_priority_task() {
 	if (low_priority_task_queue.first()) {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
@@ -344,39 +441,50 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *
 }
 
 WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_pump_task) {
-	MutexLock<BinaryMutex> lock(task_mutex);
-
-	// Get a free task
-	Task *task = task_allocator.alloc();
-	TaskID id = last_task++;
-	task->self = id;
-	task->callable = p_callable;
-	task->native_func = p_func;
-	task->native_func_userdata = p_userdata;
-	task->description = p_description;
-	task->template_userdata = p_template_userdata;
-	task->is_pump_task = p_pump_task;
-	tasks.insert(id, task);
+	ThreadData *local_post_thread = nullptr;
+	Task *task = nullptr;
+	TaskID id = INVALID_TASK_ID;
+	{
+		MutexLock<BinaryMutex> lock(task_mutex);
+
+		// Get a free task
+		task = task_allocator.alloc();
+		id = last_task++;
+		task->self = id;
+		task->callable = p_callable;
+		task->native_func = p_func;
+		task->native_func_userdata = p_userdata;
+		task->description = p_description;
+		task->template_userdata = p_template_userdata;
+		task->is_pump_task = p_pump_task;
+		tasks.insert(id, task);
 
 #ifdef THREADS_ENABLED
-	if (p_pump_task) {
-		pump_task_count++;
-		int thread_count = get_thread_count();
-		if (pump_task_count >= thread_count) {
-			print_verbose(vformat("A greater number of dedicated threads were requested (%d) than threads available (%d). Please increase the number of available worker task threads. Recovering this session by spawning more worker task threads.", pump_task_count + 1, thread_count)); // +1 because we want to keep a Thread without any pump tasks free.
-
-			// Re-sizing implies relocation, which is not supported for this array.
-			CRASH_COND_MSG(thread_count + 1 > (int)threads.get_capacity(), "Reserve trick for worker thread pool failed. Crashing.");
-			threads.resize_initialized(thread_count + 1);
-			threads[thread_count].index = thread_count;
-			threads[thread_count].pool = this;
-			threads[thread_count].thread.start(&WorkerThreadPool::_thread_function, &threads[thread_count]);
-			thread_ids.insert(threads[thread_count].thread.get_id(), thread_count);
+		if (p_pump_task) {
+			pump_task_count++;
+			int thread_count = get_thread_count();
+			if (pump_task_count >= thread_count) {
+				print_verbose(vformat("A greater number of dedicated threads were requested (%d) than threads available (%d). Please increase the number of available worker task threads. Recovering this session by spawning more worker task threads.", pump_task_count + 1, thread_count)); // +1 because we want to keep a Thread without any pump tasks free.
+
+				// Re-sizing implies relocation, which is not supported for this array.
+				CRASH_COND_MSG(thread_count + 1 > (int)threads.get_capacity(), "Reserve trick for worker thread pool failed. Crashing.");
+				threads.resize_initialized(thread_count + 1);
+				threads[thread_count].index = thread_count;
+				threads[thread_count].pool = this;
+				threads[thread_count].thread.start(&WorkerThreadPool::_thread_function, &threads[thread_count]);
+				thread_ids.insert(threads[thread_count].thread.get_id(), thread_count);
+			}
 		}
-	}
 #endif
 
-	_post_tasks(&task, 1, p_high_priority, lock, p_pump_task);
+		local_post_thread = _get_local_post_thread(p_high_priority, p_pump_task);
+		if (!local_post_thread) {
+			_post_tasks(&task, 1, p_high_priority, lock, p_pump_task);
+			return id;
+		}
+	}
+
+	_post_local_tasks(local_post_thread, &task, 1);
 
 	return id;
 }
@@ -396,7 +504,7 @@ bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
 		ERR_FAIL_V_MSG(false, "Invalid Task ID"); // Invalid task
 	}
 
-	return (*taskp)->completed;
+	return (*taskp)->is_completed();
 }
 
 Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
@@ -409,7 +517,7 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 	}
 	Task *task = *taskp;
 
-	if (task->completed) {
+	if (task->is_completed()) {
 		if (task->waiting_pool == 0 && task->waiting_user == 0) {
 			tasks.erase(p_task_id);
 			task_allocator.free(task);
@@ -419,7 +527,7 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 	}
 
 	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
-	if (caller_pool_thread && p_task_id <= caller_pool_thread->current_task->self) {
+	if (caller_pool_thread && p_task_id <= caller_pool_thread->current_task.load()->self) {
 		// Deadlock prevention:
 		// When a pool thread wants to wait for an older task, the following situations can happen:
 		// 1. Awaited task is deep in the stack of the awaiter.
@@ -441,6 +549,21 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 		task->waiting_user++;
 	}
 
+	if (task->announce_waiter()) {
+		// Completed in the meantime by a thread that didn't see this waiter, so there's nothing to wait for.
+		if (caller_pool_thread) {
+			task->waiting_pool--;
+		} else {
+			task->waiting_user--;
+		}
+		if (task->waiting_pool == 0 && task->waiting_user == 0) {
+			tasks.erase(p_task_id);
+			task_allocator.free(task);
+		}
+		task_mutex.unlock();
+		return OK;
+	}
+
 	if (caller_pool_thread) {
 		task_mutex.unlock();
 		_wait_collaboratively(caller_pool_thread, task);
@@ -504,12 +627,14 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 
 			bool wait_is_over = false;
 			if (unlikely(p_task == ThreadData::YIELDING)) {
-				if (p_caller_pool_thread->yield_is_over) {
-					p_caller_pool_thread->yield_is_over = false;
+				// The flag is per task, so neither a nested task nor a stale wake-up can end this yield.
+				Task *yielding_task = p_caller_pool_thread->current_task.load();
+				if (yielding_task->pending_notify_yield_over.is_set()) {
+					yielding_task->pending_notify_yield_over.clear();
 					wait_is_over = true;
 				}
 			} else {
-				if (p_task->completed) {
+				if (p_task->is_completed()) {
 					wait_is_over = true;
 				}
 			}
@@ -518,8 +643,8 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
-					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
+					uint32_t to_process = (task_queue.first() || _has_local_tasks()) ? 1 : 0;
+					uint32_t to_promote = p_caller_pool_thread->current_task.load()->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
 						p_caller_pool_thread->signaled = true;
@@ -530,7 +655,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				break;
 			}
 
-			if (p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first()) {
+			if (p_caller_pool_thread->current_task.load()->low_priority && low_priority_task_queue.first()) {
 				if (_try_promote_low_priority_task()) {
 					_notify_threads(p_caller_pool_thread, 1, 0);
 				}
@@ -546,6 +671,10 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 			}
 
+			if (!task_to_process) {
+				task_to_process = _pop_before_sleeping(p_caller_pool_thread);
+			}
+
 			if (!task_to_process) {
 				p_caller_pool_thread->awaited_task = p_task;
 
@@ -555,6 +684,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				relock_unlockables = true;
 
 				p_caller_pool_thread->cond_var.wait(lock);
+				sleeping_threads.decrement();
 
 				p_caller_pool_thread->awaited_task = nullptr;
 			}
@@ -589,7 +719,7 @@ bool WorkerThreadPool::_handle_runlevel(ThreadData *p_thread_data, MutexLock<Bin
 		} break;
 		case RUNLEVEL_PRE_EXIT_LANGUAGES: {
 			if (!p_thread_data->pre_exited_languages) {
-				if (!task_queue.first() && !low_priority_task_queue.first()) {
+				if (!task_queue.first() && !low_priority_task_queue.first() && !_has_local_tasks()) {
 					p_thread_data->pre_exited_languages = true;
 					runlevel_data.pre_exit_languages.num_idle_threads++;
 					control_cond_var.notify_all();
@@ -638,16 +768,15 @@ void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
 		ERR_FAIL_MSG("Invalid Task ID.");
 	}
 	Task *task = *taskp;
-	if (task->pool_thread_index == -1) { // Completed or not started yet.
-		if (!task->completed) {
-			// This avoids a race condition where a task is created and yield-over called before it's processed.
-			task->pending_notify_yield_over = true;
-		}
+	// The flag is checked under the lock by the yielding thread, and kept if the task hasn't started or yielded yet.
+	// Tasks start and end without the lock, so the thread index may be stale: at worst, another thread is woken up for nothing.
+	task->pending_notify_yield_over.set();
+	int pool_thread_index = task->pool_thread_index.get();
+	if (pool_thread_index == -1) { // Completed or not started yet.
 		return;
 	}
 
-	ThreadData &td = threads[task->pool_thread_index];
-	td.yield_is_over = true;
+	ThreadData &td = threads[pool_thread_index];
 	td.signaled = true;
 	td.cond_var.notify_one();
 }
@@ -658,43 +787,53 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 		p_tasks = MAX(1u, threads.size());
 	}
 
-	MutexLock<BinaryMutex> lock(task_mutex);
-
-	Group *group = group_allocator.alloc();
-	GroupID id = last_task++;
-	group->max = p_elements;
-	group->self = id;
-
+	ThreadData *local_post_thread = nullptr;
 	Task **tasks_posted = nullptr;
-	if (p_elements == 0) {
-		// Should really not call it with zero Elements, but at least it should work.
-		group->completed.set_to(true);
-		group->done_semaphore.post();
-		group->tasks_used = 0;
-		p_tasks = 0;
-		if (p_template_userdata) {
-			memdelete(p_template_userdata);
+	GroupID id = INVALID_TASK_ID;
+	{
+		MutexLock<BinaryMutex> lock(task_mutex);
+
+		Group *group = group_allocator.alloc();
+		id = last_task++;
+		group->max = p_elements;
+		group->self = id;
+
+		if (p_elements == 0) {
+			// Should really not call it with zero Elements, but at least it should work.
+			group->completed.set_to(true);
+			group->done_semaphore.post();
+			group->tasks_used = 0;
+			p_tasks = 0;
+			if (p_template_userdata) {
+				memdelete(p_template_userdata);
+			}
+
+		} else {
+			group->tasks_used = p_tasks;
+			tasks_posted = (Task **)alloca(sizeof(Task *) * p_tasks);
+			for (int i = 0; i < p_tasks; i++) {
+				Task *task = task_allocator.alloc();
+				task->native_group_func = p_func;
+				task->native_func_userdata = p_userdata;
+				task->description = p_description;
+				task->group = group;
+				task->callable = p_callable;
+				task->template_userdata = p_template_userdata;
+				tasks_posted[i] = task;
+				// No task ID is used.
+			}
 		}
 
-	} else {
-		group->tasks_used = p_tasks;
-		tasks_posted = (Task **)alloca(sizeof(Task *) * p_tasks);
-		for (int i = 0; i < p_tasks; i++) {
-			Task *task = task_allocator.alloc();
-			task->native_group_func = p_func;
-			task->native_func_userdata = p_userdata;
-			task->description = p_description;
-			task->group = group;
-			task->callable = p_callable;
-			task->template_userdata = p_template_userdata;
-			tasks_posted[i] = task;
-			// No task ID is used.
+		groups[id] = group;
+
+		local_post_thread = p_tasks > 0 ? _get_local_post_thread(p_high_priority, false) : nullptr;
+		if (!local_post_thread) {
+			_post_tasks(tasks_posted, p_tasks, p_high_priority, lock, false);
+			return id;
 		}
 	}
 
-	groups[id] = group;
-
-	_post_tasks(tasks_posted, p_tasks, p_high_priority, lock, false);
+	_post_local_tasks(local_post_thread, tasks_posted, p_tasks);
 
 	return id;
 }
@@ -766,8 +905,9 @@ int WorkerThreadPool::get_thread_index() const {
 
 WorkerThreadPool::TaskID WorkerThreadPool::get_caller_task_id() const {
 	int th_index = get_thread_index();
-	if (th_index != -1 && threads[th_index].current_task) {
-		return threads[th_index].current_task->self;
+	const Task *current_task = th_index != -1 ? threads[th_index].current_task.load() : nullptr;
+	if (current_task) {
+		return current_task->self;
 	} else {
 		return INVALID_TASK_ID;
 	}
@@ -775,8 +915,9 @@ WorkerThreadPool::TaskID WorkerThreadPool::get_caller_task_id() const {
 
 WorkerThreadPool::GroupID WorkerThreadPool::get_caller_group_id() const {
 	int th_index = get_thread_index();
-	if (th_index != -1 && threads[th_index].current_task && threads[th_index].current_task->group) {
-		return threads[th_index].current_task->group->self;
+	const Task *current_task = th_index != -1 ? threads[th_index].current_task.load() : nullptr;
+	if (current_task && current_task->group) {
+		return current_task->group->self;
 	} else {
 		return INVALID_TASK_ID;
 	}
@@ -943,23 +1084,46 @@ void TaskJobHandle::set_task_completed(int count) {
 	}
 }
 void TaskJobHandle::set_completed() {
-	completed.set();
-	// 通知等待的线程
+	LocalVector<Ref<TaskJobHandle>> released;
+	{
+		MutexLock lock(done_mutex);
+		if (completed.is_set()) {
+			// 退出时可能被多个批次重复标记
+			return;
+		}
+		completed.set();
+		released = std::move(dependents);
+		// 通知等待的线程
+		cv.notify_all();
+	}
+	// 由完成任务的线程直接释放依赖已满足的后续任务
+	WorkerTaskPool *pool = WorkerTaskPool::get_singleton();
+	for (const Ref<TaskJobHandle> &dependent : released) {
+		if (dependent->pending_depend_count.decrement() == 0 && pool) {
+			pool->_release_job(dependent);
+		}
+	}
+}
+bool TaskJobHandle::add_dependent(const Ref<TaskJobHandle> &p_dependent) {
 	MutexLock lock(done_mutex);
-	cv.notify_all();
+	if (completed.is_set()) {
+		return false;
+	}
+	dependents.push_back(p_dependent);
+	return true;
 }
 bool TaskJobHandle::is_completed() {
 	if (dependJob.size() > 0) {
-		depend_mutex.lock();
+		MutexLock lock(depend_mutex);
 		for (uint32_t i = 0; i < dependJob.size(); ++i) {
 			if (!dependJob[i]->is_completed()) {
 				return false;
 			}
 		}
 		dependJob.clear();
-		depend_mutex.unlock();
 	}
-	return completed.is_set();
+	// 没有提交过的句柄在依赖都完成时就算完成
+	return !is_init || completed.is_set();
 }
 
 // 等待所有依赖信号完成
@@ -984,11 +1148,9 @@ void TaskJobHandle::wait_completion() {
 		// 已经标记完成了
 		return;
 	}
-	if (is_job) {
-		// 如果完成，等待完成信号
-		MutexLock lock(done_mutex);
-		cv.wait(lock, [this] { return WorkerTaskPool::get_singleton() == nullptr || completed.is_set(); });
-	}
+	// 空任务和组合句柄也会在依赖完成时被标记完成,同样等待完成信号
+	MutexLock lock(done_mutex);
+	cv.wait(lock, [this] { return WorkerTaskPool::get_singleton() == nullptr || completed.is_set(); });
 }
 void TaskJobHandle::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_completed"), &TaskJobHandle::is_completed);
@@ -1009,13 +1171,16 @@ class ThreadTaskGroup {
 	void *native_func_userdata = nullptr;
 	int start = 0;
 	int end = 0;
+	// 就绪列队排序用: 关键路径估计值越大越先执行,相同时先进先出
+	uint64_t priority = 0;
+	uint64_t sequence = 0;
 	ThreadTaskGroup *next = nullptr;
 	friend class WorkerTaskPool;
+	friend struct ThreadTaskGroupComparator;
 
 protected:
 	void Process() {
-		// 等待所有依赖完成
-		handle->wait_depend_completion();
+		// 依赖在释放到就绪列队之前已经全部完成,这里不需要再等待
 		//try
 		{
 			if (is_labada) {
@@ -1068,10 +1233,23 @@ protected:
 	}
 };
 
+struct ThreadTaskGroupComparator {
+	_FORCE_INLINE_ bool operator()(const ThreadTaskGroup *p_a, const ThreadTaskGroup *p_b) const {
+		if (p_a->priority != p_b->priority) {
+			return p_a->priority < p_b->priority;
+		}
+		return p_a->sequence > p_b->sequence;
+	}
+};
+
 WorkerTaskPool *WorkerTaskPool::singleton = nullptr;
 
+// 追踪数据里的线程编号,非任务线程为-1
+static thread_local int task_pool_thread_index = -1;
+
 void WorkerTaskPool::_thread_task_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
+	task_pool_thread_index = thread_data->index;
 	while (true) {
 		singleton->task_available_semaphore.wait();
 		if (singleton->exit_threads) {
@@ -1083,59 +1261,6 @@ void WorkerTaskPool::_thread_task_function(void *p_user) {
 		}
 	}
 }
-void WorkerTaskPool::_thread_scheduler_function(void *p_user) {
-	Ref<TaskJobHandle> hand;
-	while (true) {
-		singleton->scheduler_semaphore.wait();
-		if (singleton->exit_threads) {
-			break;
-		}
-		singleton->scheduler_mutex.lock();
-		bool rs = singleton->scheduler_task.pop(hand);
-		singleton->scheduler_mutex.unlock();
-		if (!rs) {
-			continue;
-		}
-		hand->wait_depend_completion();
-		if (singleton->exit_threads) {
-			return;
-		}
-		// 获取任务数量
-		if (hand->depend_task_counter.is_valid()) {
-			hand->taskMax = hand->depend_task_counter->get_task_count();
-		}
-		if (hand->taskMax > 0) {
-			for (uint32_t i = 0; i < hand->taskMax; i += hand->batch_count) {
-				ThreadTaskGroup *task = singleton->allocal_task_data();
-				task->handle = hand;
-				task->callable = hand->callable;
-				task->labada = hand->labada;
-				task->is_labada = hand->is_labada;
-				task->native_group_func = hand->native_group_func;
-				task->native_func_userdata = hand->native_func_userdata;
-				task->start = i;
-				task->end = i + hand->batch_count;
-				if (task->end > hand->taskMax) {
-					task->end = hand->taskMax;
-				}
-				task->is_labada = false;
-				// 增加一个任务
-				singleton->add_task(task);
-			}
-			if (singleton->exit_threads) {
-				break;
-			}
-			// 等待任务完成,保证任务顺序完成
-			hand->wait_completion();
-			if (singleton->exit_threads) {
-				break;
-			}
-			hand.unref();
-		} else {
-			hand->set_completed();
-		}
-	}
-}
 
 class ThreadTaskGroup *WorkerTaskPool::allocal_task_data() {
 	ThreadTaskGroup *ret = nullptr;
@@ -1151,6 +1276,7 @@ class ThreadTaskGroup *WorkerTaskPool::allocal_task_data() {
 	return ret;
 }
 void WorkerTaskPool::free_task_data(class ThreadTaskGroup *task) {
+	task->handle.unref();
 	task->callable = Callable();
 	task->native_func_userdata = nullptr;
 	task->native_group_func = nullptr;
@@ -1163,22 +1289,26 @@ void WorkerTaskPool::free_task_data(class ThreadTaskGroup *task) {
 }
 void WorkerTaskPool::add_task(class ThreadTaskGroup *task) {
 	task_mutex.lock();
-	task->next = task_queue;
-	task_queue = task;
+	task->sequence = ready_sequence++;
+	ready_queue.push_back(task);
+	SortArray<ThreadTaskGroup *, ThreadTaskGroupComparator> heap;
+	heap.push_heap(0, ready_queue.size() - 1, 0, task, ready_queue.ptr());
 	task_mutex.unlock();
 	// 增加信号
 	task_available_semaphore.post();
 }
 void WorkerTaskPool::_process_task_queue(int thread_id) {
 	task_mutex.lock();
-	ThreadTaskGroup *node = task_queue;
-	if (node != nullptr) {
-		ThreadTaskGroup *task = node;
-		task_queue = task_queue->next;
+	if (!ready_queue.is_empty()) {
+		ThreadTaskGroup *task = ready_queue[0];
+		SortArray<ThreadTaskGroup *, ThreadTaskGroupComparator> heap;
+		heap.pop_heap(0, ready_queue.size(), ready_queue.ptr());
+		ready_queue.resize(ready_queue.size() - 1);
 		//bool _capture_stack = capture_stack;
 		task_mutex.unlock();
+		bool _trace_capture = trace_capture.is_set();
 		uint64_t start_time = 0;
-		if (capture_stack) {
+		if (capture_stack || _trace_capture) {
 			start_time = OS::get_singleton()->get_ticks_usec();
 		}
 		task->Process();
@@ -1187,9 +1317,14 @@ void WorkerTaskPool::_process_task_queue(int thread_id) {
 		task->labada = std::function<void(int)>();
 		task->callable = Callable();
 
-		if (capture_stack) {
+		if (capture_stack || _trace_capture) {
 			uint64_t end_time = OS::get_singleton()->get_ticks_usec();
-			push_task_stack(thread_id, task->handle->task_name, task->start, task->end, start_time / 1000.0, end_time / 1000.0);
+			if (capture_stack) {
+				push_task_stack(thread_id, task->handle->task_name, task->start, task->end, start_time / 1000.0, end_time / 1000.0);
+			}
+			if (_trace_capture) {
+				_trace_task(thread_id, task, start_time, end_time);
+			}
 		}
 		// 放到释放列队里面
 		free_task_data(task);
@@ -1198,51 +1333,123 @@ void WorkerTaskPool::_process_task_queue(int thread_id) {
 		task_mutex.unlock();
 	}
 }
-Ref<TaskJobHandle> WorkerTaskPool::add_native_group_task(const StringName &task_name, void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int _batch_count, TaskJobHandle *depend_task, const Ref<TaskJobDependCounter> &depend_task_counter) {
-	if (!Thread::is_main_thread()) {
-		ERR_PRINT("only call man thread");
-		return Ref<TaskJobHandle>();
-	}
+Ref<TaskJobHandle> WorkerTaskPool::_create_job(const StringName &p_task_name, int p_elements, int p_batch_count) {
 	Ref<TaskJobHandle> hand = Ref<TaskJobHandle>(memnew(TaskJobHandle));
 	hand->init();
-	hand->task_name = task_name;
+	hand->task_name = p_task_name;
+	if (p_elements > 0) {
+		hand->is_job = true;
+		hand->taskMax = p_elements;
+		hand->batch_count = MAX(p_batch_count, 1);
+		hand->cost = p_elements;
+	}
+	hand->critical_path.set(hand->cost);
+	hand->job_id = last_job_id.increment();
+	return hand;
+}
+void WorkerTaskPool::_submit_job(const Ref<TaskJobHandle> &p_handle, TaskJobHandle *const *p_depends, uint32_t p_depend_count, const Ref<TaskJobDependCounter> &p_depend_task_counter) {
+	if (p_depend_count > 0) {
+		p_handle->depend_task_counter = p_depend_task_counter;
+	}
+	// 提交本身占用一个计数,防止依赖在注册过程中完成,提前释放任务
+	p_handle->pending_depend_count.set(1);
+	for (uint32_t i = 0; i < p_depend_count; ++i) {
+		_add_job_depend(p_handle, p_depends[i]);
+	}
+	if (p_handle->pending_depend_count.decrement() == 0) {
+		_release_job(p_handle);
+	}
+}
+void WorkerTaskPool::_add_job_depend(const Ref<TaskJobHandle> &p_handle, TaskJobHandle *p_depend) {
+	if (!p_depend->is_init) {
+		// 没有提交过的句柄不会被标记完成,只是用 push_depend 收集的依赖集合,直接依赖它收集的句柄
+		LocalVector<Ref<TaskJobHandle>> depends;
+		p_depend->depend_mutex.lock();
+		depends = p_depend->dependJob;
+		p_depend->depend_mutex.unlock();
+		for (const Ref<TaskJobHandle> &depend : depends) {
+			_add_job_depend(p_handle, depend.ptr());
+		}
+		return;
+	}
 	// 增加依赖，保持依赖链条是正确的
-	if (depend_task != nullptr) {
-		hand->dependJob.push_back(depend_task);
-	}
-	if (p_elements <= 0) {
-		return hand;
-	}
-	hand->is_job = true;
-	if (_batch_count <= 0) {
-		_batch_count = 1;
-	}
-	hand->taskMax = p_elements;
-	hand->batch_count = _batch_count;
-	if (depend_task != nullptr) {
-		hand->depend_task_counter = depend_task_counter;
-		hand->native_func_userdata = p_userdata;
-		hand->native_group_func = p_func;
-		scheduler_mutex.lock();
-		scheduler_task.push(hand);
-		scheduler_mutex.unlock();
-		scheduler_semaphore.post();
-		return hand;
-	}
-	for (int i = 0; i < p_elements; i += _batch_count) {
+	p_handle->depend_mutex.lock();
+	p_handle->dependJob.push_back(p_depend);
+	if (trace_capture.is_set()) {
+		p_handle->trace_depend_ids.push_back(p_depend->job_id);
+	}
+	p_handle->depend_mutex.unlock();
+	if (p_depend->add_dependent(p_handle)) {
+		p_handle->pending_depend_count.increment();
+		_propagate_critical_path(p_depend, p_handle->critical_path.get());
+	}
+}
+void WorkerTaskPool::_propagate_critical_path(TaskJobHandle *p_handle, uint64_t p_successor_path) {
+	uint64_t path = p_handle->cost + p_successor_path;
+	if (path <= p_handle->critical_path.get()) {
+		return;
+	}
+	p_handle->critical_path.set(path);
+	// 关键路径变长了,继续向前序任务传播(已经完成的任务不需要)
+	MutexLock lock(p_handle->depend_mutex);
+	for (uint32_t i = 0; i < p_handle->dependJob.size(); ++i) {
+		if (!p_handle->dependJob[i]->completed.is_set()) {
+			_propagate_critical_path(p_handle->dependJob[i].ptr(), path);
+		}
+	}
+}
+void WorkerTaskPool::_release_job(const Ref<TaskJobHandle> &p_handle) {
+	// 依赖都完成了,释放对前序任务的引用
+	p_handle->depend_mutex.lock();
+	p_handle->dependJob.clear();
+	p_handle->depend_mutex.unlock();
+
+	// 获取任务数量
+	if (p_handle->depend_task_counter.is_valid()) {
+		p_handle->taskMax = p_handle->depend_task_counter->get_task_count();
+	}
+	if (trace_capture.is_set()) {
+		_trace_release(p_handle);
+	}
+	if (!p_handle->is_job || p_handle->taskMax == 0 || exit_threads) {
+		// 没有需要执行的内容,直接完成,继续释放后续任务
+		p_handle->set_completed();
+		return;
+	}
+
+	uint64_t priority = p_handle->critical_path.get();
+	uint32_t task_count = 0;
+	task_mutex.lock();
+	SortArray<ThreadTaskGroup *, ThreadTaskGroupComparator> heap;
+	for (uint32_t i = 0; i < p_handle->taskMax; i += p_handle->batch_count) {
 		ThreadTaskGroup *task = allocal_task_data();
-		task->handle = hand;
-		task->native_func_userdata = p_userdata;
-		task->native_group_func = p_func;
+		task->handle = p_handle;
+		task->callable = p_handle->callable;
+		task->labada = p_handle->labada;
+		task->is_labada = p_handle->is_labada;
+		task->native_group_func = p_handle->native_group_func;
+		task->native_func_userdata = p_handle->native_func_userdata;
 		task->start = i;
-		task->end = i + _batch_count;
-		if (task->end > p_elements) {
-			task->end = p_elements;
-		}
-		task->is_labada = false;
-		// 增加一个任务
-		add_task(task);
+		task->end = MIN(i + p_handle->batch_count, p_handle->taskMax);
+		task->priority = priority;
+		task->sequence = ready_sequence++;
+		ready_queue.push_back(task);
+		heap.push_heap(0, ready_queue.size() - 1, 0, task, ready_queue.ptr());
+		task_count++;
 	}
+	task_mutex.unlock();
+	// 增加信号
+	task_available_semaphore.post(task_count);
+}
+Ref<TaskJobHandle> WorkerTaskPool::add_native_group_task(const StringName &task_name, void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int _batch_count, TaskJobHandle *depend_task, const Ref<TaskJobDependCounter> &depend_task_counter) {
+	if (!Thread::is_main_thread()) {
+		ERR_PRINT("only call man thread");
+		return Ref<TaskJobHandle>();
+	}
+	Ref<TaskJobHandle> hand = _create_job(task_name, p_elements, _batch_count);
+	hand->native_func_userdata = p_userdata;
+	hand->native_group_func = p_func;
+	_submit_job(hand, &depend_task, depend_task != nullptr ? 1 : 0, depend_task_counter);
 	return hand;
 }
 Ref<TaskJobHandle> WorkerTaskPool::add_group_task(const StringName &task_name, const Callable &p_action, int p_elements, int _batch_count, TaskJobHandle *depend_task, const Ref<TaskJobDependCounter> &depend_task_counter) {
@@ -1250,44 +1457,9 @@ Ref<TaskJobHandle> WorkerTaskPool::add_group_task(const StringName &task_name, c
 		ERR_PRINT("only call man thread");
 		return Ref<TaskJobHandle>();
 	}
-	Ref<TaskJobHandle> hand = Ref<TaskJobHandle>(memnew(TaskJobHandle));
-	hand->init();
-	hand->task_name = task_name;
-	// 增加依赖，保持依赖链条是正确的
-	if (depend_task != nullptr) {
-		hand->dependJob.push_back(depend_task);
-	}
-	if (p_elements <= 0) {
-		return hand;
-	}
-	hand->is_job = true;
-	if (_batch_count <= 0) {
-		_batch_count = 1;
-	}
-	hand->taskMax = p_elements;
-	hand->batch_count = _batch_count;
-	if (depend_task != nullptr) {
-		hand->callable = p_action;
-		hand->depend_task_counter = depend_task_counter;
-		scheduler_mutex.lock();
-		scheduler_task.push(hand);
-		scheduler_mutex.unlock();
-		scheduler_semaphore.post();
-		return hand;
-	}
-	for (int i = 0; i < p_elements; i += _batch_count) {
-		ThreadTaskGroup *task = allocal_task_data();
-		task->handle = hand;
-		task->callable = p_action;
-		task->start = i;
-		task->end = i + _batch_count;
-		if (task->end > p_elements) {
-			task->end = p_elements;
-		}
-		task->is_labada = false;
-		// 增加一个任务
-		add_task(task);
-	}
+	Ref<TaskJobHandle> hand = _create_job(task_name, p_elements, _batch_count);
+	hand->callable = p_action;
+	_submit_job(hand, &depend_task, depend_task != nullptr ? 1 : 0, depend_task_counter);
 	return hand;
 }
 Ref<TaskJobHandle> WorkerTaskPool::add_labada_group_task(const StringName &_task_name, const std::function<void(int)> &p_action, int p_elements, int _batch_count, TaskJobHandle *depend_task, const Ref<TaskJobDependCounter> &depend_task_counter) {
@@ -1295,69 +1467,38 @@ Ref<TaskJobHandle> WorkerTaskPool::add_labada_group_task(const StringName &_task
 		ERR_PRINT("only call man thread");
 		return Ref<TaskJobHandle>();
 	}
-	Ref<TaskJobHandle> hand = Ref<TaskJobHandle>(memnew(TaskJobHandle));
-	hand->init();
-	hand->task_name = _task_name;
-	// 增加依赖，保持依赖链条是正确的
-	if (depend_task != nullptr) {
-		hand->dependJob.push_back(depend_task);
-	}
-	if (p_elements <= 0) {
-		return hand;
-	}
-	hand->is_job = true;
-	if (_batch_count <= 0) {
-		_batch_count = 1;
-	}
-	hand->taskMax = p_elements;
-	hand->batch_count = _batch_count;
-	if (depend_task != nullptr) {
-		hand->depend_task_counter = depend_task_counter;
-		hand->labada = p_action;
-		hand->is_labada = true;
-		scheduler_mutex.lock();
-		scheduler_task.push(hand);
-		scheduler_mutex.unlock();
-		scheduler_semaphore.post();
-		return hand;
-	}
-	for (int i = 0; i < p_elements; i += _batch_count) {
-		ThreadTaskGroup *task = allocal_task_data();
-		task->handle = hand;
-		task->labada = p_action;
-		task->is_labada = true;
-		task->start = i;
-		task->end = i + _batch_count;
-		if (task->end > p_elements) {
-			task->end = p_elements;
-		}
-		// 增加一个任务
-		add_task(task);
-	}
+	Ref<TaskJobHandle> hand = _create_job(_task_name, p_elements, _batch_count);
+	hand->labada = p_action;
+	hand->is_labada = true;
+	_submit_job(hand, &depend_task, depend_task != nullptr ? 1 : 0, depend_task_counter);
 	return hand;
 }
 Ref<TaskJobHandle> WorkerTaskPool::combined_job_handle(TypedArray<TaskJobHandle> _handles) {
 	if (_handles.size() == 0) {
 		return nullptr;
 	}
-	Ref<TaskJobHandle> hand = Ref<TaskJobHandle>(memnew(TaskJobHandle));
-	hand->init();
-	hand->dependJob.resize(_handles.size());
+	Ref<TaskJobHandle> hand = _create_job(StringName(), 0, 0);
+	LocalVector<TaskJobHandle *> depends;
+	depends.reserve(_handles.size());
 	for (int i = 0; i < _handles.size(); ++i) {
 		Ref<TaskJobHandle> job = _handles[i];
-		if (job == nullptr) {
-			String err_str = "combined_job_handle job is not TaskJobHandle" + itos(i) + "\n";
-			//PRINT_STACK_TRACE(err_str);
+		if (job.is_null()) {
+			ERR_PRINT("combined_job_handle job is not TaskJobHandle: " + itos(i));
 			continue;
 		}
-		hand->dependJob[i] = job;
+		depends.push_back(job.ptr());
 	}
+	// 所有句柄完成时由最后完成的线程标记组合句柄完成,不需要调度线程
+	_submit_job(hand, depends.ptr(), depends.size(), Ref<TaskJobDependCounter>());
 	return hand;
 }
 void WorkerTaskPool::_bind_methods() {
 	//ClassDB::bind_method(D_METHOD("add_native_group_task", "func", "userdata", "elements","batch_count","depend_task"), &WorkerTaskPool::add_native_group_task);
 	ClassDB::bind_method(D_METHOD("add_group_task", "task_name", "action", "elements", "batch_count", "depend_task", "depend_task_counter"), &WorkerTaskPool::add_group_task, DEFVAL(Ref<TaskJobDependCounter>()));
 	ClassDB::bind_method(D_METHOD("combined_job_handle", "handles"), &WorkerTaskPool::combined_job_handle);
+	ClassDB::bind_method(D_METHOD("start_trace_capture", "path"), &WorkerTaskPool::start_trace_capture);
+	ClassDB::bind_method(D_METHOD("stop_trace_capture"), &WorkerTaskPool::stop_trace_capture);
+	ClassDB::bind_method(D_METHOD("is_trace_capturing"), &WorkerTaskPool::is_trace_capturing);
 }
 
 void WorkerTaskPool::init() {
@@ -1371,10 +1512,6 @@ void WorkerTaskPool::init() {
 		threads[i].thread.start(&WorkerTaskPool::_thread_task_function, &threads[i], settings);
 		threads[i].thread.set_thread_name(String("Worker Job Pool Thread:") + String::num_int64(i));
 	}
-	Thread::Settings settings;
-	settings.priority = Thread::PRIORITY_NORMAL;
-	thread_scheduler.start(&WorkerTaskPool::_thread_scheduler_function, this, settings);
-	thread_scheduler.set_thread_name(String("Worker Job Scheduler Thread"));
 }
 
 void WorkerTaskPool::push_task_stack(int thread_index, const StringName &task_name, uint32_t task_start, uint32_t task_end, double task_start_time, double task_end_time) {
@@ -1443,16 +1580,79 @@ void WorkerTaskPool::get_task_stack_data(LocalVector<ThreadRunStack> &stack) {
 	}
 	stack_mutex.unlock();
 }
+Error WorkerTaskPool::start_trace_capture(const String &p_path) {
+	MutexLock lock(trace_mutex);
+	ERR_FAIL_COND_V_MSG(trace_file.is_valid(), ERR_ALREADY_IN_USE, "WorkerTaskPool trace capture is already running.");
+	Error err = OK;
+	trace_file = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(trace_file.is_null(), err, vformat("Cannot open WorkerTaskPool trace file '%s'.", p_path));
+
+	trace_file->store_string("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	trace_event_count = 0;
+	for (uint32_t i = 0; i < threads.size(); ++i) {
+		if (trace_event_count++ > 0) {
+			trace_file->store_string(",\n");
+		}
+		trace_file->store_string(vformat("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"Worker Job Pool Thread:%d\"}}", i, i));
+	}
+	trace_capture.set();
+	return OK;
+}
+void WorkerTaskPool::stop_trace_capture() {
+	MutexLock lock(trace_mutex);
+	if (trace_file.is_null()) {
+		return;
+	}
+	trace_capture.clear();
+	trace_file->store_string("\n]}\n");
+	trace_file.unref();
+}
+void WorkerTaskPool::_write_trace_event(const String &p_event) {
+	MutexLock lock(trace_mutex);
+	if (trace_file.is_null()) {
+		return;
+	}
+	if (trace_event_count++ > 0) {
+		trace_file->store_string(",\n");
+	}
+	trace_file->store_string(p_event);
+}
+String WorkerTaskPool::_trace_depends(const TaskJobHandle *p_handle) {
+	String depends;
+	for (uint32_t i = 0; i < p_handle->trace_depend_ids.size(); ++i) {
+		if (i > 0) {
+			depends += ",";
+		}
+		depends += itos(p_handle->trace_depend_ids[i]);
+	}
+	return depends;
+}
+void WorkerTaskPool::_trace_task(int p_thread_index, const ThreadTaskGroup *p_task, uint64_t p_start_usec, uint64_t p_end_usec) {
+	const TaskJobHandle *handle = p_task->handle.ptr();
+	String name = String(handle->task_name).json_escape();
+	String event = vformat("{\"name\":\"%s\",\"cat\":\"job\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%d,\"dur\":%d,\"args\":{\"job\":%d,\"start\":%d,\"end\":%d,\"depends\":[%s]}}",
+			name, p_thread_index, (int64_t)p_start_usec, (int64_t)(p_end_usec - p_start_usec), (int64_t)handle->job_id, p_task->start, p_task->end, _trace_depends(handle));
+	if (p_task->start == 0) {
+		// 第一个批次作为释放箭头的终点
+		event += vformat(",\n{\"name\":\"release\",\"cat\":\"job\",\"ph\":\"f\",\"bp\":\"e\",\"id\":%d,\"pid\":0,\"tid\":%d,\"ts\":%d}", (int64_t)handle->job_id, p_thread_index, (int64_t)p_start_usec);
+	}
+	_write_trace_event(event);
+}
+void WorkerTaskPool::_trace_release(const Ref<TaskJobHandle> &p_handle) {
+	// 释放任务的线程(完成最后一个依赖的线程,或者提交任务的线程)
+	int64_t tid = task_pool_thread_index >= 0 ? (int64_t)task_pool_thread_index : (int64_t)Thread::get_caller_id();
+	int64_t now = OS::get_singleton()->get_ticks_usec();
+	if (p_handle->is_job && p_handle->taskMax > 0) {
+		_write_trace_event(vformat("{\"name\":\"release\",\"cat\":\"job\",\"ph\":\"s\",\"id\":%d,\"pid\":0,\"tid\":%d,\"ts\":%d}", (int64_t)p_handle->job_id, tid, now));
+	} else {
+		// 空任务或组合句柄没有执行批次,记录为瞬时事件
+		_write_trace_event(vformat("{\"name\":\"%s\",\"cat\":\"combined\",\"ph\":\"i\",\"s\":\"t\",\"pid\":0,\"tid\":%d,\"ts\":%d,\"args\":{\"job\":%d,\"depends\":[%s]}}",
+				String(p_handle->task_name).json_escape(), tid, now, (int64_t)p_handle->job_id, _trace_depends(p_handle.ptr())));
+	}
+}
 void WorkerTaskPool::finish() {
 	exit_threads = true;
 
-	scheduler_semaphore.post();
-	scheduler_semaphore.post();
-	// 等待调度线程结束
-	if (thread_scheduler.is_started()) {
-		thread_scheduler.wait_to_finish();
-	}
-
 	// 结束所有任务线程结束
 	for (uint32_t i = 0; i < threads.size(); i++) {
 		task_available_semaphore.post();
@@ -1463,18 +1663,18 @@ void WorkerTaskPool::finish() {
 			data.thread.wait_to_finish();
 		}
 	}
+	stop_trace_capture();
 	singleton = nullptr;
-	class ThreadTaskGroup *it = task_queue;
-	while (it) {
-		memdelete(it);
-		it = it->next;
+	for (ThreadTaskGroup *task : ready_queue) {
+		memdelete(task);
 	}
-	it = free_queue;
+	ready_queue.clear();
+	class ThreadTaskGroup *it = free_queue;
 	while (it) {
+		class ThreadTaskGroup *next = it->next;
 		memdelete(it);
-		it = it->next;
+		it = next;
 	}
-	task_queue = nullptr;
 	free_queue = nullptr;
 }
 WorkerTaskPool::WorkerTaskPool() {
@@ -42,6 +42,9 @@
 #include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
 #include "core/templates/stack.h"
+#include "core/templates/work_stealing_queue.h"
+
+#include <atomic>
 #include <functional>
 
 class WorkerThreadPool : public Object {
@@ -82,27 +85,35 @@ private:
 		void *native_func_userdata = nullptr;
 		String description;
 		Semaphore done_semaphore; // For user threads awaiting.
-		bool completed : 1;
-		bool pending_notify_yield_over : 1;
-		bool is_pump_task : 1;
+		// Completion bit plus the number of waiters that announced themselves, so the thread running
+		// the task only needs the lock to complete it if somebody has to be woken up.
+		SafeNumeric<uint32_t> wait_state;
+		SafeFlag pending_notify_yield_over;
+		bool is_pump_task = false;
 		Group *group = nullptr;
 		SelfList<Task> task_elem;
 		uint32_t waiting_pool = 0;
 		uint32_t waiting_user = 0;
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
-		int pool_thread_index = -1;
+		SafeNumeric<int> pool_thread_index{ -1 };
+
+		static constexpr uint32_t COMPLETED = 1u << 31;
+
+		_FORCE_INLINE_ bool is_completed() const { return wait_state.get() & COMPLETED; }
+		// Returns the number of waiters announced before completion. If zero, the task may be freed by then.
+		_FORCE_INLINE_ uint32_t complete() { return wait_state.bit_or(COMPLETED) & ~COMPLETED; }
+		// Returns whether the task was already completed, in which case nobody will wake the waiter.
+		_FORCE_INLINE_ bool announce_waiter() { return wait_state.postincrement() & COMPLETED; }
 
 		void free_template_userdata();
 		Task() :
-				completed(false),
-				pending_notify_yield_over(false),
-				is_pump_task(false),
 				task_elem(this) {}
 	};
 
 	static const uint32_t TASKS_PAGE_SIZE = 1024;
 	static const uint32_t GROUPS_PAGE_SIZE = 256;
+	static const uint32_t LOCAL_QUEUE_SIZE = 256;
 	String thread_name;
 	PagedAllocator<Task, false, TASKS_PAGE_SIZE> task_allocator;
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
@@ -118,21 +129,22 @@ private:
 		uint32_t index = 0;
 		Thread thread;
 		bool signaled : 1;
-		bool yield_is_over : 1;
 		bool pre_exited_languages : 1;
 		bool exited_languages : 1;
-		bool has_pump_task : 1; // Threads can only have one pump task.
-		Task *current_task = nullptr;
+		// Only accessed by the owning thread.
+		bool has_pump_task = false; // Threads can only have one pump task.
+		// Set by the owning thread without the lock, so this is kept out of the bit fields.
+		std::atomic<Task *> current_task = nullptr;
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
 		WorkerThreadPool *pool = nullptr;
+		// Tasks posted by this thread. Popped by it without locking and stolen by idle siblings.
+		WorkStealingQueue<Task *, LOCAL_QUEUE_SIZE> local_queue;
 
 		ThreadData() :
 				signaled(false),
-				yield_is_over(false),
 				pre_exited_languages(false),
-				exited_languages(false),
-				has_pump_task(false) {}
+				exited_languages(false) {}
 	};
 
 	TightLocalVector<ThreadData> threads;
@@ -171,6 +183,9 @@ private:
 	uint32_t max_low_priority_threads = 0;
 	uint32_t low_priority_threads_used = 0;
 	uint32_t notify_index = 0; // For rotating across threads, no help distributing load.
+	// Threads about to wait for a notification. Local queues are pushed to without the lock,
+	// so pushers check this to know whether they have to take the lock to wake someone up.
+	SafeNumeric<uint32_t> sleeping_threads;
 
 	uint64_t last_task = 1;
 	int pump_task_count = 0;
@@ -182,10 +197,16 @@ private:
 	void _process_task(Task *task);
 
 	void _post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, MutexLock<BinaryMutex> &p_lock, bool p_pump_task);
+	ThreadData *_get_local_post_thread(bool p_high_priority, bool p_pump_task);
+	void _post_local_tasks(ThreadData *p_thread_data, Task **p_tasks, uint32_t p_count);
+	Task *_pop_before_sleeping(ThreadData *p_thread_data);
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
 
 	bool _try_promote_low_priority_task();
 
+	Task *_pop_local_or_steal(ThreadData *p_thread_data);
+	bool _has_local_tasks() const;
+
 	static WorkerThreadPool *singleton;
 
 #ifdef THREADS_ENABLED
@@ -340,7 +361,9 @@ public:
 
 protected:
 	bool exit_threads = false;
-	class ThreadTaskGroup *task_queue = nullptr;
+	// 就绪列队,按关键路径估计值排序的二叉堆
+	LocalVector<class ThreadTaskGroup *> ready_queue;
+	uint64_t ready_sequence = 0;
 	// 释放的列队
 	class ThreadTaskGroup *free_queue = nullptr;
 	Mutex task_mutex;
@@ -359,16 +382,6 @@ protected:
 	//
 	float tick_time_seconds = 0.5f;
 
-	// 调度器
-	// 主要处理需要顺序执行的多线程,需要用专门的线程保证执行顺序,
-	// 防止出现后续任务抢先执行,占满所有的资源出现,前序任务抢不到资源,出现死锁现象
-	Thread thread_scheduler;
-	// 调度器的信号
-	Semaphore scheduler_semaphore;
-	// 阻塞执行的人物列表
-	Stack<Ref<TaskJobHandle>> scheduler_task;
-	Mutex scheduler_mutex;
-
 	Mutex stack_mutex;
 	LocalVector<ThreadRunStack> task_run_stack_pool;
 	ThreadRunStack *first_stack = nullptr;
@@ -380,6 +393,18 @@ protected:
 	void reset_task_stack();
 	void get_task_stack_data(LocalVector<ThreadRunStack> &stack);
 
+	// Chrome Trace Event 格式(chrome://tracing, Perfetto UI)导出
+	Mutex trace_mutex;
+	Ref<class FileAccess> trace_file;
+	uint64_t trace_event_count = 0;
+	SafeFlag trace_capture;
+	SafeNumeric<uint64_t> last_job_id;
+
+	void _write_trace_event(const String &p_event);
+	void _trace_task(int p_thread_index, const class ThreadTaskGroup *p_task, uint64_t p_start_usec, uint64_t p_end_usec);
+	void _trace_release(const Ref<TaskJobHandle> &p_handle);
+	static String _trace_depends(const TaskJobHandle *p_handle);
+
 public:
 	template <typename... VarArgs>
 	_FORCE_INLINE_ Ref<TaskJobHandle> add_group_task_bind(const StringName &_task_name, const Callable &p_action, int p_elements_count, int _batch_count, TaskJobHandle *depend_task, VarArgs... p_args) {
@@ -398,6 +423,11 @@ public:
 public:
 	Ref<TaskJobHandle> combined_job_handle(TypedArray<TaskJobHandle> _handles);
 
+	// 开始把任务执行记录写入 Chrome Trace Event JSON 文件,finish() 时自动结束
+	Error start_trace_capture(const String &p_path);
+	void stop_trace_capture();
+	bool is_trace_capturing() const { return trace_capture.is_set(); }
+
 public:
 	static WorkerTaskPool *get_singleton() { return singleton; }
 
@@ -409,12 +439,20 @@ public:
 
 protected:
 	static void _thread_task_function(void *p_user);
-	static void _thread_scheduler_function(void *p_user);
 	void _process_task_queue(int thread_id);
 	class ThreadTaskGroup *allocal_task_data();
 	void free_task_data(class ThreadTaskGroup *task);
 	void add_task(class ThreadTaskGroup *task);
+
+	// 依赖图调度:
+	// 任务在所有依赖完成时,由完成最后一个依赖的线程直接释放到就绪列队,不再经过调度线程.
+	Ref<TaskJobHandle> _create_job(const StringName &p_task_name, int p_elements, int p_batch_count);
+	void _submit_job(const Ref<TaskJobHandle> &p_handle, TaskJobHandle *const *p_depends, uint32_t p_depend_count, const Ref<TaskJobDependCounter> &p_depend_task_counter);
+	void _add_job_depend(const Ref<TaskJobHandle> &p_handle, TaskJobHandle *p_depend);
+	void _release_job(const Ref<TaskJobHandle> &p_handle);
+	void _propagate_critical_path(TaskJobHandle *p_handle, uint64_t p_successor_path);
 	friend class ThreadTaskGroup;
+	friend class TaskJobHandle;
 
 private:
 };
@@ -451,8 +489,11 @@ public:
 	}
 
 	// 添加依赖，这个句柄,必须是自己心分配的,不能复用
+	// 提交任务时会直接依赖这里收集的句柄
 	void push_depend(TaskJobHandle *depend_task) {
 		ERR_FAIL_COND(is_init);
+		ERR_FAIL_COND(depend_task == nullptr || depend_task == this);
+		MutexLock lock(depend_mutex);
 		dependJob.push_back(depend_task);
 	}
 	uint32_t depend_count() {
@@ -470,6 +511,8 @@ protected:
 	void set_completed();
 	// 等待所有依赖信号完成
 	void wait_depend_completion();
+	// 注册后续任务,如果自己已经完成则返回false
+	bool add_dependent(const Ref<TaskJobHandle> &p_dependent);
 
 protected:
 	// 任务名称
@@ -477,8 +520,20 @@ protected:
 	Mutex depend_mutex;
 	// 依赖的句柄
 	LocalVector<Ref<TaskJobHandle>> dependJob;
-	// 完成标志
+	// 完成标志,同时保护后续任务列表
 	BinaryMutex done_mutex;
+	// 等待自己完成的后续任务
+	LocalVector<Ref<TaskJobHandle>> dependents;
+	// 尚未完成的依赖数量,为0时释放任务
+	SafeNumeric<uint32_t> pending_depend_count;
+	// 自身的估计开销(元素数量)
+	uint64_t cost = 0;
+	// 从自己开始的最长任务链的估计开销,用于就绪列队排序
+	SafeNumeric<uint64_t> critical_path;
+	// 任务编号,用于导出追踪数据
+	uint64_t job_id = 0;
+	// 依赖的任务编号,只在导出追踪数据时记录
+	LocalVector<uint64_t> trace_depend_ids;
 	ConditionVariable cv;
 	SafeFlag completed;
 	// 完成数量
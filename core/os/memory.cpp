@@ -32,6 +32,7 @@
 #include "mutex.h"
 
 #include "core/math/math_funcs_binary.h"
+#include "core/os/small_allocator.h"
 #include "core/profiling/profiling.h"
 #include "core/templates/safe_refcount.h"
 
@@ -58,251 +59,46 @@ static SafeNumeric<uint64_t> _current_mem_usage;
 static SafeNumeric<uint64_t> _max_mem_usage;
 #endif
 
-#define SAMLL_MEMORY_MANAGER 0
-
-#if SAMLL_MEMORY_MANAGER
-template <int SIZE_COUNT>
-struct SmallMemoryBuffer {
-	uint64_t size_or_next = 0;
-	uint8_t data[SIZE_COUNT];
-};
-template <int SIZE_COUNT>
-struct SmallMemory {
-	_FORCE_INLINE_ void *alloc_mem(int p_count) {
-		{
-			void *ret = nullptr;
-			mutex.lock();
-			if (buffers != nullptr) {
-				SmallMemoryBuffer<SIZE_COUNT> *b = buffers;
-				buffers = (SmallMemoryBuffer<SIZE_COUNT> *)b->size_or_next;
-				ret = b->data;
-				b->size_or_next = p_count;
-			}
-			mutex.unlock();
-			if (ret != nullptr) {
-				return ret;
-			}
-		}
-		SmallMemoryBuffer<SIZE_COUNT> *b = (SmallMemoryBuffer<SIZE_COUNT> *)malloc(sizeof(SmallMemoryBuffer<SIZE_COUNT>));
-		if (b == nullptr) {
-			return nullptr;
-		}
-		b->size_or_next = p_count;
-		return b->data;
-	}
-	_FORCE_INLINE_ void free_mem(void *p_ptr, int max_cache_count) {
-		if (p_ptr == nullptr) {
-			return;
-		}
-
-		uint8_t *mem = (uint8_t *)p_ptr;
-		mem -= sizeof(uint64_t);
-		if (free_count.get() > max_cache_count) {
-			free(mem);
-			return;
-		}
-		SmallMemoryBuffer<SIZE_COUNT> *b = (SmallMemoryBuffer<SIZE_COUNT> *)mem;
-		mutex.lock();
-		b->size_or_next = (uint64_t)buffers;
-		buffers = b;
-		mutex.unlock();
-	}
-
-	SystemMutex mutex;
-	SmallMemoryBuffer<SIZE_COUNT> *buffers = nullptr;
-	SafeNumeric<uint64_t> free_count;
-};
-
-struct SmallMemoryManager {
-#define SAMLL_MEMORY_MEMBER(count) SmallMemory<count> small_memory_##count
-#define SAMLL_MEMORY_MEMBER_BREAH(value, count) \
-	if (value <= count) { \
-		return small_memory_##count.alloc_mem(count); \
-	}
-#define SAMLL_MEMORY_MEMBER_BREAH_FREE(ptr, value, count, max_cache_count) \
-	if (value <= count) { \
-		small_memory_##count.free_mem(ptr, max_cache_count); \
-	}
-
-#define SAMLL_MEMORY_MEMBER_BREAH_ELSE(value, count) \
-	else SAMLL_MEMORY_MEMBER_BREAH(value, count)
-#define SAMLL_MEMORY_MEMBER_BREAH_FREE_ELSE(ptr, value, count, max_cache_count) \
-	else SAMLL_MEMORY_MEMBER_BREAH_FREE(ptr, value, count, max_cache_count)
-#define SAMLL_MEMORY_MEMBER_BREAH_INDEX(value, count, index) \
-	if (value <= count) { \
-		return index; \
-	}
-
-#define SAMLL_MEMORY_MEMBER_BREAH_INDEX_ELSE(value, count, index) \
-	else SAMLL_MEMORY_MEMBER_BREAH_INDEX(value, count, index)
-	void *alloc_mem(int p_count) {
-		if (p_count <= 0) {
-			return nullptr;
-		}
-		SAMLL_MEMORY_MEMBER_BREAH(p_count, 20)
-		SAMLL_MEMORY_MEMBER_BREAH_ELSE(p_count, 40)
-		SAMLL_MEMORY_MEMBER_BREAH_ELSE(p_count, 80)
-		SAMLL_MEMORY_MEMBER_BREAH_ELSE(p_count, 120)
-		SAMLL_MEMORY_MEMBER_BREAH_ELSE(p_count, 160)
-		SAMLL_MEMORY_MEMBER_BREAH_ELSE(p_count, 180)
-		SAMLL_MEMORY_MEMBER_BREAH_ELSE(p_count, 256)
-		SAMLL_MEMORY_MEMBER_BREAH_ELSE(p_count, 320)
-		SAMLL_MEMORY_MEMBER_BREAH_ELSE(p_count, 480)
-		SAMLL_MEMORY_MEMBER_BREAH_ELSE(p_count, 512)
-		SAMLL_MEMORY_MEMBER_BREAH_ELSE(p_count, 800)
-		SAMLL_MEMORY_MEMBER_BREAH_ELSE(p_count, 1024)
-		SAMLL_MEMORY_MEMBER_BREAH_ELSE(p_count, 1500)
-		SAMLL_MEMORY_MEMBER_BREAH_ELSE(p_count, 1800)
-		SAMLL_MEMORY_MEMBER_BREAH_ELSE(p_count, 2048)
-		SAMLL_MEMORY_MEMBER_BREAH_ELSE(p_count, 3000)
-		SAMLL_MEMORY_MEMBER_BREAH_ELSE(p_count, 5000)
-		SAMLL_MEMORY_MEMBER_BREAH_ELSE(p_count, 7000)
-		SAMLL_MEMORY_MEMBER_BREAH_ELSE(p_count, 8000)
-		SAMLL_MEMORY_MEMBER_BREAH_ELSE(p_count, 12000)
-		SAMLL_MEMORY_MEMBER_BREAH_ELSE(p_count, 15000)
-		SAMLL_MEMORY_MEMBER_BREAH_ELSE(p_count, 20000)
-		else {
-			uint8_t *mem = (uint8_t *)malloc(p_count + sizeof(uint64_t));
-			if (mem == nullptr) {
-				return nullptr;
-			}
-			*(uint64_t *)mem = p_count;
-			return mem + sizeof(uint64_t);
-		}
-	}
-	void free_mem(void *p_ptr) {
-		if (p_ptr == nullptr) {
-			return;
-		}
-		uint64_t p_count = get_buffer_count(p_ptr);
-		SAMLL_MEMORY_MEMBER_BREAH_FREE(p_ptr, p_count, 20, 2048)
-		SAMLL_MEMORY_MEMBER_BREAH_FREE_ELSE(p_ptr, p_count, 40, 2048)
-		SAMLL_MEMORY_MEMBER_BREAH_FREE_ELSE(p_ptr, p_count, 80, 2048)
-		SAMLL_MEMORY_MEMBER_BREAH_FREE_ELSE(p_ptr, p_count, 120, 1500)
-		SAMLL_MEMORY_MEMBER_BREAH_FREE_ELSE(p_ptr, p_count, 160, 1500)
-		SAMLL_MEMORY_MEMBER_BREAH_FREE_ELSE(p_ptr, p_count, 180, 1500)
-		SAMLL_MEMORY_MEMBER_BREAH_FREE_ELSE(p_ptr, p_count, 256, 1500)
-		SAMLL_MEMORY_MEMBER_BREAH_FREE_ELSE(p_ptr, p_count, 320, 1500)
-		SAMLL_MEMORY_MEMBER_BREAH_FREE_ELSE(p_ptr, p_count, 480, 1200)
-		SAMLL_MEMORY_MEMBER_BREAH_FREE_ELSE(p_ptr, p_count, 512, 1200)
-		SAMLL_MEMORY_MEMBER_BREAH_FREE_ELSE(p_ptr, p_count, 800, 1200)
-		SAMLL_MEMORY_MEMBER_BREAH_FREE_ELSE(p_ptr, p_count, 1024, 800)
-		SAMLL_MEMORY_MEMBER_BREAH_FREE_ELSE(p_ptr, p_count, 1500, 800)
-		SAMLL_MEMORY_MEMBER_BREAH_FREE_ELSE(p_ptr, p_count, 1800, 800)
-		SAMLL_MEMORY_MEMBER_BREAH_FREE_ELSE(p_ptr, p_count, 2048, 600)
-		SAMLL_MEMORY_MEMBER_BREAH_FREE_ELSE(p_ptr, p_count, 3000, 600)
-		SAMLL_MEMORY_MEMBER_BREAH_FREE_ELSE(p_ptr, p_count, 5000, 500)
-		SAMLL_MEMORY_MEMBER_BREAH_FREE_ELSE(p_ptr, p_count, 7000, 500)
-		SAMLL_MEMORY_MEMBER_BREAH_FREE_ELSE(p_ptr, p_count, 8000, 500)
-		SAMLL_MEMORY_MEMBER_BREAH_FREE_ELSE(p_ptr, p_count, 12000, 500)
-		SAMLL_MEMORY_MEMBER_BREAH_FREE_ELSE(p_ptr, p_count, 15000, 300)
-		SAMLL_MEMORY_MEMBER_BREAH_FREE_ELSE(p_ptr, p_count, 20000, 300)
-		else {
-			uint8_t *mem = (uint8_t *)p_ptr - sizeof(uint64_t);
-			free(mem);
-		}
-	}
-	void *realloc_mem(void *p_memory, size_t p_new_bytes) {
-		if (p_memory == nullptr) {
-			return alloc_mem(p_new_bytes);
-		}
-		//uint8_t *mem = (uint8_t *)p_memory;
-		if (p_new_bytes == 0) {
-			free_mem(p_memory);
-			return nullptr;
-		} else {
-			auto old_count = get_buffer_count(p_memory);
-
-			int index = get_buffer_type_index(old_count);
-			if (index >= 0 && index == get_buffer_type_index(p_new_bytes)) {
-				return p_memory;
-			}
-			void *new_mem = alloc_mem(p_new_bytes);
-			memcpy(new_mem, p_memory, MIN(old_count, p_new_bytes));
-			free_mem(p_memory);
-			return new_mem;
-		}
-	}
-	_FORCE_INLINE_ uint64_t get_buffer_count(void *p_ptr) {
-		uint8_t *mem = (uint8_t *)p_ptr - sizeof(uint64_t);
-		return *(uint64_t *)(mem);
-	}
-	_FORCE_INLINE_ int get_buffer_type_index(void *p_ptr) {
-		uint8_t *mem = (uint8_t *)p_ptr - sizeof(uint64_t);
-		uint64_t count = *(uint64_t *)(mem);
-		return get_buffer_type_index(count);
-	}
+// With `small_allocator=yes`, small blocks come from SmallAllocator's per-thread
+// size-class caches instead of the system allocator. The layout Memory puts on
+// top of the raw block (size header, element count) is the same either way.
+static _FORCE_INLINE_ void *_raw_alloc(size_t p_bytes) {
+#ifdef SMALL_ALLOCATOR_ENABLED
+	return SmallAllocator::alloc(p_bytes);
+#else
+	return malloc(p_bytes);
+#endif
+}
 
-	int get_buffer_type_index(int p_count) {
-		SAMLL_MEMORY_MEMBER_BREAH_INDEX(p_count, 20, 0)
-		SAMLL_MEMORY_MEMBER_BREAH_INDEX_ELSE(p_count, 40, 1)
-		SAMLL_MEMORY_MEMBER_BREAH_INDEX_ELSE(p_count, 80, 2)
-		SAMLL_MEMORY_MEMBER_BREAH_INDEX_ELSE(p_count, 120, 3)
-		SAMLL_MEMORY_MEMBER_BREAH_INDEX_ELSE(p_count, 160, 4)
-		SAMLL_MEMORY_MEMBER_BREAH_INDEX_ELSE(p_count, 180, 5)
-		SAMLL_MEMORY_MEMBER_BREAH_INDEX_ELSE(p_count, 256, 6)
-		SAMLL_MEMORY_MEMBER_BREAH_INDEX_ELSE(p_count, 320, 7)
-		SAMLL_MEMORY_MEMBER_BREAH_INDEX_ELSE(p_count, 480, 8)
-		SAMLL_MEMORY_MEMBER_BREAH_INDEX_ELSE(p_count, 512, 9)
-		SAMLL_MEMORY_MEMBER_BREAH_INDEX_ELSE(p_count, 800, 10)
-		SAMLL_MEMORY_MEMBER_BREAH_INDEX_ELSE(p_count, 1024, 11)
-		SAMLL_MEMORY_MEMBER_BREAH_INDEX_ELSE(p_count, 1500, 12)
-		SAMLL_MEMORY_MEMBER_BREAH_INDEX_ELSE(p_count, 1800, 13)
-		SAMLL_MEMORY_MEMBER_BREAH_INDEX_ELSE(p_count, 2048, 14)
-		SAMLL_MEMORY_MEMBER_BREAH_INDEX_ELSE(p_count, 3000, 15)
-		SAMLL_MEMORY_MEMBER_BREAH_INDEX_ELSE(p_count, 5000, 16)
-		SAMLL_MEMORY_MEMBER_BREAH_INDEX_ELSE(p_count, 7000, 17)
-		SAMLL_MEMORY_MEMBER_BREAH_INDEX_ELSE(p_count, 8000, 18)
-		SAMLL_MEMORY_MEMBER_BREAH_INDEX_ELSE(p_count, 12000, 19)
-		SAMLL_MEMORY_MEMBER_BREAH_INDEX_ELSE(p_count, 15000, 20)
-		SAMLL_MEMORY_MEMBER_BREAH_INDEX_ELSE(p_count, 20000, 21)
-
-		return -1;
-	}
+static _FORCE_INLINE_ void *_raw_alloc_zeroed(size_t p_bytes) {
+#ifdef SMALL_ALLOCATOR_ENABLED
+	return SmallAllocator::alloc_zeroed(p_bytes);
+#else
+	return calloc(1, p_bytes);
+#endif
+}
 
-	SAMLL_MEMORY_MEMBER(20);
-	SAMLL_MEMORY_MEMBER(40);
-	SAMLL_MEMORY_MEMBER(80);
-	SAMLL_MEMORY_MEMBER(120);
-	SAMLL_MEMORY_MEMBER(160);
-	SAMLL_MEMORY_MEMBER(180);
-	SAMLL_MEMORY_MEMBER(256);
-	SAMLL_MEMORY_MEMBER(320);
-	SAMLL_MEMORY_MEMBER(480);
-	SAMLL_MEMORY_MEMBER(512);
-	SAMLL_MEMORY_MEMBER(800);
-	SAMLL_MEMORY_MEMBER(1024);
-	SAMLL_MEMORY_MEMBER(1500);
-	SAMLL_MEMORY_MEMBER(1800);
-	SAMLL_MEMORY_MEMBER(2048);
-	SAMLL_MEMORY_MEMBER(3000);
-	SAMLL_MEMORY_MEMBER(5000);
-	SAMLL_MEMORY_MEMBER(7000);
-	SAMLL_MEMORY_MEMBER(8000);
-	SAMLL_MEMORY_MEMBER(12000);
-	SAMLL_MEMORY_MEMBER(15000);
-	SAMLL_MEMORY_MEMBER(20000);
-
-#undef SAMLL_MEMORY_MEMBER
-#undef SAMLL_MEMORY_MEMBER_BREAH
-#undef SAMLL_MEMORY_MEMBER_BREAH_FREE
-#undef SAMLL_MEMORY_MEMBER_BREAH_INDEX
-};
-
-static _FORCE_INLINE_ SmallMemoryManager &get_small_memory_manager() {
-	static SmallMemoryManager *s_manager = new (malloc(sizeof(SmallMemoryManager))) SmallMemoryManager();
-	return *s_manager;
+static _FORCE_INLINE_ void *_raw_realloc(void *p_memory, size_t p_bytes) {
+#ifdef SMALL_ALLOCATOR_ENABLED
+	return SmallAllocator::realloc(p_memory, p_bytes);
+#else
+	return realloc(p_memory, p_bytes);
+#endif
 }
+
+static _FORCE_INLINE_ void _raw_free(void *p_memory) {
+#ifdef SMALL_ALLOCATOR_ENABLED
+	SmallAllocator::free(p_memory);
+#else
+	free(p_memory);
 #endif
+}
 
 void *Memory::alloc_aligned_static(size_t p_bytes, size_t p_alignment) {
-#if SAMLL_MEMORY_MANAGER
-	return get_small_memory_manager().alloc_mem(p_bytes);
-#endif
 	DEV_ASSERT(Math::is_power_of_2(p_alignment));
 
 	void *p1, *p2;
-	if ((p1 = (void *)malloc(p_bytes + p_alignment - 1 + sizeof(uint32_t))) == nullptr) {
+	if ((p1 = (void *)_raw_alloc(p_bytes + p_alignment - 1 + sizeof(uint32_t))) == nullptr) {
 		return nullptr;
 	}
 	GodotProfileAlloc(p1, p_bytes + p_alignment - 1 + sizeof(uint32_t));
@@ -313,10 +109,6 @@ void *Memory::alloc_aligned_static(size_t p_bytes, size_t p_alignment) {
 }
 
 void *Memory::realloc_aligned_static(void *p_memory, size_t p_bytes, size_t p_prev_bytes, size_t p_alignment) {
-#if SAMLL_MEMORY_MANAGER
-	return get_small_memory_manager().realloc_mem(p_memory, p_bytes);
-#endif
-
 	if (p_memory == nullptr) {
 		return alloc_aligned_static(p_bytes, p_alignment);
 	}
@@ -330,21 +122,14 @@ void *Memory::realloc_aligned_static(void *p_memory, size_t p_bytes, size_t p_pr
 }
 
 void Memory::free_aligned_static(void *p_memory) {
-#if SAMLL_MEMORY_MANAGER
-	get_small_memory_manager().free_mem(p_memory);
-	return;
-#endif
 	uint32_t offset = *((uint32_t *)p_memory - 1);
 	void *p = (void *)((uint8_t *)p_memory - offset);
 	GodotProfileFree(p);
-	free(p);
+	_raw_free(p);
 }
 
 template <bool p_ensure_zero>
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
-#if SAMLL_MEMORY_MANAGER
-	return get_small_memory_manager().alloc_mem(p_bytes);
-#endif
 #ifdef DEBUG_ENABLED
 	bool prepad = true;
 #else
@@ -353,9 +138,9 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 
 	void *mem;
 	if constexpr (p_ensure_zero) {
-		mem = calloc(1, p_bytes + (prepad ? DATA_OFFSET : 0));
+		mem = _raw_alloc_zeroed(p_bytes + (prepad ? DATA_OFFSET : 0));
 	} else {
-		mem = malloc(p_bytes + (prepad ? DATA_OFFSET : 0));
+		mem = _raw_alloc(p_bytes + (prepad ? DATA_OFFSET : 0));
 	}
 
 	ERR_FAIL_NULL_V(mem, nullptr);
@@ -381,9 +166,6 @@ template void *Memory::alloc_static<true>(size_t p_bytes, bool p_pad_align);
 template void *Memory::alloc_static<false>(size_t p_bytes, bool p_pad_align);
 
 void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
-#if SAMLL_MEMORY_MANAGER
-	return get_small_memory_manager().realloc_mem(p_memory, p_bytes);
-#endif
 	if (p_memory == nullptr) {
 		return alloc_static(p_bytes, p_pad_align);
 	}
@@ -411,13 +193,13 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 		if (p_bytes == 0) {
 			GodotProfileFree(mem);
-			free(mem);
+			_raw_free(mem);
 			return nullptr;
 		} else {
 			*s = p_bytes;
 
 			GodotProfileFree(mem);
-			mem = (uint8_t *)realloc(mem, p_bytes + DATA_OFFSET);
+			mem = (uint8_t *)_raw_realloc(mem, p_bytes + DATA_OFFSET);
 			ERR_FAIL_NULL_V(mem, nullptr);
 			GodotProfileAlloc(mem, p_bytes + DATA_OFFSET);
 
@@ -429,7 +211,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 		}
 	} else {
 		GodotProfileFree(mem);
-		mem = (uint8_t *)realloc(mem, p_bytes);
+		mem = (uint8_t *)_raw_realloc(mem, p_bytes);
 
 		ERR_FAIL_COND_V(mem == nullptr && p_bytes > 0, nullptr);
 		GodotProfileAlloc(mem, p_bytes);
@@ -439,10 +221,6 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 }
 
 void Memory::free_static(void *p_ptr, bool p_pad_align) {
-#if SAMLL_MEMORY_MANAGER
-	get_small_memory_manager().free_mem(p_ptr);
-	return;
-#endif
 	ERR_FAIL_NULL(p_ptr);
 
 	uint8_t *mem = (uint8_t *)p_ptr;
@@ -462,10 +240,10 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 #endif
 
 		GodotProfileFree(mem);
-		free(mem);
+		_raw_free(mem);
 	} else {
 		GodotProfileFree(mem);
-		free(mem);
+		_raw_free(mem);
 	}
 }
 
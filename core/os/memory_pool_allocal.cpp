@@ -1,13 +1,383 @@
 #include "memory_pool_allocal.h"
-MemoryPoolAllocal::Block *MemoryPoolAllocal::Block::s_freeBlock = nullptr;
-Mutex MemoryPoolAllocal::Block::mutex;
+
+#if defined(__GNUC__)
+#define POOL_FLS(x) (31 - __builtin_clz(x))
+#define POOL_FFS(x) __builtin_ctz(x)
+#elif defined(_MSC_VER)
+#include <intrin.h>
+static _FORCE_INLINE_ int _pool_fls(uint32_t x) {
+	unsigned long index;
+	_BitScanReverse(&index, x);
+	return index;
+}
+static _FORCE_INLINE_ int _pool_ffs(uint32_t x) {
+	unsigned long index;
+	_BitScanForward(&index, x);
+	return index;
+}
+#define POOL_FLS(x) _pool_fls(x)
+#define POOL_FFS(x) _pool_ffs(x)
+#endif
+
+// 大小到 (一级, 二级) 桶的映射，小于 SL_COUNT 的大小都放在第 0 级里线性分布。
+static _FORCE_INLINE_ void _pool_mapping(uint32_t p_size, uint32_t &r_fl, uint32_t &r_sl) {
+	if (p_size < MemoryPoolAllocal::SL_COUNT) {
+		r_fl = 0;
+		r_sl = p_size;
+	} else {
+		uint32_t fl = POOL_FLS(p_size);
+		r_sl = (p_size >> (fl - MemoryPoolAllocal::SL_BITS)) ^ MemoryPoolAllocal::SL_COUNT;
+		r_fl = fl - MemoryPoolAllocal::SL_BITS + 1;
+	}
+}
+
+MemoryPoolAllocal::~MemoryPoolAllocal() {
+	release();
+	while (m_block_cache != nullptr) {
+		Block *next = m_block_cache->next;
+		memdelete(m_block_cache);
+		m_block_cache = next;
+	}
+}
+
+MemoryPoolAllocal::Block *MemoryPoolAllocal::_new_block() {
+	Block *block = m_block_cache;
+	if (block != nullptr) {
+		m_block_cache = block->next;
+		*block = Block();
+		return block;
+	}
+	return memnew(Block);
+}
+
+void MemoryPoolAllocal::_recycle_block(Block *p_block) {
+	p_block->next = m_block_cache;
+	m_block_cache = p_block;
+}
+
+void MemoryPoolAllocal::_insert_free(Block *p_block) {
+	uint32_t fl, sl;
+	_pool_mapping(p_block->size, fl, sl);
+	p_block->prev = nullptr;
+	p_block->next = m_free_lists[fl][sl];
+	if (p_block->next != nullptr) {
+		p_block->next->prev = p_block;
+	}
+	m_free_lists[fl][sl] = p_block;
+	m_fl_bitmap |= 1u << fl;
+	m_sl_bitmap[fl] |= 1u << sl;
+	m_free_size += p_block->size;
+	m_free_block_count++;
+}
+
+void MemoryPoolAllocal::_remove_free(Block *p_block) {
+	uint32_t fl, sl;
+	_pool_mapping(p_block->size, fl, sl);
+	if (p_block->prev != nullptr) {
+		p_block->prev->next = p_block->next;
+	} else {
+		m_free_lists[fl][sl] = p_block->next;
+		if (p_block->next == nullptr) {
+			m_sl_bitmap[fl] &= ~(1u << sl);
+			if (m_sl_bitmap[fl] == 0) {
+				m_fl_bitmap &= ~(1u << fl);
+			}
+		}
+	}
+	if (p_block->next != nullptr) {
+		p_block->next->prev = p_block->prev;
+	}
+	p_block->next = nullptr;
+	p_block->prev = nullptr;
+	m_free_size -= p_block->size;
+	m_free_block_count--;
+}
+
+MemoryPoolAllocal::Block *MemoryPoolAllocal::_find_free(uint32_t p_size) {
+	// 先把大小向上取整到下一个桶的起点，这样命中的桶里任何块都放得下。
+	uint64_t search_size = p_size;
+	if (p_size >= SL_COUNT) {
+		search_size += (1u << (POOL_FLS(p_size) - SL_BITS)) - 1;
+	}
+	if (search_size <= UINT32_MAX) {
+		uint32_t fl, sl;
+		_pool_mapping((uint32_t)search_size, fl, sl);
+		uint32_t sl_map = m_sl_bitmap[fl] & (~0u << sl);
+		if (sl_map == 0) {
+			uint32_t fl_map = fl + 1 < 32 ? (m_fl_bitmap & (~0u << (fl + 1))) : 0;
+			if (fl_map != 0) {
+				fl = POOL_FFS(fl_map);
+				sl_map = m_sl_bitmap[fl];
+			}
+		}
+		if (sl_map != 0) {
+			return m_free_lists[fl][POOL_FFS(sl_map)];
+		}
+	}
+
+	// 更大的桶都是空的，在请求大小所在的桶里找一个刚好放得下的。
+	uint32_t fl, sl;
+	_pool_mapping(p_size, fl, sl);
+	for (Block *block = m_free_lists[fl][sl]; block != nullptr; block = block->next) {
+		if (block->size >= p_size) {
+			return block;
+		}
+	}
+	return nullptr;
+}
+
+MemoryPoolAllocal::Block *MemoryPoolAllocal::_merge(Block *p_block, Block *p_next) {
+	p_block->size += p_next->size;
+	p_block->next_physical = p_next->next_physical;
+	if (p_block->next_physical != nullptr) {
+		p_block->next_physical->prev_physical = p_block;
+	} else {
+		m_last_block = p_block;
+	}
+	m_block_map.erase(p_next->offset);
+	m_total_Blocks.erase(p_next);
+	_recycle_block(p_next);
+	return p_block;
+}
+
+void MemoryPoolAllocal::release() {
+	for (auto &entry : m_block_map) {
+		_recycle_block(entry.value);
+	}
+	m_block_map.clear();
+	m_total_Blocks.clear();
+	m_totalMemorySize = 0;
+	m_free_size = 0;
+	m_free_block_count = 0;
+	m_last_block = nullptr;
+	m_fl_bitmap = 0;
+	for (uint32_t fl = 0; fl < FL_COUNT; fl++) {
+		m_sl_bitmap[fl] = 0;
+		for (uint32_t sl = 0; sl < SL_COUNT; sl++) {
+			m_free_lists[fl][sl] = nullptr;
+		}
+	}
+}
+
+MemoryPoolAllocal::Block *MemoryPoolAllocal::add_free_block(int count) {
+	ERR_FAIL_COND_V(count <= 0, nullptr);
+
+	Block *first_block = _new_block();
+	first_block->available = true;
+	first_block->offset = m_totalMemorySize;
+	first_block->size = count;
+	first_block->prev_physical = m_last_block;
+	if (m_last_block != nullptr) {
+		m_last_block->next_physical = first_block;
+	}
+	m_last_block = first_block;
+	m_block_map.insert(first_block->offset, first_block);
+	m_total_Blocks.insert(first_block);
+	m_totalMemorySize += count;
+
+	// 末尾本来就是空闲块时直接接上
+	Block *prev = first_block->prev_physical;
+	if (prev != nullptr && prev->available) {
+		_remove_free(prev);
+		first_block = _merge(prev, first_block);
+	}
+	_insert_free(first_block);
+	return first_block;
+}
+
+MemoryPoolAllocal::Block *MemoryPoolAllocal::allocate(uint32_t requested_size, uint32_t _auto_addcount) {
+	if (requested_size <= 0) {
+		//Debug.LogError($"无法分配{requested_size}内存，数量非法！");
+		return nullptr;
+	}
+
+	Block *best_fit_block = _find_free(requested_size);
+	if (best_fit_block == nullptr) {
+		if (_auto_addcount == 0) {
+			// 如果没有找到合适的内存块，返回nullptr
+			return nullptr;
+		}
+		// 还没有找到，并且允许自动分配就新增一个内存块
+		best_fit_block = add_free_block(MAX(requested_size, _auto_addcount));
+		if (best_fit_block == nullptr) {
+			return nullptr;
+		}
+	}
+
+	_remove_free(best_fit_block);
+
+	// 若分配后还有剩余，把剩余部分切成新的空闲块
+	if (best_fit_block->size > requested_size) {
+		Block *remaining_block = _new_block();
+		remaining_block->offset = best_fit_block->offset + requested_size;
+		remaining_block->size = best_fit_block->size - requested_size;
+		remaining_block->available = true;
+		remaining_block->prev_physical = best_fit_block;
+		remaining_block->next_physical = best_fit_block->next_physical;
+		if (remaining_block->next_physical != nullptr) {
+			remaining_block->next_physical->prev_physical = remaining_block;
+		} else {
+			m_last_block = remaining_block;
+		}
+		best_fit_block->next_physical = remaining_block;
+		best_fit_block->size = requested_size;
+
+		m_block_map.insert(remaining_block->offset, remaining_block);
+		m_total_Blocks.insert(remaining_block);
+		_insert_free(remaining_block);
+	}
+
+	// 标记已分配内存块为不可用
+	best_fit_block->available = false;
+	return best_fit_block;
+}
+
+MemoryPoolAllocal::Block *MemoryPoolAllocal::reduction_memory(Block *block, uint32_t reduction_count) {
+	if (reduction_count == 0) {
+		return block;
+	}
+	if (!m_total_Blocks.has(block) || block->available) {
+		//Debug.LogError("发现外来物种入侵，请弄死他！");
+		return block;
+	}
+	if (reduction_count >= block->size) {
+		//Debug.LogError("你这是要掘地三尺的减少呀！");
+		return block;
+	}
+
+	Block *tail = _new_block();
+	block->size -= reduction_count;
+	tail->offset = block->end();
+	tail->size = reduction_count;
+	tail->available = false;
+	tail->prev_physical = block;
+	tail->next_physical = block->next_physical;
+	if (tail->next_physical != nullptr) {
+		tail->next_physical->prev_physical = tail;
+	} else {
+		m_last_block = tail;
+	}
+	block->next_physical = tail;
+	m_block_map.insert(tail->start(), tail);
+	m_total_Blocks.insert(tail);
+
+	// 切下来的部分当作一次释放，顺便和后面的空闲块合并
+	free_block(tail);
+	return block;
+}
+
+void MemoryPoolAllocal::free_block(int block_offset) {
+	auto it = m_block_map.find(block_offset);
+	if (it != m_block_map.end()) {
+		free_block(it->value);
+
+	} else {
+		//Debug.LogError("非法索引！block_offset 不存在！");
+	}
+}
+
+void MemoryPoolAllocal::free_block(Block *freed_block) {
+	if (!m_total_Blocks.has(freed_block)) {
+		return;
+	}
+	if (freed_block->available == true) {
+		return;
+	}
+	freed_block->available = true;
+
+	// 合并后一个空闲区域
+	Block *next_block = freed_block->next_physical;
+	if (next_block != nullptr && next_block->available) {
+		_remove_free(next_block);
+		freed_block = _merge(freed_block, next_block);
+	}
+
+	// 合并上一个空闲区域
+	Block *prev_block = freed_block->prev_physical;
+	if (prev_block != nullptr && prev_block->available) {
+		_remove_free(prev_block);
+		freed_block = _merge(prev_block, freed_block);
+	}
+
+	_insert_free(freed_block);
+}
+
+uint64_t MemoryPoolAllocal::get_largest_free_block_size() const {
+	if (m_fl_bitmap == 0) {
+		return 0;
+	}
+	// 最大的块一定在最高的非空桶里
+	uint32_t fl = POOL_FLS(m_fl_bitmap);
+	uint32_t sl = POOL_FLS(m_sl_bitmap[fl]);
+	uint64_t largest = 0;
+	for (const Block *block = m_free_lists[fl][sl]; block != nullptr; block = block->next) {
+		largest = MAX(largest, (uint64_t)block->size);
+	}
+	return largest;
+}
+
+double MemoryPoolAllocal::get_fragmentation() const {
+	if (m_free_size == 0) {
+		return 0.0;
+	}
+	return 1.0 - (double)get_largest_free_block_size() / (double)m_free_size;
+}
+
+MemoryPoolAllocal::Block *MemoryPoolAllocal::_get_used_block(int64_t p_block) const {
+	if (p_block < 0 || p_block > INT32_MAX) {
+		return nullptr;
+	}
+	Block *const *block = m_block_map.getptr((int)p_block);
+	if (block == nullptr || (*block)->available) {
+		return nullptr;
+	}
+	return *block;
+}
+
+int64_t MemoryPoolAllocal::allocate_imp(uint32_t p_size) {
+	Block *block = allocate(p_size);
+	if (block == nullptr) {
+		return -1;
+	}
+	return block->offset;
+}
+
+void MemoryPoolAllocal::free_imp(int64_t p_block) {
+	Block *block = _get_used_block(p_block);
+	ERR_FAIL_NULL_MSG(block, vformat("Invalid block %d, it isn't allocated from this pool.", p_block));
+	free_block(block);
+}
+
+int MemoryPoolAllocal::get_block_size(int64_t p_block) const {
+	const Block *block = _get_used_block(p_block);
+	ERR_FAIL_NULL_V_MSG(block, 0, vformat("Invalid block %d, it isn't allocated from this pool.", p_block));
+	return block->size;
+}
+
+int MemoryPoolAllocal::get_block_offset(int64_t p_block) const {
+	const Block *block = _get_used_block(p_block);
+	ERR_FAIL_NULL_V_MSG(block, 0, vformat("Invalid block %d, it isn't allocated from this pool.", p_block));
+	return block->offset;
+}
+
+int MemoryPoolAllocal::get_block_end(int64_t p_block) const {
+	const Block *block = _get_used_block(p_block);
+	ERR_FAIL_NULL_V_MSG(block, 0, vformat("Invalid block %d, it isn't allocated from this pool.", p_block));
+	return block->offset + block->size;
+}
 
 void MemoryPoolAllocal::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("allocate", "count"), &MemoryPoolAllocal::allocate_imp);
 	ClassDB::bind_method(D_METHOD("free_block", "block"), &MemoryPoolAllocal::free_imp);
 	ClassDB::bind_method(D_METHOD("get_total_memory_size"), &MemoryPoolAllocal::get_total_memory_size);
+	ClassDB::bind_method(D_METHOD("get_free_memory_size"), &MemoryPoolAllocal::get_free_memory_size);
+	ClassDB::bind_method(D_METHOD("get_used_memory_size"), &MemoryPoolAllocal::get_used_memory_size);
+	ClassDB::bind_method(D_METHOD("get_free_block_count"), &MemoryPoolAllocal::get_free_block_count);
+	ClassDB::bind_method(D_METHOD("get_used_block_count"), &MemoryPoolAllocal::get_used_block_count);
+	ClassDB::bind_method(D_METHOD("get_largest_free_block_size"), &MemoryPoolAllocal::get_largest_free_block_size);
+	ClassDB::bind_method(D_METHOD("get_fragmentation"), &MemoryPoolAllocal::get_fragmentation);
 
-	ClassDB::bind_static_method("MemoryPoolAllocal", D_METHOD("get_block_offset", "block"), &MemoryPoolAllocal::get_block_offset);
-	ClassDB::bind_static_method("MemoryPoolAllocal", D_METHOD("get_block_end", "block"), &MemoryPoolAllocal::get_block_end);
-	ClassDB::bind_static_method("MemoryPoolAllocal", D_METHOD("get_block_size", "block"), &MemoryPoolAllocal::get_block_size);
-}
\ No newline at end of file
+	ClassDB::bind_method(D_METHOD("get_block_offset", "block"), &MemoryPoolAllocal::get_block_offset);
+	ClassDB::bind_method(D_METHOD("get_block_end", "block"), &MemoryPoolAllocal::get_block_end);
+	ClassDB::bind_method(D_METHOD("get_block_size", "block"), &MemoryPoolAllocal::get_block_size);
+}
@@ -0,0 +1,326 @@
+/**************************************************************************/
+/*  small_allocator.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "small_allocator.h"
+
+#include "core/os/memory.h"
+#include "core/os/spin_lock.h"
+#include "core/templates/safe_refcount.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+
+struct BlockHeader {
+	uint64_t size; // Requested size, only meaningful for large blocks.
+	uint32_t size_class; // LARGE_CLASS for blocks from malloc.
+	uint32_t padding;
+};
+
+static_assert(sizeof(BlockHeader) % Memory::MAX_ALIGN == 0);
+
+constexpr uint32_t LARGE_CLASS = UINT32_MAX;
+constexpr uint32_t SPAN_SIZE = 64 * 1024;
+constexpr uint32_t CACHE_BYTES = 16 * 1024; // Upper bound of each per-thread list, in bytes.
+
+struct FreeBlock {
+	FreeBlock *next;
+};
+
+// 16 byte steps up to 128, then four classes per power of two.
+struct SizeClassTable {
+	uint32_t block_size[SmallAllocator::SIZE_CLASS_COUNT] = {};
+	uint32_t batch_count[SmallAllocator::SIZE_CLASS_COUNT] = {};
+	uint8_t class_for_units[(SmallAllocator::MAX_SMALL_SIZE + sizeof(BlockHeader)) / 16 + 1] = {};
+
+	constexpr SizeClassTable() {
+		for (uint32_t i = 0; i < SmallAllocator::SIZE_CLASS_COUNT; i++) {
+			uint32_t size = 0;
+			if (i < 8) {
+				size = (i + 1) * 16;
+			} else {
+				uint32_t group = (i - 8) / 4;
+				uint32_t step = (i - 8) % 4;
+				size = (128u << group) + (step + 1) * (32u << group);
+			}
+			block_size[i] = size;
+			uint32_t batch = SPAN_SIZE / 4 / size;
+			batch_count[i] = batch < 4 ? 4 : (batch > 64 ? 64 : batch);
+		}
+		uint32_t c = 0;
+		for (uint32_t units = 0; units < std_size(class_for_units); units++) {
+			while (c < SmallAllocator::SIZE_CLASS_COUNT - 1 && block_size[c] < units * 16) {
+				c++;
+			}
+			class_for_units[units] = c;
+		}
+	}
+};
+
+constexpr SizeClassTable size_classes;
+
+static_assert(size_classes.block_size[SmallAllocator::SIZE_CLASS_COUNT - 1] >= SmallAllocator::MAX_SMALL_SIZE + sizeof(BlockHeader));
+
+struct CentralList {
+	SpinLock lock;
+	FreeBlock *head = nullptr;
+	uint8_t *span_pos = nullptr; // Uncarved tail of the most recent span.
+	uint8_t *span_end = nullptr;
+};
+
+CentralList central_lists[SmallAllocator::SIZE_CLASS_COUNT];
+SafeNumeric<uint64_t> span_bytes;
+
+struct ThreadCache {
+	FreeBlock *head[SmallAllocator::SIZE_CLASS_COUNT] = {};
+	uint32_t count[SmallAllocator::SIZE_CLASS_COUNT] = {};
+
+	~ThreadCache();
+};
+
+thread_local ThreadCache thread_cache;
+// Trivially destructible, so it stays valid while (and after) thread_cache is being destroyed.
+thread_local bool thread_cache_destroyed = false;
+
+_FORCE_INLINE_ uint32_t _get_size_class(size_t p_block_bytes) {
+	return size_classes.class_for_units[(p_block_bytes + 15) >> 4];
+}
+
+// Takes up to p_count blocks from the central list, carving a new span if it runs dry.
+// Returns the chain and stores its length in r_taken.
+FreeBlock *_central_take(uint32_t p_class, uint32_t p_count, uint32_t &r_taken) {
+	CentralList &list = central_lists[p_class];
+	const uint32_t block_size = size_classes.block_size[p_class];
+
+	list.lock.lock();
+
+	FreeBlock *first = nullptr;
+	FreeBlock **tail = &first;
+	uint32_t taken = 0;
+
+	while (taken < p_count && list.head) {
+		*tail = list.head;
+		tail = &list.head->next;
+		list.head = list.head->next;
+		taken++;
+	}
+
+	while (taken < p_count) {
+		if (list.span_pos + block_size > list.span_end) {
+			if (taken > 0) {
+				break; // Don't grab a new span just to top up the batch.
+			}
+			uint8_t *span = (uint8_t *)malloc(SPAN_SIZE);
+			if (span == nullptr) {
+				break;
+			}
+			span_bytes.add(SPAN_SIZE);
+			list.span_pos = span;
+			list.span_end = span + SPAN_SIZE;
+		}
+		FreeBlock *block = (FreeBlock *)list.span_pos;
+		list.span_pos += block_size;
+		*tail = block;
+		tail = &block->next;
+		taken++;
+	}
+
+	*tail = nullptr;
+	list.lock.unlock();
+
+	r_taken = taken;
+	return first;
+}
+
+void _central_give(uint32_t p_class, FreeBlock *p_first, FreeBlock *p_last) {
+	CentralList &list = central_lists[p_class];
+	list.lock.lock();
+	p_last->next = list.head;
+	list.head = p_first;
+	list.lock.unlock();
+}
+
+ThreadCache::~ThreadCache() {
+	thread_cache_destroyed = true;
+	for (uint32_t i = 0; i < SmallAllocator::SIZE_CLASS_COUNT; i++) {
+		if (head[i] == nullptr) {
+			continue;
+		}
+		FreeBlock *last = head[i];
+		while (last->next) {
+			last = last->next;
+		}
+		_central_give(i, head[i], last);
+		head[i] = nullptr;
+		count[i] = 0;
+	}
+}
+
+void *_alloc_small(uint32_t p_class) {
+	FreeBlock *block;
+	if (likely(!thread_cache_destroyed)) {
+		ThreadCache &cache = thread_cache;
+		block = cache.head[p_class];
+		if (unlikely(block == nullptr)) {
+			uint32_t taken = 0;
+			block = _central_take(p_class, size_classes.batch_count[p_class], taken);
+			if (block == nullptr) {
+				return nullptr;
+			}
+			cache.count[p_class] = taken;
+		}
+		cache.head[p_class] = block->next;
+		cache.count[p_class]--;
+	} else {
+		uint32_t taken = 0;
+		block = _central_take(p_class, 1, taken);
+		if (block == nullptr) {
+			return nullptr;
+		}
+	}
+
+	BlockHeader *header = (BlockHeader *)block;
+	header->size_class = p_class;
+	return header + 1;
+}
+
+void _free_small(BlockHeader *p_header, uint32_t p_class) {
+	FreeBlock *block = (FreeBlock *)p_header;
+	if (unlikely(thread_cache_destroyed)) {
+		_central_give(p_class, block, block);
+		return;
+	}
+
+	ThreadCache &cache = thread_cache;
+	block->next = cache.head[p_class];
+	cache.head[p_class] = block;
+	cache.count[p_class]++;
+
+	const uint32_t batch = size_classes.batch_count[p_class];
+	if (unlikely(cache.count[p_class] > batch && cache.count[p_class] * size_classes.block_size[p_class] > CACHE_BYTES)) {
+		// Hand a batch back so other threads can reuse it.
+		FreeBlock *first = cache.head[p_class];
+		FreeBlock *last = first;
+		for (uint32_t i = 1; i < batch; i++) {
+			last = last->next;
+		}
+		cache.head[p_class] = last->next;
+		cache.count[p_class] -= batch;
+		_central_give(p_class, first, last);
+	}
+}
+
+void *_alloc_large(size_t p_bytes, bool p_zeroed) {
+	BlockHeader *header = (BlockHeader *)(p_zeroed ? calloc(1, p_bytes + sizeof(BlockHeader)) : malloc(p_bytes + sizeof(BlockHeader)));
+	if (header == nullptr) {
+		return nullptr;
+	}
+	header->size = p_bytes;
+	header->size_class = LARGE_CLASS;
+	return header + 1;
+}
+
+} // namespace
+
+void *SmallAllocator::alloc(size_t p_bytes) {
+	if (p_bytes <= MAX_SMALL_SIZE) {
+		return _alloc_small(_get_size_class(p_bytes + sizeof(BlockHeader)));
+	}
+	return _alloc_large(p_bytes, false);
+}
+
+void *SmallAllocator::alloc_zeroed(size_t p_bytes) {
+	if (p_bytes <= MAX_SMALL_SIZE) {
+		void *mem = _alloc_small(_get_size_class(p_bytes + sizeof(BlockHeader)));
+		if (mem) {
+			memset(mem, 0, p_bytes);
+		}
+		return mem;
+	}
+	return _alloc_large(p_bytes, true);
+}
+
+void *SmallAllocator::realloc(void *p_memory, size_t p_bytes) {
+	if (p_memory == nullptr) {
+		return alloc(p_bytes);
+	}
+	if (p_bytes == 0) {
+		free(p_memory);
+		return nullptr;
+	}
+
+	BlockHeader *header = (BlockHeader *)p_memory - 1;
+	if (header->size_class == LARGE_CLASS) {
+		if (p_bytes > MAX_SMALL_SIZE) {
+			header = (BlockHeader *)::realloc(header, p_bytes + sizeof(BlockHeader));
+			if (header == nullptr) {
+				return nullptr;
+			}
+			header->size = p_bytes;
+			return header + 1;
+		}
+	} else if (p_bytes <= MAX_SMALL_SIZE && _get_size_class(p_bytes + sizeof(BlockHeader)) == header->size_class) {
+		return p_memory; // Still fits the same class.
+	}
+
+	void *new_memory = alloc(p_bytes);
+	if (new_memory == nullptr) {
+		return nullptr;
+	}
+	size_t old_bytes = get_usable_size(p_memory);
+	memcpy(new_memory, p_memory, MIN(old_bytes, p_bytes));
+	free(p_memory);
+	return new_memory;
+}
+
+void SmallAllocator::free(void *p_memory) {
+	if (p_memory == nullptr) {
+		return;
+	}
+	BlockHeader *header = (BlockHeader *)p_memory - 1;
+	if (header->size_class == LARGE_CLASS) {
+		::free(header);
+	} else {
+		_free_small(header, header->size_class);
+	}
+}
+
+size_t SmallAllocator::get_usable_size(const void *p_memory) {
+	const BlockHeader *header = (const BlockHeader *)p_memory - 1;
+	if (header->size_class == LARGE_CLASS) {
+		return header->size;
+	}
+	return size_classes.block_size[header->size_class] - sizeof(BlockHeader);
+}
+
+uint64_t SmallAllocator::get_span_bytes() {
+	return span_bytes.get();
+}
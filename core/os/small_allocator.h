@@ -0,0 +1,60 @@
+/**************************************************************************/
+/*  small_allocator.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/typedefs.h"
+
+// Size-class allocator used by Memory::alloc_static when the engine is built
+// with `small_allocator=yes` (SMALL_ALLOCATOR_ENABLED).
+//
+// Requests up to MAX_SMALL_SIZE bytes are rounded up to one of a fixed set of
+// size classes and served from per-thread free lists, which only touch the
+// shared per-class lists (and their lock) in batches. Blocks are carved from
+// spans that are never returned to the system; memory freed on one thread is
+// reused by any thread through the shared lists. Larger requests go to malloc.
+//
+// Every block is prefixed by a small header recording its size class, so the
+// allocator works with any pointer layout Memory uses on top of it.
+class SmallAllocator {
+public:
+	static constexpr uint32_t MAX_SMALL_SIZE = 4096 - 16; // Largest size class, minus the block header.
+	static constexpr uint32_t SIZE_CLASS_COUNT = 28;
+
+	static void *alloc(size_t p_bytes);
+	static void *alloc_zeroed(size_t p_bytes);
+	static void *realloc(void *p_memory, size_t p_bytes);
+	static void free(void *p_memory);
+
+	// Bytes usable by the caller in a block returned by this allocator.
+	static size_t get_usable_size(const void *p_memory);
+	// Total bytes taken from the system for small block spans.
+	static uint64_t get_span_bytes();
+};
@@ -52,6 +52,7 @@
 #include "core/io/image_frames_loader.h"
 #include "core/io/image_loader.h"
 #include "core/io/json.h"
+#include "core/io/json_document.h"
 #include "core/io/marshalls.h"
 #include "core/io/missing_resource.h"
 #include "core/io/packet_peer.h"
@@ -63,11 +64,14 @@
 #include "core/io/resource_uid.h"
 #include "core/io/stream_peer_gzip.h"
 #include "core/io/stream_peer_tls.h"
+#include "core/io/stream_peer_zstd.h"
 #include "core/io/tcp_server.h"
 #include "core/io/translation_loader_po.h"
 #include "core/io/udp_server.h"
+#include "core/io/variant_schema.h"
 #include "core/io/uds_server.h"
 #include "core/io/xml_parser.h"
+#include "core/io/zstd_dictionary.h"
 #include "core/math/a_star.h"
 #include "core/math/a_star_grid_2d.h"
 #include "core/math/expression.h"
@@ -195,6 +199,7 @@ void register_core_types() {
 	GDREGISTER_CLASS(MissingResource);
 	GDREGISTER_CLASS(TaskJobDependCounter);
 	GDREGISTER_CLASS(TaskJobHandle);
+	GDREGISTER_CLASS(MemoryPoolAllocal);
 	GDREGISTER_CLASS(Image);
 	GDREGISTER_CLASS(ImageFrames);
 
@@ -224,6 +229,7 @@ void register_core_types() {
 	GDREGISTER_CLASS(StreamPeerExtension);
 	GDREGISTER_CLASS(StreamPeerBuffer);
 	GDREGISTER_CLASS(StreamPeerGZIP);
+	GDREGISTER_CLASS(StreamPeerZSTD);
 	GDREGISTER_CLASS(StreamPeerTCP);
 	GDREGISTER_CLASS(TCPServer);
 
@@ -285,6 +291,9 @@ void register_core_types() {
 
 	GDREGISTER_CLASS(XMLParser);
 	GDREGISTER_CLASS(JSON);
+	GDREGISTER_CLASS(JSONDocument);
+	GDREGISTER_CLASS(ZSTDDictionary);
+	GDREGISTER_CLASS(VariantSchema);
 
 	GDREGISTER_CLASS(ConfigFile);
 
@@ -39,9 +39,24 @@ struct StringName::Table {
 	constexpr static uint32_t TABLE_LEN = 1 << TABLE_BITS;
 	constexpr static uint32_t TABLE_MASK = TABLE_LEN - 1;
 
+	// Buckets are guarded by one of STRIPE_COUNT locks (picked by the low bits of the
+	// bucket index), so threads interning or releasing unrelated names rarely contend.
+	// Each stripe allocates its own entries, so no global lock is left on these paths.
+	constexpr static uint32_t STRIPE_BITS = 6;
+	constexpr static uint32_t STRIPE_COUNT = 1 << STRIPE_BITS;
+	constexpr static uint32_t STRIPE_MASK = STRIPE_COUNT - 1;
+
+	struct alignas(64) Stripe {
+		BinaryMutex mutex;
+		PagedAllocator<_Data, false, 256> allocator;
+	};
+
 	static inline _Data *table[TABLE_LEN];
-	static inline BinaryMutex mutex;
-	static inline PagedAllocator<_Data> allocator;
+	static inline Stripe stripes[STRIPE_COUNT];
+
+	_FORCE_INLINE_ static Stripe &get_stripe(uint32_t p_idx) {
+		return stripes[p_idx & STRIPE_MASK];
+	}
 };
 
 void StringName::setup() {
@@ -53,7 +68,6 @@ void StringName::setup() {
 }
 
 void StringName::cleanup() {
-	MutexLock lock(Table::mutex);
 
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
@@ -86,6 +100,8 @@ void StringName::cleanup() {
 #endif
 	int lost_strings = 0;
 	for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
+		Table::Stripe &stripe = Table::get_stripe(i);
+		MutexLock lock(stripe.mutex);
 		while (Table::table[i]) {
 			_Data *d = Table::table[i];
 			if (d->static_count.get() != d->refcount.get()) {
@@ -97,7 +113,7 @@ void StringName::cleanup() {
 			}
 
 			Table::table[i] = Table::table[i]->next;
-			Table::allocator.free(d);
+			stripe.allocator.free(d);
 		}
 	}
 	if (lost_strings) {
@@ -110,7 +126,9 @@ void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(Table::mutex);
+		const uint32_t idx = _data->hash & Table::TABLE_MASK;
+		Table::Stripe &stripe = Table::get_stripe(idx);
+		MutexLock lock(stripe.mutex);
 
 		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
 			ERR_PRINT("BUG: Unreferenced static string to 0: " + _data->name);
@@ -118,14 +136,13 @@ void StringName::unref() {
 		if (_data->prev) {
 			_data->prev->next = _data->next;
 		} else {
-			const uint32_t idx = _data->hash & Table::TABLE_MASK;
 			Table::table[idx] = _data->next;
 		}
 
 		if (_data->next) {
 			_data->next->prev = _data->prev;
 		}
-		Table::allocator.free(_data);
+		stripe.allocator.free(_data);
 	}
 
 	_data = nullptr;
@@ -213,7 +230,8 @@ StringName::StringName(const char *p_name, bool p_static) {
 	const uint32_t hash = String::hash(p_name);
 	const uint32_t idx = hash & Table::TABLE_MASK;
 
-	MutexLock lock(Table::mutex);
+	Table::Stripe &stripe = Table::get_stripe(idx);
+	MutexLock lock(stripe.mutex);
 	_data = Table::table[idx];
 
 	while (_data) {
@@ -237,7 +255,7 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return;
 	}
 
-	_data = Table::allocator.alloc();
+	_data = stripe.allocator.alloc();
 	_data->name = p_name;
 	if (_data->name.length() <= 24) {
 		_data->refcount.init(2);
@@ -274,7 +292,8 @@ StringName::StringName(const String &p_name, bool p_static) {
 	const uint32_t hash = p_name.hash();
 	const uint32_t idx = hash & Table::TABLE_MASK;
 
-	MutexLock lock(Table::mutex);
+	Table::Stripe &stripe = Table::get_stripe(idx);
+	MutexLock lock(stripe.mutex);
 	_data = Table::table[idx];
 
 	while (_data) {
@@ -297,7 +316,7 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	_data = Table::allocator.alloc();
+	_data = stripe.allocator.alloc();
 	_data->name = p_name;
 	if (_data->name.length() <= 24) {
 		_data->refcount.init(2);
@@ -2747,8 +2747,8 @@ done:
 #define READING_EXP 3
 #define READING_DONE 4
 
-double String::to_float(const char *p_str) {
-	return built_in_strtod<char>(p_str);
+double String::to_float(const char *p_str, const char **r_end) {
+	return built_in_strtod<char>(p_str, (char **)r_end);
 }
 
 double String::to_float(const char32_t *p_str, const char32_t **r_end) {
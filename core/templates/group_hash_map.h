@@ -0,0 +1,813 @@
+/**************************************************************************/
+/*  group_hash_map.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/math_funcs_binary.h"
+#include "core/os/memory.h"
+#include "core/string/print_string.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/pair.h"
+
+#include <initializer_list>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GROUP_HASH_MAP_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define GROUP_HASH_MAP_NEON
+#include <arm_neon.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+class String;
+class StringName;
+class Variant;
+
+// A 16 byte window over the control bytes of a GroupHashMap, compared all at once.
+struct GroupHashMapGroup {
+	static constexpr uint32_t SIZE = 16;
+
+	// Control byte values. Full slots store the low 7 bits of the hash, so the high bit is clear.
+	static constexpr uint8_t CTRL_EMPTY = 0x80;
+	static constexpr uint8_t CTRL_DELETED = 0xFE;
+
+	// One bit (NEON: one nibble) per matching slot, lowest slot first.
+	struct Mask {
+#ifdef GROUP_HASH_MAP_NEON
+		static constexpr uint32_t SHIFT = 2;
+#else
+		static constexpr uint32_t SHIFT = 0;
+#endif
+		uint64_t bits;
+
+		_FORCE_INLINE_ explicit operator bool() const { return bits != 0; }
+		_FORCE_INLINE_ uint32_t lowest() const {
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_ctzll(bits) >> SHIFT;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+			unsigned long index;
+			_BitScanForward64(&index, bits);
+			return index >> SHIFT;
+#else
+			uint32_t index = 0;
+			while (!((bits >> index) & 1)) {
+				index++;
+			}
+			return index >> SHIFT;
+#endif
+		}
+		_FORCE_INLINE_ void clear_lowest() { bits &= bits - 1; }
+	};
+
+#if defined(GROUP_HASH_MAP_SSE2)
+	__m128i ctrl;
+
+	_FORCE_INLINE_ explicit GroupHashMapGroup(const uint8_t *p_ctrl) {
+		ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_ctrl));
+	}
+	_FORCE_INLINE_ Mask match(uint8_t p_h2) const {
+		return Mask{ (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)p_h2))) };
+	}
+	_FORCE_INLINE_ Mask match_empty() const {
+		return match(CTRL_EMPTY);
+	}
+	_FORCE_INLINE_ Mask match_empty_or_deleted() const {
+		// Both special values have the high bit set.
+		return Mask{ (uint64_t)(uint32_t)_mm_movemask_epi8(ctrl) };
+	}
+#elif defined(GROUP_HASH_MAP_NEON)
+	uint8x16_t ctrl;
+
+	_FORCE_INLINE_ explicit GroupHashMapGroup(const uint8_t *p_ctrl) {
+		ctrl = vld1q_u8(p_ctrl);
+	}
+	static _FORCE_INLINE_ Mask _to_mask(uint8x16_t p_cmp) {
+		// Narrow each 0x00/0xFF byte to a nibble, keep one bit per nibble.
+		uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(p_cmp), 4);
+		return Mask{ vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & 0x8888888888888888ull };
+	}
+	_FORCE_INLINE_ Mask match(uint8_t p_h2) const {
+		return _to_mask(vceqq_u8(ctrl, vdupq_n_u8(p_h2)));
+	}
+	_FORCE_INLINE_ Mask match_empty() const {
+		return match(CTRL_EMPTY);
+	}
+	_FORCE_INLINE_ Mask match_empty_or_deleted() const {
+		return _to_mask(vcltq_s8(vreinterpretq_s8_u8(ctrl), vdupq_n_s8(0)));
+	}
+#else
+	const uint8_t *ctrl;
+
+	_FORCE_INLINE_ explicit GroupHashMapGroup(const uint8_t *p_ctrl) {
+		ctrl = p_ctrl;
+	}
+	_FORCE_INLINE_ Mask match(uint8_t p_h2) const {
+		uint64_t bits = 0;
+		for (uint32_t i = 0; i < SIZE; i++) {
+			bits |= uint64_t(ctrl[i] == p_h2) << i;
+		}
+		return Mask{ bits };
+	}
+	_FORCE_INLINE_ Mask match_empty() const {
+		return match(CTRL_EMPTY);
+	}
+	_FORCE_INLINE_ Mask match_empty_or_deleted() const {
+		uint64_t bits = 0;
+		for (uint32_t i = 0; i < SIZE; i++) {
+			bits |= uint64_t(ctrl[i] >> 7) << i;
+		}
+		return Mask{ bits };
+	}
+#endif
+};
+
+/**
+ * A variant of AHashMap that probes its table 16 slots at a time, Swiss table style.
+ *
+ * Elements live in a dense array exactly like in AHashMap (same API, same index and
+ * erase semantics), but the table only keeps one control byte per slot, holding 7 bits
+ * of the hash. A lookup compares a whole group of control bytes against those bits
+ * with one SSE2/NEON instruction and only touches the elements whose bits match,
+ * which keeps long collision chains and failed lookups cheap.
+ *
+ * Prefer it over AHashMap for large, lookup-heavy maps (e.g. per-class method tables).
+ * For a handful of elements AHashMap is just as fast and smaller.
+ */
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class GroupHashMap {
+public:
+	// Must be a power of two, and at least one group.
+	static constexpr uint32_t INITIAL_CAPACITY = GroupHashMapGroup::SIZE;
+
+private:
+	typedef GroupHashMapGroup Group;
+	typedef KeyValue<TKey, TValue> MapKeyValue;
+
+	MapKeyValue *_elements = nullptr;
+	uint32_t *_hashes = nullptr; // Full hash of each element, to rehash and relocate without calling Hasher.
+	uint8_t *_ctrl = nullptr; // One byte per slot, plus a copy of the first group at the end for unaligned loads.
+	uint32_t *_slots = nullptr; // Element index of each full slot.
+
+	// Due to optimization, this is `capacity - 1`. Use + 1 to get normal capacity.
+	uint32_t _capacity_mask = INITIAL_CAPACITY - 1;
+	uint32_t _size = 0;
+	uint32_t _deleted = 0;
+
+	static _FORCE_INLINE_ uint32_t _get_max_load(uint32_t p_capacity_mask) {
+		return (p_capacity_mask + 1) - ((p_capacity_mask + 1) >> 3); // 7/8 of the capacity.
+	}
+
+	static _FORCE_INLINE_ uint8_t _h2(uint32_t p_hash) { return p_hash & 0x7F; }
+	static _FORCE_INLINE_ uint32_t _h1(uint32_t p_hash) { return p_hash >> 7; }
+
+	_FORCE_INLINE_ void _set_ctrl(uint32_t p_slot, uint8_t p_value) {
+		_ctrl[p_slot] = p_value;
+		if (p_slot < Group::SIZE) {
+			_ctrl[_capacity_mask + 1 + p_slot] = p_value;
+		}
+	}
+
+	bool _lookup_idx_with_hash(const TKey &p_key, uint32_t &r_element_idx, uint32_t &r_slot, uint32_t p_hash) const {
+		if (unlikely(_elements == nullptr)) {
+			return false; // Failed lookups, no _elements.
+		}
+
+		const uint8_t h2 = _h2(p_hash);
+		uint32_t pos = _h1(p_hash) & _capacity_mask;
+		uint32_t step = 0;
+		while (true) {
+			Group group(_ctrl + pos);
+			for (Group::Mask match = group.match(h2); match; match.clear_lowest()) {
+				uint32_t slot = (pos + match.lowest()) & _capacity_mask;
+				uint32_t element_idx = _slots[slot];
+				if (_hashes[element_idx] == p_hash && Comparator::compare(_elements[element_idx].key, p_key)) {
+					r_element_idx = element_idx;
+					r_slot = slot;
+					return true;
+				}
+			}
+			if (group.match_empty()) {
+				return false;
+			}
+			// Triangular probing over groups visits every group once when the capacity is a power of two.
+			step += Group::SIZE;
+			pos = (pos + step) & _capacity_mask;
+		}
+	}
+
+	bool _lookup_idx(const TKey &p_key, uint32_t &r_element_idx, uint32_t &r_slot) const {
+		if (unlikely(_elements == nullptr)) {
+			return false; // Failed lookups, no _elements.
+		}
+		return _lookup_idx_with_hash(p_key, r_element_idx, r_slot, Hasher::hash(p_key));
+	}
+
+	// Slot currently pointing at p_element_idx.
+	uint32_t _find_slot_of_element(uint32_t p_element_idx) const {
+		const uint32_t hash = _hashes[p_element_idx];
+		const uint8_t h2 = _h2(hash);
+		uint32_t pos = _h1(hash) & _capacity_mask;
+		uint32_t step = 0;
+		while (true) {
+			Group group(_ctrl + pos);
+			for (Group::Mask match = group.match(h2); match; match.clear_lowest()) {
+				uint32_t slot = (pos + match.lowest()) & _capacity_mask;
+				if (_slots[slot] == p_element_idx) {
+					return slot;
+				}
+			}
+			step += Group::SIZE;
+			pos = (pos + step) & _capacity_mask;
+		}
+	}
+
+	void _insert_slot(uint32_t p_hash, uint32_t p_element_idx) {
+		uint32_t pos = _h1(p_hash) & _capacity_mask;
+		uint32_t step = 0;
+		while (true) {
+			Group::Mask free_slots = Group(_ctrl + pos).match_empty_or_deleted();
+			if (free_slots) {
+				uint32_t slot = (pos + free_slots.lowest()) & _capacity_mask;
+				if (_ctrl[slot] == Group::CTRL_DELETED) {
+					_deleted--;
+				}
+				_set_ctrl(slot, _h2(p_hash));
+				_slots[slot] = p_element_idx;
+				return;
+			}
+			step += Group::SIZE;
+			pos = (pos + step) & _capacity_mask;
+		}
+	}
+
+	void _allocate_table() {
+		const uint32_t capacity = _capacity_mask + 1;
+		_ctrl = reinterpret_cast<uint8_t *>(Memory::alloc_static(capacity + Group::SIZE));
+		memset(_ctrl, Group::CTRL_EMPTY, capacity + Group::SIZE);
+		_slots = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * capacity));
+		_deleted = 0;
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity) {
+		// Capacity can't be smaller than one group and must be 2^n.
+		_capacity_mask = Math::next_power_of_2(MAX(INITIAL_CAPACITY, p_new_capacity)) - 1;
+
+		Memory::free_static(_ctrl);
+		Memory::free_static(_slots);
+		_allocate_table();
+
+		const uint32_t max_load = _get_max_load(_capacity_mask);
+		_elements = reinterpret_cast<MapKeyValue *>(Memory::realloc_static(_elements, sizeof(MapKeyValue) * max_load));
+		_hashes = reinterpret_cast<uint32_t *>(Memory::realloc_static(_hashes, sizeof(uint32_t) * max_load));
+
+		for (uint32_t i = 0; i < _size; i++) {
+			_insert_slot(_hashes[i], i);
+		}
+	}
+
+	int32_t _insert_element(const TKey &p_key, const TValue &p_value, uint32_t p_hash) {
+		if (unlikely(_elements == nullptr)) {
+			// Allocate on demand to save memory.
+			_allocate_table();
+			const uint32_t max_load = _get_max_load(_capacity_mask);
+			_elements = reinterpret_cast<MapKeyValue *>(Memory::alloc_static(sizeof(MapKeyValue) * max_load));
+			_hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * max_load));
+		}
+
+		// Keep at least one empty slot so failed lookups terminate; tombstones count as taken.
+		const uint32_t max_load = _get_max_load(_capacity_mask);
+		if (unlikely(_size + _deleted + 1 >= max_load)) {
+			if (_size + 1 >= max_load) {
+				_resize_and_rehash((_capacity_mask + 1) * 2);
+			} else {
+				_resize_and_rehash(_capacity_mask + 1); // Only clears tombstones.
+			}
+		}
+
+		memnew_placement(&_elements[_size], MapKeyValue(p_key, p_value));
+		_hashes[_size] = p_hash;
+
+		_insert_slot(p_hash, _size);
+		_size++;
+		return _size - 1;
+	}
+
+	void _init_from(const GroupHashMap &p_other) {
+		_capacity_mask = p_other._capacity_mask;
+		_size = p_other._size;
+		_deleted = p_other._deleted;
+
+		if (p_other._elements == nullptr) {
+			return;
+		}
+
+		const uint32_t capacity = _capacity_mask + 1;
+		const uint32_t max_load = _get_max_load(_capacity_mask);
+		_ctrl = reinterpret_cast<uint8_t *>(Memory::alloc_static(capacity + Group::SIZE));
+		_slots = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * capacity));
+		_elements = reinterpret_cast<MapKeyValue *>(Memory::alloc_static(sizeof(MapKeyValue) * max_load));
+		_hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * max_load));
+
+		if constexpr (std::is_trivially_copyable_v<TKey> && std::is_trivially_copyable_v<TValue>) {
+			void *destination = _elements;
+			const void *source = p_other._elements;
+			memcpy(destination, source, sizeof(MapKeyValue) * _size);
+		} else {
+			for (uint32_t i = 0; i < _size; i++) {
+				memnew_placement(&_elements[i], MapKeyValue(p_other._elements[i]));
+			}
+		}
+
+		memcpy(_hashes, p_other._hashes, sizeof(uint32_t) * _size);
+		memcpy(_ctrl, p_other._ctrl, capacity + Group::SIZE);
+		memcpy(_slots, p_other._slots, sizeof(uint32_t) * capacity);
+	}
+
+	// Frees the slot and moves the last element into the hole left at p_element_idx.
+	void _erase_at(uint32_t p_element_idx, uint32_t p_slot) {
+		_set_ctrl(p_slot, Group::CTRL_DELETED);
+		_deleted++;
+
+		_elements[p_element_idx].key.~TKey();
+		_elements[p_element_idx].value.~TValue();
+		_size--;
+
+		if (p_element_idx < _size) {
+			memcpy((void *)&_elements[p_element_idx], (const void *)&_elements[_size], sizeof(MapKeyValue));
+			_slots[_find_slot_of_element(_size)] = p_element_idx;
+			_hashes[p_element_idx] = _hashes[_size];
+		}
+	}
+
+public:
+	/* Standard Godot Container API */
+
+	_FORCE_INLINE_ uint32_t get_capacity() const { return _capacity_mask + 1; }
+	_FORCE_INLINE_ uint32_t size() const { return _size; }
+
+	_FORCE_INLINE_ bool is_empty() const {
+		return _size == 0;
+	}
+
+	void clear() {
+		if (_elements == nullptr || (_size == 0 && _deleted == 0)) {
+			return;
+		}
+
+		memset(_ctrl, Group::CTRL_EMPTY, _capacity_mask + 1 + Group::SIZE);
+		if constexpr (!(std::is_trivially_destructible_v<TKey> && std::is_trivially_destructible_v<TValue>)) {
+			for (uint32_t i = 0; i < _size; i++) {
+				_elements[i].key.~TKey();
+				_elements[i].value.~TValue();
+			}
+		}
+
+		_size = 0;
+		_deleted = 0;
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot);
+		CRASH_COND_MSG(!exists, "GroupHashMap key not found.");
+		return _elements[element_idx].value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot);
+		CRASH_COND_MSG(!exists, "GroupHashMap key not found.");
+		return _elements[element_idx].value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot);
+
+		if (exists) {
+			return &_elements[element_idx].value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot);
+
+		if (exists) {
+			return &_elements[element_idx].value;
+		}
+		return nullptr;
+	}
+
+	bool has(const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		return _lookup_idx(p_key, element_idx, slot);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot);
+
+		if (!exists) {
+			return false;
+		}
+
+		_erase_at(element_idx, slot);
+		return true;
+	}
+
+	// Replace the key of an entry in-place, without invalidating iterators or changing the entries position during iteration.
+	// p_old_key must exist in the map and p_new_key must not, unless it is equal to p_old_key.
+	bool replace_key(const TKey &p_old_key, const TKey &p_new_key) {
+		if (p_old_key == p_new_key) {
+			return true;
+		}
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		ERR_FAIL_COND_V(_lookup_idx(p_new_key, element_idx, slot), false);
+		ERR_FAIL_COND_V(!_lookup_idx(p_old_key, element_idx, slot), false);
+		MapKeyValue &element = _elements[element_idx];
+		const_cast<TKey &>(element.key) = p_new_key;
+
+		_set_ctrl(slot, Group::CTRL_DELETED);
+		_deleted++;
+
+		uint32_t hash = Hasher::hash(p_new_key);
+		_hashes[element_idx] = hash;
+		_insert_slot(hash, element_idx);
+
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	// If adding a known (possibly large) number of elements at once, must be larger than old capacity.
+	void reserve(uint32_t p_new_capacity) {
+		// Leave room for the load factor.
+		uint32_t new_capacity = p_new_capacity + p_new_capacity / 7 + 1;
+		if (_elements == nullptr) {
+			_capacity_mask = Math::next_power_of_2(MAX(INITIAL_CAPACITY, new_capacity)) - 1;
+			return; // Unallocated yet.
+		}
+		if (new_capacity <= get_capacity()) {
+			if (p_new_capacity < size()) {
+				WARN_VERBOSE("reserve() called with a capacity smaller than the current size. This is likely a mistake.");
+			}
+			return;
+		}
+		_resize_and_rehash(new_capacity);
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const MapKeyValue &operator*() const {
+			return *pair;
+		}
+		_FORCE_INLINE_ const MapKeyValue *operator->() const {
+			return pair;
+		}
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			pair++;
+			return *this;
+		}
+
+		_FORCE_INLINE_ ConstIterator &operator--() {
+			pair--;
+			if (pair < begin) {
+				pair = end;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return pair == b.pair; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return pair != b.pair; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return pair != end;
+		}
+
+		_FORCE_INLINE_ ConstIterator(MapKeyValue *p_key, MapKeyValue *p_begin, MapKeyValue *p_end) {
+			pair = p_key;
+			begin = p_begin;
+			end = p_end;
+		}
+		_FORCE_INLINE_ ConstIterator() {}
+		_FORCE_INLINE_ ConstIterator(const ConstIterator &p_it) {
+			pair = p_it.pair;
+			begin = p_it.begin;
+			end = p_it.end;
+		}
+		_FORCE_INLINE_ void operator=(const ConstIterator &p_it) {
+			pair = p_it.pair;
+			begin = p_it.begin;
+			end = p_it.end;
+		}
+
+	private:
+		MapKeyValue *pair = nullptr;
+		MapKeyValue *begin = nullptr;
+		MapKeyValue *end = nullptr;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ MapKeyValue &operator*() const {
+			return *pair;
+		}
+		_FORCE_INLINE_ MapKeyValue *operator->() const {
+			return pair;
+		}
+		_FORCE_INLINE_ Iterator &operator++() {
+			pair++;
+			return *this;
+		}
+		_FORCE_INLINE_ Iterator &operator--() {
+			pair--;
+			if (pair < begin) {
+				pair = end;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return pair == b.pair; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return pair != b.pair; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return pair != end;
+		}
+
+		_FORCE_INLINE_ Iterator(MapKeyValue *p_key, MapKeyValue *p_begin, MapKeyValue *p_end) {
+			pair = p_key;
+			begin = p_begin;
+			end = p_end;
+		}
+		_FORCE_INLINE_ Iterator() {}
+		_FORCE_INLINE_ Iterator(const Iterator &p_it) {
+			pair = p_it.pair;
+			begin = p_it.begin;
+			end = p_it.end;
+		}
+		_FORCE_INLINE_ void operator=(const Iterator &p_it) {
+			pair = p_it.pair;
+			begin = p_it.begin;
+			end = p_it.end;
+		}
+
+		operator ConstIterator() const {
+			return ConstIterator(pair, begin, end);
+		}
+
+	private:
+		MapKeyValue *pair = nullptr;
+		MapKeyValue *begin = nullptr;
+		MapKeyValue *end = nullptr;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		return Iterator(_elements, _elements, _elements + _size);
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator(_elements + _size, _elements, _elements + _size);
+	}
+	_FORCE_INLINE_ Iterator last() {
+		if (unlikely(_size == 0)) {
+			return Iterator(nullptr, nullptr, nullptr);
+		}
+		return Iterator(_elements + _size - 1, _elements, _elements + _size);
+	}
+
+	Iterator find(const TKey &p_key) {
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot);
+		if (!exists) {
+			return end();
+		}
+		return Iterator(_elements + element_idx, _elements, _elements + _size);
+	}
+
+	void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			erase(p_iter->key);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(_elements, _elements, _elements + _size);
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(_elements + _size, _elements, _elements + _size);
+	}
+	_FORCE_INLINE_ ConstIterator last() const {
+		if (unlikely(_size == 0)) {
+			return ConstIterator(nullptr, nullptr, nullptr);
+		}
+		return ConstIterator(_elements + _size - 1, _elements, _elements + _size);
+	}
+
+	ConstIterator find(const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot);
+		if (!exists) {
+			return end();
+		}
+		return ConstIterator(_elements + element_idx, _elements, _elements + _size);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot);
+		CRASH_COND(!exists);
+		return _elements[element_idx].value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		uint32_t hash = Hasher::hash(p_key);
+		bool exists = _lookup_idx_with_hash(p_key, element_idx, slot, hash);
+
+		if (exists) {
+			return _elements[element_idx].value;
+		} else {
+			element_idx = _insert_element(p_key, TValue(), hash);
+			return _elements[element_idx].value;
+		}
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		uint32_t hash = Hasher::hash(p_key);
+		bool exists = _lookup_idx_with_hash(p_key, element_idx, slot, hash);
+
+		if (!exists) {
+			element_idx = _insert_element(p_key, p_value, hash);
+		} else {
+			_elements[element_idx].value = p_value;
+		}
+		return Iterator(_elements + element_idx, _elements, _elements + _size);
+	}
+
+	// Inserts an element without checking if it already exists.
+	Iterator insert_new(const TKey &p_key, const TValue &p_value) {
+		DEV_ASSERT(!has(p_key));
+		uint32_t hash = Hasher::hash(p_key);
+		uint32_t element_idx = _insert_element(p_key, p_value, hash);
+		return Iterator(_elements + element_idx, _elements, _elements + _size);
+	}
+
+	/* Array methods. */
+
+	// Unsafe. Changing keys and going outside the bounds of an array can lead to undefined behavior.
+	KeyValue<TKey, TValue> *get_elements_ptr() {
+		return _elements;
+	}
+
+	// Returns the element index. If not found, returns -1.
+	int get_index(const TKey &p_key) {
+		uint32_t element_idx = 0;
+		uint32_t slot = 0;
+		bool exists = _lookup_idx(p_key, element_idx, slot);
+		if (!exists) {
+			return -1;
+		}
+		return element_idx;
+	}
+
+	KeyValue<TKey, TValue> &get_by_index(uint32_t p_index) {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, _size);
+		return _elements[p_index];
+	}
+
+	bool erase_by_index(uint32_t p_index) {
+		if (p_index >= size()) {
+			return false;
+		}
+		_erase_at(p_index, _find_slot_of_element(p_index));
+		return true;
+	}
+
+	/* Constructors */
+
+	GroupHashMap(GroupHashMap &&p_other) {
+		_elements = p_other._elements;
+		_hashes = p_other._hashes;
+		_ctrl = p_other._ctrl;
+		_slots = p_other._slots;
+		_capacity_mask = p_other._capacity_mask;
+		_size = p_other._size;
+		_deleted = p_other._deleted;
+
+		p_other._elements = nullptr;
+		p_other._hashes = nullptr;
+		p_other._ctrl = nullptr;
+		p_other._slots = nullptr;
+		p_other._capacity_mask = INITIAL_CAPACITY - 1;
+		p_other._size = 0;
+		p_other._deleted = 0;
+	}
+
+	explicit GroupHashMap(const GroupHashMap &p_other) {
+		_init_from(p_other);
+	}
+
+	void operator=(const GroupHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+
+		reset();
+
+		_init_from(p_other);
+	}
+
+	GroupHashMap(uint32_t p_initial_capacity) {
+		reserve(p_initial_capacity);
+	}
+	GroupHashMap() {}
+
+	GroupHashMap(std::initializer_list<KeyValue<TKey, TValue>> p_init) {
+		reserve(p_init.size());
+		for (const KeyValue<TKey, TValue> &E : p_init) {
+			insert(E.key, E.value);
+		}
+	}
+
+	void reset() {
+		if (_elements != nullptr) {
+			if constexpr (!(std::is_trivially_destructible_v<TKey> && std::is_trivially_destructible_v<TValue>)) {
+				for (uint32_t i = 0; i < _size; i++) {
+					_elements[i].key.~TKey();
+					_elements[i].value.~TValue();
+				}
+			}
+			Memory::free_static(_elements);
+			Memory::free_static(_hashes);
+			Memory::free_static(_ctrl);
+			Memory::free_static(_slots);
+			_elements = nullptr;
+			_hashes = nullptr;
+			_ctrl = nullptr;
+			_slots = nullptr;
+		}
+		_capacity_mask = INITIAL_CAPACITY - 1;
+		_size = 0;
+		_deleted = 0;
+	}
+
+	~GroupHashMap() {
+		reset();
+	}
+};
+
+extern template class GroupHashMap<int, int>;
+extern template class GroupHashMap<String, int>;
+extern template class GroupHashMap<StringName, StringName>;
+extern template class GroupHashMap<StringName, Variant>;
+extern template class GroupHashMap<StringName, int>;
@@ -0,0 +1,274 @@
+/**************************************************************************/
+/*  parallel_algorithms.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+#include "core/templates/sort_array.h"
+
+// Data-parallel helpers on top of WorkerThreadPool.
+//
+// Work is cut into chunks that the pool threads and the calling thread pull from a
+// shared counter until none are left, so uneven chunks still balance out. When the
+// work is too small, there is no thread pool, or the caller is itself a pool thread
+// (waiting on a group from there could starve the pool), everything runs serially on
+// the calling thread.
+
+namespace ParallelAlgorithms {
+
+// Below this many elements, parallel_sort() is just SortArray.
+static constexpr int64_t SORT_SERIAL_THRESHOLD = 16384;
+
+_FORCE_INLINE_ int get_parallel_worker_count() {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (pool == nullptr || pool->get_thread_index() != -1) {
+		return 0;
+	}
+	return pool->get_thread_count();
+}
+
+template <typename F>
+struct ChunkRunner {
+	F *func = nullptr;
+	int64_t count = 0;
+	int64_t chunk_size = 1;
+	int64_t chunk_count = 0;
+	SafeNumeric<int64_t> next_chunk;
+
+	void run_chunks() {
+		while (true) {
+			int64_t chunk = next_chunk.postincrement();
+			if (chunk >= chunk_count) {
+				break;
+			}
+			int64_t begin = chunk * chunk_size;
+			(*func)(chunk, begin, MIN(begin + chunk_size, count));
+		}
+	}
+
+	void work(uint32_t p_index, void *p_userdata) {
+		run_chunks();
+	}
+};
+
+// Calls p_func(chunk_index, begin, end) for consecutive ranges of at least p_min_chunk elements covering [0, p_count).
+// Returns the number of chunks, which is never more than (get_parallel_worker_count() + 1) * 4.
+template <typename F>
+int64_t for_each_chunk(int64_t p_count, int64_t p_min_chunk, F &p_func) {
+	if (p_count <= 0) {
+		return 0;
+	}
+	p_min_chunk = MAX(p_min_chunk, (int64_t)1);
+
+	const int workers = get_parallel_worker_count();
+	// A few chunks per thread, so threads that finish early can help the others.
+	const int64_t max_chunks = MAX((int64_t)(workers + 1) * 4, (int64_t)1);
+	const int64_t chunk_size = MAX(p_min_chunk, (p_count + max_chunks - 1) / max_chunks);
+	const int64_t chunk_count = (p_count + chunk_size - 1) / chunk_size;
+
+	if (workers == 0 || chunk_count == 1) {
+		for (int64_t chunk = 0; chunk < chunk_count; chunk++) {
+			int64_t begin = chunk * chunk_size;
+			p_func(chunk, begin, MIN(begin + chunk_size, p_count));
+		}
+		return chunk_count;
+	}
+
+	ChunkRunner<F> runner;
+	runner.func = &p_func;
+	runner.count = p_count;
+	runner.chunk_size = chunk_size;
+	runner.chunk_count = chunk_count;
+
+	// The calling thread takes a share too.
+	const int helpers = (int)MIN((int64_t)workers, chunk_count - 1);
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	WorkerThreadPool::GroupID group = pool->add_template_group_task(&runner, &ChunkRunner<F>::work, (void *)nullptr, helpers, helpers, true);
+	runner.run_chunks();
+	pool->wait_for_group_task_completion(group);
+	return chunk_count;
+}
+
+template <typename T, typename C>
+struct MergeLevel {
+	const T *src = nullptr;
+	T *dst = nullptr;
+	C compare;
+	int64_t len = 0;
+	int64_t run = 0; // Length of the sorted runs being merged pairwise.
+	int64_t segments_per_pair = 1;
+
+	// Number of elements taken from `a` among the first p_diagonal elements of the stable merge of a and b.
+	int64_t merge_path(const T *a, int64_t a_len, const T *b, int64_t b_len, int64_t p_diagonal) const {
+		int64_t lo = MAX((int64_t)0, p_diagonal - b_len);
+		int64_t hi = MIN(p_diagonal, a_len);
+		while (lo < hi) {
+			int64_t i = (lo + hi) / 2;
+			// Take a[i] before b[d - i - 1] unless b's is strictly smaller.
+			if (compare(b[p_diagonal - i - 1], a[i])) {
+				hi = i;
+			} else {
+				lo = i + 1;
+			}
+		}
+		return lo;
+	}
+
+	void merge_segment(int64_t p_task) {
+		const int64_t pair = p_task / segments_per_pair;
+		const int64_t segment = p_task % segments_per_pair;
+
+		const int64_t a_begin = pair * run * 2;
+		const int64_t a_end = MIN(a_begin + run, len);
+		const int64_t b_end = MIN(a_end + run, len);
+		const T *a = src + a_begin;
+		const T *b = src + a_end;
+		const int64_t a_len = a_end - a_begin;
+		const int64_t b_len = b_end - a_end;
+		const int64_t total = a_len + b_len;
+
+		const int64_t out_begin = total * segment / segments_per_pair;
+		const int64_t out_end = total * (segment + 1) / segments_per_pair;
+		int64_t i = merge_path(a, a_len, b, b_len, out_begin);
+		int64_t j = out_begin - i;
+		const int64_t i_end = merge_path(a, a_len, b, b_len, out_end);
+		const int64_t j_end = out_end - i_end;
+
+		T *out = dst + a_begin + out_begin;
+		while (i < i_end && j < j_end) {
+			if (compare(b[j], a[i])) {
+				*out++ = b[j++];
+			} else {
+				*out++ = a[i++];
+			}
+		}
+		while (i < i_end) {
+			*out++ = a[i++];
+		}
+		while (j < j_end) {
+			*out++ = b[j++];
+		}
+	}
+};
+
+} // namespace ParallelAlgorithms
+
+// Calls p_func(begin, end) on disjoint ranges covering [0, p_count), possibly from several threads at once.
+// Ranges hold at least p_min_chunk elements (except the last one); raise it when each element is cheap.
+template <typename F>
+void parallel_for(int64_t p_count, F p_func, int64_t p_min_chunk = 1024) {
+	auto chunk_func = [&p_func](int64_t p_chunk, int64_t p_begin, int64_t p_end) {
+		p_func(p_begin, p_end);
+	};
+	ParallelAlgorithms::for_each_chunk(p_count, p_min_chunk, chunk_func);
+}
+
+// Reduces [0, p_count) to a single value: p_func(begin, end) computes the value of a range, and
+// p_combine(a, b) merges two of them. p_combine must be associative; partial results are always
+// combined left to right, starting from p_identity, so the result does not depend on thread timing.
+template <typename T, typename F, typename R>
+T parallel_reduce(int64_t p_count, const T &p_identity, F p_func, R p_combine, int64_t p_min_chunk = 1024) {
+	LocalVector<T> partials;
+	const int64_t max_chunks = (int64_t)(ParallelAlgorithms::get_parallel_worker_count() + 1) * 4;
+	partials.resize(MAX(max_chunks, (int64_t)1));
+
+	auto chunk_func = [&](int64_t p_chunk, int64_t p_begin, int64_t p_end) {
+		partials[p_chunk] = p_func(p_begin, p_end);
+	};
+	const int64_t used_chunks = ParallelAlgorithms::for_each_chunk(p_count, p_min_chunk, chunk_func);
+
+	T result = p_identity;
+	for (int64_t i = 0; i < used_chunks; i++) {
+		result = p_combine(result, partials[i]);
+	}
+	return result;
+}
+
+// Sorts p_array like SortArray::sort() (so not stable), using all pool threads for large arrays:
+// blocks are sorted in parallel with SortArray, then merged pairwise, each merge split across threads.
+template <typename T, typename C = Comparator<T>>
+void parallel_sort(T *p_array, int64_t p_len, const C &p_compare = C()) {
+	const int workers = ParallelAlgorithms::get_parallel_worker_count();
+	if (p_len < ParallelAlgorithms::SORT_SERIAL_THRESHOLD || workers == 0) {
+		SortArray<T, C> sorter;
+		sorter.compare = p_compare;
+		sorter.sort(p_array, p_len);
+		return;
+	}
+
+	// Power of two blocks so the merge levels pair up evenly.
+	int64_t blocks = 1;
+	while (blocks < (int64_t)(workers + 1) * 2 && p_len / (blocks * 2) >= ParallelAlgorithms::SORT_SERIAL_THRESHOLD / 4) {
+		blocks *= 2;
+	}
+	const int64_t block_size = (p_len + blocks - 1) / blocks;
+
+	auto sort_block = [&](int64_t p_chunk, int64_t p_begin, int64_t p_end) {
+		SortArray<T, C> sorter;
+		sorter.compare = p_compare;
+		sorter.sort(p_array + p_begin, p_end - p_begin);
+	};
+	ParallelAlgorithms::for_each_chunk(p_len, block_size, sort_block);
+
+	LocalVector<T> buffer;
+	buffer.resize(p_len);
+	T *src = p_array;
+	T *dst = buffer.ptr();
+
+	const int64_t total_segments = (int64_t)(workers + 1) * 4;
+	for (int64_t run = block_size; run < p_len; run *= 2) {
+		ParallelAlgorithms::MergeLevel<T, C> level;
+		level.src = src;
+		level.dst = dst;
+		level.compare = p_compare;
+		level.len = p_len;
+		level.run = run;
+		const int64_t pairs = (p_len + run * 2 - 1) / (run * 2);
+		level.segments_per_pair = MAX(total_segments / pairs, (int64_t)1);
+
+		auto merge_tasks = [&level](int64_t p_chunk, int64_t p_begin, int64_t p_end) {
+			for (int64_t i = p_begin; i < p_end; i++) {
+				level.merge_segment(i);
+			}
+		};
+		ParallelAlgorithms::for_each_chunk(pairs * level.segments_per_pair, 1, merge_tasks);
+		SWAP(src, dst);
+	}
+
+	if (src != p_array) {
+		parallel_for(p_len, [&](int64_t p_begin, int64_t p_end) {
+			for (int64_t i = p_begin; i < p_end; i++) {
+				p_array[i] = src[i];
+			}
+		});
+	}
+}
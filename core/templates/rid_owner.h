@@ -32,6 +32,7 @@
 
 #include "core/os/memory.h"
 #include "core/os/mutex.h"
+#include "core/os/spin_lock.h"
 #include "core/string/print_string.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/safe_refcount.h"
@@ -67,6 +68,9 @@
 class RID_AllocBase {
 	static inline SafeNumeric<uint64_t> base_id{ 1 };
 
+	static inline SafeNumeric<uint32_t> thread_slot_count{ 0 };
+	static inline thread_local uint32_t thread_slot = UINT32_MAX;
+
 protected:
 	static _FORCE_INLINE_ RID _make_from_id(uint64_t p_id) {
 		RID rid;
@@ -78,6 +82,15 @@ protected:
 		return _make_from_id(_gen_id());
 	}
 
+	// A small number handed out once per thread, used to spread threads over the
+	// free slot caches of thread-safe allocators.
+	static _FORCE_INLINE_ uint32_t _get_thread_slot() {
+		if (unlikely(thread_slot == UINT32_MAX)) {
+			thread_slot = thread_slot_count.postincrement();
+		}
+		return thread_slot;
+	}
+
 	friend struct VariantUtilityFunctions;
 
 	static _FORCE_INLINE_ uint64_t _gen_id() {
@@ -99,6 +112,8 @@ class RID_Alloc : public RID_AllocBase {
 
 	uint32_t elements_in_chunk;
 	uint32_t max_alloc = 0;
+	// Slots taken from the free list. In thread-safe mode, this includes the ones
+	// sitting in the free caches, and live RIDs are counted in rid_count instead.
 	uint32_t alloc_count = 0;
 	uint32_t chunk_limit = 0;
 
@@ -106,67 +121,202 @@ class RID_Alloc : public RID_AllocBase {
 
 	mutable Mutex mutex;
 
-	_FORCE_INLINE_ RID _allocate_rid() {
+	// When thread-safe, lookups never lock, and allocating or freeing goes through a
+	// few small caches of free slots, picked per thread. The mutex is only taken to
+	// move FREE_CACHE_BATCH slots at a time between a cache and the shared free list.
+	static constexpr uint32_t FREE_CACHE_COUNT = 8;
+	static constexpr uint32_t FREE_CACHE_SIZE = 32;
+	static constexpr uint32_t FREE_CACHE_BATCH = FREE_CACHE_SIZE / 2;
+
+	struct FreeCache {
+		SpinLock lock;
+		uint32_t count = 0;
+		uint32_t indices[FREE_CACHE_SIZE];
+	};
+	FreeCache *free_caches = nullptr;
+	SafeNumeric<uint32_t> rid_count{ 0 };
+
+	static _FORCE_INLINE_ uint32_t _load_validator(const Chunk &p_chunk) {
 		if constexpr (THREAD_SAFE) {
-			mutex.lock();
+			return ((const std::atomic<uint32_t> *)&p_chunk.validator)->load(std::memory_order_acquire);
+		} else {
+			return p_chunk.validator;
 		}
+	}
 
-		if (alloc_count == max_alloc) {
-			//allocate a new chunk
-			uint32_t chunk_count = alloc_count == 0 ? 0 : (max_alloc / elements_in_chunk);
-			if (THREAD_SAFE && chunk_count == chunk_limit) {
-				mutex.unlock();
-				if (description != nullptr) {
-					ERR_FAIL_V_MSG(RID(), vformat("Element limit for RID of type '%s' reached.", String(description)));
-				} else {
-					ERR_FAIL_V_MSG(RID(), "Element limit reached.");
+	static _FORCE_INLINE_ void _store_validator(Chunk &p_chunk, uint32_t p_validator) {
+		if constexpr (THREAD_SAFE) {
+			((std::atomic<uint32_t> *)&p_chunk.validator)->store(p_validator, std::memory_order_release);
+		} else {
+			p_chunk.validator = p_validator;
+		}
+	}
+
+	_FORCE_INLINE_ uint32_t _get_max_alloc() const {
+		if constexpr (THREAD_SAFE) { // Read atomically to avoid data race with the store in _grow().
+			return ((const std::atomic<uint32_t> *)&max_alloc)->load(std::memory_order_acquire);
+		} else {
+			return max_alloc;
+		}
+	}
+
+	// Adds a chunk of free slots. Called with the mutex held when thread-safe.
+	bool _grow() {
+		uint32_t chunk_count = alloc_count == 0 ? 0 : (max_alloc / elements_in_chunk);
+		if (THREAD_SAFE && chunk_count == chunk_limit) {
+			return false;
+		}
+
+		//grow chunks
+		if constexpr (!THREAD_SAFE) {
+			chunks = (Chunk **)memrealloc(chunks, sizeof(Chunk *) * (chunk_count + 1));
+		}
+		chunks[chunk_count] = (Chunk *)memalloc(sizeof(Chunk) * elements_in_chunk); //but don't initialize
+		//grow free lists
+		if constexpr (!THREAD_SAFE) {
+			free_list_chunks = (uint32_t **)memrealloc(free_list_chunks, sizeof(uint32_t *) * (chunk_count + 1));
+		}
+		free_list_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
+
+		//initialize
+		for (uint32_t i = 0; i < elements_in_chunk; i++) {
+			// Don't initialize chunk.
+			chunks[chunk_count][i].validator = 0xFFFFFFFF;
+			free_list_chunks[chunk_count][i] = alloc_count + i;
+		}
+
+		if constexpr (THREAD_SAFE) {
+			// Publish the new chunk to lock-free lookups.
+			((std::atomic<uint32_t> *)&max_alloc)->store(max_alloc + elements_in_chunk, std::memory_order_release);
+		} else {
+			max_alloc += elements_in_chunk;
+		}
+		return true;
+	}
+
+	// Moves up to p_max free slots from the shared free list to r_indices, adding at
+	// most p_max_chunks chunks if it runs out.
+	uint32_t _take_free_indices(uint32_t *r_indices, uint32_t p_max, uint32_t p_max_chunks = 1) {
+		MutexLock lock(mutex);
+		uint32_t taken = 0;
+		uint32_t grown = 0;
+		while (taken < p_max) {
+			if (alloc_count == max_alloc) {
+				if (grown == p_max_chunks || !_grow()) {
+					break;
 				}
+				grown++;
 			}
+			r_indices[taken++] = free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk];
+			alloc_count++;
+		}
+		return taken;
+	}
+
+	void _return_free_indices(const uint32_t *p_indices, uint32_t p_count) {
+		MutexLock lock(mutex);
+		for (uint32_t i = 0; i < p_count; i++) {
+			alloc_count--;
+			free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = p_indices[i];
+		}
+	}
+
+	bool _pop_free_index(uint32_t &r_index) {
+		FreeCache &cache = free_caches[_get_thread_slot() % FREE_CACHE_COUNT];
+		cache.lock.lock();
+		if (likely(cache.count > 0)) {
+			r_index = cache.indices[--cache.count];
+			cache.lock.unlock();
+			return true;
+		}
+		cache.lock.unlock();
 
-			//grow chunks
-			if constexpr (!THREAD_SAFE) {
-				chunks = (Chunk **)memrealloc(chunks, sizeof(Chunk *) * (chunk_count + 1));
+		// Refill outside of the cache lock, growing may allocate.
+		uint32_t batch[FREE_CACHE_BATCH];
+		uint32_t taken = _take_free_indices(batch, FREE_CACHE_BATCH);
+		if (taken > 0) {
+			r_index = batch[--taken];
+			uint32_t overflow = 0;
+			cache.lock.lock();
+			while (taken > 0 && cache.count < FREE_CACHE_SIZE) {
+				cache.indices[cache.count++] = batch[--taken];
 			}
-			chunks[chunk_count] = (Chunk *)memalloc(sizeof(Chunk) * elements_in_chunk); //but don't initialize
-			//grow free lists
-			if constexpr (!THREAD_SAFE) {
-				free_list_chunks = (uint32_t **)memrealloc(free_list_chunks, sizeof(uint32_t *) * (chunk_count + 1));
+			overflow = taken;
+			cache.lock.unlock();
+			if (overflow) {
+				// Another thread refilled the cache meanwhile.
+				_return_free_indices(batch, overflow);
 			}
-			free_list_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
+			return true;
+		}
 
-			//initialize
-			for (uint32_t i = 0; i < elements_in_chunk; i++) {
-				// Don't initialize chunk.
-				chunks[chunk_count][i].validator = 0xFFFFFFFF;
-				free_list_chunks[chunk_count][i] = alloc_count + i;
+		// Out of chunks, but other caches may still hold free slots.
+		for (uint32_t i = 0; i < FREE_CACHE_COUNT; i++) {
+			FreeCache &other = free_caches[i];
+			other.lock.lock();
+			if (other.count > 0) {
+				r_index = other.indices[--other.count];
+				other.lock.unlock();
+				return true;
 			}
+			other.lock.unlock();
+		}
+		return false;
+	}
 
-			if constexpr (THREAD_SAFE) {
-				// Store atomically to avoid data race with the load in get_or_null().
-				((std::atomic<uint32_t> *)&max_alloc)->store(max_alloc + elements_in_chunk, std::memory_order_relaxed);
-			} else {
-				max_alloc += elements_in_chunk;
+	void _push_free_index(uint32_t p_index) {
+		FreeCache &cache = free_caches[_get_thread_slot() % FREE_CACHE_COUNT];
+		cache.lock.lock();
+		if (likely(cache.count < FREE_CACHE_SIZE)) {
+			cache.indices[cache.count++] = p_index;
+			cache.lock.unlock();
+			return;
+		}
+
+		// Full, give the oldest half back and keep the recently freed (likely still cached) slots.
+		uint32_t batch[FREE_CACHE_BATCH];
+		memcpy(batch, cache.indices, sizeof(batch));
+		memmove(cache.indices, cache.indices + FREE_CACHE_BATCH, sizeof(uint32_t) * (FREE_CACHE_SIZE - FREE_CACHE_BATCH));
+		cache.count -= FREE_CACHE_BATCH;
+		cache.indices[cache.count++] = p_index;
+		cache.lock.unlock();
+
+		_return_free_indices(batch, FREE_CACHE_BATCH);
+	}
+
+	_FORCE_INLINE_ RID _allocate_rid() {
+		uint32_t free_index;
+		if constexpr (THREAD_SAFE) {
+			if (unlikely(!_pop_free_index(free_index))) {
+				if (description != nullptr) {
+					ERR_FAIL_V_MSG(RID(), vformat("Element limit for RID of type '%s' reached.", String(description)));
+				} else {
+					ERR_FAIL_V_MSG(RID(), "Element limit reached.");
+				}
 			}
+		} else {
+			if (alloc_count == max_alloc) {
+				//allocate a new chunk
+				_grow();
+			}
+			free_index = free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk];
+			alloc_count++;
 		}
 
-		uint32_t free_index = free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk];
+		if constexpr (THREAD_SAFE) {
+			rid_count.increment();
+		}
 
-		uint32_t free_chunk = free_index / elements_in_chunk;
-		uint32_t free_element = free_index % elements_in_chunk;
+		return _make_allocated_rid(free_index);
+	}
 
+	_FORCE_INLINE_ RID _make_allocated_rid(uint32_t p_index) {
 		uint32_t validator = 1 + (uint32_t)(_gen_id() % 0x7FFFFFFF);
 		uint64_t id = validator;
 		id <<= 32;
-		id |= free_index;
-
-		chunks[free_chunk][free_element].validator = validator;
-		chunks[free_chunk][free_element].validator |= 0x80000000; //mark uninitialized bit
-
-		alloc_count++;
+		id |= p_index;
 
-		if constexpr (THREAD_SAFE) {
-			mutex.unlock();
-		}
+		_store_validator(chunks[p_index / elements_in_chunk][p_index % elements_in_chunk], validator | 0x80000000); //mark uninitialized bit
 
 		return _make_from_id(id);
 	}
@@ -188,6 +338,52 @@ public:
 		return _allocate_rid();
 	}
 
+	// Like allocate_rid(), for p_count RIDs at once. When thread-safe, the shared free
+	// list is locked once for the whole batch, and slots come out in index order when
+	// fresh chunks are used. If the element limit is reached, the remaining RIDs are null.
+	void allocate_rids(RID *r_rids, uint32_t p_count) {
+		LocalVector<uint32_t> indices;
+		indices.resize(p_count);
+		uint32_t taken = 0;
+
+		if constexpr (THREAD_SAFE) {
+			FreeCache &cache = free_caches[_get_thread_slot() % FREE_CACHE_COUNT];
+			cache.lock.lock();
+			while (taken < p_count && cache.count > 0) {
+				indices[taken++] = cache.indices[--cache.count];
+			}
+			cache.lock.unlock();
+
+			if (taken < p_count) {
+				taken += _take_free_indices(indices.ptr() + taken, p_count - taken, UINT32_MAX);
+			}
+			rid_count.add(taken);
+		} else {
+			for (; taken < p_count; taken++) {
+				if (alloc_count == max_alloc) {
+					_grow();
+				}
+				indices[taken] = free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk];
+				alloc_count++;
+			}
+		}
+
+		for (uint32_t i = 0; i < taken; i++) {
+			r_rids[i] = _make_allocated_rid(indices[i]);
+		}
+		for (uint32_t i = taken; i < p_count; i++) {
+			r_rids[i] = RID();
+		}
+
+		if (unlikely(taken < p_count)) {
+			if (description != nullptr) {
+				ERR_FAIL_MSG(vformat("Element limit for RID of type '%s' reached.", String(description)));
+			} else {
+				ERR_FAIL_MSG("Element limit reached.");
+			}
+		}
+	}
+
 	_FORCE_INLINE_ T *get_or_null(const RID &p_rid, bool p_initialize = false) {
 		if (p_rid == RID()) {
 			return nullptr;
@@ -199,13 +395,7 @@ public:
 
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		uint32_t ma;
-		if constexpr (THREAD_SAFE) { // Read atomically to avoid data race with the store in _allocate_rid().
-			ma = ((std::atomic<uint32_t> *)&max_alloc)->load(std::memory_order_relaxed);
-		} else {
-			ma = max_alloc;
-		}
-		if (unlikely(idx >= ma)) {
+		if (unlikely(idx >= _get_max_alloc())) {
 			return nullptr;
 		}
 
@@ -231,19 +421,20 @@ public:
 #endif
 		}
 
+		const uint32_t current = _load_validator(c);
 		if (unlikely(p_initialize)) {
-			if (unlikely(!(c.validator & 0x80000000))) {
+			if (unlikely(!(current & 0x80000000))) {
 				ERR_FAIL_V_MSG(nullptr, "Initializing already initialized RID");
 			}
 
-			if (unlikely((c.validator & 0x7FFFFFFF) != validator)) {
+			if (unlikely((current & 0x7FFFFFFF) != validator)) {
 				ERR_FAIL_V_MSG(nullptr, "Attempting to initialize the wrong RID");
 			}
 
-			c.validator &= 0x7FFFFFFF; //initialized
+			_store_validator(c, validator); //initialized
 
-		} else if (unlikely(c.validator != validator)) {
-			if ((c.validator & 0x80000000) && c.validator != 0xFFFFFFFF) {
+		} else if (unlikely(current != validator)) {
+			if ((current & 0x80000000) && current != 0xFFFFFFFF) {
 				ERR_FAIL_V_MSG(nullptr, "Attempting to use an uninitialized RID");
 			}
 			return nullptr;
@@ -300,16 +491,9 @@ public:
 	}
 
 	_FORCE_INLINE_ bool owns(const RID &p_rid) const {
-		if constexpr (THREAD_SAFE) {
-			mutex.lock();
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
-			}
+		if (unlikely(idx >= _get_max_alloc())) {
 			return false;
 		}
 
@@ -318,58 +502,49 @@ public:
 
 		uint32_t validator = uint32_t(id >> 32);
 
-		bool owned = (chunks[idx_chunk][idx_element].validator & 0x7FFFFFFF) == validator;
-
-		if constexpr (THREAD_SAFE) {
-			mutex.unlock();
-		}
-
-		return owned;
+		return (_load_validator(chunks[idx_chunk][idx_element]) & 0x7FFFFFFF) == validator;
 	}
 
 	_FORCE_INLINE_ void free(const RID &p_rid) {
-		if constexpr (THREAD_SAFE) {
-			mutex.lock();
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
-			}
-			ERR_FAIL();
-		}
+		ERR_FAIL_COND(idx >= _get_max_alloc());
 
 		uint32_t idx_chunk = idx / elements_in_chunk;
 		uint32_t idx_element = idx % elements_in_chunk;
 
 		uint32_t validator = uint32_t(id >> 32);
-		if (unlikely(chunks[idx_chunk][idx_element].validator & 0x80000000)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
-			}
+		Chunk &c = chunks[idx_chunk][idx_element];
+		uint32_t current = _load_validator(c);
+		if (unlikely(current & 0x80000000)) {
 			ERR_FAIL_MSG("Attempted to free an uninitialized or invalid RID");
-		} else if (unlikely(chunks[idx_chunk][idx_element].validator != validator)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
-			}
-			ERR_FAIL();
 		}
-
-		chunks[idx_chunk][idx_element].data.~T();
-		chunks[idx_chunk][idx_element].validator = 0xFFFFFFFF; // go invalid
-
-		alloc_count--;
-		free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = idx;
+		ERR_FAIL_COND(current != validator);
 
 		if constexpr (THREAD_SAFE) {
-			mutex.unlock();
+			// Invalidate first, so only one of several threads freeing the same RID
+			// gets to destroy it.
+			if (unlikely(!((std::atomic<uint32_t> *)&c.validator)->compare_exchange_strong(current, 0xFFFFFFFF, std::memory_order_acq_rel))) {
+				ERR_FAIL();
+			}
+			c.data.~T();
+			rid_count.decrement();
+			_push_free_index(idx);
+		} else {
+			c.data.~T();
+			c.validator = 0xFFFFFFFF; // go invalid
+
+			alloc_count--;
+			free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = idx;
 		}
 	}
 
 	_FORCE_INLINE_ uint32_t get_rid_count() const {
-		return alloc_count;
+		if constexpr (THREAD_SAFE) {
+			return rid_count.get();
+		} else {
+			return alloc_count;
+		}
 	}
 	LocalVector<RID> get_owned_list() const {
 		LocalVector<RID> owned;
@@ -377,7 +552,7 @@ public:
 			mutex.lock();
 		}
 		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator;
+			uint64_t validator = _load_validator(chunks[i / elements_in_chunk][i % elements_in_chunk]);
 			if (validator != 0xFFFFFFFF) {
 				owned.push_back(_make_from_id((validator << 32) | i));
 			}
@@ -395,7 +570,7 @@ public:
 		}
 		uint32_t idx = 0;
 		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator;
+			uint64_t validator = _load_validator(chunks[i / elements_in_chunk][i % elements_in_chunk]);
 			if (validator != 0xFFFFFFFF) {
 				p_rid_buffer[idx] = _make_from_id((validator << 32) | i);
 				idx++;
@@ -417,6 +592,7 @@ public:
 			chunk_limit = (p_maximum_number_of_elements / elements_in_chunk) + 1;
 			chunks = (Chunk **)memalloc(sizeof(Chunk *) * chunk_limit);
 			free_list_chunks = (uint32_t **)memalloc(sizeof(uint32_t *) * chunk_limit);
+			free_caches = memnew_arr(FreeCache, FREE_CACHE_COUNT);
 			SYNC_RELEASE;
 		}
 	}
@@ -426,9 +602,10 @@ public:
 			SYNC_ACQUIRE;
 		}
 
-		if (alloc_count) {
+		const uint32_t leaked = get_rid_count();
+		if (leaked) {
 			print_error(vformat("ERROR: %d RID allocations of type '%s' were leaked at exit.",
-					alloc_count, description ? description : typeid(T).name()));
+					leaked, description ? description : typeid(T).name()));
 
 			for (size_t i = 0; i < max_alloc; i++) {
 				uint32_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator;
@@ -451,6 +628,9 @@ public:
 			memfree(chunks);
 			memfree(free_list_chunks);
 		}
+		if (free_caches) {
+			memdelete_arr(free_caches);
+		}
 	}
 };
 
@@ -467,6 +647,10 @@ public:
 		return alloc.allocate_rid();
 	}
 
+	_FORCE_INLINE_ void allocate_rids(RID *r_rids, uint32_t p_count) {
+		alloc.allocate_rids(r_rids, p_count);
+	}
+
 	_FORCE_INLINE_ void initialize_rid(RID p_rid, T *p_ptr) {
 		alloc.initialize_rid(p_rid, p_ptr);
 	}
@@ -529,6 +713,10 @@ public:
 		return alloc.allocate_rid();
 	}
 
+	_FORCE_INLINE_ void allocate_rids(RID *r_rids, uint32_t p_count) {
+		alloc.allocate_rids(r_rids, p_count);
+	}
+
 	_FORCE_INLINE_ void initialize_rid(RID p_rid) {
 		alloc.initialize_rid(p_rid);
 	}
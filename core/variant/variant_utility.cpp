@@ -1054,43 +1054,23 @@ Variant VariantUtilityFunctions::str_to_var(const String &p_var) {
 }
 
 PackedByteArray VariantUtilityFunctions::var_to_bytes(const Variant &p_var) {
-	int len;
-	Error err = encode_variant(p_var, nullptr, len, false);
+	VariantEncodeBuffer buffer;
+	Error err = buffer.encode(p_var, false);
 	if (err != OK) {
 		return PackedByteArray();
 	}
 
-	PackedByteArray barr;
-	barr.resize(len);
-	{
-		uint8_t *w = barr.ptrw();
-		err = encode_variant(p_var, w, len, false);
-		if (err != OK) {
-			return PackedByteArray();
-		}
-	}
-
-	return barr;
+	return buffer.to_bytes();
 }
 
 PackedByteArray VariantUtilityFunctions::var_to_bytes_with_objects(const Variant &p_var) {
-	int len;
-	Error err = encode_variant(p_var, nullptr, len, true);
+	VariantEncodeBuffer buffer;
+	Error err = buffer.encode(p_var, true);
 	if (err != OK) {
 		return PackedByteArray();
 	}
 
-	PackedByteArray barr;
-	barr.resize(len);
-	{
-		uint8_t *w = barr.ptrw();
-		err = encode_variant(p_var, w, len, true);
-		if (err != OK) {
-			return PackedByteArray();
-		}
-	}
-
-	return barr;
+	return buffer.to_bytes();
 }
 
 Variant VariantUtilityFunctions::bytes_to_var(const PackedByteArray &p_arr) {
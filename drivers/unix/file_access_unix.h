@@ -53,6 +53,9 @@ class FileAccessUnix : public FileAccess {
 	String get_real_path() const; // Returns the resolved real path for the current open file.
 #endif
 
+protected:
+	int _get_fd() const { return f ? fileno(f) : -1; }
+
 public:
 	typedef void (*CloseNotificationFunc)(const String &p_file, int p_flags);
 	static CloseNotificationFunc close_notification_func;
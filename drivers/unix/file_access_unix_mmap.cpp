@@ -0,0 +1,207 @@
+/**************************************************************************/
+/*  file_access_unix_mmap.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "file_access_unix_mmap.h"
+
+#if defined(UNIX_ENABLED)
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+Mutex FileAccessUnixMmap::mappings_mutex;
+HashMap<String, FileAccessUnixMmap::Mapping *> FileAccessUnixMmap::mappings;
+
+void FileAccessUnixMmap::_unmap() {
+	if (mapping) {
+		MutexLock lock(mappings_mutex);
+		if (--mapping->refcount == 0) {
+			HashMap<String, Mapping *>::Iterator E = mappings.find(mapping->path);
+			if (E && E->value == mapping) {
+				mappings.remove(E);
+			}
+			munmap((void *)mapping->data, mapping->length);
+			memdelete(mapping);
+		}
+		mapping = nullptr;
+	}
+	data = nullptr;
+	length = 0;
+	pos = 0;
+	eof = false;
+}
+
+Error FileAccessUnixMmap::open_internal(const String &p_path, int p_mode_flags) {
+	_unmap();
+
+	Error err = FileAccessUnix::open_internal(p_path, p_mode_flags);
+	if (err != OK || p_mode_flags != READ) {
+		return err;
+	}
+
+	// Large packs would exhaust a 32-bit address space; keep using stdio there.
+	if (sizeof(void *) < 8) {
+		return OK;
+	}
+
+	int fd = _get_fd();
+	struct stat st = {};
+	if (fd == -1 || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || (uint64_t)st.st_size < MIN_MAP_SIZE) {
+		return OK;
+	}
+
+	String path = fix_path(p_path);
+	uint64_t modified_time = (uint64_t)st.st_mtime;
+
+	MutexLock lock(mappings_mutex);
+	HashMap<String, Mapping *>::Iterator E = mappings.find(path);
+	if (E) {
+		Mapping *m = E->value;
+		if (m->device == (uint64_t)st.st_dev && m->inode == (uint64_t)st.st_ino && m->length == (uint64_t)st.st_size && m->modified_time == modified_time) {
+			m->refcount++;
+			mapping = m;
+			data = m->data;
+			length = m->length;
+			return OK;
+		}
+		// The file changed on disk; instances still using the old mapping keep it alive.
+		mappings.remove(E);
+	}
+
+	void *mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (mapped == MAP_FAILED) {
+		return OK; // Not fatal, reads go through stdio instead.
+	}
+
+	mapping = memnew(Mapping);
+	mapping->path = path;
+	mapping->data = (const uint8_t *)mapped;
+	mapping->length = st.st_size;
+	mapping->device = st.st_dev;
+	mapping->inode = st.st_ino;
+	mapping->modified_time = modified_time;
+	mapping->refcount = 1;
+	mappings.insert(path, mapping);
+
+	data = mapping->data;
+	length = mapping->length;
+	return OK;
+}
+
+void FileAccessUnixMmap::seek(uint64_t p_position) {
+	if (!data) {
+		FileAccessUnix::seek(p_position);
+		return;
+	}
+
+	pos = p_position;
+	eof = false;
+}
+
+void FileAccessUnixMmap::seek_end(int64_t p_position) {
+	if (!data) {
+		FileAccessUnix::seek_end(p_position);
+		return;
+	}
+
+	if (p_position < 0 && uint64_t(-p_position) > length) {
+		return; // Same as fseeko(), seeking before the start is ignored.
+	}
+	pos = length + p_position;
+	eof = false;
+}
+
+uint64_t FileAccessUnixMmap::get_position() const {
+	if (!data) {
+		return FileAccessUnix::get_position();
+	}
+	return pos;
+}
+
+uint64_t FileAccessUnixMmap::get_length() const {
+	if (!data) {
+		return FileAccessUnix::get_length();
+	}
+	return length;
+}
+
+bool FileAccessUnixMmap::eof_reached() const {
+	if (!data) {
+		return FileAccessUnix::eof_reached();
+	}
+	return eof;
+}
+
+uint64_t FileAccessUnixMmap::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
+	if (!data) {
+		return FileAccessUnix::get_buffer(p_dst, p_length);
+	}
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+
+	uint64_t to_read = p_length;
+	uint64_t available = pos < length ? length - pos : 0;
+	if (to_read > available) {
+		to_read = available;
+		eof = true;
+	}
+
+	if (to_read > 0) {
+		memcpy(p_dst, data + pos, to_read);
+		pos += to_read;
+	}
+	return to_read;
+}
+
+Span<uint8_t> FileAccessUnixMmap::get_buffer_view(uint64_t p_length) const {
+	if (!data || pos > length || p_length > length - pos) {
+		return Span<uint8_t>();
+	}
+
+	Span<uint8_t> view(data + pos, p_length);
+	pos += p_length;
+	return view;
+}
+
+Error FileAccessUnixMmap::get_error() const {
+	if (!data) {
+		return FileAccessUnix::get_error();
+	}
+	return eof ? ERR_FILE_EOF : OK;
+}
+
+void FileAccessUnixMmap::close() {
+	_unmap();
+	FileAccessUnix::close();
+}
+
+FileAccessUnixMmap::~FileAccessUnixMmap() {
+	_unmap();
+}
+
+#endif // UNIX_ENABLED
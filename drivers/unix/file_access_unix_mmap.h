@@ -0,0 +1,97 @@
+/**************************************************************************/
+/*  file_access_unix_mmap.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "drivers/unix/file_access_unix.h"
+
+#if defined(UNIX_ENABLED)
+
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+
+// Read-only file access that maps the whole file into memory, so reads are plain
+// copies out of the page cache and get_buffer_view() can return zero-copy views.
+// Files opened for writing, or too small for a mapping to pay off, are read through
+// FileAccessUnix as usual.
+// Truncating the file on disk while it is mapped makes reads fault (SIGBUS), so this
+// is only used for files opened with the MMAP flag.
+class FileAccessUnixMmap : public FileAccessUnix {
+	GDSOFTCLASS(FileAccessUnixMmap, FileAccessUnix);
+
+	// Mappings are shared by every open instance of the same unchanged file, so opening
+	// many resources from one pack maps the pack once instead of once per resource.
+	struct Mapping {
+		String path;
+		const uint8_t *data = nullptr;
+		uint64_t length = 0;
+		uint64_t device = 0;
+		uint64_t inode = 0;
+		uint64_t modified_time = 0;
+		uint32_t refcount = 0;
+	};
+
+	static Mutex mappings_mutex;
+	static HashMap<String, Mapping *> mappings;
+
+	Mapping *mapping = nullptr;
+	const uint8_t *data = nullptr;
+	uint64_t length = 0;
+	mutable uint64_t pos = 0;
+	mutable bool eof = false;
+
+	void _unmap();
+
+public:
+	static constexpr uint64_t MIN_MAP_SIZE = 64 * 1024;
+
+	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
+
+	bool is_mapped() const { return data != nullptr; }
+
+	virtual void seek(uint64_t p_position) override;
+	virtual void seek_end(int64_t p_position = 0) override;
+	virtual uint64_t get_position() const override;
+	virtual uint64_t get_length() const override;
+
+	virtual bool eof_reached() const override;
+
+	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual Span<uint8_t> get_buffer_view(uint64_t p_length) const override;
+
+	virtual Error get_error() const override;
+
+	virtual void close() override;
+
+	FileAccessUnixMmap() {}
+	virtual ~FileAccessUnixMmap();
+};
+
+#endif // UNIX_ENABLED
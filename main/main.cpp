@@ -49,6 +49,7 @@
 #include "core/io/resource_loader.h"
 #include "core/object/message_queue.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/os/time.h"
 #include "core/profiling/profiling.h"
@@ -639,7 +640,11 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("-b, --breakpoints", "Breakpoint list as source::line comma-separated pairs, no spaces (use %%20 instead).\n");
 	print_help_option("--ignore-error-breaks", "If debugger is connected, prevents sending error breakpoints.\n");
 	print_help_option("--profiling", "Enable profiling in the script debugger.\n");
+#if defined(DEBUG_ENABLED) && defined(MODULE_GDSCRIPT_ENABLED)
+	print_help_option("--gdscript-profile <file>", "Sample GDScript call stacks per line and count executed opcodes, writing flame graph compatible folded stacks to the specified path on exit.\n", CLI_OPTION_AVAILABILITY_TEMPLATE_DEBUG);
+#endif
 	print_help_option("--gpu-profile", "Show a GPU profile of the tasks that took the most time during frame rendering.\n");
+	print_help_option("--task-trace <file>", "Write the WorkerTaskPool job timeline to the specified path in Chrome Trace Event JSON format (viewable in chrome://tracing or Perfetto).\n");
 	print_help_option("--gpu-validation", "Enable graphics API validation layers for debugging.\n");
 #ifdef DEBUG_ENABLED
 	print_help_option("--gpu-abort", "Abort on graphics API usage errors (usually validation layer errors). May help see the problem if your system freezes.\n", CLI_OPTION_AVAILABILITY_TEMPLATE_DEBUG);
@@ -1472,9 +1477,32 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 				OS::get_singleton()->print("Missing log file path argument, aborting.\n");
 				goto error;
 			}
+		} else if (arg == "--task-trace") { // write WorkerTaskPool trace
+
+			if (N) {
+				if (WorkerTaskPool::get_singleton()->start_trace_capture(N->get()) != OK) {
+					OS::get_singleton()->print("Couldn't open task trace file, aborting.\n");
+					goto error;
+				}
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing task trace file path argument, aborting.\n");
+				goto error;
+			}
 		} else if (arg == "--profiling") { // enable profiling
 
 			use_debug_profiler = true;
+#if defined(DEBUG_ENABLED) && defined(MODULE_GDSCRIPT_ENABLED)
+		} else if (arg == "--gdscript-profile") { // write GDScript line and opcode profile
+
+			if (N) {
+				GDScriptLanguage::instruction_profile_path = N->get();
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing GDScript profile file path argument, aborting.\n");
+				goto error;
+			}
+#endif // DEBUG_ENABLED && MODULE_GDSCRIPT_ENABLED
 
 		} else if (arg == "-l" || arg == "--language") { // language
 
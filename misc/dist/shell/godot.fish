@@ -83,7 +83,9 @@ complete -c godot -l xr-mode -d "Select Extended Reality (XR) mode" -a "default
 complete -c godot -s d -l debug -d "Debug (local stdout debugger)"
 complete -c godot -s b -l breakpoints -d "Specify the breakpoint list as source::line comma-separated pairs, no spaces (use %20 instead)" -x
 complete -c godot -l profiling -d "Enable profiling in the script debugger"
+complete -c godot -l gdscript-profile -d "Sample GDScript lines and count executed opcodes, writing folded stacks to the specified path on exit" -x
 complete -c godot -l gpu-profile -d "Show a GPU profile of the tasks that took the most time during frame rendering"
+complete -c godot -l task-trace -d "Write the WorkerTaskPool job timeline to the specified path in Chrome Trace Event JSON format" -x
 complete -c godot -l gpu-validation -d "Enable graphics API validation layers for debugging"
 complete -c godot -l gpu-abort -d "Abort on graphics API usage errors (usually validation layer errors)"
 complete -c godot -l remote-debug -d "Enable remote debugging"
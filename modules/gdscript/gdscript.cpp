@@ -31,6 +31,7 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
@@ -804,6 +805,26 @@ Error GDScript::reload(bool p_keep_state) {
 
 	bool can_run = ScriptServer::is_scripting_enabled() || is_tool();
 
+	if (!is_valid() && !has_instances) {
+		Error err = OK;
+		if (GDScriptBytecodeCache::load(this, err)) {
+			if (err) {
+				_err_print_error("GDScript::reload", (const char *)path.utf8().get_data(), 0, "Compile Error: Failed to compile depended scripts.", false, ERR_HANDLER_SCRIPT);
+				reloading = false;
+				return ERR_COMPILATION_FAILED;
+			}
+			if (ScriptServer::is_scripting_enabled() || is_tool()) {
+				err = _static_init();
+				if (err) {
+					reloading = false;
+					return err;
+				}
+			}
+			reloading = false;
+			return OK;
+		}
+	}
+
 #ifdef TOOLS_ENABLED
 	if (p_keep_state && can_run && is_valid()) {
 		_save_old_static_data();
@@ -871,6 +892,8 @@ Error GDScript::reload(bool p_keep_state) {
 	GDScriptDocGen::generate_docs(this, parser.get_tree());
 #endif
 
+	GDScriptBytecodeCache::save(this, parser);
+
 #ifdef DEBUG_ENABLED
 	for (const GDScriptWarning &warning : parser.get_warnings()) {
 		if (EngineDebugger::is_active()) {
@@ -2206,11 +2229,70 @@ void GDScriptLanguage::init() {
 	}
 #endif // DEBUG_ENABLED
 
+#ifdef DEBUG_ENABLED
+	// Can be toggled at runtime with `EngineDebugger.profiler_enable("gdscript_instructions", enable, options)`.
+	// When enabling, options are the profile flags and the sampling interval in microseconds.
+	// When disabling, an optional path saves the profile.
+	if (!EngineDebugger::has_profiler("gdscript_instructions")) {
+		EngineDebugger::Profiler instruction_profiler(
+				this,
+				[](void *p_user, bool p_enable, const Array &p_opts) {
+					GDScriptLanguage *language = static_cast<GDScriptLanguage *>(p_user);
+					if (p_enable) {
+						const uint32_t flags = p_opts.size() > 0 ? uint32_t(p_opts[0]) : uint32_t(INSTRUCTION_PROFILE_LINES | INSTRUCTION_PROFILE_OPCODES);
+						const uint64_t interval = p_opts.size() > 1 ? uint64_t(p_opts[1]) : 1000;
+						language->instruction_profiling_start(flags, interval);
+					} else {
+						language->instruction_profiling_stop();
+						if (p_opts.size() > 0) {
+							language->instruction_profiling_save(p_opts[0]);
+						}
+					}
+				},
+				nullptr, nullptr);
+		EngineDebugger::register_profiler("gdscript_instructions", instruction_profiler);
+	}
+
+	if (!instruction_profile_path.is_empty()) {
+		instruction_profiling_start(INSTRUCTION_PROFILE_LINES | INSTRUCTION_PROFILE_OPCODES);
+	}
+#endif // DEBUG_ENABLED
+
+	if (parallel_startup_parse) {
+		_parse_startup_scripts();
+	}
+
 #ifdef TESTS_ENABLED
 	GDScriptTests::GDScriptTestRunner::handle_cmdline();
 #endif // TESTS_ENABLED
 }
 
+void GDScriptLanguage::_parse_startup_scripts() {
+	// Scripts loaded from the bytecode cache aren't parsed at all.
+	if (Engine::get_singleton()->is_editor_hint() || GDScriptBytecodeCache::is_enabled()) {
+		return;
+	}
+
+	Vector<String> paths;
+	for (const KeyValue<StringName, ProjectSettings::AutoloadInfo> &E : ProjectSettings::get_singleton()->get_autoload_list()) {
+		if (E.value.path.get_extension() == "gd") {
+			paths.push_back(E.value.path);
+		}
+	}
+
+	LocalVector<StringName> global_classes;
+	ScriptServer::get_global_class_list(global_classes);
+	for (const StringName &class_name : global_classes) {
+		if (ScriptServer::get_global_class_language(class_name) == get_name()) {
+			paths.push_back(ScriptServer::get_global_class_path(class_name));
+		}
+	}
+
+	// Errors are reported when the scripts are loaded.
+	Error err = OK;
+	startup_parsers = GDScriptCache::get_parsers(paths, GDScriptParserRef::INTERFACE_SOLVED, err);
+}
+
 #ifdef TOOLS_ENABLED
 void GDScriptLanguage::_extension_loaded(const Ref<GDExtension> &p_extension) {
 	List<StringName> class_list;
@@ -2247,8 +2329,21 @@ void GDScriptLanguage::finish() {
 	}
 	finishing = true;
 
+#ifdef DEBUG_ENABLED
+	if (!instruction_profile_path.is_empty()) {
+		instruction_profiling_stop();
+		instruction_profiling_save(instruction_profile_path);
+	}
+	if (EngineDebugger::has_profiler("gdscript_instructions")) {
+		EngineDebugger::unregister_profiler("gdscript_instructions");
+	}
+#endif // DEBUG_ENABLED
+
+	startup_parsers.clear();
+
 	// Clear the cache before parsing the script_list
 	GDScriptCache::clear();
+	GDScriptBytecodeCache::finish();
 
 	// Clear dependencies between scripts, to ensure cyclic references are broken
 	// (to avoid leaks at exit).
@@ -2429,6 +2524,179 @@ void GDScriptLanguage::profiling_collate_native_call_data(bool p_accumulated) {
 #endif
 }
 
+#ifdef DEBUG_ENABLED
+static String _get_instruction_profile_frame(const GDScriptFunction *p_function, int p_line) {
+	String frame = String(p_function->get_name()) + " (" + p_function->get_script()->get_script_path();
+	if (p_line >= 0) {
+		frame += ":" + itos(p_line);
+	}
+	return frame + ")";
+}
+
+static Error _save_folded_stacks(const String &p_path, const HashMap<String, uint64_t> &p_stacks) {
+	Error err;
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(file.is_null(), err, vformat("Can't open GDScript profile file for writing: \"%s\".", p_path));
+
+	LocalVector<String> lines;
+	lines.reserve(p_stacks.size());
+	for (const KeyValue<String, uint64_t> &E : p_stacks) {
+		lines.push_back(E.key + " " + itos(E.value));
+	}
+	lines.sort();
+	for (const String &line : lines) {
+		file->store_line(line);
+	}
+	return OK;
+}
+
+static void _fold_opcode_counts(const String &p_frame, const LocalVector<uint64_t> &p_counts, HashMap<String, uint64_t> &r_opcodes) {
+	for (uint32_t i = 0; i < p_counts.size(); i++) {
+		if (p_counts[i] > 0) {
+			r_opcodes[p_frame + ";" + GDScriptFunction::get_opcode_name(GDScriptFunction::Opcode(i))] += p_counts[i];
+		}
+	}
+}
+
+GDScriptLanguage::InstructionProfile *GDScriptLanguage::_get_instruction_profile() {
+	if (unlikely(!_instruction_profile)) {
+		_instruction_profile = memnew(InstructionProfile);
+		MutexLock lock(mutex);
+		instruction_profiles.push_back(_instruction_profile);
+	}
+	return _instruction_profile;
+}
+
+// Called with `mutex` held when a function is freed, as a new one may be allocated at the same address.
+void GDScriptLanguage::_instruction_profile_remove_function(const GDScriptFunction *p_function) {
+	for (InstructionProfile *profile : instruction_profiles) {
+		MutexLock profile_lock(profile->mutex);
+		HashMap<const GDScriptFunction *, InstructionProfile::FunctionOpcodes>::Iterator E = profile->opcodes.find(p_function);
+		if (E) {
+			_fold_opcode_counts(E->value.frame, E->value.counts, profile->freed_opcodes);
+			profile->opcodes.remove(E);
+		}
+	}
+}
+#endif
+
+void GDScriptLanguage::instruction_profiling_start(uint32_t p_flags, uint64_t p_sample_interval_usec) {
+#ifdef DEBUG_ENABLED
+	MutexLock lock(mutex);
+
+	// Running functions may still hold their opcode counters, so those are reset in place.
+	for (InstructionProfile *profile : instruction_profiles) {
+		MutexLock profile_lock(profile->mutex);
+		profile->stacks.clear();
+		profile->freed_opcodes.clear();
+		for (KeyValue<const GDScriptFunction *, InstructionProfile::FunctionOpcodes> &E : profile->opcodes) {
+			memset(E.value.counts.ptr(), 0, E.value.counts.size() * sizeof(uint64_t));
+		}
+	}
+
+	instruction_profile_session++;
+	instruction_profile_interval = p_sample_interval_usec;
+	instruction_profiling = p_flags;
+#endif
+}
+
+void GDScriptLanguage::instruction_profiling_stop() {
+#ifdef DEBUG_ENABLED
+	MutexLock lock(mutex);
+
+	instruction_profiling = 0;
+#endif
+}
+
+Error GDScriptLanguage::instruction_profiling_save(const String &p_path) {
+#ifdef DEBUG_ENABLED
+	HashMap<String, uint64_t> stacks;
+	HashMap<String, uint64_t> opcodes;
+	{
+		MutexLock lock(mutex);
+		for (InstructionProfile *profile : instruction_profiles) {
+			MutexLock profile_lock(profile->mutex);
+			for (const KeyValue<String, uint64_t> &E : profile->stacks) {
+				stacks[E.key] += E.value;
+			}
+			for (const KeyValue<const GDScriptFunction *, InstructionProfile::FunctionOpcodes> &E : profile->opcodes) {
+				_fold_opcode_counts(E.value.frame, E.value.counts, opcodes);
+			}
+			for (const KeyValue<String, uint64_t> &E : profile->freed_opcodes) {
+				opcodes[E.key] += E.value;
+			}
+		}
+	}
+
+	Error err = _save_folded_stacks(p_path, stacks);
+	if (err != OK || opcodes.is_empty()) {
+		return err;
+	}
+	const String extension = p_path.get_extension();
+	return _save_folded_stacks(extension.is_empty() ? p_path + ".opcodes" : p_path.get_basename() + ".opcodes." + extension, opcodes);
+#else
+	return ERR_UNAVAILABLE;
+#endif
+}
+
+#ifdef DEBUG_ENABLED
+uint64_t *GDScriptLanguage::instruction_profile_enter(const GDScriptFunction *p_function) {
+	InstructionProfile *profile = _get_instruction_profile();
+
+	// Time spent in the engine between calls from it isn't attributed to any line.
+	if (_call_stack_size <= 1 || profile->session != instruction_profile_session) {
+		profile->session = instruction_profile_session;
+		profile->last_sample_usec = OS::get_singleton()->get_ticks_usec();
+	}
+
+	if (!(instruction_profiling & INSTRUCTION_PROFILE_OPCODES)) {
+		return nullptr;
+	}
+
+	MutexLock lock(profile->mutex);
+	InstructionProfile::FunctionOpcodes *opcodes = profile->opcodes.getptr(p_function);
+	if (!opcodes) {
+		opcodes = &profile->opcodes.insert(p_function, InstructionProfile::FunctionOpcodes())->value;
+		opcodes->frame = _get_instruction_profile_frame(p_function, -1);
+		opcodes->counts.resize_initialized(GDScriptFunction::OPCODE_END + 1);
+	}
+	return opcodes->counts.ptr();
+}
+
+void GDScriptLanguage::instruction_profile_line() {
+	InstructionProfile *profile = _get_instruction_profile();
+	const uint64_t now = OS::get_singleton()->get_ticks_usec();
+	if (unlikely(profile->session != instruction_profile_session)) {
+		profile->session = instruction_profile_session;
+		profile->last_sample_usec = now;
+		return;
+	}
+
+	const uint64_t elapsed = now - profile->last_sample_usec;
+	if (elapsed < instruction_profile_interval) {
+		return;
+	}
+	profile->last_sample_usec = now;
+
+	// Called before the line changes, so the innermost frame still points to the line that
+	// took the time since the previous sample.
+	LocalVector<const CallLevel *> levels;
+	for (const CallLevel *level = _call_stack; level; level = level->prev) {
+		levels.push_back(level);
+	}
+	String stack;
+	for (int i = levels.size() - 1; i >= 0; i--) {
+		if (!stack.is_empty()) {
+			stack += ";";
+		}
+		stack += _get_instruction_profile_frame(levels[i]->function, *levels[i]->line);
+	}
+
+	MutexLock lock(profile->mutex);
+	profile->stacks[stack] += elapsed;
+}
+#endif
+
 struct GDScriptDepSort {
 	//must support sorting so inheritance works properly (parent must be reloaded first)
 	bool operator()(const Ref<GDScript> &A, const Ref<GDScript> &B) const {
@@ -2627,6 +2895,10 @@ void GDScriptLanguage::reload_tool_script(const Ref<Script> &p_script, bool p_so
 }
 
 void GDScriptLanguage::frame() {
+	if (!startup_parsers.is_empty()) {
+		startup_parsers.clear();
+	}
+
 #ifdef DEBUG_ENABLED
 	if (profiling) {
 		MutexLock lock(mutex);
@@ -2851,6 +3123,9 @@ String GDScriptLanguage::_get_global_class_name(const String &p_path, String *r_
 
 thread_local GDScriptLanguage::CallLevel *GDScriptLanguage::_call_stack = nullptr;
 thread_local uint32_t GDScriptLanguage::_call_stack_size = 0;
+#ifdef DEBUG_ENABLED
+thread_local GDScriptLanguage::InstructionProfile *GDScriptLanguage::_instruction_profile = nullptr;
+#endif
 
 GDScriptLanguage::CallLevel *GDScriptLanguage::_get_stack_level(uint32_t p_level) {
 	ERR_FAIL_UNSIGNED_INDEX_V(p_level, _call_stack_size, nullptr);
@@ -2889,6 +3164,10 @@ GDScriptLanguage::GDScriptLanguage() {
 	track_call_stack = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_call_stacks", false);
 	track_locals = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_local_variables", false);
 
+	parallel_startup_parse = GLOBAL_DEF_RST("gdscript/loading/parallel_startup_parse", false);
+
+	GDScriptBytecodeCache::initialize();
+
 #ifdef DEBUG_ENABLED
 	track_call_stack = true;
 	track_locals = track_locals || EngineDebugger::is_active();
@@ -2921,6 +3200,12 @@ GDScriptLanguage::GDScriptLanguage() {
 }
 
 GDScriptLanguage::~GDScriptLanguage() {
+#ifdef DEBUG_ENABLED
+	for (InstructionProfile *profile : instruction_profiles) {
+		memdelete(profile);
+	}
+	_instruction_profile = nullptr;
+#endif
 	singleton = nullptr;
 }
 
@@ -60,6 +60,8 @@
 #define GDScriptLanguage _ID290HI109CNQ00
 #endif
 
+class GDScriptParserRef;
+
 class GDScriptNativeClass : public RefCounted {
 	GDCLASS(GDScriptNativeClass, RefCounted);
 
@@ -109,6 +111,7 @@ class GDScript : public Script {
 	friend class GDScriptLambdaCallable;
 	friend class GDScriptLambdaSelfCallable;
 	friend class GDScriptLanguage;
+	friend class GDScriptBytecodeCache;
 	friend struct GDScriptUtilityFunctionsDefinitions;
 
 	Ref<GDScriptNativeClass> native;
@@ -480,10 +483,38 @@ class GDScriptLanguage : public ScriptLanguage {
 	bool profiling;
 	bool profile_native_calls;
 	uint64_t script_frame_time;
+
+	// Line samples and opcode counts, kept per thread so the VM only locks an uncontended mutex.
+	struct InstructionProfile {
+		struct FunctionOpcodes {
+			String frame;
+			LocalVector<uint64_t> counts;
+		};
+
+		Mutex mutex;
+		uint32_t session = 0;
+		uint64_t last_sample_usec = 0;
+		HashMap<String, uint64_t> stacks; // Folded call stacks, outermost frame first, to sampled microseconds.
+		HashMap<const GDScriptFunction *, FunctionOpcodes> opcodes;
+		HashMap<String, uint64_t> freed_opcodes; // Folded like when saving, for functions freed since starting.
+	};
+
+	static thread_local InstructionProfile *_instruction_profile;
+	LocalVector<InstructionProfile *> instruction_profiles;
+	uint32_t instruction_profile_session = 0;
+	uint64_t instruction_profile_interval = 0;
+
+	InstructionProfile *_get_instruction_profile();
+	void _instruction_profile_remove_function(const GDScriptFunction *p_function);
 #endif
 
 	HashMap<String, ObjectID> orphan_subclasses;
 
+	bool parallel_startup_parse = false;
+	Vector<Ref<GDScriptParserRef>> startup_parsers; // Kept until the first frame, so scripts loaded on startup can use them.
+
+	void _parse_startup_scripts();
+
 #ifdef TOOLS_ENABLED
 	void _extension_loaded(const Ref<GDExtension> &p_extension);
 	void _extension_unloading(const Ref<GDExtension> &p_extension);
@@ -667,6 +698,29 @@ public:
 	virtual int profiling_get_accumulated_data(ProfilingInfo *p_info_arr, int p_info_max) override;
 	virtual int profiling_get_frame_data(ProfilingInfo *p_info_arr, int p_info_max) override;
 
+	// Line sampling and opcode counting inside functions, only available in debug builds.
+	// Profiles are saved as folded stacks, the input format of flame graph tools.
+	enum InstructionProfileFlags {
+		INSTRUCTION_PROFILE_LINES = 1 << 0,
+		INSTRUCTION_PROFILE_OPCODES = 1 << 1,
+	};
+
+	// Set by the `--gdscript-profile <file>` command line argument. Profiling starts with the
+	// language and the result is saved to that path when it finishes.
+	static inline String instruction_profile_path;
+
+	void instruction_profiling_start(uint32_t p_flags, uint64_t p_sample_interval_usec = 1000);
+	void instruction_profiling_stop();
+	Error instruction_profiling_save(const String &p_path);
+
+#ifdef DEBUG_ENABLED
+	uint32_t instruction_profiling = 0;
+
+	// Called by the VM while profiling.
+	uint64_t *instruction_profile_enter(const GDScriptFunction *p_function);
+	void instruction_profile_line();
+#endif
+
 	/* LOADER FUNCTIONS */
 
 	virtual void get_recognized_extensions(List<String> *p_extensions) const override;
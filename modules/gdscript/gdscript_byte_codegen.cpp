@@ -193,6 +193,11 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		}
 	}
 
+	if (superinstructions) {
+		fuse_superinstructions();
+	}
+	fusion_candidates.reset();
+
 	if (constant_map.size()) {
 		function->_constant_count = constant_map.size();
 		function->constants.resize(constant_map.size());
@@ -431,6 +436,160 @@ void GDScriptByteCodeGenerator::set_initial_line(int p_line) {
 #define IS_BUILTIN_TYPE(m_var, m_type) \
 	(m_var.type.kind == GDScriptDataType::BUILTIN && m_var.type.builtin_type == m_type && m_type != Variant::NIL)
 
+void GDScriptByteCodeGenerator::append_conditional_jump(GDScriptFunction::Opcode p_code, const Address &p_condition) {
+	// Conditions proven to be booleans are tested directly, without booleanizing them.
+	if (typed_fast_paths && IS_BUILTIN_TYPE(p_condition, Variant::BOOL)) {
+		p_code = p_code == GDScriptFunction::OPCODE_JUMP_IF ? GDScriptFunction::OPCODE_JUMP_IF_BOOL : GDScriptFunction::OPCODE_JUMP_IF_NOT_BOOL;
+	}
+	append_opcode(p_code);
+	append(p_condition);
+}
+
+// Operators the VM runs inline on typed operands. Only covers operators without runtime
+// checks (int division and modulo check for zero).
+static GDScriptFunction::Opcode get_typed_operator_opcode(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type) {
+#define TYPED_OPERATOR(m_op, m_name) \
+	case Variant::OP_##m_op: \
+		return GDScriptFunction::OPCODE_OPERATOR_##m_op##_##m_name;
+
+	if (p_left_type == Variant::INT && p_right_type == Variant::INT) {
+		switch (p_operator) {
+			TYPED_OPERATOR(ADD, INT)
+			TYPED_OPERATOR(SUBTRACT, INT)
+			TYPED_OPERATOR(MULTIPLY, INT)
+			TYPED_OPERATOR(EQUAL, INT)
+			TYPED_OPERATOR(NOT_EQUAL, INT)
+			TYPED_OPERATOR(LESS, INT)
+			TYPED_OPERATOR(LESS_EQUAL, INT)
+			TYPED_OPERATOR(GREATER, INT)
+			TYPED_OPERATOR(GREATER_EQUAL, INT)
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::FLOAT && p_right_type == Variant::FLOAT) {
+		switch (p_operator) {
+			TYPED_OPERATOR(ADD, FLOAT)
+			TYPED_OPERATOR(SUBTRACT, FLOAT)
+			TYPED_OPERATOR(MULTIPLY, FLOAT)
+			TYPED_OPERATOR(DIVIDE, FLOAT)
+			TYPED_OPERATOR(EQUAL, FLOAT)
+			TYPED_OPERATOR(NOT_EQUAL, FLOAT)
+			TYPED_OPERATOR(LESS, FLOAT)
+			TYPED_OPERATOR(LESS_EQUAL, FLOAT)
+			TYPED_OPERATOR(GREATER, FLOAT)
+			TYPED_OPERATOR(GREATER_EQUAL, FLOAT)
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::VECTOR2 && p_right_type == Variant::VECTOR2) {
+		switch (p_operator) {
+			TYPED_OPERATOR(ADD, VECTOR2)
+			TYPED_OPERATOR(SUBTRACT, VECTOR2)
+			TYPED_OPERATOR(MULTIPLY, VECTOR2)
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::VECTOR3 && p_right_type == Variant::VECTOR3) {
+		switch (p_operator) {
+			TYPED_OPERATOR(ADD, VECTOR3)
+			TYPED_OPERATOR(SUBTRACT, VECTOR3)
+			TYPED_OPERATOR(MULTIPLY, VECTOR3)
+			default:
+				break;
+		}
+	} else if (p_operator == Variant::OP_MULTIPLY && p_right_type == Variant::FLOAT) {
+		if (p_left_type == Variant::VECTOR2) {
+			return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT;
+		} else if (p_left_type == Variant::VECTOR3) {
+			return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT;
+		}
+	}
+#undef TYPED_OPERATOR
+
+	return GDScriptFunction::OPCODE_END;
+}
+
+// Superinstruction for an operator followed by a conditional jump on its result.
+static GDScriptFunction::Opcode get_fused_jump_opcode(int p_operator_opcode) {
+#define FUSED_OPERATOR(m_name, m_suffix) \
+	case GDScriptFunction::OPCODE_OPERATOR_##m_name: \
+		return GDScriptFunction::OPCODE_OPERATOR_##m_name##_##m_suffix;
+
+	switch (p_operator_opcode) {
+		FUSED_OPERATOR(VALIDATED, JUMP_IF_NOT)
+		FUSED_OPERATOR(EQUAL_INT, JUMP_IF_NOT)
+		FUSED_OPERATOR(NOT_EQUAL_INT, JUMP_IF_NOT)
+		FUSED_OPERATOR(LESS_INT, JUMP_IF_NOT)
+		FUSED_OPERATOR(LESS_EQUAL_INT, JUMP_IF_NOT)
+		FUSED_OPERATOR(GREATER_INT, JUMP_IF_NOT)
+		FUSED_OPERATOR(GREATER_EQUAL_INT, JUMP_IF_NOT)
+		FUSED_OPERATOR(EQUAL_FLOAT, JUMP_IF_NOT)
+		FUSED_OPERATOR(NOT_EQUAL_FLOAT, JUMP_IF_NOT)
+		FUSED_OPERATOR(LESS_FLOAT, JUMP_IF_NOT)
+		FUSED_OPERATOR(LESS_EQUAL_FLOAT, JUMP_IF_NOT)
+		FUSED_OPERATOR(GREATER_FLOAT, JUMP_IF_NOT)
+		FUSED_OPERATOR(GREATER_EQUAL_FLOAT, JUMP_IF_NOT)
+		default:
+			return GDScriptFunction::OPCODE_END;
+	}
+}
+
+// Superinstruction for an operator whose result is assigned right away (`i += 1`, `x = a * b`).
+static GDScriptFunction::Opcode get_fused_assign_opcode(int p_operator_opcode) {
+	switch (p_operator_opcode) {
+		FUSED_OPERATOR(VALIDATED, ASSIGN)
+		FUSED_OPERATOR(ADD_INT, ASSIGN)
+		FUSED_OPERATOR(SUBTRACT_INT, ASSIGN)
+		FUSED_OPERATOR(MULTIPLY_INT, ASSIGN)
+		FUSED_OPERATOR(ADD_FLOAT, ASSIGN)
+		FUSED_OPERATOR(SUBTRACT_FLOAT, ASSIGN)
+		FUSED_OPERATOR(MULTIPLY_FLOAT, ASSIGN)
+		FUSED_OPERATOR(DIVIDE_FLOAT, ASSIGN)
+		default:
+			return GDScriptFunction::OPCODE_END;
+	}
+#undef FUSED_OPERATOR
+}
+
+// Fusion only rewrites the opcode of the first instruction. Its handler runs both instructions
+// and skips over the second one, which is left intact: instruction positions, jump targets and
+// line data stay valid, and jumps landing on the second instruction still execute it alone.
+// Pairs split by any other instruction (such as a line opcode) are never fused.
+void GDScriptByteCodeGenerator::fuse_superinstructions() {
+	int *code = opcodes.ptrw();
+	const int code_size = opcodes.size();
+
+	for (const int position : fusion_candidates) {
+		const int opcode = code[position];
+		const int next = position + (opcode == GDScriptFunction::OPCODE_OPERATOR_VALIDATED ? 5 : 4);
+		if (next + 3 > code_size) {
+			continue; // Followed by the end of the function.
+		}
+		const int result = code[position + 3];
+
+		GDScriptFunction::Opcode fused = GDScriptFunction::OPCODE_END;
+		switch (code[next]) {
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT_BOOL:
+				if (code[next + 1] == result) {
+					fused = get_fused_jump_opcode(opcode);
+				}
+				break;
+			case GDScriptFunction::OPCODE_ASSIGN:
+				if (code[next + 2] == result) {
+					fused = get_fused_assign_opcode(opcode);
+				}
+				break;
+			default:
+				break;
+		}
+
+		if (fused != GDScriptFunction::OPCODE_END) {
+			code[position] = fused;
+		}
+	}
+}
+
 void GDScriptByteCodeGenerator::write_type_adjust(const Address &p_target, Variant::Type p_new_type) {
 	switch (p_new_type) {
 		case Variant::BOOL:
@@ -559,6 +718,7 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, Variant::NIL);
 
+		fusion_candidates.push_back(opcodes.size());
 		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
 		append(p_left_operand);
 		append(Address());
@@ -571,6 +731,7 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 	}
 
 	// No specific types, perform variant evaluation.
+	function->operator_positions.push_back(opcodes.size());
 	append_opcode(GDScriptFunction::OPCODE_OPERATOR);
 	append(p_left_operand);
 	append(Address());
@@ -613,9 +774,20 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 			}
 		}
 
+		GDScriptFunction::Opcode typed_opcode = typed_fast_paths ? get_typed_operator_opcode(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type) : GDScriptFunction::OPCODE_END;
+		if (typed_opcode != GDScriptFunction::OPCODE_END) {
+			fusion_candidates.push_back(opcodes.size());
+			append_opcode(typed_opcode);
+			append(p_left_operand);
+			append(p_right_operand);
+			append(p_target);
+			return;
+		}
+
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
+		fusion_candidates.push_back(opcodes.size());
 		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
 		append(p_left_operand);
 		append(p_right_operand);
@@ -628,6 +800,7 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 	}
 
 	// No specific types, perform variant evaluation.
+	function->operator_positions.push_back(opcodes.size());
 	append_opcode(GDScriptFunction::OPCODE_OPERATOR);
 	append(p_left_operand);
 	append(p_right_operand);
@@ -694,15 +867,13 @@ void GDScriptByteCodeGenerator::write_type_test(const Address &p_target, const A
 }
 
 void GDScriptByteCodeGenerator::write_and_left_operand(const Address &p_left_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_left_operand);
+	append_conditional_jump(GDScriptFunction::OPCODE_JUMP_IF_NOT, p_left_operand);
 	logic_op_jump_pos1.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
 }
 
 void GDScriptByteCodeGenerator::write_and_right_operand(const Address &p_right_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_right_operand);
+	append_conditional_jump(GDScriptFunction::OPCODE_JUMP_IF_NOT, p_right_operand);
 	logic_op_jump_pos2.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
 }
@@ -724,15 +895,13 @@ void GDScriptByteCodeGenerator::write_end_and(const Address &p_target) {
 }
 
 void GDScriptByteCodeGenerator::write_or_left_operand(const Address &p_left_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF);
-	append(p_left_operand);
+	append_conditional_jump(GDScriptFunction::OPCODE_JUMP_IF, p_left_operand);
 	logic_op_jump_pos1.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
 }
 
 void GDScriptByteCodeGenerator::write_or_right_operand(const Address &p_right_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF);
-	append(p_right_operand);
+	append_conditional_jump(GDScriptFunction::OPCODE_JUMP_IF, p_right_operand);
 	logic_op_jump_pos2.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
 }
@@ -758,8 +927,7 @@ void GDScriptByteCodeGenerator::write_start_ternary(const Address &p_target) {
 }
 
 void GDScriptByteCodeGenerator::write_ternary_condition(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
+	append_conditional_jump(GDScriptFunction::OPCODE_JUMP_IF_NOT, p_condition);
 	ternary_jump_fail_pos.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
 }
@@ -1029,6 +1197,7 @@ void GDScriptByteCodeGenerator::write_assign_default_parameter(const Address &p_
 void GDScriptByteCodeGenerator::write_store_global(const Address &p_dst, int p_global_index) {
 	append_opcode(GDScriptFunction::OPCODE_STORE_GLOBAL);
 	append(p_dst);
+	function->global_index_positions.push_back(opcodes.size());
 	append(p_global_index);
 }
 
@@ -1512,8 +1681,7 @@ void GDScriptByteCodeGenerator::write_await(const Address &p_target, const Addre
 }
 
 void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
+	append_conditional_jump(GDScriptFunction::OPCODE_JUMP_IF_NOT, p_condition);
 	if_jmp_addrs.push_back(opcodes.size());
 	append(0); // Jump destination, will be patched.
 }
@@ -1787,8 +1955,7 @@ void GDScriptByteCodeGenerator::start_while_condition() {
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
 	// Condition check.
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
+	append_conditional_jump(GDScriptFunction::OPCODE_JUMP_IF_NOT, p_condition);
 	while_jmp_addrs.push_back(opcodes.size());
 	append(0); // End of loop address, will be patched.
 }
@@ -35,6 +35,7 @@
 #include "gdscript_function.h"
 #include "gdscript_utility_functions.h"
 
+#include "core/templates/local_vector.h"
 #include "core/templates/rb_map.h"
 #define GDScriptByteCodeGenerator _ID34HH7893AAVC
 
@@ -101,6 +102,9 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	int current_line = 0;
 	int instr_args_max = 0;
 
+	// Positions of operator instructions that may be fused with the instruction that follows them.
+	LocalVector<int> fusion_candidates;
+
 #ifdef DEBUG_ENABLED
 	List<int> temp_stack;
 #endif
@@ -388,6 +392,9 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		instr_args_max = MAX(instr_args_max, p_argument_count);
 	}
 
+	void append_conditional_jump(GDScriptFunction::Opcode p_code, const Address &p_condition);
+	void fuse_superinstructions();
+
 	void append(int p_code) {
 		opcodes.push_back(p_code);
 	}
@@ -457,6 +464,12 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	}
 
 public:
+	// Emit inline opcodes for operators and conditions on proven-typed values. Can be
+	// disabled to compare against the generic validated paths.
+	static inline bool typed_fast_paths = true;
+	// Fuse common instruction pairs into single superinstructions once the function is complete.
+	static inline bool superinstructions = true;
+
 	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local_constant(const StringName &p_name, const Variant &p_constant) override;
@@ -0,0 +1,1792 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript_byte_codegen.h"
+#include "gdscript_parser.h"
+#include "gdscript_utility_functions.h"
+
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/crypto/crypto_core.h"
+#include "core/debugger/engine_debugger.h"
+#include "core/extension/gdextension_manager.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/object/class_db.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/templates/pair.h"
+#include "core/templates/rb_map.h"
+#include "core/version.h"
+
+struct GDScriptBytecodeCache::Writer {
+	LocalVector<uint8_t> data;
+
+	void put_8(uint8_t p_value) {
+		data.push_back(p_value);
+	}
+
+	void put_32(uint32_t p_value) {
+		const uint32_t size = data.size();
+		data.resize(size + 4);
+		encode_uint32(p_value, &data[size]);
+	}
+
+	void put_buffer(const uint8_t *p_data, uint32_t p_size) {
+		const uint32_t size = data.size();
+		data.resize(size + p_size);
+		if (p_size > 0) {
+			memcpy(&data[size], p_data, p_size);
+		}
+	}
+
+	void put_string(const String &p_string) {
+		const CharString utf8 = p_string.utf8();
+		put_32(utf8.length());
+		put_buffer((const uint8_t *)utf8.get_data(), utf8.length());
+	}
+
+	bool put_value(const Variant &p_value) {
+		return encode_variant(p_value, data) == OK;
+	}
+
+	void put_property(const PropertyInfo &p_info) {
+		put_32(p_info.type);
+		put_string(p_info.name);
+		put_string(p_info.class_name);
+		put_32(p_info.hint);
+		put_string(p_info.hint_string);
+		put_32(p_info.usage);
+	}
+};
+
+struct GDScriptBytecodeCache::Reader {
+	const uint8_t *data = nullptr;
+	int size = 0;
+	int pos = 0;
+	bool failed = false;
+
+	bool has(int p_bytes) {
+		if (failed || p_bytes < 0 || p_bytes > size - pos) {
+			failed = true;
+			return false;
+		}
+		return true;
+	}
+
+	uint8_t get_8() {
+		if (!has(1)) {
+			return 0;
+		}
+		return data[pos++];
+	}
+
+	uint32_t get_32() {
+		if (!has(4)) {
+			return 0;
+		}
+		const uint32_t value = decode_uint32(data + pos);
+		pos += 4;
+		return value;
+	}
+
+	int get_int() {
+		return int32_t(get_32());
+	}
+
+	// Reads the size of a list, failing if the rest of the image is too short to hold it.
+	int get_count(int p_element_size = 1) {
+		const uint32_t count = get_32();
+		if (failed || count > uint32_t(size - pos) / p_element_size) {
+			failed = true;
+			return 0;
+		}
+		return count;
+	}
+
+	String get_string() {
+		const int length = get_count();
+		if (failed) {
+			return String();
+		}
+		const String string = String::utf8((const char *)data + pos, length);
+		pos += length;
+		return string;
+	}
+
+	StringName get_string_name() {
+		return StringName(get_string());
+	}
+
+	Variant get_value() {
+		Variant value;
+		int length = 0;
+		if (failed || decode_variant(value, data + pos, size - pos, &length) != OK) {
+			failed = true;
+			return Variant();
+		}
+		pos += length;
+		return value;
+	}
+
+	PropertyInfo get_property() {
+		PropertyInfo info;
+		info.type = Variant::Type(get_32());
+		info.name = get_string();
+		info.class_name = get_string_name();
+		info.hint = PropertyHint(get_32());
+		info.hint_string = get_string();
+		info.usage = get_32();
+		if (info.type >= Variant::VARIANT_MAX) {
+			failed = true;
+		}
+		return info;
+	}
+
+	Reader(const Vector<uint8_t> &p_data) :
+			data(p_data.ptr()), size(p_data.size()) {}
+};
+
+// Native functions are stored by what they were looked up with when compiling,
+// so these map each of them back to its key.
+struct GDScriptBytecodeCache::Symbols {
+	RBMap<Variant::ValidatedOperatorEvaluator, int> operators;
+	RBMap<Variant::ValidatedSetter, Pair<int, StringName>> setters;
+	RBMap<Variant::ValidatedGetter, Pair<int, StringName>> getters;
+	RBMap<Variant::ValidatedKeyedSetter, int> keyed_setters;
+	RBMap<Variant::ValidatedKeyedGetter, int> keyed_getters;
+	RBMap<Variant::ValidatedIndexedSetter, int> indexed_setters;
+	RBMap<Variant::ValidatedIndexedGetter, int> indexed_getters;
+	RBMap<Variant::ValidatedBuiltInMethod, Pair<int, StringName>> builtin_methods;
+	RBMap<Variant::ValidatedConstructor, Pair<int, int>> constructors;
+	RBMap<Variant::ValidatedUtilityFunction, StringName> utilities;
+	RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName> gds_utilities;
+
+	template <typename F, typename K>
+	static void add(RBMap<F, K> &r_map, F p_function, const K &p_key) {
+		// Identical functions may have been merged by the linker, any of their keys gives the same function back.
+		if (p_function != nullptr && !r_map.has(p_function)) {
+			r_map.insert(p_function, p_key);
+		}
+	}
+
+	static void put_key(Writer &p_writer, int p_key) {
+		p_writer.put_32(p_key);
+	}
+
+	static void put_key(Writer &p_writer, const StringName &p_key) {
+		p_writer.put_string(p_key);
+	}
+
+	static void put_key(Writer &p_writer, const Pair<int, StringName> &p_key) {
+		p_writer.put_32(p_key.first);
+		p_writer.put_string(p_key.second);
+	}
+
+	static void put_key(Writer &p_writer, const Pair<int, int> &p_key) {
+		p_writer.put_32(p_key.first);
+		p_writer.put_32(p_key.second);
+	}
+
+	template <typename F, typename K>
+	static bool write(Writer &p_writer, const Vector<F> &p_functions, const RBMap<F, K> &p_keys) {
+		p_writer.put_32(p_functions.size());
+		for (const F function : p_functions) {
+			const typename RBMap<F, K>::Element *E = p_keys.find(function);
+			if (E == nullptr) {
+				return false;
+			}
+			put_key(p_writer, E->value());
+		}
+		return true;
+	}
+
+	template <typename F>
+	static bool read(Reader &p_reader, Vector<F> &r_functions, F (*p_resolve)(Reader &)) {
+		const int count = p_reader.get_count(4);
+		r_functions.resize(count);
+		for (int i = 0; i < count; i++) {
+			const F function = p_resolve(p_reader);
+			if (function == nullptr) {
+				return false;
+			}
+			r_functions.write[i] = function;
+		}
+		return !p_reader.failed;
+	}
+
+	static Variant::Type get_type(Reader &p_reader) {
+		const uint32_t type = p_reader.get_32();
+		return type < Variant::VARIANT_MAX ? Variant::Type(type) : Variant::VARIANT_MAX;
+	}
+
+	static Variant::ValidatedOperatorEvaluator resolve_operator(Reader &p_reader) {
+		const uint32_t key = p_reader.get_32();
+		const uint32_t op = key >> 16;
+		const uint32_t type_a = (key >> 8) & 0xFF;
+		const uint32_t type_b = key & 0xFF;
+		if (op >= Variant::OP_MAX || type_a >= Variant::VARIANT_MAX || type_b >= Variant::VARIANT_MAX) {
+			return nullptr;
+		}
+		return Variant::get_validated_operator_evaluator(Variant::Operator(op), Variant::Type(type_a), Variant::Type(type_b));
+	}
+
+	static Variant::ValidatedSetter resolve_setter(Reader &p_reader) {
+		const Variant::Type type = get_type(p_reader);
+		const StringName member = p_reader.get_string_name();
+		return type < Variant::VARIANT_MAX ? Variant::get_member_validated_setter(type, member) : nullptr;
+	}
+
+	static Variant::ValidatedGetter resolve_getter(Reader &p_reader) {
+		const Variant::Type type = get_type(p_reader);
+		const StringName member = p_reader.get_string_name();
+		return type < Variant::VARIANT_MAX ? Variant::get_member_validated_getter(type, member) : nullptr;
+	}
+
+	static Variant::ValidatedKeyedSetter resolve_keyed_setter(Reader &p_reader) {
+		const Variant::Type type = get_type(p_reader);
+		return type < Variant::VARIANT_MAX ? Variant::get_member_validated_keyed_setter(type) : nullptr;
+	}
+
+	static Variant::ValidatedKeyedGetter resolve_keyed_getter(Reader &p_reader) {
+		const Variant::Type type = get_type(p_reader);
+		return type < Variant::VARIANT_MAX ? Variant::get_member_validated_keyed_getter(type) : nullptr;
+	}
+
+	static Variant::ValidatedIndexedSetter resolve_indexed_setter(Reader &p_reader) {
+		const Variant::Type type = get_type(p_reader);
+		return type < Variant::VARIANT_MAX ? Variant::get_member_validated_indexed_setter(type) : nullptr;
+	}
+
+	static Variant::ValidatedIndexedGetter resolve_indexed_getter(Reader &p_reader) {
+		const Variant::Type type = get_type(p_reader);
+		return type < Variant::VARIANT_MAX ? Variant::get_member_validated_indexed_getter(type) : nullptr;
+	}
+
+	static Variant::ValidatedBuiltInMethod resolve_builtin_method(Reader &p_reader) {
+		const Variant::Type type = get_type(p_reader);
+		const StringName method = p_reader.get_string_name();
+		if (type >= Variant::VARIANT_MAX || !Variant::has_builtin_method(type, method)) {
+			return nullptr;
+		}
+		return Variant::get_validated_builtin_method(type, method);
+	}
+
+	static Variant::ValidatedConstructor resolve_constructor(Reader &p_reader) {
+		const Variant::Type type = get_type(p_reader);
+		const int index = p_reader.get_int();
+		if (type >= Variant::VARIANT_MAX || index < 0 || index >= Variant::get_constructor_count(type)) {
+			return nullptr;
+		}
+		return Variant::get_validated_constructor(type, index);
+	}
+
+	static Variant::ValidatedUtilityFunction resolve_utility(Reader &p_reader) {
+		return Variant::get_validated_utility_function(p_reader.get_string_name());
+	}
+
+	static GDScriptUtilityFunctions::FunctionPtr resolve_gds_utility(Reader &p_reader) {
+		const StringName function = p_reader.get_string_name();
+		return GDScriptUtilityFunctions::function_exists(function) ? GDScriptUtilityFunctions::get_function(function) : nullptr;
+	}
+
+	static MethodBind *resolve_method(Reader &p_reader) {
+		const StringName class_name = p_reader.get_string_name();
+		const StringName method = p_reader.get_string_name();
+		const uint32_t hash = p_reader.get_32();
+		MethodBind *bind = ClassDB::get_method(class_name, method);
+		// The signature may have changed since the image was made, even if the name didn't.
+		return bind != nullptr && bind->get_hash() == hash ? bind : nullptr;
+	}
+
+	Symbols() {
+		for (int type = 0; type < Variant::VARIANT_MAX; type++) {
+			const Variant::Type variant_type = Variant::Type(type);
+
+			for (int op = 0; op < Variant::OP_MAX; op++) {
+				for (int type_b = 0; type_b < Variant::VARIANT_MAX; type_b++) {
+					add(operators, Variant::get_validated_operator_evaluator(Variant::Operator(op), variant_type, Variant::Type(type_b)), (op << 16) | (type << 8) | type_b);
+				}
+			}
+
+			List<StringName> members;
+			Variant::get_member_list(variant_type, &members);
+			for (const StringName &member : members) {
+				add(setters, Variant::get_member_validated_setter(variant_type, member), Pair<int, StringName>(type, member));
+				add(getters, Variant::get_member_validated_getter(variant_type, member), Pair<int, StringName>(type, member));
+			}
+
+			add(keyed_setters, Variant::get_member_validated_keyed_setter(variant_type), type);
+			add(keyed_getters, Variant::get_member_validated_keyed_getter(variant_type), type);
+			add(indexed_setters, Variant::get_member_validated_indexed_setter(variant_type), type);
+			add(indexed_getters, Variant::get_member_validated_indexed_getter(variant_type), type);
+
+			List<StringName> methods;
+			Variant::get_builtin_method_list(variant_type, &methods);
+			for (const StringName &method : methods) {
+				add(builtin_methods, Variant::get_validated_builtin_method(variant_type, method), Pair<int, StringName>(type, method));
+			}
+
+			for (int i = 0; i < Variant::get_constructor_count(variant_type); i++) {
+				add(constructors, Variant::get_validated_constructor(variant_type, i), Pair<int, int>(type, i));
+			}
+		}
+
+		List<StringName> functions;
+		Variant::get_utility_function_list(&functions);
+		for (const StringName &function : functions) {
+			add(utilities, Variant::get_validated_utility_function(function), function);
+		}
+
+		functions.clear();
+		GDScriptUtilityFunctions::get_function_list(&functions);
+		for (const StringName &function : functions) {
+			add(gds_utilities, GDScriptUtilityFunctions::get_function(function), function);
+		}
+	}
+};
+
+struct GDScriptBytecodeCache::SaveContext {
+	const GDScript *root = nullptr;
+	HashMap<ObjectID, StringName> global_objects;
+	HashMap<int, StringName> global_indices;
+	HashSet<String> dependencies; // Other scripts referenced by the image.
+};
+
+struct GDScriptBytecodeCache::ClassData {
+	GDScript *script = nullptr;
+	bool tool = false;
+	bool is_abstract = false;
+	Ref<GDScriptNativeClass> native;
+	Ref<GDScript> base;
+	ClassData *base_data = nullptr; // Set if the base is in the same file.
+	int base_member_count = 0;
+	LocalVector<Pair<StringName, GDScript::MemberInfo>> members;
+	HashMap<StringName, GDScript::MemberInfo> static_variables_indices;
+	HashMap<StringName, Variant> constants;
+	HashMap<StringName, MethodInfo> signals;
+	Dictionary rpc_config;
+#ifdef TOOLS_ENABLED
+	HashMap<StringName, Variant> member_default_values;
+#endif
+	HashMap<StringName, GDScriptFunction *> member_functions;
+	GDScriptFunction *implicit_initializer = nullptr;
+	GDScriptFunction *implicit_ready = nullptr;
+	GDScriptFunction *static_initializer = nullptr;
+	HashMap<GDScriptFunction *, GDScript::LambdaInfo> lambda_info;
+	LocalVector<ClassData *> subclasses;
+	bool installed = false;
+
+	~ClassData() {
+		for (ClassData *subclass : subclasses) {
+			memdelete(subclass);
+		}
+	}
+};
+
+struct GDScriptBytecodeCache::LoadContext {
+	GDScript *root = nullptr;
+	HashMap<GDScript *, ClassData *> classes;
+	LocalVector<GDScriptFunction *> functions; // Freed if the image can't be used. Lambdas are freed along with them.
+};
+
+static bool _has_static_data(const GDScriptParser::ClassNode *p_class) {
+	if (p_class->has_static_data) {
+		return true;
+	}
+	for (const GDScriptParser::ClassNode::Member &member : p_class->members) {
+		if (member.type == GDScriptParser::ClassNode::Member::CLASS && _has_static_data(member.m_class)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void GDScriptBytecodeCache::initialize() {
+	enabled = GLOBAL_DEF_RST("gdscript/bytecode_cache/enabled", false);
+	cache_path = GLOBAL_DEF_RST(PropertyInfo(Variant::STRING, "gdscript/bytecode_cache/path", PROPERTY_HINT_DIR), "user://gdscript_cache");
+}
+
+void GDScriptBytecodeCache::finish() {
+	MutexLock lock(mutex);
+	if (symbols != nullptr) {
+		memdelete(symbols);
+		symbols = nullptr;
+	}
+	build_key = String();
+	environment_hash = String();
+	file_hashes.clear();
+	pending_images.clear();
+}
+
+bool GDScriptBytecodeCache::is_enabled() {
+	return enabled && !cache_path.is_empty() && !Engine::get_singleton()->is_editor_hint() && !EngineDebugger::is_active();
+}
+
+String GDScriptBytecodeCache::get_image_path(const String &p_script_path) {
+	return cache_path.path_join(p_script_path.get_file().get_basename() + "-" + p_script_path.md5_text() + ".gdbc");
+}
+
+bool GDScriptBytecodeCache::_can_cache(const GDScript *p_script) {
+	if (!p_script->is_root_script() || p_script->path.is_empty() || p_script->path.contains("::")) {
+		return false; // Built-in scripts are stored with their resource.
+	}
+	return !p_script->source.is_empty() || !p_script->binary_tokens.is_empty();
+}
+
+String GDScriptBytecodeCache::_get_build_key() {
+	MutexLock lock(mutex);
+	if (build_key.is_empty()) {
+		// Opcodes and the layout of the image only match within one build, which the version doesn't tell apart for custom builds.
+		build_key = vformat("%s:%s:%d:%d:%d:%d:%d", GODOT_VERSION_FULL_BUILD, GODOT_VERSION_HASH, (int)sizeof(void *), (int)sizeof(real_t), (int)GDScriptFunction::OPCODE_END, (int)Variant::VARIANT_MAX, (int)Variant::OP_MAX);
+		build_key += ":" + itos(FileAccess::get_modified_time(OS::get_singleton()->get_executable_path()));
+		// Method binds are linked by name, the class API and loaded extensions tell whether they still match.
+		// API hashes are 0 outside debug builds, the hash of each method is still checked when linking.
+		build_key += vformat(":%d:%d", ClassDB::get_api_hash(ClassDB::API_CORE), ClassDB::get_api_hash(ClassDB::API_EXTENSION));
+		Vector<String> extensions = GDExtensionManager::get_singleton()->get_loaded_extensions();
+		extensions.sort();
+		for (const String &extension : extensions) {
+			build_key += ":" + extension;
+		}
+#ifdef DEBUG_ENABLED
+		build_key += ":debug";
+#endif
+#ifdef TOOLS_ENABLED
+		build_key += vformat(":tools:%d", ClassDB::get_api_hash(ClassDB::API_EDITOR));
+#endif
+	}
+
+	// These change the generated code and can be toggled at runtime.
+	const GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	return build_key + vformat(":%d%d%d%d", (int)GDScriptByteCodeGenerator::typed_fast_paths, (int)GDScriptByteCodeGenerator::superinstructions, (int)language->should_track_call_stack(), (int)language->should_track_locals());
+}
+
+String GDScriptBytecodeCache::_get_environment_hash() {
+	MutexLock lock(mutex);
+	if (!environment_hash.is_empty()) {
+		return environment_hash;
+	}
+
+	// Identifiers are resolved to global classes and autoloads when analyzing.
+	String environment;
+
+	LocalVector<StringName> global_classes;
+	ScriptServer::get_global_class_list(global_classes);
+	global_classes.sort_custom<StringName::AlphCompare>();
+	for (const StringName &class_name : global_classes) {
+		environment += vformat("%s:%s:%s\n", class_name, ScriptServer::get_global_class_path(class_name), ScriptServer::get_global_class_base(class_name));
+	}
+
+	LocalVector<String> autoloads;
+	for (const KeyValue<StringName, ProjectSettings::AutoloadInfo> &E : ProjectSettings::get_singleton()->get_autoload_list()) {
+		autoloads.push_back(vformat("%s:%s:%d\n", E.key, E.value.path, (int)E.value.is_singleton));
+	}
+	autoloads.sort();
+	for (const String &autoload : autoloads) {
+		environment += autoload;
+	}
+
+	environment_hash = environment.md5_text();
+	return environment_hash;
+}
+
+String GDScriptBytecodeCache::_get_file_hash(const String &p_path) {
+	MutexLock lock(mutex);
+	const String *hash = file_hashes.getptr(p_path);
+	if (hash != nullptr) {
+		return *hash;
+	}
+	const String file_hash = FileAccess::get_md5(ResourceLoader::path_remap(p_path));
+	file_hashes.insert(p_path, file_hash);
+	return file_hash;
+}
+
+String GDScriptBytecodeCache::_get_source_hash(const GDScript *p_script) {
+	if (!p_script->binary_tokens.is_empty()) {
+		unsigned char hash[16];
+		CryptoCore::md5(p_script->binary_tokens.ptr(), p_script->binary_tokens.size(), hash);
+		return String::md5(hash);
+	}
+	return p_script->source.md5_text();
+}
+
+bool GDScriptBytecodeCache::_collect_dependencies(GDScriptParser *p_parser, HashSet<String> &r_paths) {
+	for (const KeyValue<String, Ref<GDScriptParserRef>> &E : p_parser->get_depended_parsers()) {
+		if (r_paths.has(E.key)) {
+			continue;
+		}
+		r_paths.insert(E.key);
+		if (E.value.is_null() || E.value->get_parser() == nullptr) {
+			return false;
+		}
+		if (!_collect_dependencies(E.value->get_parser(), r_paths)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GDScriptBytecodeCache::_read_image(const GDScript *p_script, Vector<uint8_t> &r_body) {
+	Error err = OK;
+	const Vector<uint8_t> image = FileAccess::get_file_as_bytes(get_image_path(p_script->path), &err);
+	if (err != OK) {
+		return false;
+	}
+
+	Reader reader(image);
+	if (!reader.has(4) || memcmp(image.ptr(), "GDBC", 4) != 0) {
+		return false;
+	}
+	reader.pos += 4;
+	if (reader.get_32() != FORMAT_VERSION) {
+		return false;
+	}
+	if (reader.get_string() != _get_build_key() || reader.get_string() != _get_environment_hash() || reader.get_string() != _get_source_hash(p_script)) {
+		return false;
+	}
+
+	const int dependency_count = reader.get_count(8);
+	for (int i = 0; i < dependency_count; i++) {
+		const String path = reader.get_string();
+		const String hash = reader.get_string();
+		if (reader.failed || hash != _get_file_hash(path)) {
+			return false;
+		}
+	}
+
+	const String body_hash = reader.get_string();
+	if (reader.failed) {
+		return false;
+	}
+	unsigned char hash[16];
+	CryptoCore::md5(image.ptr() + reader.pos, reader.size - reader.pos, hash);
+	if (String::md5(hash) != body_hash) {
+		return false;
+	}
+
+	r_body = image.slice(reader.pos);
+	return true;
+}
+
+void GDScriptBytecodeCache::_link_function(GDScriptFunction *p_function) {
+	// Same as `GDScriptByteCodeGenerator::write_end()`.
+	p_function->_code_ptr = p_function->code.is_empty() ? nullptr : p_function->code.ptrw();
+	p_function->_code_size = p_function->code.size();
+	p_function->_default_arg_ptr = p_function->default_arguments.is_empty() ? nullptr : p_function->default_arguments.ptr();
+	p_function->_default_arg_count = p_function->default_arguments.is_empty() ? 0 : p_function->default_arguments.size() - 1;
+	p_function->_constants_ptr = p_function->constants.is_empty() ? nullptr : p_function->constants.ptrw();
+	p_function->_constant_count = p_function->constants.size();
+	p_function->_global_names_ptr = p_function->global_names.is_empty() ? nullptr : p_function->global_names.ptr();
+	p_function->_global_names_count = p_function->global_names.size();
+	p_function->_operator_funcs_ptr = p_function->operator_funcs.is_empty() ? nullptr : p_function->operator_funcs.ptr();
+	p_function->_operator_funcs_count = p_function->operator_funcs.size();
+	p_function->_setters_ptr = p_function->setters.is_empty() ? nullptr : p_function->setters.ptr();
+	p_function->_setters_count = p_function->setters.size();
+	p_function->_getters_ptr = p_function->getters.is_empty() ? nullptr : p_function->getters.ptr();
+	p_function->_getters_count = p_function->getters.size();
+	p_function->_keyed_setters_ptr = p_function->keyed_setters.is_empty() ? nullptr : p_function->keyed_setters.ptr();
+	p_function->_keyed_setters_count = p_function->keyed_setters.size();
+	p_function->_keyed_getters_ptr = p_function->keyed_getters.is_empty() ? nullptr : p_function->keyed_getters.ptr();
+	p_function->_keyed_getters_count = p_function->keyed_getters.size();
+	p_function->_indexed_setters_ptr = p_function->indexed_setters.is_empty() ? nullptr : p_function->indexed_setters.ptr();
+	p_function->_indexed_setters_count = p_function->indexed_setters.size();
+	p_function->_indexed_getters_ptr = p_function->indexed_getters.is_empty() ? nullptr : p_function->indexed_getters.ptr();
+	p_function->_indexed_getters_count = p_function->indexed_getters.size();
+	p_function->_builtin_methods_ptr = p_function->builtin_methods.is_empty() ? nullptr : p_function->builtin_methods.ptr();
+	p_function->_builtin_methods_count = p_function->builtin_methods.size();
+	p_function->_constructors_ptr = p_function->constructors.is_empty() ? nullptr : p_function->constructors.ptr();
+	p_function->_constructors_count = p_function->constructors.size();
+	p_function->_utilities_ptr = p_function->utilities.is_empty() ? nullptr : p_function->utilities.ptr();
+	p_function->_utilities_count = p_function->utilities.size();
+	p_function->_gds_utilities_ptr = p_function->gds_utilities.is_empty() ? nullptr : p_function->gds_utilities.ptr();
+	p_function->_gds_utilities_count = p_function->gds_utilities.size();
+	p_function->_methods_ptr = p_function->methods.is_empty() ? nullptr : p_function->methods.ptrw();
+	p_function->_methods_count = p_function->methods.size();
+	p_function->_lambdas_ptr = p_function->lambdas.is_empty() ? nullptr : p_function->lambdas.ptrw();
+	p_function->_lambdas_count = p_function->lambdas.size();
+}
+
+void GDScriptBytecodeCache::_free_function(GDScriptFunction *p_function) {
+	// The destructor erases the function from its script by name, which would remove the function that's in use there.
+	for (GDScriptFunction *lambda : p_function->lambdas) {
+		_free_function(lambda);
+	}
+	p_function->lambdas.clear();
+	p_function->name = StringName();
+	memdelete(p_function);
+}
+
+void GDScriptBytecodeCache::_reset_class(GDScript *p_script) {
+	// Same as `GDScriptCompiler::_prepare_compilation()`.
+	p_script->clearing = true;
+
+	p_script->cancel_pending_functions(true);
+
+	p_script->native = Ref<GDScriptNativeClass>();
+	p_script->base = Ref<GDScript>();
+	p_script->members.clear();
+
+	// This makes possible to clear script constants and member_functions without heap-use-after-free errors.
+	HashMap<StringName, Variant> constants;
+	for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+		constants.insert(E.key, E.value);
+	}
+	p_script->constants.clear();
+	constants.clear();
+	HashMap<StringName, GDScriptFunction *> member_functions;
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		member_functions.insert(E.key, E.value);
+	}
+	p_script->member_functions.clear();
+	for (const KeyValue<StringName, GDScriptFunction *> &E : member_functions) {
+		memdelete(E.value);
+	}
+	member_functions.clear();
+
+	if (p_script->implicit_initializer) {
+		memdelete(p_script->implicit_initializer);
+	}
+	if (p_script->implicit_ready) {
+		memdelete(p_script->implicit_ready);
+	}
+	if (p_script->static_initializer) {
+		memdelete(p_script->static_initializer);
+	}
+
+	p_script->member_functions.clear();
+	p_script->member_indices.clear();
+	p_script->static_variables_indices.clear();
+	p_script->static_variables.clear();
+	p_script->_signals.clear();
+	p_script->initializer = nullptr;
+	p_script->implicit_initializer = nullptr;
+	p_script->implicit_ready = nullptr;
+	p_script->static_initializer = nullptr;
+	p_script->rpc_config.clear();
+	p_script->lambda_info.clear();
+
+	p_script->clearing = false;
+}
+
+bool GDScriptBytecodeCache::_write_object(SaveContext &p_context, Writer &p_writer, const Object *p_object) {
+	if (p_object == nullptr) {
+		p_writer.put_8(OBJECT_NULL);
+		return true;
+	}
+
+	const StringName *global = p_context.global_objects.getptr(p_object->get_instance_id());
+	if (global != nullptr) {
+		// Native classes and singletons.
+		p_writer.put_8(OBJECT_GLOBAL);
+		p_writer.put_string(*global);
+		return true;
+	}
+
+	const GDScript *gdscript = Object::cast_to<GDScript>(p_object);
+	if (gdscript != nullptr) {
+		if (gdscript->path.is_empty() || gdscript->path.contains("::")) {
+			return false;
+		}
+		p_writer.put_8(OBJECT_GDSCRIPT);
+		p_writer.put_string(gdscript->path);
+		p_writer.put_string(gdscript->fully_qualified_name);
+		if (gdscript->path != p_context.root->path) {
+			p_context.dependencies.insert(gdscript->path);
+		}
+		return true;
+	}
+
+	const Resource *resource = Object::cast_to<Resource>(p_object);
+	if (resource == nullptr || resource->is_built_in()) {
+		return false;
+	}
+	p_writer.put_8(OBJECT_RESOURCE);
+	p_writer.put_string(resource->get_path());
+	if (Object::cast_to<Script>(resource) != nullptr) {
+		p_context.dependencies.insert(resource->get_path());
+	}
+	return true;
+}
+
+bool GDScriptBytecodeCache::_write_variant(SaveContext &p_context, Writer &p_writer, const Variant &p_value) {
+	switch (p_value.get_type()) {
+		case Variant::OBJECT: {
+			p_writer.put_8(VARIANT_OBJECT);
+			return _write_object(p_context, p_writer, p_value.get_validated_object());
+		}
+		case Variant::ARRAY: {
+			const Array array = p_value;
+			p_writer.put_8(VARIANT_ARRAY);
+			p_writer.put_8(array.is_read_only());
+			p_writer.put_32(array.get_typed_builtin());
+			p_writer.put_string(array.get_typed_class_name());
+			if (!_write_object(p_context, p_writer, array.get_typed_script().get_validated_object())) {
+				return false;
+			}
+			p_writer.put_32(array.size());
+			for (const Variant &element : array) {
+				if (!_write_variant(p_context, p_writer, element)) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case Variant::DICTIONARY: {
+			const Dictionary dictionary = p_value;
+			p_writer.put_8(VARIANT_DICTIONARY);
+			p_writer.put_8(dictionary.is_read_only());
+			p_writer.put_32(dictionary.get_typed_key_builtin());
+			p_writer.put_string(dictionary.get_typed_key_class_name());
+			if (!_write_object(p_context, p_writer, dictionary.get_typed_key_script().get_validated_object())) {
+				return false;
+			}
+			p_writer.put_32(dictionary.get_typed_value_builtin());
+			p_writer.put_string(dictionary.get_typed_value_class_name());
+			if (!_write_object(p_context, p_writer, dictionary.get_typed_value_script().get_validated_object())) {
+				return false;
+			}
+			p_writer.put_32(dictionary.size());
+			for (const KeyValue<Variant, Variant> &E : dictionary) {
+				if (!_write_variant(p_context, p_writer, E.key) || !_write_variant(p_context, p_writer, E.value)) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case Variant::CALLABLE:
+		case Variant::SIGNAL:
+		case Variant::RID: {
+			return false; // Only valid in this process.
+		}
+		default: {
+			p_writer.put_8(VARIANT_VALUE);
+			return p_writer.put_value(p_value);
+		}
+	}
+}
+
+bool GDScriptBytecodeCache::_write_data_type(SaveContext &p_context, Writer &p_writer, const GDScriptDataType &p_type) {
+	p_writer.put_8(p_type.kind);
+	p_writer.put_32(p_type.builtin_type);
+	p_writer.put_string(p_type.native_type);
+	if (!_write_object(p_context, p_writer, p_type.script_type)) {
+		return false;
+	}
+	p_writer.put_8(p_type.script_type_ref.is_valid());
+	p_writer.put_32(p_type.container_element_types.size());
+	for (const GDScriptDataType &element_type : p_type.container_element_types) {
+		if (!_write_data_type(p_context, p_writer, element_type)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GDScriptBytecodeCache::_write_method_info(SaveContext &p_context, Writer &p_writer, const MethodInfo &p_info) {
+	p_writer.put_string(p_info.name);
+	p_writer.put_property(p_info.return_val);
+	p_writer.put_32(p_info.flags);
+	p_writer.put_32(p_info.id);
+	p_writer.put_32(p_info.arguments.size());
+	for (const PropertyInfo &argument : p_info.arguments) {
+		p_writer.put_property(argument);
+	}
+	p_writer.put_32(p_info.default_arguments.size());
+	for (const Variant &default_argument : p_info.default_arguments) {
+		if (!_write_variant(p_context, p_writer, default_argument)) {
+			return false;
+		}
+	}
+	p_writer.put_32(p_info.return_val_metadata);
+	p_writer.put_32(p_info.arguments_metadata.size());
+	for (const int metadata : p_info.arguments_metadata) {
+		p_writer.put_32(metadata);
+	}
+	return true;
+}
+
+bool GDScriptBytecodeCache::_write_member_info(SaveContext &p_context, Writer &p_writer, const GDScript::MemberInfo &p_info) {
+	p_writer.put_32(p_info.index);
+	p_writer.put_string(p_info.setter);
+	p_writer.put_string(p_info.getter);
+	p_writer.put_property(p_info.property_info);
+	return _write_data_type(p_context, p_writer, p_info.data_type);
+}
+
+bool GDScriptBytecodeCache::_write_function(SaveContext &p_context, Writer &p_writer, const GDScript *p_class, const GDScriptFunction *p_function) {
+	p_writer.put_string(p_function->name);
+	p_writer.put_8(p_function->_static);
+	p_writer.put_32(p_function->argument_types.size());
+	for (const GDScriptDataType &argument_type : p_function->argument_types) {
+		if (!_write_data_type(p_context, p_writer, argument_type)) {
+			return false;
+		}
+	}
+	if (!_write_data_type(p_context, p_writer, p_function->return_type) || !_write_method_info(p_context, p_writer, p_function->method_info) || !_write_variant(p_context, p_writer, p_function->rpc_config)) {
+		return false;
+	}
+
+	p_writer.put_32(p_function->_initial_line);
+	p_writer.put_32(p_function->_argument_count);
+	p_writer.put_32(p_function->_vararg_index);
+	p_writer.put_32(p_function->_stack_size);
+	p_writer.put_32(p_function->_instruction_args_size);
+
+	p_writer.put_32(p_function->temporary_slots.size());
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		p_writer.put_32(E.key);
+		p_writer.put_32(E.value);
+	}
+
+	p_writer.put_32(p_function->stack_debug.size());
+	for (const GDScriptFunction::StackDebug &stack_debug : p_function->stack_debug) {
+		p_writer.put_32(stack_debug.line);
+		p_writer.put_32(stack_debug.pos);
+		p_writer.put_8(stack_debug.added);
+		p_writer.put_string(stack_debug.identifier);
+	}
+
+	// Operators cache their evaluator in the code once they have run, so the image gets the code as it was generated.
+	Vector<int> code = p_function->code;
+	constexpr int pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(int);
+	for (const int position : p_function->operator_positions) {
+		ERR_FAIL_COND_V(position + 7 + pointer_size > code.size(), false);
+		for (int i = position + 5; i < position + 7 + pointer_size; i++) {
+			code.write[i] = 0;
+		}
+	}
+	p_writer.put_32(code.size());
+	for (const int word : code) {
+		p_writer.put_32(word);
+	}
+
+	p_writer.put_32(p_function->global_index_positions.size());
+	for (const int position : p_function->global_index_positions) {
+		const StringName *global = p_context.global_indices.getptr(code[position]);
+		if (global == nullptr) {
+			return false;
+		}
+		p_writer.put_32(position);
+		p_writer.put_string(*global);
+	}
+	p_writer.put_32(p_function->operator_positions.size());
+	for (const int position : p_function->operator_positions) {
+		p_writer.put_32(position);
+	}
+
+	p_writer.put_32(p_function->default_arguments.size());
+	for (const int default_argument : p_function->default_arguments) {
+		p_writer.put_32(default_argument);
+	}
+	p_writer.put_32(p_function->constants.size());
+	for (const Variant &constant : p_function->constants) {
+		if (!_write_variant(p_context, p_writer, constant)) {
+			return false;
+		}
+	}
+	p_writer.put_32(p_function->constant_map.size());
+	for (const KeyValue<StringName, Variant> &E : p_function->constant_map) {
+		p_writer.put_string(E.key);
+		if (!_write_variant(p_context, p_writer, E.value)) {
+			return false;
+		}
+	}
+	p_writer.put_32(p_function->global_names.size());
+	for (const StringName &global_name : p_function->global_names) {
+		p_writer.put_string(global_name);
+	}
+
+	if (!Symbols::write(p_writer, p_function->operator_funcs, symbols->operators) ||
+			!Symbols::write(p_writer, p_function->setters, symbols->setters) ||
+			!Symbols::write(p_writer, p_function->getters, symbols->getters) ||
+			!Symbols::write(p_writer, p_function->keyed_setters, symbols->keyed_setters) ||
+			!Symbols::write(p_writer, p_function->keyed_getters, symbols->keyed_getters) ||
+			!Symbols::write(p_writer, p_function->indexed_setters, symbols->indexed_setters) ||
+			!Symbols::write(p_writer, p_function->indexed_getters, symbols->indexed_getters) ||
+			!Symbols::write(p_writer, p_function->builtin_methods, symbols->builtin_methods) ||
+			!Symbols::write(p_writer, p_function->constructors, symbols->constructors) ||
+			!Symbols::write(p_writer, p_function->utilities, symbols->utilities) ||
+			!Symbols::write(p_writer, p_function->gds_utilities, symbols->gds_utilities)) {
+		return false;
+	}
+
+	p_writer.put_32(p_function->methods.size());
+	for (const MethodBind *method : p_function->methods) {
+		if (ClassDB::get_method(method->get_instance_class(), method->get_name()) != method) {
+			return false;
+		}
+		p_writer.put_string(method->get_instance_class());
+		p_writer.put_string(method->get_name());
+		p_writer.put_32(method->get_hash());
+	}
+
+	p_writer.put_32(p_function->lambdas.size());
+	for (const GDScriptFunction *lambda : p_function->lambdas) {
+		const GDScript::LambdaInfo *info = p_class->lambda_info.getptr(const_cast<GDScriptFunction *>(lambda));
+		if (info == nullptr) {
+			return false;
+		}
+		p_writer.put_32(info->capture_count);
+		p_writer.put_8(info->use_self);
+		if (!_write_function(p_context, p_writer, p_class, lambda)) {
+			return false;
+		}
+	}
+
+#ifdef DEBUG_ENABLED
+	for (const Vector<String> *names : { &p_function->operator_names, &p_function->setter_names, &p_function->getter_names, &p_function->builtin_methods_names, &p_function->constructors_names, &p_function->utilities_names, &p_function->gds_utilities_names }) {
+		p_writer.put_32(names->size());
+		for (const String &name : *names) {
+			p_writer.put_string(name);
+		}
+	}
+#endif
+
+	return true;
+}
+
+bool GDScriptBytecodeCache::_write_class(SaveContext &p_context, Writer &p_writer, const GDScript *p_class) {
+	p_writer.put_8(p_class->tool);
+	p_writer.put_8(p_class->_is_abstract);
+	if (p_class->native.is_null()) {
+		return false;
+	}
+	p_writer.put_string(p_class->native->get_name());
+	if (!_write_object(p_context, p_writer, p_class->base.ptr())) {
+		return false;
+	}
+	p_writer.put_32(p_class->base.is_valid() ? p_class->base->member_indices.size() : 0);
+
+	p_writer.put_32(p_class->members.size());
+	for (const StringName &member : p_class->members) {
+		p_writer.put_string(member);
+		if (!_write_member_info(p_context, p_writer, p_class->member_indices[member])) {
+			return false;
+		}
+	}
+	p_writer.put_32(p_class->static_variables_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_class->static_variables_indices) {
+		p_writer.put_string(E.key);
+		if (!_write_member_info(p_context, p_writer, E.value)) {
+			return false;
+		}
+	}
+	p_writer.put_32(p_class->constants.size());
+	for (const KeyValue<StringName, Variant> &E : p_class->constants) {
+		p_writer.put_string(E.key);
+		if (!_write_variant(p_context, p_writer, E.value)) {
+			return false;
+		}
+	}
+	p_writer.put_32(p_class->_signals.size());
+	for (const KeyValue<StringName, MethodInfo> &E : p_class->_signals) {
+		p_writer.put_string(E.key);
+		if (!_write_method_info(p_context, p_writer, E.value)) {
+			return false;
+		}
+	}
+	if (!_write_variant(p_context, p_writer, p_class->rpc_config)) {
+		return false;
+	}
+#ifdef TOOLS_ENABLED
+	p_writer.put_32(p_class->member_default_values.size());
+	for (const KeyValue<StringName, Variant> &E : p_class->member_default_values) {
+		p_writer.put_string(E.key);
+		if (!_write_variant(p_context, p_writer, E.value)) {
+			return false;
+		}
+	}
+#endif
+
+	p_writer.put_32(p_class->member_functions.size());
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_class->member_functions) {
+		if (!_write_function(p_context, p_writer, p_class, E.value)) {
+			return false;
+		}
+	}
+	for (const GDScriptFunction *function : { p_class->implicit_initializer, p_class->implicit_ready, p_class->static_initializer }) {
+		p_writer.put_8(function != nullptr);
+		if (function != nullptr && !_write_function(p_context, p_writer, p_class, function)) {
+			return false;
+		}
+	}
+
+	p_writer.put_32(p_class->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_class->subclasses) {
+		p_writer.put_string(E.key);
+		if (!_write_class(p_context, p_writer, E.value.ptr())) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void GDScriptBytecodeCache::_write_skeleton(Writer &p_writer, const GDScript *p_class) {
+	p_writer.put_string(p_class->fully_qualified_name);
+	p_writer.put_string(p_class->local_name);
+	p_writer.put_string(p_class->global_name);
+	p_writer.put_string(p_class->simplified_icon_path);
+	p_writer.put_32(p_class->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_class->subclasses) {
+		p_writer.put_string(E.key);
+		_write_skeleton(p_writer, E.value.ptr());
+	}
+}
+
+bool GDScriptBytecodeCache::_read_object(LoadContext &p_context, Reader &p_reader, Variant &r_object) {
+	switch (p_reader.get_8()) {
+		case OBJECT_NULL: {
+			r_object = (Object *)nullptr;
+		} break;
+		case OBJECT_GLOBAL: {
+			const StringName name = p_reader.get_string_name();
+			GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+			const int *index = language->get_global_map().getptr(name);
+			if (index == nullptr || language->get_global_array()[*index].get_validated_object() == nullptr) {
+				return false;
+			}
+			r_object = language->get_global_array()[*index];
+		} break;
+		case OBJECT_GDSCRIPT: {
+			const String path = p_reader.get_string();
+			const String fully_qualified_name = p_reader.get_string();
+			if (p_reader.failed) {
+				return false;
+			}
+			Ref<GDScript> root = Ref<GDScript>(p_context.root);
+			if (path != p_context.root->path) {
+				Error err = OK;
+				root = GDScriptCache::get_shallow_script(path, err, p_context.root->path);
+				if (err != OK || root.is_null()) {
+					return false;
+				}
+			}
+			GDScript *script = root->find_class(fully_qualified_name);
+			if (script == nullptr) {
+				return false;
+			}
+			r_object = script;
+		} break;
+		case OBJECT_RESOURCE: {
+			const String path = p_reader.get_string();
+			if (p_reader.failed) {
+				return false;
+			}
+			Ref<Resource> resource = ResourceLoader::load(path);
+			if (resource.is_null()) {
+				return false;
+			}
+			r_object = resource;
+		} break;
+		default: {
+			return false;
+		}
+	}
+	return !p_reader.failed;
+}
+
+bool GDScriptBytecodeCache::_read_variant(LoadContext &p_context, Reader &p_reader, Variant &r_value) {
+	switch (p_reader.get_8()) {
+		case VARIANT_VALUE: {
+			r_value = p_reader.get_value();
+		} break;
+		case VARIANT_OBJECT: {
+			return _read_object(p_context, p_reader, r_value);
+		}
+		case VARIANT_ARRAY: {
+			const bool read_only = p_reader.get_8();
+			const uint32_t type = p_reader.get_32();
+			const StringName class_name = p_reader.get_string_name();
+			Variant script;
+			if (!_read_object(p_context, p_reader, script) || type >= Variant::VARIANT_MAX) {
+				return false;
+			}
+			Array array;
+			if (type != Variant::NIL) {
+				array.set_typed(type, class_name, script);
+			}
+			const int size = p_reader.get_count();
+			for (int i = 0; i < size; i++) {
+				Variant element;
+				if (!_read_variant(p_context, p_reader, element)) {
+					return false;
+				}
+				array.push_back(element);
+			}
+			if (read_only) {
+				array.make_read_only();
+			}
+			r_value = array;
+		} break;
+		case VARIANT_DICTIONARY: {
+			const bool read_only = p_reader.get_8();
+			const uint32_t key_type = p_reader.get_32();
+			const StringName key_class_name = p_reader.get_string_name();
+			Variant key_script;
+			if (!_read_object(p_context, p_reader, key_script)) {
+				return false;
+			}
+			const uint32_t value_type = p_reader.get_32();
+			const StringName value_class_name = p_reader.get_string_name();
+			Variant value_script;
+			if (!_read_object(p_context, p_reader, value_script) || key_type >= Variant::VARIANT_MAX || value_type >= Variant::VARIANT_MAX) {
+				return false;
+			}
+			Dictionary dictionary;
+			if (key_type != Variant::NIL || value_type != Variant::NIL) {
+				dictionary.set_typed(key_type, key_class_name, key_script, value_type, value_class_name, value_script);
+			}
+			const int size = p_reader.get_count(2);
+			for (int i = 0; i < size; i++) {
+				Variant key;
+				Variant value;
+				if (!_read_variant(p_context, p_reader, key) || !_read_variant(p_context, p_reader, value)) {
+					return false;
+				}
+				dictionary[key] = value;
+			}
+			if (read_only) {
+				dictionary.make_read_only();
+			}
+			r_value = dictionary;
+		} break;
+		default: {
+			return false;
+		}
+	}
+	return !p_reader.failed;
+}
+
+bool GDScriptBytecodeCache::_read_data_type(LoadContext &p_context, Reader &p_reader, GDScriptDataType &r_type) {
+	const uint8_t kind = p_reader.get_8();
+	const uint32_t builtin_type = p_reader.get_32();
+	if (kind > GDScriptDataType::GDSCRIPT || builtin_type >= Variant::VARIANT_MAX) {
+		return false;
+	}
+	r_type.kind = GDScriptDataType::Kind(kind);
+	r_type.builtin_type = Variant::Type(builtin_type);
+	r_type.native_type = p_reader.get_string_name();
+
+	Variant script;
+	if (!_read_object(p_context, p_reader, script)) {
+		return false;
+	}
+	r_type.script_type = Object::cast_to<Script>(script.get_validated_object());
+	if (p_reader.get_8()) {
+		r_type.script_type_ref = Ref<Script>(r_type.script_type);
+	} else if (r_type.script_type != nullptr) {
+		// Only classes of the same file are referenced weakly, other scripts could be freed.
+		GDScript *gdscript = Object::cast_to<GDScript>(r_type.script_type);
+		if (gdscript == nullptr || gdscript->get_root_script() != p_context.root) {
+			return false;
+		}
+	}
+
+	const int count = p_reader.get_count();
+	r_type.container_element_types.resize(count);
+	for (int i = 0; i < count; i++) {
+		if (!_read_data_type(p_context, p_reader, r_type.container_element_types.write[i])) {
+			return false;
+		}
+	}
+	return !p_reader.failed;
+}
+
+bool GDScriptBytecodeCache::_read_method_info(LoadContext &p_context, Reader &p_reader, MethodInfo &r_info) {
+	r_info.name = p_reader.get_string_name();
+	r_info.return_val = p_reader.get_property();
+	r_info.flags = p_reader.get_32();
+	r_info.id = p_reader.get_int();
+	const int argument_count = p_reader.get_count();
+	for (int i = 0; i < argument_count; i++) {
+		r_info.arguments.push_back(p_reader.get_property());
+	}
+	const int default_argument_count = p_reader.get_count();
+	for (int i = 0; i < default_argument_count; i++) {
+		Variant default_argument;
+		if (!_read_variant(p_context, p_reader, default_argument)) {
+			return false;
+		}
+		r_info.default_arguments.push_back(default_argument);
+	}
+	r_info.return_val_metadata = p_reader.get_int();
+	const int metadata_count = p_reader.get_count(4);
+	for (int i = 0; i < metadata_count; i++) {
+		r_info.arguments_metadata.push_back(p_reader.get_int());
+	}
+	return !p_reader.failed;
+}
+
+bool GDScriptBytecodeCache::_read_member_info(LoadContext &p_context, Reader &p_reader, GDScript::MemberInfo &r_info) {
+	r_info.index = p_reader.get_int();
+	r_info.setter = p_reader.get_string_name();
+	r_info.getter = p_reader.get_string_name();
+	r_info.property_info = p_reader.get_property();
+	return _read_data_type(p_context, p_reader, r_info.data_type);
+}
+
+bool GDScriptBytecodeCache::_read_function_data(LoadContext &p_context, Reader &p_reader, ClassData &p_class, GDScriptFunction *p_function) {
+	p_function->_static = p_reader.get_8();
+	const int argument_count = p_reader.get_count();
+	p_function->argument_types.resize(argument_count);
+	for (int i = 0; i < argument_count; i++) {
+		if (!_read_data_type(p_context, p_reader, p_function->argument_types.write[i])) {
+			return false;
+		}
+	}
+	if (!_read_data_type(p_context, p_reader, p_function->return_type) || !_read_method_info(p_context, p_reader, p_function->method_info) || !_read_variant(p_context, p_reader, p_function->rpc_config)) {
+		return false;
+	}
+
+	p_function->_initial_line = p_reader.get_int();
+	p_function->_argument_count = p_reader.get_int();
+	p_function->_vararg_index = p_reader.get_int();
+	p_function->_stack_size = p_reader.get_int();
+	p_function->_instruction_args_size = p_reader.get_int();
+
+	const int temporary_count = p_reader.get_count(8);
+	for (int i = 0; i < temporary_count; i++) {
+		const int slot = p_reader.get_int();
+		const uint32_t type = p_reader.get_32();
+		if (type >= Variant::VARIANT_MAX) {
+			return false;
+		}
+		p_function->temporary_slots.insert(slot, Variant::Type(type));
+	}
+
+	const int stack_debug_count = p_reader.get_count(13);
+	for (int i = 0; i < stack_debug_count; i++) {
+		GDScriptFunction::StackDebug stack_debug;
+		stack_debug.line = p_reader.get_int();
+		stack_debug.pos = p_reader.get_int();
+		stack_debug.added = p_reader.get_8();
+		stack_debug.identifier = p_reader.get_string_name();
+		p_function->stack_debug.push_back(stack_debug);
+	}
+
+	const int code_size = p_reader.get_count(4);
+	p_function->code.resize(code_size);
+	for (int i = 0; i < code_size; i++) {
+		p_function->code.write[i] = p_reader.get_int();
+	}
+
+	const HashMap<StringName, int> &globals = GDScriptLanguage::get_singleton()->get_global_map();
+	const int global_index_count = p_reader.get_count(8);
+	p_function->global_index_positions.resize(global_index_count);
+	for (int i = 0; i < global_index_count; i++) {
+		const int position = p_reader.get_int();
+		const int *index = globals.getptr(p_reader.get_string_name());
+		if (position < 0 || position >= code_size || index == nullptr) {
+			return false;
+		}
+		p_function->global_index_positions.write[i] = position;
+		p_function->code.write[position] = *index;
+	}
+	constexpr int pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(int);
+	const int operator_count = p_reader.get_count(4);
+	p_function->operator_positions.resize(operator_count);
+	for (int i = 0; i < operator_count; i++) {
+		const int position = p_reader.get_int();
+		if (position < 0 || position + 7 + pointer_size > code_size) {
+			return false;
+		}
+		p_function->operator_positions.write[i] = position;
+	}
+
+	const int default_argument_count = p_reader.get_count(4);
+	p_function->default_arguments.resize(default_argument_count);
+	for (int i = 0; i < default_argument_count; i++) {
+		p_function->default_arguments.write[i] = p_reader.get_int();
+	}
+	const int constant_count = p_reader.get_count();
+	p_function->constants.resize(constant_count);
+	for (int i = 0; i < constant_count; i++) {
+		if (!_read_variant(p_context, p_reader, p_function->constants.write[i])) {
+			return false;
+		}
+	}
+	const int constant_map_count = p_reader.get_count(5);
+	for (int i = 0; i < constant_map_count; i++) {
+		const StringName name = p_reader.get_string_name();
+		Variant constant;
+		if (!_read_variant(p_context, p_reader, constant)) {
+			return false;
+		}
+		p_function->constant_map.insert(name, constant);
+	}
+	const int global_name_count = p_reader.get_count(4);
+	p_function->global_names.resize(global_name_count);
+	for (int i = 0; i < global_name_count; i++) {
+		p_function->global_names.write[i] = p_reader.get_string_name();
+	}
+
+	if (!Symbols::read(p_reader, p_function->operator_funcs, &Symbols::resolve_operator) ||
+			!Symbols::read(p_reader, p_function->setters, &Symbols::resolve_setter) ||
+			!Symbols::read(p_reader, p_function->getters, &Symbols::resolve_getter) ||
+			!Symbols::read(p_reader, p_function->keyed_setters, &Symbols::resolve_keyed_setter) ||
+			!Symbols::read(p_reader, p_function->keyed_getters, &Symbols::resolve_keyed_getter) ||
+			!Symbols::read(p_reader, p_function->indexed_setters, &Symbols::resolve_indexed_setter) ||
+			!Symbols::read(p_reader, p_function->indexed_getters, &Symbols::resolve_indexed_getter) ||
+			!Symbols::read(p_reader, p_function->builtin_methods, &Symbols::resolve_builtin_method) ||
+			!Symbols::read(p_reader, p_function->constructors, &Symbols::resolve_constructor) ||
+			!Symbols::read(p_reader, p_function->utilities, &Symbols::resolve_utility) ||
+			!Symbols::read(p_reader, p_function->gds_utilities, &Symbols::resolve_gds_utility) ||
+			!Symbols::read(p_reader, p_function->methods, &Symbols::resolve_method)) {
+		return false;
+	}
+
+	const int lambda_count = p_reader.get_count(5);
+	for (int i = 0; i < lambda_count; i++) {
+		GDScript::LambdaInfo info;
+		info.capture_count = p_reader.get_int();
+		info.use_self = p_reader.get_8();
+		GDScriptFunction *lambda = _read_function(p_context, p_reader, p_class);
+		if (lambda == nullptr) {
+			return false;
+		}
+		p_function->lambdas.push_back(lambda);
+		p_class.lambda_info.insert(lambda, info);
+	}
+
+#ifdef DEBUG_ENABLED
+	for (Vector<String> *names : { &p_function->operator_names, &p_function->setter_names, &p_function->getter_names, &p_function->builtin_methods_names, &p_function->constructors_names, &p_function->utilities_names, &p_function->gds_utilities_names }) {
+		const int name_count = p_reader.get_count(4);
+		names->resize(name_count);
+		for (int i = 0; i < name_count; i++) {
+			names->write[i] = p_reader.get_string();
+		}
+	}
+#endif
+
+	return !p_reader.failed;
+}
+
+GDScriptFunction *GDScriptBytecodeCache::_read_function(LoadContext &p_context, Reader &p_reader, ClassData &p_class) {
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	function->_script = p_class.script;
+	function->source = p_class.script->get_script_path();
+	function->name = p_reader.get_string_name();
+
+#ifdef DEBUG_ENABLED
+	function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+	function->_func_cname = function->func_cname.get_data();
+#endif
+
+	if (!_read_function_data(p_context, p_reader, p_class, function)) {
+		_free_function(function);
+		return nullptr;
+	}
+
+	_link_function(function);
+	return function;
+}
+
+bool GDScriptBytecodeCache::_read_class(LoadContext &p_context, Reader &p_reader, ClassData &r_class) {
+	p_context.classes.insert(r_class.script, &r_class);
+
+	r_class.tool = p_reader.get_8();
+	r_class.is_abstract = p_reader.get_8();
+
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	const int *native_index = language->get_global_map().getptr(p_reader.get_string_name());
+	if (native_index == nullptr) {
+		return false;
+	}
+	r_class.native = language->get_global_array()[*native_index];
+	if (r_class.native.is_null()) {
+		return false;
+	}
+
+	Variant base;
+	if (!_read_object(p_context, p_reader, base)) {
+		return false;
+	}
+	if (base.get_validated_object() != nullptr) {
+		r_class.base = Ref<GDScript>(Object::cast_to<GDScript>(base.get_validated_object()));
+		if (r_class.base.is_null()) {
+			return false;
+		}
+	}
+	r_class.base_member_count = p_reader.get_int();
+
+	const int member_count = p_reader.get_count();
+	for (int i = 0; i < member_count; i++) {
+		Pair<StringName, GDScript::MemberInfo> member;
+		member.first = p_reader.get_string_name();
+		if (!_read_member_info(p_context, p_reader, member.second)) {
+			return false;
+		}
+		r_class.members.push_back(member);
+	}
+	const int static_variable_count = p_reader.get_count();
+	for (int i = 0; i < static_variable_count; i++) {
+		const StringName name = p_reader.get_string_name();
+		if (!_read_member_info(p_context, p_reader, r_class.static_variables_indices[name])) {
+			return false;
+		}
+	}
+	const int constant_count = p_reader.get_count();
+	for (int i = 0; i < constant_count; i++) {
+		const StringName name = p_reader.get_string_name();
+		if (!_read_variant(p_context, p_reader, r_class.constants[name])) {
+			return false;
+		}
+	}
+	const int signal_count = p_reader.get_count();
+	for (int i = 0; i < signal_count; i++) {
+		const StringName name = p_reader.get_string_name();
+		if (!_read_method_info(p_context, p_reader, r_class.signals[name])) {
+			return false;
+		}
+	}
+	Variant rpc_config;
+	if (!_read_variant(p_context, p_reader, rpc_config) || rpc_config.get_type() != Variant::DICTIONARY) {
+		return false;
+	}
+	r_class.rpc_config = rpc_config;
+#ifdef TOOLS_ENABLED
+	const int default_value_count = p_reader.get_count();
+	for (int i = 0; i < default_value_count; i++) {
+		const StringName name = p_reader.get_string_name();
+		if (!_read_variant(p_context, p_reader, r_class.member_default_values[name])) {
+			return false;
+		}
+	}
+#endif
+
+	const int function_count = p_reader.get_count();
+	for (int i = 0; i < function_count; i++) {
+		GDScriptFunction *function = _read_function(p_context, p_reader, r_class);
+		if (function == nullptr) {
+			return false;
+		}
+		p_context.functions.push_back(function);
+		r_class.member_functions.insert(function->name, function);
+	}
+	for (GDScriptFunction **special : { &r_class.implicit_initializer, &r_class.implicit_ready, &r_class.static_initializer }) {
+		if (p_reader.get_8()) {
+			*special = _read_function(p_context, p_reader, r_class);
+			if (*special == nullptr) {
+				return false;
+			}
+			p_context.functions.push_back(*special);
+		}
+	}
+
+	const int subclass_count = p_reader.get_count();
+	for (int i = 0; i < subclass_count; i++) {
+		const Ref<GDScript> *subclass = r_class.script->subclasses.getptr(p_reader.get_string_name());
+		if (subclass == nullptr) {
+			return false;
+		}
+		ClassData *subclass_data = memnew(ClassData);
+		subclass_data->script = subclass->ptr();
+		r_class.subclasses.push_back(subclass_data);
+		if (!_read_class(p_context, p_reader, *subclass_data)) {
+			return false;
+		}
+	}
+
+	return !p_reader.failed;
+}
+
+bool GDScriptBytecodeCache::_read_skeleton(Reader &p_reader, GDScript *p_class) {
+	// Same as `GDScriptCompiler::make_scripts()` when keeping the state.
+	p_class->fully_qualified_name = p_reader.get_string();
+	p_class->local_name = p_reader.get_string_name();
+	p_class->global_name = p_reader.get_string_name();
+	p_class->simplified_icon_path = p_reader.get_string();
+
+	HashMap<StringName, Ref<GDScript>> old_subclasses(p_class->subclasses);
+	p_class->subclasses.clear();
+
+	const int subclass_count = p_reader.get_count();
+	for (int i = 0; i < subclass_count; i++) {
+		const StringName name = p_reader.get_string_name();
+
+		// The fully qualified name starts the record of the subclass.
+		const int position = p_reader.pos;
+		const String fully_qualified_name = p_reader.get_string();
+		p_reader.pos = position;
+		if (p_reader.failed) {
+			return false;
+		}
+
+		Ref<GDScript> subclass;
+		if (old_subclasses.has(name)) {
+			subclass = old_subclasses[name];
+		} else {
+			subclass = GDScriptLanguage::get_singleton()->get_orphan_subclass(fully_qualified_name);
+		}
+		if (subclass.is_null()) {
+			subclass.instantiate();
+		}
+
+		subclass->_owner = p_class;
+		subclass->path = p_class->path;
+		p_class->subclasses.insert(name, subclass);
+
+		if (!_read_skeleton(p_reader, subclass.ptr())) {
+			return false;
+		}
+	}
+	return !p_reader.failed;
+}
+
+void GDScriptBytecodeCache::_install_class(ClassData &p_class) {
+	if (p_class.installed) {
+		return;
+	}
+	p_class.installed = true;
+	if (p_class.base_data != nullptr) {
+		_install_class(*p_class.base_data);
+	}
+
+	GDScript *script = p_class.script;
+	_reset_class(script);
+
+	script->tool = p_class.tool;
+	script->_is_abstract = p_class.is_abstract;
+	script->native = p_class.native;
+	script->base = p_class.base;
+	if (script->base.is_valid()) {
+		script->member_indices = script->base->member_indices;
+	}
+	for (const Pair<StringName, GDScript::MemberInfo> &member : p_class.members) {
+		script->member_indices[member.first] = member.second;
+		script->members.insert(member.first);
+	}
+	script->static_variables_indices = p_class.static_variables_indices;
+	script->static_variables.resize(script->static_variables_indices.size());
+	script->constants = p_class.constants;
+	script->_signals = p_class.signals;
+	script->rpc_config = p_class.rpc_config;
+#ifdef TOOLS_ENABLED
+	script->member_default_values = p_class.member_default_values;
+#endif
+
+	script->member_functions = p_class.member_functions;
+	GDScriptFunction **initializer = script->member_functions.getptr(GDScriptLanguage::get_singleton()->strings._init);
+	script->initializer = initializer != nullptr ? *initializer : nullptr;
+	script->implicit_initializer = p_class.implicit_initializer;
+	script->implicit_ready = p_class.implicit_ready;
+	script->static_initializer = p_class.static_initializer;
+	script->lambda_info = p_class.lambda_info;
+
+	for (ClassData *subclass : p_class.subclasses) {
+		_install_class(*subclass);
+	}
+
+	script->_static_default_init();
+	script->valid = true;
+}
+
+bool GDScriptBytecodeCache::make_scripts(GDScript *p_script) {
+	if (!is_enabled() || !_can_cache(p_script)) {
+		return false;
+	}
+
+	Vector<uint8_t> body;
+	if (!_read_image(p_script, body)) {
+		return false;
+	}
+	Reader reader(body);
+	if (!_read_skeleton(reader, p_script)) {
+		return false;
+	}
+
+	MutexLock lock(mutex);
+	pending_images[p_script->path] = body;
+	return true;
+}
+
+bool GDScriptBytecodeCache::load(GDScript *p_script, Error &r_error) {
+	r_error = OK;
+	if (!is_enabled() || !_can_cache(p_script)) {
+		return false;
+	}
+
+	Vector<uint8_t> body;
+	{
+		MutexLock lock(mutex);
+		HashMap<String, Vector<uint8_t>>::Iterator E = pending_images.find(p_script->path);
+		if (E) {
+			body = E->value;
+			pending_images.remove(E);
+		}
+	}
+	if (body.is_empty() && !_read_image(p_script, body)) {
+		return false;
+	}
+	{
+		MutexLock lock(mutex);
+		if (symbols == nullptr) {
+			symbols = memnew(Symbols);
+		}
+	}
+
+	// Everything is read before installing it, so the classes can still be compiled if the image can't be used.
+	Reader reader(body);
+	if (!_read_skeleton(reader, p_script)) {
+		return false;
+	}
+	const bool register_static = reader.get_8();
+
+	LoadContext context;
+	context.root = p_script;
+	ClassData root;
+	root.script = p_script;
+	bool valid = _read_class(context, reader, root) && reader.pos == reader.size;
+
+	for (KeyValue<GDScript *, ClassData *> &E : context.classes) {
+		if (!valid) {
+			break;
+		}
+		ClassData &class_data = *E.value;
+		if (class_data.base.is_null()) {
+			valid = class_data.base_member_count == 0;
+			continue;
+		}
+
+		ClassData **base_data = context.classes.getptr(class_data.base.ptr());
+		if (base_data != nullptr) {
+			class_data.base_data = *base_data;
+			valid = class_data.base_member_count == (*base_data)->base_member_count + (int)(*base_data)->members.size();
+			continue;
+		}
+
+		// Member indices continue from the base, which has to be compiled first.
+		if (!class_data.base->is_valid()) {
+			Error err = OK;
+			GDScriptCache::get_full_script(class_data.base->path, err, p_script->path);
+		}
+		valid = class_data.base->is_valid() && class_data.base_member_count == (int)class_data.base->member_indices.size();
+	}
+
+	if (!valid) {
+		for (GDScriptFunction *function : context.functions) {
+			_free_function(function);
+		}
+		return false;
+	}
+
+	_install_class(root);
+
+	if (register_static) {
+		GDScriptCache::add_static_script(p_script);
+	}
+	r_error = GDScriptCache::finish_compiling(p_script->path);
+	return true;
+}
+
+Error GDScriptBytecodeCache::save(GDScript *p_script, GDScriptParser &p_parser) {
+	if (!is_enabled() || !_can_cache(p_script)) {
+		return ERR_UNAVAILABLE;
+	}
+
+	HashSet<String> dependencies;
+	if (!_collect_dependencies(&p_parser, dependencies)) {
+		return ERR_UNAVAILABLE;
+	}
+	{
+		MutexLock lock(mutex);
+		if (symbols == nullptr) {
+			symbols = memnew(Symbols);
+		}
+	}
+
+	SaveContext context;
+	context.root = p_script;
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	for (const KeyValue<StringName, int> &E : language->get_global_map()) {
+		context.global_indices.insert(E.value, E.key);
+		const Object *object = language->get_global_array()[E.value].get_validated_object();
+		if (object != nullptr) {
+			context.global_objects.insert(object->get_instance_id(), E.key);
+		}
+	}
+
+	Writer body;
+	_write_skeleton(body, p_script);
+	body.put_8(!p_parser.get_tree()->annotated_static_unload && _has_static_data(p_parser.get_tree()));
+	if (!_write_class(context, body, p_script)) {
+		return ERR_UNAVAILABLE;
+	}
+
+	for (const String &path : context.dependencies) {
+		dependencies.insert(path);
+	}
+	dependencies.erase(p_script->path);
+
+	Writer image;
+	image.put_buffer((const uint8_t *)"GDBC", 4);
+	image.put_32(FORMAT_VERSION);
+	image.put_string(_get_build_key());
+	image.put_string(_get_environment_hash());
+	image.put_string(_get_source_hash(p_script));
+	image.put_32(dependencies.size());
+	for (const String &path : dependencies) {
+		const String hash = _get_file_hash(path);
+		if (hash.is_empty()) {
+			return ERR_FILE_CANT_READ;
+		}
+		image.put_string(path);
+		image.put_string(hash);
+	}
+	unsigned char hash[16];
+	CryptoCore::md5(body.data.ptr(), body.data.size(), hash);
+	image.put_string(String::md5(hash));
+	image.put_buffer(body.data.ptr(), body.data.size());
+
+	Error err = DirAccess::make_dir_recursive_absolute(cache_path);
+	if (err != OK) {
+		return err;
+	}
+
+	// Written aside and moved in place, so other threads and processes never read a partial image.
+	const String image_path = get_image_path(p_script->path);
+	const String temp_path = image_path + vformat(".%d-%d.tmp", OS::get_singleton()->get_process_id(), (int64_t)Thread::get_caller_id());
+	{
+		Ref<FileAccess> file = FileAccess::open(temp_path, FileAccess::WRITE, &err);
+		if (err != OK) {
+			return err;
+		}
+		file->store_buffer(image.data.ptr(), image.data.size());
+	}
+	err = DirAccess::rename_absolute(temp_path, image_path);
+	if (err != OK) {
+		DirAccess::remove_absolute(temp_path);
+	}
+	return err;
+}
@@ -0,0 +1,131 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "gdscript.h"
+#include "gdscript_cache.h"
+
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+
+// Stores compiled scripts on disk, so later runs load them without parsing, analyzing
+// and compiling them again.
+//
+// An image holds the classes, member info, constants and bytecode of one script file.
+// Native function pointers are stored by name and looked up again when loading. An
+// image is only used by the engine build that wrote it, while the source of the script
+// and of every script its compilation depended on still hash the same, and the global
+// class and autoload lists haven't changed.
+//
+// It's only used when running a project, not in the editor or with the debugger
+// attached, which need the parse tree for docs, warnings and hot reloading. Objects are
+// stored as references to native classes, singletons, scripts and resources saved to
+// a file. Scripts holding any other object, a callable or a signal are compiled every time.
+class GDScriptBytecodeCache {
+	struct Writer;
+	struct Reader;
+	struct Symbols;
+	struct SaveContext;
+	struct ClassData;
+	struct LoadContext;
+
+	enum ObjectTag {
+		OBJECT_NULL,
+		OBJECT_GLOBAL,
+		OBJECT_GDSCRIPT,
+		OBJECT_RESOURCE,
+	};
+
+	enum VariantTag {
+		VARIANT_VALUE,
+		VARIANT_OBJECT,
+		VARIANT_ARRAY,
+		VARIANT_DICTIONARY,
+	};
+
+	static inline Mutex mutex;
+	static inline Symbols *symbols = nullptr;
+	static inline String build_key;
+	static inline String environment_hash;
+	static inline HashMap<String, String> file_hashes;
+	static inline HashMap<String, Vector<uint8_t>> pending_images; // Bodies checked when making the inner classes, used when loading.
+
+	static bool _can_cache(const GDScript *p_script);
+	static String _get_build_key();
+	static String _get_environment_hash();
+	static String _get_file_hash(const String &p_path);
+	static String _get_source_hash(const GDScript *p_script);
+	static bool _collect_dependencies(GDScriptParser *p_parser, HashSet<String> &r_paths);
+	static bool _read_image(const GDScript *p_script, Vector<uint8_t> &r_body);
+	static void _link_function(GDScriptFunction *p_function);
+	static void _free_function(GDScriptFunction *p_function);
+	static void _reset_class(GDScript *p_script);
+
+	static bool _write_object(SaveContext &p_context, Writer &p_writer, const Object *p_object);
+	static bool _write_variant(SaveContext &p_context, Writer &p_writer, const Variant &p_value);
+	static bool _write_data_type(SaveContext &p_context, Writer &p_writer, const GDScriptDataType &p_type);
+	static bool _write_method_info(SaveContext &p_context, Writer &p_writer, const MethodInfo &p_info);
+	static bool _write_member_info(SaveContext &p_context, Writer &p_writer, const GDScript::MemberInfo &p_info);
+	static bool _write_function(SaveContext &p_context, Writer &p_writer, const GDScript *p_class, const GDScriptFunction *p_function);
+	static bool _write_class(SaveContext &p_context, Writer &p_writer, const GDScript *p_class);
+	static void _write_skeleton(Writer &p_writer, const GDScript *p_class);
+
+	static bool _read_object(LoadContext &p_context, Reader &p_reader, Variant &r_object);
+	static bool _read_variant(LoadContext &p_context, Reader &p_reader, Variant &r_value);
+	static bool _read_data_type(LoadContext &p_context, Reader &p_reader, GDScriptDataType &r_type);
+	static bool _read_method_info(LoadContext &p_context, Reader &p_reader, MethodInfo &r_info);
+	static bool _read_member_info(LoadContext &p_context, Reader &p_reader, GDScript::MemberInfo &r_info);
+	static bool _read_function_data(LoadContext &p_context, Reader &p_reader, ClassData &p_class, GDScriptFunction *p_function);
+	static GDScriptFunction *_read_function(LoadContext &p_context, Reader &p_reader, ClassData &p_class);
+	static bool _read_class(LoadContext &p_context, Reader &p_reader, ClassData &r_class);
+	static bool _read_skeleton(Reader &p_reader, GDScript *p_class);
+	static void _install_class(ClassData &p_class);
+
+public:
+	static constexpr uint32_t FORMAT_VERSION = 1;
+
+	static inline bool enabled = false;
+	static inline String cache_path;
+
+	static void initialize();
+	static void finish();
+	static bool is_enabled();
+	static String get_image_path(const String &p_script_path);
+
+	// Creates the inner classes of a script from its image, like GDScriptCompiler::make_scripts().
+	static bool make_scripts(GDScript *p_script);
+	// Loads a script from its image. Returns false if there is no usable image, so the script has to be compiled.
+	// r_error is set if the image was loaded but scripts it depends on failed to compile.
+	static bool load(GDScript *p_script, Error &r_error);
+	// Writes the image of a script that was just compiled from p_parser.
+	static Error save(GDScript *p_script, GDScriptParser &p_parser);
+};
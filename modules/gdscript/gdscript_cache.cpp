@@ -32,10 +32,12 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/vector.h"
 
 GDScriptParserRef::Status GDScriptParserRef::get_status() const {
@@ -241,6 +243,107 @@ Ref<GDScriptParserRef> GDScriptCache::get_parser(const String &p_path, GDScriptP
 	return ref;
 }
 
+void GDScriptCache::_parse_thread(void *p_userdata, uint32_t p_index) {
+	Ref<GDScriptParserRef> *parsers = static_cast<Ref<GDScriptParserRef> *>(p_userdata);
+	parsers[p_index]->raise_status(GDScriptParserRef::PARSED);
+}
+
+Vector<Ref<GDScriptParserRef>> GDScriptCache::get_parsers(const Vector<String> &p_paths, GDScriptParserRef::Status p_status, Error &r_error) {
+	r_error = OK;
+
+	HashSet<String> requested;
+	LocalVector<Ref<GDScriptParserRef>> unparsed;
+	{
+		MutexLock lock(singleton->mutex);
+		for (const String &path : p_paths) {
+			if (requested.has(path)) {
+				continue;
+			}
+			requested.insert(path);
+			if (singleton->parser_map.has(path) || !FileAccess::exists(ResourceLoader::path_remap(path))) {
+				continue;
+			}
+			// Kept out of the cache until parsed, so no other thread can reach it in the meantime.
+			// Marked as abandoned so it doesn't erase another parser for the same path if it's dropped.
+			Ref<GDScriptParserRef> ref;
+			ref.instantiate();
+			ref->path = path;
+			ref->abandoned = true;
+			// The first parser registers the annotations, which has to happen on a single thread.
+			ref->get_parser();
+			unparsed.push_back(ref);
+		}
+	}
+
+	if (!unparsed.is_empty()) {
+		// Lazily filled on first use, like the annotations.
+		GDScriptParser::get_builtin_type(StringName());
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_parse_thread, unparsed.ptr(), unparsed.size(), -1, false, SNAME("GDScriptParse"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	// Base scripts are raised first, so the analyzer finds them already resolved instead of recursing into them.
+	HashMap<String, String> bases;
+	{
+		MutexLock lock(singleton->mutex);
+		for (Ref<GDScriptParserRef> &ref : unparsed) {
+			if (singleton->parser_map.has(ref->path)) {
+				// Another thread parsed it meanwhile.
+				continue;
+			}
+			ref->abandoned = false;
+			singleton->parser_map[ref->path] = ref.ptr();
+
+			const GDScriptParser::ClassNode *head = ref->parser->get_tree();
+			if (ref->result != OK || head == nullptr) {
+				continue;
+			}
+			String base_path;
+			if (!head->extends_path.is_empty()) {
+				base_path = head->extends_path;
+				if (base_path.is_relative_path()) {
+					base_path = ref->path.get_base_dir().path_join(base_path).simplify_path();
+				}
+			} else if (!head->extends.is_empty() && ScriptServer::is_global_class(head->extends[0]->name)) {
+				base_path = ScriptServer::get_global_class_path(head->extends[0]->name);
+			}
+			if (requested.has(base_path)) {
+				bases[ref->path] = base_path;
+			}
+		}
+	}
+
+	LocalVector<String> ordered;
+	HashSet<String> visited;
+	for (const String &path : p_paths) {
+		LocalVector<String> chain;
+		for (String current = path; !current.is_empty() && !visited.has(current);) {
+			visited.insert(current);
+			chain.push_back(current);
+			HashMap<String, String>::ConstIterator base = bases.find(current);
+			current = base ? base->value : String();
+		}
+		for (int64_t i = int64_t(chain.size()) - 1; i >= 0; i--) {
+			ordered.push_back(chain[i]);
+		}
+	}
+
+	Vector<Ref<GDScriptParserRef>> parsers;
+	for (const String &path : ordered) {
+		Error err = OK;
+		Ref<GDScriptParserRef> ref = get_parser(path, p_status, err);
+		if (err != OK && r_error == OK) {
+			r_error = err;
+		}
+		if (ref.is_valid()) {
+			parsers.push_back(ref);
+		}
+	}
+
+	return parsers;
+}
+
 bool GDScriptCache::has_parser(const String &p_path) {
 	MutexLock lock(singleton->mutex);
 	return singleton->parser_map.has(p_path);
@@ -333,9 +436,11 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
-	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
-	if (r_error == OK) {
-		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+	if (!GDScriptBytecodeCache::make_scripts(script.ptr())) {
+		Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
+		if (r_error == OK) {
+			GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+		}
 	}
 
 	singleton->shallow_gdscript_cache[p_path] = script;
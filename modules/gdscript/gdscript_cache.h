@@ -105,6 +105,7 @@ class GDScriptCache {
 	friend class GDScript;
 	friend class GDScriptParserRef;
 	friend class GDScriptInstance;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptTests::TestGDScriptCacheAccessor;
 
 	static GDScriptCache *singleton;
@@ -118,10 +119,21 @@ private:
 	static SafeBinaryMutex<BINARY_MUTEX_TAG> mutex;
 	friend SafeBinaryMutex<BINARY_MUTEX_TAG> &_get_gdscript_cache_mutex();
 
+	static void _parse_thread(void *p_userdata, uint32_t p_index);
+
 public:
 	static void move_script(const String &p_from, const String &p_to);
 	static void remove_script(const String &p_path);
 	static Ref<GDScriptParserRef> get_parser(const String &p_path, GDScriptParserRef::Status status, Error &r_error, const String &p_owner = String());
+	/**
+	 * Returns the parsers for a batch of scripts, raised to the given status.
+	 *
+	 * Scripts that aren't cached yet are parsed concurrently on the WorkerThreadPool.
+	 * The analyzer resolves types across scripts and writes into the trees of their dependencies,
+	 * so the parsers are then raised on the calling thread, base scripts first.
+	 * Parsers stay cached for as long as the returned references are kept.
+	 */
+	static Vector<Ref<GDScriptParserRef>> get_parsers(const Vector<String> &p_paths, GDScriptParserRef::Status p_status, Error &r_error);
 	static bool has_parser(const String &p_path);
 	static void remove_parser(const String &p_path);
 	static String get_source_code(const String &p_path);
@@ -141,6 +141,130 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+
+#define DISASSEMBLE_OPERATOR_TYPED(m_name, m_op) \
+	case OPCODE_OPERATOR_##m_name: { \
+		text += "typed operator ("; \
+		text += #m_name; \
+		text += ") "; \
+		text += DADDR(3); \
+		text += " = "; \
+		text += DADDR(1); \
+		text += " " m_op " "; \
+		text += DADDR(2); \
+		incr += 4; \
+	} break
+
+				DISASSEMBLE_OPERATOR_TYPED(ADD_INT, "+");
+				DISASSEMBLE_OPERATOR_TYPED(SUBTRACT_INT, "-");
+				DISASSEMBLE_OPERATOR_TYPED(MULTIPLY_INT, "*");
+				DISASSEMBLE_OPERATOR_TYPED(EQUAL_INT, "==");
+				DISASSEMBLE_OPERATOR_TYPED(NOT_EQUAL_INT, "!=");
+				DISASSEMBLE_OPERATOR_TYPED(LESS_INT, "<");
+				DISASSEMBLE_OPERATOR_TYPED(LESS_EQUAL_INT, "<=");
+				DISASSEMBLE_OPERATOR_TYPED(GREATER_INT, ">");
+				DISASSEMBLE_OPERATOR_TYPED(GREATER_EQUAL_INT, ">=");
+				DISASSEMBLE_OPERATOR_TYPED(ADD_FLOAT, "+");
+				DISASSEMBLE_OPERATOR_TYPED(SUBTRACT_FLOAT, "-");
+				DISASSEMBLE_OPERATOR_TYPED(MULTIPLY_FLOAT, "*");
+				DISASSEMBLE_OPERATOR_TYPED(DIVIDE_FLOAT, "/");
+				DISASSEMBLE_OPERATOR_TYPED(EQUAL_FLOAT, "==");
+				DISASSEMBLE_OPERATOR_TYPED(NOT_EQUAL_FLOAT, "!=");
+				DISASSEMBLE_OPERATOR_TYPED(LESS_FLOAT, "<");
+				DISASSEMBLE_OPERATOR_TYPED(LESS_EQUAL_FLOAT, "<=");
+				DISASSEMBLE_OPERATOR_TYPED(GREATER_FLOAT, ">");
+				DISASSEMBLE_OPERATOR_TYPED(GREATER_EQUAL_FLOAT, ">=");
+				DISASSEMBLE_OPERATOR_TYPED(ADD_VECTOR2, "+");
+				DISASSEMBLE_OPERATOR_TYPED(SUBTRACT_VECTOR2, "-");
+				DISASSEMBLE_OPERATOR_TYPED(MULTIPLY_VECTOR2, "*");
+				DISASSEMBLE_OPERATOR_TYPED(MULTIPLY_VECTOR2_FLOAT, "*");
+				DISASSEMBLE_OPERATOR_TYPED(ADD_VECTOR3, "+");
+				DISASSEMBLE_OPERATOR_TYPED(SUBTRACT_VECTOR3, "-");
+				DISASSEMBLE_OPERATOR_TYPED(MULTIPLY_VECTOR3, "*");
+				DISASSEMBLE_OPERATOR_TYPED(MULTIPLY_VECTOR3_FLOAT, "*");
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
+				text += "validated operator ";
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+				text += "; jump-if-not to ";
+				text += itos(_code_ptr[ip + 7]);
+
+				incr += 8;
+			} break;
+			case OPCODE_OPERATOR_VALIDATED_ASSIGN: {
+				text += "validated operator ";
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+				text += "; assign ";
+				text += DADDR(6);
+				text += " = ";
+				text += DADDR(3);
+
+				incr += 8;
+			} break;
+
+#define DISASSEMBLE_OPERATOR_TYPED_JUMP_IF_NOT(m_name, m_op) \
+	case OPCODE_OPERATOR_##m_name##_JUMP_IF_NOT: { \
+		text += "typed operator ("; \
+		text += #m_name; \
+		text += ") "; \
+		text += DADDR(3); \
+		text += " = "; \
+		text += DADDR(1); \
+		text += " " m_op " "; \
+		text += DADDR(2); \
+		text += "; jump-if-not to "; \
+		text += itos(_code_ptr[ip + 6]); \
+		incr += 7; \
+	} break
+
+				DISASSEMBLE_OPERATOR_TYPED_JUMP_IF_NOT(EQUAL_INT, "==");
+				DISASSEMBLE_OPERATOR_TYPED_JUMP_IF_NOT(NOT_EQUAL_INT, "!=");
+				DISASSEMBLE_OPERATOR_TYPED_JUMP_IF_NOT(LESS_INT, "<");
+				DISASSEMBLE_OPERATOR_TYPED_JUMP_IF_NOT(LESS_EQUAL_INT, "<=");
+				DISASSEMBLE_OPERATOR_TYPED_JUMP_IF_NOT(GREATER_INT, ">");
+				DISASSEMBLE_OPERATOR_TYPED_JUMP_IF_NOT(GREATER_EQUAL_INT, ">=");
+				DISASSEMBLE_OPERATOR_TYPED_JUMP_IF_NOT(EQUAL_FLOAT, "==");
+				DISASSEMBLE_OPERATOR_TYPED_JUMP_IF_NOT(NOT_EQUAL_FLOAT, "!=");
+				DISASSEMBLE_OPERATOR_TYPED_JUMP_IF_NOT(LESS_FLOAT, "<");
+				DISASSEMBLE_OPERATOR_TYPED_JUMP_IF_NOT(LESS_EQUAL_FLOAT, "<=");
+				DISASSEMBLE_OPERATOR_TYPED_JUMP_IF_NOT(GREATER_FLOAT, ">");
+				DISASSEMBLE_OPERATOR_TYPED_JUMP_IF_NOT(GREATER_EQUAL_FLOAT, ">=");
+
+#define DISASSEMBLE_OPERATOR_TYPED_ASSIGN(m_name, m_op) \
+	case OPCODE_OPERATOR_##m_name##_ASSIGN: { \
+		text += "typed operator ("; \
+		text += #m_name; \
+		text += ") "; \
+		text += DADDR(3); \
+		text += " = "; \
+		text += DADDR(1); \
+		text += " " m_op " "; \
+		text += DADDR(2); \
+		text += "; assign "; \
+		text += DADDR(5); \
+		text += " = "; \
+		text += DADDR(3); \
+		incr += 7; \
+	} break
+
+				DISASSEMBLE_OPERATOR_TYPED_ASSIGN(ADD_INT, "+");
+				DISASSEMBLE_OPERATOR_TYPED_ASSIGN(SUBTRACT_INT, "-");
+				DISASSEMBLE_OPERATOR_TYPED_ASSIGN(MULTIPLY_INT, "*");
+				DISASSEMBLE_OPERATOR_TYPED_ASSIGN(ADD_FLOAT, "+");
+				DISASSEMBLE_OPERATOR_TYPED_ASSIGN(SUBTRACT_FLOAT, "-");
+				DISASSEMBLE_OPERATOR_TYPED_ASSIGN(MULTIPLY_FLOAT, "*");
+				DISASSEMBLE_OPERATOR_TYPED_ASSIGN(DIVIDE_FLOAT, "/");
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -1058,6 +1182,22 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr = 3;
 			} break;
+			case OPCODE_JUMP_IF_BOOL: {
+				text += "jump-if (bool) ";
+				text += DADDR(1);
+				text += " to ";
+				text += itos(_code_ptr[ip + 2]);
+
+				incr = 3;
+			} break;
+			case OPCODE_JUMP_IF_NOT_BOOL: {
+				text += "jump-if-not (bool) ";
+				text += DADDR(1);
+				text += " to ";
+				text += itos(_code_ptr[ip + 2]);
+
+				incr = 3;
+			} break;
 			case OPCODE_JUMP_TO_DEF_ARGUMENT: {
 				text += "jump-to-default-argument ";
 
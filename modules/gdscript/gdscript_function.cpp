@@ -42,6 +42,225 @@ StringName GDScriptFunction::get_global_name(int p_idx) const {
 	return global_names[p_idx];
 }
 
+#ifdef DEBUG_ENABLED
+const char *GDScriptFunction::get_opcode_name(Opcode p_opcode) {
+	static const char *names[] = {
+		"operator",
+		"operator_validated",
+		"operator_add_int",
+		"operator_subtract_int",
+		"operator_multiply_int",
+		"operator_equal_int",
+		"operator_not_equal_int",
+		"operator_less_int",
+		"operator_less_equal_int",
+		"operator_greater_int",
+		"operator_greater_equal_int",
+		"operator_add_float",
+		"operator_subtract_float",
+		"operator_multiply_float",
+		"operator_divide_float",
+		"operator_equal_float",
+		"operator_not_equal_float",
+		"operator_less_float",
+		"operator_less_equal_float",
+		"operator_greater_float",
+		"operator_greater_equal_float",
+		"operator_add_vector2",
+		"operator_subtract_vector2",
+		"operator_multiply_vector2",
+		"operator_multiply_vector2_float",
+		"operator_add_vector3",
+		"operator_subtract_vector3",
+		"operator_multiply_vector3",
+		"operator_multiply_vector3_float",
+		"operator_validated_jump_if_not",
+		"operator_validated_assign",
+		"operator_equal_int_jump_if_not",
+		"operator_not_equal_int_jump_if_not",
+		"operator_less_int_jump_if_not",
+		"operator_less_equal_int_jump_if_not",
+		"operator_greater_int_jump_if_not",
+		"operator_greater_equal_int_jump_if_not",
+		"operator_equal_float_jump_if_not",
+		"operator_not_equal_float_jump_if_not",
+		"operator_less_float_jump_if_not",
+		"operator_less_equal_float_jump_if_not",
+		"operator_greater_float_jump_if_not",
+		"operator_greater_equal_float_jump_if_not",
+		"operator_add_int_assign",
+		"operator_subtract_int_assign",
+		"operator_multiply_int_assign",
+		"operator_add_float_assign",
+		"operator_subtract_float_assign",
+		"operator_multiply_float_assign",
+		"operator_divide_float_assign",
+		"type_test_builtin",
+		"type_test_array",
+		"type_test_dictionary",
+		"type_test_native",
+		"type_test_script",
+		"set_keyed",
+		"set_keyed_validated",
+		"set_indexed_validated",
+		"get_keyed",
+		"get_keyed_validated",
+		"get_indexed_validated",
+		"set_named",
+		"set_named_validated",
+		"get_named",
+		"get_named_validated",
+		"set_member",
+		"get_member",
+		"set_static_variable",
+		"get_static_variable",
+		"assign",
+		"assign_null",
+		"assign_true",
+		"assign_false",
+		"assign_typed_builtin",
+		"assign_typed_array",
+		"assign_typed_dictionary",
+		"assign_typed_native",
+		"assign_typed_script",
+		"cast_to_builtin",
+		"cast_to_native",
+		"cast_to_script",
+		"construct",
+		"construct_validated",
+		"construct_array",
+		"construct_typed_array",
+		"construct_dictionary",
+		"construct_typed_dictionary",
+		"call",
+		"call_return",
+		"call_async",
+		"call_utility",
+		"call_utility_validated",
+		"call_gdscript_utility",
+		"call_builtin_type_validated",
+		"call_self_base",
+		"call_method_bind",
+		"call_method_bind_ret",
+		"call_builtin_static",
+		"call_native_static",
+		"call_native_static_validated_return",
+		"call_native_static_validated_no_return",
+		"call_method_bind_validated_return",
+		"call_method_bind_validated_no_return",
+		"await",
+		"await_resume",
+		"create_lambda",
+		"create_self_lambda",
+		"jump",
+		"jump_if",
+		"jump_if_not",
+		"jump_if_bool",
+		"jump_if_not_bool",
+		"jump_to_def_argument",
+		"jump_if_shared",
+		"return",
+		"return_typed_builtin",
+		"return_typed_array",
+		"return_typed_dictionary",
+		"return_typed_native",
+		"return_typed_script",
+		"iterate_begin",
+		"iterate_begin_int",
+		"iterate_begin_float",
+		"iterate_begin_vector2",
+		"iterate_begin_vector2i",
+		"iterate_begin_vector3",
+		"iterate_begin_vector3i",
+		"iterate_begin_string",
+		"iterate_begin_dictionary",
+		"iterate_begin_array",
+		"iterate_begin_packed_byte_array",
+		"iterate_begin_packed_int32_array",
+		"iterate_begin_packed_int64_array",
+		"iterate_begin_packed_float32_array",
+		"iterate_begin_packed_float64_array",
+		"iterate_begin_packed_string_array",
+		"iterate_begin_packed_vector2_array",
+		"iterate_begin_packed_vector3_array",
+		"iterate_begin_packed_color_array",
+		"iterate_begin_packed_vector4_array",
+		"iterate_begin_object",
+		"iterate_begin_range",
+		"iterate",
+		"iterate_int",
+		"iterate_float",
+		"iterate_vector2",
+		"iterate_vector2i",
+		"iterate_vector3",
+		"iterate_vector3i",
+		"iterate_string",
+		"iterate_dictionary",
+		"iterate_array",
+		"iterate_packed_byte_array",
+		"iterate_packed_int32_array",
+		"iterate_packed_int64_array",
+		"iterate_packed_float32_array",
+		"iterate_packed_float64_array",
+		"iterate_packed_string_array",
+		"iterate_packed_vector2_array",
+		"iterate_packed_vector3_array",
+		"iterate_packed_color_array",
+		"iterate_packed_vector4_array",
+		"iterate_object",
+		"iterate_range",
+		"store_global",
+		"store_named_global",
+		"type_adjust_bool",
+		"type_adjust_int",
+		"type_adjust_float",
+		"type_adjust_string",
+		"type_adjust_vector2",
+		"type_adjust_vector2i",
+		"type_adjust_rect2",
+		"type_adjust_rect2i",
+		"type_adjust_vector3",
+		"type_adjust_vector3i",
+		"type_adjust_transform2d",
+		"type_adjust_vector4",
+		"type_adjust_vector4i",
+		"type_adjust_plane",
+		"type_adjust_quaternion",
+		"type_adjust_aabb",
+		"type_adjust_basis",
+		"type_adjust_transform3d",
+		"type_adjust_projection",
+		"type_adjust_color",
+		"type_adjust_string_name",
+		"type_adjust_node_path",
+		"type_adjust_rid",
+		"type_adjust_object",
+		"type_adjust_callable",
+		"type_adjust_signal",
+		"type_adjust_dictionary",
+		"type_adjust_array",
+		"type_adjust_packed_byte_array",
+		"type_adjust_packed_int32_array",
+		"type_adjust_packed_int64_array",
+		"type_adjust_packed_float32_array",
+		"type_adjust_packed_float64_array",
+		"type_adjust_packed_string_array",
+		"type_adjust_packed_vector2_array",
+		"type_adjust_packed_vector3_array",
+		"type_adjust_packed_color_array",
+		"type_adjust_packed_vector4_array",
+		"assert",
+		"breakpoint",
+		"line",
+		"end",
+	};
+	static_assert(std_size(names) == (OPCODE_END + 1), "Opcode names aren't the same as opcodes in enum.");
+
+	ERR_FAIL_INDEX_V(p_opcode, OPCODE_END + 1, "<invalid opcode>");
+	return names[p_opcode];
+}
+#endif
+
 struct _GDFKC {
 	int order = 0;
 	List<int> pos;
@@ -129,6 +348,7 @@ GDScriptFunction::~GDScriptFunction() {
 #ifdef DEBUG_ENABLED
 	MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
 	GDScriptLanguage::get_singleton()->function_list.remove(&function_list);
+	GDScriptLanguage::get_singleton()->_instruction_profile_remove_function(this);
 #endif
 }
 
@@ -290,6 +290,54 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_ADD_INT,
+		OPCODE_OPERATOR_SUBTRACT_INT,
+		OPCODE_OPERATOR_MULTIPLY_INT,
+		OPCODE_OPERATOR_EQUAL_INT,
+		OPCODE_OPERATOR_NOT_EQUAL_INT,
+		OPCODE_OPERATOR_LESS_INT,
+		OPCODE_OPERATOR_LESS_EQUAL_INT,
+		OPCODE_OPERATOR_GREATER_INT,
+		OPCODE_OPERATOR_GREATER_EQUAL_INT,
+		OPCODE_OPERATOR_ADD_FLOAT,
+		OPCODE_OPERATOR_SUBTRACT_FLOAT,
+		OPCODE_OPERATOR_MULTIPLY_FLOAT,
+		OPCODE_OPERATOR_DIVIDE_FLOAT,
+		OPCODE_OPERATOR_EQUAL_FLOAT,
+		OPCODE_OPERATOR_NOT_EQUAL_FLOAT,
+		OPCODE_OPERATOR_LESS_FLOAT,
+		OPCODE_OPERATOR_LESS_EQUAL_FLOAT,
+		OPCODE_OPERATOR_GREATER_FLOAT,
+		OPCODE_OPERATOR_GREATER_EQUAL_FLOAT,
+		OPCODE_OPERATOR_ADD_VECTOR2,
+		OPCODE_OPERATOR_SUBTRACT_VECTOR2,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR2,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT,
+		OPCODE_OPERATOR_ADD_VECTOR3,
+		OPCODE_OPERATOR_SUBTRACT_VECTOR3,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR3,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,
+		OPCODE_OPERATOR_VALIDATED_ASSIGN,
+		OPCODE_OPERATOR_EQUAL_INT_JUMP_IF_NOT,
+		OPCODE_OPERATOR_NOT_EQUAL_INT_JUMP_IF_NOT,
+		OPCODE_OPERATOR_LESS_INT_JUMP_IF_NOT,
+		OPCODE_OPERATOR_LESS_EQUAL_INT_JUMP_IF_NOT,
+		OPCODE_OPERATOR_GREATER_INT_JUMP_IF_NOT,
+		OPCODE_OPERATOR_GREATER_EQUAL_INT_JUMP_IF_NOT,
+		OPCODE_OPERATOR_EQUAL_FLOAT_JUMP_IF_NOT,
+		OPCODE_OPERATOR_NOT_EQUAL_FLOAT_JUMP_IF_NOT,
+		OPCODE_OPERATOR_LESS_FLOAT_JUMP_IF_NOT,
+		OPCODE_OPERATOR_LESS_EQUAL_FLOAT_JUMP_IF_NOT,
+		OPCODE_OPERATOR_GREATER_FLOAT_JUMP_IF_NOT,
+		OPCODE_OPERATOR_GREATER_EQUAL_FLOAT_JUMP_IF_NOT,
+		OPCODE_OPERATOR_ADD_INT_ASSIGN,
+		OPCODE_OPERATOR_SUBTRACT_INT_ASSIGN,
+		OPCODE_OPERATOR_MULTIPLY_INT_ASSIGN,
+		OPCODE_OPERATOR_ADD_FLOAT_ASSIGN,
+		OPCODE_OPERATOR_SUBTRACT_FLOAT_ASSIGN,
+		OPCODE_OPERATOR_MULTIPLY_FLOAT_ASSIGN,
+		OPCODE_OPERATOR_DIVIDE_FLOAT_ASSIGN,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_DICTIONARY,
@@ -350,6 +398,8 @@ public:
 		OPCODE_JUMP,
 		OPCODE_JUMP_IF,
 		OPCODE_JUMP_IF_NOT,
+		OPCODE_JUMP_IF_BOOL,
+		OPCODE_JUMP_IF_NOT_BOOL,
 		OPCODE_JUMP_TO_DEF_ARGUMENT,
 		OPCODE_JUMP_IF_SHARED,
 		OPCODE_RETURN,
@@ -480,6 +530,7 @@ private:
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
 	friend class GDScriptLanguage;
+	friend class GDScriptBytecodeCache;
 
 	StringName name;
 	StringName source;
@@ -502,6 +553,9 @@ private:
 	List<StackDebug> stack_debug;
 
 	Vector<int> code;
+	// Positions in `code` holding values that are only valid in this process, rewritten by GDScriptBytecodeCache.
+	Vector<int> global_index_positions; // Operands of `OPCODE_STORE_GLOBAL`, indices into the global array.
+	Vector<int> operator_positions; // `OPCODE_OPERATOR` instructions, which cache an evaluator pointer in place.
 	Vector<int> default_arguments;
 	Vector<Variant> constants;
 	HashMap<StringName, Variant> constant_map;
@@ -631,6 +685,7 @@ public:
 #ifdef DEBUG_ENABLED
 	void _profile_native_call(uint64_t p_t_taken, const String &p_function_name, const String &p_instance_class_name = String());
 	void disassemble(const Vector<String> &p_code_lines) const;
+	static const char *get_opcode_name(Opcode p_opcode);
 #endif
 
 	GDScriptFunction();
@@ -255,6 +255,54 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = { \
 		&&OPCODE_OPERATOR, \
 		&&OPCODE_OPERATOR_VALIDATED, \
+		&&OPCODE_OPERATOR_ADD_INT, \
+		&&OPCODE_OPERATOR_SUBTRACT_INT, \
+		&&OPCODE_OPERATOR_MULTIPLY_INT, \
+		&&OPCODE_OPERATOR_EQUAL_INT, \
+		&&OPCODE_OPERATOR_NOT_EQUAL_INT, \
+		&&OPCODE_OPERATOR_LESS_INT, \
+		&&OPCODE_OPERATOR_LESS_EQUAL_INT, \
+		&&OPCODE_OPERATOR_GREATER_INT, \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_INT, \
+		&&OPCODE_OPERATOR_ADD_FLOAT, \
+		&&OPCODE_OPERATOR_SUBTRACT_FLOAT, \
+		&&OPCODE_OPERATOR_MULTIPLY_FLOAT, \
+		&&OPCODE_OPERATOR_DIVIDE_FLOAT, \
+		&&OPCODE_OPERATOR_EQUAL_FLOAT, \
+		&&OPCODE_OPERATOR_NOT_EQUAL_FLOAT, \
+		&&OPCODE_OPERATOR_LESS_FLOAT, \
+		&&OPCODE_OPERATOR_LESS_EQUAL_FLOAT, \
+		&&OPCODE_OPERATOR_GREATER_FLOAT, \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_FLOAT, \
+		&&OPCODE_OPERATOR_ADD_VECTOR2, \
+		&&OPCODE_OPERATOR_SUBTRACT_VECTOR2, \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR2, \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT, \
+		&&OPCODE_OPERATOR_ADD_VECTOR3, \
+		&&OPCODE_OPERATOR_SUBTRACT_VECTOR3, \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR3, \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT, \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT, \
+		&&OPCODE_OPERATOR_VALIDATED_ASSIGN, \
+		&&OPCODE_OPERATOR_EQUAL_INT_JUMP_IF_NOT, \
+		&&OPCODE_OPERATOR_NOT_EQUAL_INT_JUMP_IF_NOT, \
+		&&OPCODE_OPERATOR_LESS_INT_JUMP_IF_NOT, \
+		&&OPCODE_OPERATOR_LESS_EQUAL_INT_JUMP_IF_NOT, \
+		&&OPCODE_OPERATOR_GREATER_INT_JUMP_IF_NOT, \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_INT_JUMP_IF_NOT, \
+		&&OPCODE_OPERATOR_EQUAL_FLOAT_JUMP_IF_NOT, \
+		&&OPCODE_OPERATOR_NOT_EQUAL_FLOAT_JUMP_IF_NOT, \
+		&&OPCODE_OPERATOR_LESS_FLOAT_JUMP_IF_NOT, \
+		&&OPCODE_OPERATOR_LESS_EQUAL_FLOAT_JUMP_IF_NOT, \
+		&&OPCODE_OPERATOR_GREATER_FLOAT_JUMP_IF_NOT, \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_FLOAT_JUMP_IF_NOT, \
+		&&OPCODE_OPERATOR_ADD_INT_ASSIGN, \
+		&&OPCODE_OPERATOR_SUBTRACT_INT_ASSIGN, \
+		&&OPCODE_OPERATOR_MULTIPLY_INT_ASSIGN, \
+		&&OPCODE_OPERATOR_ADD_FLOAT_ASSIGN, \
+		&&OPCODE_OPERATOR_SUBTRACT_FLOAT_ASSIGN, \
+		&&OPCODE_OPERATOR_MULTIPLY_FLOAT_ASSIGN, \
+		&&OPCODE_OPERATOR_DIVIDE_FLOAT_ASSIGN, \
 		&&OPCODE_TYPE_TEST_BUILTIN, \
 		&&OPCODE_TYPE_TEST_ARRAY, \
 		&&OPCODE_TYPE_TEST_DICTIONARY, \
@@ -315,6 +363,8 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_JUMP, \
 		&&OPCODE_JUMP_IF, \
 		&&OPCODE_JUMP_IF_NOT, \
+		&&OPCODE_JUMP_IF_BOOL, \
+		&&OPCODE_JUMP_IF_NOT_BOOL, \
 		&&OPCODE_JUMP_TO_DEF_ARGUMENT, \
 		&&OPCODE_JUMP_IF_SHARED, \
 		&&OPCODE_RETURN, \
@@ -426,6 +476,9 @@ void (*type_init_function_table[])(Variant *) = {
 #ifdef DEBUG_ENABLED
 #define DISPATCH_OPCODE \
 	last_opcode = _code_ptr[ip]; \
+	if (unlikely(opcode_counts)) { \
+		opcode_counts[last_opcode]++; \
+	} \
 	goto *switch_table_ops[last_opcode]
 #else // !DEBUG_ENABLED
 #define DISPATCH_OPCODE goto *switch_table_ops[_code_ptr[ip]]
@@ -733,6 +786,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		profile.call_count.increment();
 		profile.frame_call_count.increment();
 	}
+
+	// Only set while counting opcodes, so dispatching checks a single local.
+	uint64_t *opcode_counts = nullptr;
+	if (unlikely(GDScriptLanguage::get_singleton()->instruction_profiling)) {
+		opcode_counts = GDScriptLanguage::get_singleton()->instruction_profile_enter(this);
+	}
+
 	bool exit_ok = false;
 	int variant_address_limits[ADDR_TYPE_MAX] = { _stack_size, _constant_count, p_instance ? (int)p_instance->members.size() : 0 };
 #endif
@@ -743,6 +803,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #ifdef DEBUG_ENABLED
 	OPCODE_WHILE(ip < _code_size) {
 		int last_opcode = _code_ptr[ip];
+		if (unlikely(opcode_counts)) {
+			opcode_counts[last_opcode]++;
+		}
 #else
 	OPCODE_WHILE(true) {
 #endif
@@ -852,6 +915,145 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+// Operators on proven-typed operands, working on the values inside the Variants.
+// Like validated operators, the destination already holds the result type.
+#define OPCODE_OPERATOR_TYPED(m_name, m_left, m_right, m_ret, m_op) \
+	OPCODE(OPCODE_OPERATOR_##m_name) { \
+		CHECK_SPACE(4); \
+		GET_VARIANT_PTR(a, 0); \
+		GET_VARIANT_PTR(b, 1); \
+		GET_VARIANT_PTR(dst, 2); \
+		*VariantInternal::OP_GET_##m_ret(dst) = *VariantInternal::OP_GET_##m_left(a) m_op *VariantInternal::OP_GET_##m_right(b); \
+		ip += 4; \
+	} \
+	DISPATCH_OPCODE
+
+			OPCODE_OPERATOR_TYPED(ADD_INT, INT, INT, INT, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_INT, INT, INT, INT, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_INT, INT, INT, INT, *);
+			OPCODE_OPERATOR_TYPED(EQUAL_INT, INT, INT, BOOL, ==);
+			OPCODE_OPERATOR_TYPED(NOT_EQUAL_INT, INT, INT, BOOL, !=);
+			OPCODE_OPERATOR_TYPED(LESS_INT, INT, INT, BOOL, <);
+			OPCODE_OPERATOR_TYPED(LESS_EQUAL_INT, INT, INT, BOOL, <=);
+			OPCODE_OPERATOR_TYPED(GREATER_INT, INT, INT, BOOL, >);
+			OPCODE_OPERATOR_TYPED(GREATER_EQUAL_INT, INT, INT, BOOL, >=);
+			OPCODE_OPERATOR_TYPED(ADD_FLOAT, FLOAT, FLOAT, FLOAT, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_FLOAT, FLOAT, FLOAT, FLOAT, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_FLOAT, FLOAT, FLOAT, FLOAT, *);
+			OPCODE_OPERATOR_TYPED(DIVIDE_FLOAT, FLOAT, FLOAT, FLOAT, /);
+			OPCODE_OPERATOR_TYPED(EQUAL_FLOAT, FLOAT, FLOAT, BOOL, ==);
+			OPCODE_OPERATOR_TYPED(NOT_EQUAL_FLOAT, FLOAT, FLOAT, BOOL, !=);
+			OPCODE_OPERATOR_TYPED(LESS_FLOAT, FLOAT, FLOAT, BOOL, <);
+			OPCODE_OPERATOR_TYPED(LESS_EQUAL_FLOAT, FLOAT, FLOAT, BOOL, <=);
+			OPCODE_OPERATOR_TYPED(GREATER_FLOAT, FLOAT, FLOAT, BOOL, >);
+			OPCODE_OPERATOR_TYPED(GREATER_EQUAL_FLOAT, FLOAT, FLOAT, BOOL, >=);
+			OPCODE_OPERATOR_TYPED(ADD_VECTOR2, VECTOR2, VECTOR2, VECTOR2, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_VECTOR2, VECTOR2, VECTOR2, VECTOR2, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR2, VECTOR2, VECTOR2, VECTOR2, *);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR2_FLOAT, VECTOR2, FLOAT, VECTOR2, *);
+			OPCODE_OPERATOR_TYPED(ADD_VECTOR3, VECTOR3, VECTOR3, VECTOR3, +);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_VECTOR3, VECTOR3, VECTOR3, VECTOR3, -);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR3, VECTOR3, VECTOR3, VECTOR3, *);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR3_FLOAT, VECTOR3, FLOAT, VECTOR3, *);
+
+			// Superinstructions: an operator fused with the instruction that follows it. The
+			// second instruction is still in the code right after the first one, so its
+			// operands are read from there and both are skipped at once.
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+				CHECK_SPACE(8);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				if (!dst->booleanize()) {
+					int to = _code_ptr[ip + 7];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 8;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_ASSIGN) {
+				CHECK_SPACE(8);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+				GET_VARIANT_PTR(target, 5);
+
+				operator_func(a, b, dst);
+				*target = *dst;
+
+				ip += 8;
+			}
+			DISPATCH_OPCODE;
+
+#define OPCODE_OPERATOR_TYPED_JUMP_IF_NOT(m_name, m_type, m_op) \
+	OPCODE(OPCODE_OPERATOR_##m_name##_JUMP_IF_NOT) { \
+		CHECK_SPACE(7); \
+		GET_VARIANT_PTR(a, 0); \
+		GET_VARIANT_PTR(b, 1); \
+		GET_VARIANT_PTR(dst, 2); \
+		bool result = *VariantInternal::OP_GET_##m_type(a) m_op *VariantInternal::OP_GET_##m_type(b); \
+		*VariantInternal::get_bool(dst) = result; \
+		if (!result) { \
+			int to = _code_ptr[ip + 6]; \
+			GD_ERR_BREAK(to < 0 || to > _code_size); \
+			ip = to; \
+		} else { \
+			ip += 7; \
+		} \
+	} \
+	DISPATCH_OPCODE
+
+			OPCODE_OPERATOR_TYPED_JUMP_IF_NOT(EQUAL_INT, INT, ==);
+			OPCODE_OPERATOR_TYPED_JUMP_IF_NOT(NOT_EQUAL_INT, INT, !=);
+			OPCODE_OPERATOR_TYPED_JUMP_IF_NOT(LESS_INT, INT, <);
+			OPCODE_OPERATOR_TYPED_JUMP_IF_NOT(LESS_EQUAL_INT, INT, <=);
+			OPCODE_OPERATOR_TYPED_JUMP_IF_NOT(GREATER_INT, INT, >);
+			OPCODE_OPERATOR_TYPED_JUMP_IF_NOT(GREATER_EQUAL_INT, INT, >=);
+			OPCODE_OPERATOR_TYPED_JUMP_IF_NOT(EQUAL_FLOAT, FLOAT, ==);
+			OPCODE_OPERATOR_TYPED_JUMP_IF_NOT(NOT_EQUAL_FLOAT, FLOAT, !=);
+			OPCODE_OPERATOR_TYPED_JUMP_IF_NOT(LESS_FLOAT, FLOAT, <);
+			OPCODE_OPERATOR_TYPED_JUMP_IF_NOT(LESS_EQUAL_FLOAT, FLOAT, <=);
+			OPCODE_OPERATOR_TYPED_JUMP_IF_NOT(GREATER_FLOAT, FLOAT, >);
+			OPCODE_OPERATOR_TYPED_JUMP_IF_NOT(GREATER_EQUAL_FLOAT, FLOAT, >=);
+
+#define OPCODE_OPERATOR_TYPED_ASSIGN(m_name, m_type, m_op) \
+	OPCODE(OPCODE_OPERATOR_##m_name##_ASSIGN) { \
+		CHECK_SPACE(7); \
+		GET_VARIANT_PTR(a, 0); \
+		GET_VARIANT_PTR(b, 1); \
+		GET_VARIANT_PTR(dst, 2); \
+		GET_VARIANT_PTR(target, 4); \
+		*VariantInternal::OP_GET_##m_type(dst) = *VariantInternal::OP_GET_##m_type(a) m_op *VariantInternal::OP_GET_##m_type(b); \
+		*target = *dst; \
+		ip += 7; \
+	} \
+	DISPATCH_OPCODE
+
+			OPCODE_OPERATOR_TYPED_ASSIGN(ADD_INT, INT, +);
+			OPCODE_OPERATOR_TYPED_ASSIGN(SUBTRACT_INT, INT, -);
+			OPCODE_OPERATOR_TYPED_ASSIGN(MULTIPLY_INT, INT, *);
+			OPCODE_OPERATOR_TYPED_ASSIGN(ADD_FLOAT, FLOAT, +);
+			OPCODE_OPERATOR_TYPED_ASSIGN(SUBTRACT_FLOAT, FLOAT, -);
+			OPCODE_OPERATOR_TYPED_ASSIGN(MULTIPLY_FLOAT, FLOAT, *);
+			OPCODE_OPERATOR_TYPED_ASSIGN(DIVIDE_FLOAT, FLOAT, /);
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -2768,6 +2970,36 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_JUMP_IF_BOOL) {
+				CHECK_SPACE(3);
+
+				GET_VARIANT_PTR(test, 0);
+
+				if (*VariantInternal::get_bool(test)) {
+					int to = _code_ptr[ip + 2];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 3;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_JUMP_IF_NOT_BOOL) {
+				CHECK_SPACE(3);
+
+				GET_VARIANT_PTR(test, 0);
+
+				if (!*VariantInternal::get_bool(test)) {
+					int to = _code_ptr[ip + 2];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 3;
+				}
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_JUMP_TO_DEF_ARGUMENT) {
 				CHECK_SPACE(2);
 				ip = _default_arg_ptr[defarg];
@@ -3900,6 +4132,12 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			OPCODE(OPCODE_LINE) {
 				CHECK_SPACE(2);
 
+#ifdef DEBUG_ENABLED
+				if (unlikely(GDScriptLanguage::get_singleton()->instruction_profiling & GDScriptLanguage::INSTRUCTION_PROFILE_LINES)) {
+					GDScriptLanguage::get_singleton()->instruction_profile_line();
+				}
+#endif
+
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
@@ -52,10 +52,12 @@
 
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
+#include "core/object/worker_thread_pool.h"
 
 #ifdef TOOLS_ENABLED
 #include "editor/editor_node.h"
 #include "editor/export/editor_export.h"
+#include "editor/file_system/editor_file_system.h"
 #include "editor/translations/editor_translation_parser.h"
 
 #ifndef GDSCRIPT_NO_LSP
@@ -82,14 +84,63 @@ class EditorExportGDScript : public EditorExportPlugin {
 	static constexpr EditorExportPreset::ScriptExportMode DEFAULT_SCRIPT_MODE = EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED;
 	EditorExportPreset::ScriptExportMode script_mode = DEFAULT_SCRIPT_MODE;
 
+	// Scripts are tokenized up front on the WorkerThreadPool, `_export_file()` only picks up the result.
+	LocalVector<String> script_paths;
+	LocalVector<Vector<uint8_t>> script_tokens;
+	HashMap<String, Vector<uint8_t>> tokenized_scripts;
+
+	void _find_scripts(EditorFileSystemDirectory *p_dir) {
+		for (int i = 0; i < p_dir->get_subdir_count(); i++) {
+			_find_scripts(p_dir->get_subdir(i));
+		}
+
+		for (int i = 0; i < p_dir->get_file_count(); i++) {
+			const String path = p_dir->get_file_path(i);
+			if (path.get_extension() == "gd") {
+				script_paths.push_back(path);
+			}
+		}
+	}
+
+	Vector<uint8_t> _tokenize(const String &p_path) const {
+		Vector<uint8_t> file = FileAccess::get_file_as_bytes(p_path);
+		if (file.is_empty()) {
+			return file;
+		}
+
+		String source = String::utf8(reinterpret_cast<const char *>(file.ptr()), file.size());
+		GDScriptTokenizerBuffer::CompressMode compress_mode = script_mode == EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED ? GDScriptTokenizerBuffer::COMPRESS_ZSTD : GDScriptTokenizerBuffer::COMPRESS_NONE;
+		return GDScriptTokenizerBuffer::parse_code_string(source, compress_mode);
+	}
+
+	void _tokenize_thread(uint32_t p_index, void *p_userdata) {
+		script_tokens[p_index] = _tokenize(script_paths[p_index]);
+	}
+
 protected:
 	virtual void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override {
 		script_mode = DEFAULT_SCRIPT_MODE;
+		tokenized_scripts.clear();
 
 		const Ref<EditorExportPreset> &preset = get_export_preset();
 		if (preset.is_valid()) {
 			script_mode = preset->get_script_export_mode();
 		}
+
+		if (script_mode == EditorExportPreset::MODE_SCRIPT_TEXT || EditorFileSystem::get_singleton() == nullptr) {
+			return;
+		}
+
+		_find_scripts(EditorFileSystem::get_singleton()->get_filesystem());
+		script_tokens.resize(script_paths.size());
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &EditorExportGDScript::_tokenize_thread, (void *)nullptr, script_paths.size(), -1, true, SNAME("GDScriptExportTokenize"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		for (uint32_t i = 0; i < script_paths.size(); i++) {
+			tokenized_scripts.insert(script_paths[i], script_tokens[i]);
+		}
+		script_paths.clear();
+		script_tokens.clear();
 	}
 
 	virtual void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override {
@@ -97,14 +148,12 @@ protected:
 			return;
 		}
 
-		Vector<uint8_t> file = FileAccess::get_file_as_bytes(p_path);
-		if (file.is_empty()) {
-			return;
+		Vector<uint8_t> file;
+		if (HashMap<String, Vector<uint8_t>>::Iterator E = tokenized_scripts.find(p_path)) {
+			file = E->value;
+		} else {
+			file = _tokenize(p_path);
 		}
-
-		String source = String::utf8(reinterpret_cast<const char *>(file.ptr()), file.size());
-		GDScriptTokenizerBuffer::CompressMode compress_mode = script_mode == EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED ? GDScriptTokenizerBuffer::COMPRESS_ZSTD : GDScriptTokenizerBuffer::COMPRESS_NONE;
-		file = GDScriptTokenizerBuffer::parse_code_string(source, compress_mode);
 		if (file.is_empty()) {
 			return;
 		}
@@ -112,6 +161,10 @@ protected:
 		add_file(p_path.get_basename() + ".gdc", file, true);
 	}
 
+	virtual void _export_end() override {
+		tokenized_scripts.clear();
+	}
+
 public:
 	virtual String get_name() const override { return "GDScript"; }
 };
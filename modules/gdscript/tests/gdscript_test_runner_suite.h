@@ -32,6 +32,10 @@
 
 #include "gdscript_test_runner.h"
 
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "modules/gdscript/gdscript_byte_codegen.h"
+#include "modules/gdscript/gdscript_bytecode_cache.h"
 #include "modules/gdscript/gdscript_cache.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
@@ -135,4 +139,379 @@ TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	}
 }
 
+TEST_CASE("[Modules][GDScript] Bytecode cache loads scripts without compiling them") {
+	GDScriptLanguage::get_singleton()->init();
+	const String dependency_path = TestUtils::get_temp_path("gdscript_bytecode_cache_dependency.gd");
+	const String path = TestUtils::get_temp_path("gdscript_bytecode_cache_main.gd");
+	const String source = vformat(R"(
+extends RefCounted
+
+const Dependency = preload("%s")
+const NAMES = ["a", "b"]
+enum Mode { FIRST, SECOND = 5 }
+
+static var counter := 3
+
+class Base:
+	var base_value := 10
+
+	func describe() -> String:
+		return "base %%d" %% base_value
+
+class Inner extends Base:
+	var items: Array[int] = [1, 2, 3]
+
+	func describe() -> String:
+		return super() + " inner %%d" %% items.size()
+
+var offset = 2
+
+func run() -> Array:
+	var inner := Inner.new()
+	var total = 0
+	for item in inner.items:
+		total += item * offset
+	var vector := Vector2(3, 4)
+	vector.y = 8
+	var dictionary := { "key": 7 }
+	var add_offset := func(x): return x * 2 + offset
+	var text := inner.describe()
+	counter += 1
+	return [total, vector.length(), vector.x, inner.items[1], dictionary["key"], add_offset.call(5), text.to_upper(), NAMES[1], len(NAMES), Mode.SECOND, absf(-1.5), max(1, 7), counter, inner.get_reference_count(), ClassDB.class_exists("Node"), Dependency.new().value()]
+)",
+			dependency_path);
+
+	{
+		Ref<FileAccess> fa = FileAccess::open(dependency_path, FileAccess::ModeFlags::WRITE);
+		fa->store_string("extends RefCounted\n\nfunc value() -> int:\n\treturn 40 + 2\n");
+		fa = FileAccess::open(path, FileAccess::ModeFlags::WRITE);
+		fa->store_string(source);
+	}
+
+	GDScriptBytecodeCache::enabled = true;
+	GDScriptBytecodeCache::cache_path = TestUtils::get_temp_path("gdscript_bytecode_cache");
+	const String image_path = GDScriptBytecodeCache::get_image_path(path);
+	DirAccess::remove_absolute(image_path);
+	DirAccess::remove_absolute(GDScriptBytecodeCache::get_image_path(dependency_path));
+
+	const auto run = [&]() {
+		Error err = OK;
+		Ref<GDScript> gdscript = GDScriptCache::get_full_script(path, err);
+		REQUIRE(err == OK);
+		REQUIRE(gdscript->is_valid());
+		Ref<RefCounted> instance = memnew(RefCounted);
+		instance->set_script(gdscript);
+		const Array result = instance->call("run");
+		instance = Ref<RefCounted>();
+		gdscript = Ref<GDScript>();
+		GDScriptCache::remove_static_script(path);
+		GDScriptCache::remove_script(path);
+		GDScriptCache::remove_script(dependency_path);
+		return result;
+	};
+
+	// Compiled from source, which writes the images.
+	const Array compiled = run();
+	CHECK(FileAccess::exists(image_path));
+	CHECK(FileAccess::exists(GDScriptBytecodeCache::get_image_path(dependency_path)));
+
+	// Loaded from the images, without parsing the dependency.
+	const Array loaded = run();
+	CHECK_FALSE(GDScriptCache::has_parser(dependency_path));
+	CHECK(loaded == compiled);
+	CHECK(int(loaded[0]) == 12);
+	CHECK(String(loaded[6]) == "BASE 10 INNER 3");
+	CHECK(int(loaded[12]) == 4);
+	CHECK(int(loaded[15]) == 42);
+
+	// An image isn't used once the source has changed.
+	Ref<GDScript> modified;
+	modified.instantiate();
+	modified->set_path_cache(path);
+	modified->set_source_code(source + "\nfunc added():\n\tpass\n");
+	Error err = OK;
+	CHECK_FALSE(GDScriptBytecodeCache::load(modified.ptr(), err));
+
+	GDScriptBytecodeCache::enabled = false;
+}
+
+TEST_CASE("[Modules][GDScript] Batch parsing resolves base scripts first") {
+	GDScriptLanguage::get_singleton()->init();
+	const String base_path = TestUtils::get_temp_path("gdscript_batch_base.gd");
+	const String derived_path = TestUtils::get_temp_path("gdscript_batch_derived.gd");
+	const String other_path = TestUtils::get_temp_path("gdscript_batch_other.gd");
+	{
+		Ref<FileAccess> fa = FileAccess::open(base_path, FileAccess::ModeFlags::WRITE);
+		fa->store_string("extends RefCounted\n\nvar value := 1\n");
+		fa = FileAccess::open(derived_path, FileAccess::ModeFlags::WRITE);
+		fa->store_string(vformat("extends \"%s\"\n\nfunc get_value() -> int:\n\treturn value + 1\n", base_path));
+		fa = FileAccess::open(other_path, FileAccess::ModeFlags::WRITE);
+		fa->store_string("extends Node\n\nsignal changed\n");
+	}
+
+	Error err = OK;
+	Vector<Ref<GDScriptParserRef>> parsers = GDScriptCache::get_parsers({ derived_path, other_path, base_path, derived_path }, GDScriptParserRef::INTERFACE_SOLVED, err);
+	CHECK(err == OK);
+	REQUIRE(parsers.size() == 3);
+	CHECK(parsers[0]->get_path() == base_path);
+	CHECK(parsers[1]->get_path() == derived_path);
+	CHECK(parsers[2]->get_path() == other_path);
+	for (const Ref<GDScriptParserRef> &parser : parsers) {
+		CHECK(parser->get_status() >= GDScriptParserRef::INTERFACE_SOLVED);
+		CHECK(GDScriptCache::has_parser(parser->get_path()));
+	}
+
+	// Already cached parsers are returned as they are.
+	Vector<Ref<GDScriptParserRef>> cached = GDScriptCache::get_parsers({ base_path }, GDScriptParserRef::PARSED, err);
+	CHECK(err == OK);
+	REQUIRE(cached.size() == 1);
+	CHECK(cached[0] == parsers[0]);
+
+	cached.clear();
+	parsers.clear();
+	CHECK_FALSE(GDScriptCache::has_parser(base_path));
+	CHECK_FALSE(GDScriptCache::has_parser(derived_path));
+
+	parsers = GDScriptCache::get_parsers({ TestUtils::get_temp_path("gdscript_batch_missing.gd") }, GDScriptParserRef::PARSED, err);
+	CHECK(err == ERR_FILE_NOT_FOUND);
+	CHECK(parsers.is_empty());
+}
+
+#ifdef DEBUG_ENABLED
+TEST_CASE("[Modules][GDScript] Instruction profiler writes folded stacks") {
+	GDScriptLanguage::get_singleton()->init();
+	const String source = R"(
+extends RefCounted
+
+func inner(n: int) -> int:
+	var sum := 0
+	for i in n:
+		sum += i
+	return sum
+
+func outer() -> int:
+	return inner(100) + inner(200)
+)";
+
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(source);
+	REQUIRE(gdscript->reload() == OK);
+	gdscript->set_path("res://profiled.gd");
+	Ref<RefCounted> instance = memnew(RefCounted);
+	instance->set_script(gdscript);
+
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	// A zero interval records every line.
+	language->instruction_profiling_start(GDScriptLanguage::INSTRUCTION_PROFILE_LINES | GDScriptLanguage::INSTRUCTION_PROFILE_OPCODES, 0);
+	CHECK(int(instance->call("outer")) == 24850);
+	language->instruction_profiling_stop();
+
+	const String path = TestUtils::get_temp_path("gdscript_profile.folded");
+	REQUIRE(language->instruction_profiling_save(path) == OK);
+
+	const String stacks = FileAccess::get_file_as_string(path);
+	CHECK(stacks.contains("outer (res://profiled.gd:11);inner (res://profiled.gd:"));
+	for (const String &line : stacks.split("\n", false)) {
+		// Each line is a stack followed by its sampled time.
+		CHECK(line.rsplit(" ", true, 1)[1].is_valid_int());
+	}
+
+	const String opcodes = FileAccess::get_file_as_string(TestUtils::get_temp_path("gdscript_profile.opcodes.folded"));
+	CHECK(opcodes.contains("inner (res://profiled.gd);line "));
+	CHECK(opcodes.contains("outer (res://profiled.gd);call_return "));
+
+	// Calls after stopping aren't recorded.
+	language->instruction_profiling_start(GDScriptLanguage::INSTRUCTION_PROFILE_OPCODES);
+	language->instruction_profiling_stop();
+	instance->call("outer");
+	REQUIRE(language->instruction_profiling_save(path) == OK);
+	CHECK(FileAccess::get_file_as_string(path).is_empty());
+
+	// Counts of functions freed by a reload are kept until the next session, and aren't
+	// inherited by new functions (which may be allocated at the same address).
+	language->instruction_profiling_start(GDScriptLanguage::INSTRUCTION_PROFILE_OPCODES);
+	instance->call("outer");
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func outer() -> int:
+	return 1
+)");
+	REQUIRE(gdscript->reload(true) == OK);
+	CHECK(int(instance->call("outer")) == 1);
+	language->instruction_profiling_stop();
+	REQUIRE(language->instruction_profiling_save(path) == OK);
+	CHECK(FileAccess::get_file_as_string(TestUtils::get_temp_path("gdscript_profile.opcodes.folded")).contains("inner (res://profiled.gd);line "));
+
+	language->instruction_profiling_start(GDScriptLanguage::INSTRUCTION_PROFILE_OPCODES);
+	instance->call("outer");
+	language->instruction_profiling_stop();
+	REQUIRE(language->instruction_profiling_save(path) == OK);
+	const String reloaded_opcodes = FileAccess::get_file_as_string(TestUtils::get_temp_path("gdscript_profile.opcodes.folded"));
+	CHECK(reloaded_opcodes.contains("outer (res://profiled.gd);"));
+	CHECK_FALSE(reloaded_opcodes.contains("inner ("));
+}
+#endif // DEBUG_ENABLED
+
+TEST_CASE("[Modules][GDScript][Benchmark] Typed loops, vector math and array fill" * doctest::skip()) {
+	GDScriptLanguage::get_singleton()->init();
+	const String source = R"(
+extends RefCounted
+
+func int_loop(n: int) -> int:
+	var sum := 0
+	var i := 0
+	while i < n:
+		sum += i * 3 - 1
+		i += 1
+	return sum
+
+func float_loop(n: int) -> float:
+	var x := 0.0
+	for i in n:
+		x = x * 0.5 + 1.25
+		if x > 2.0:
+			x -= 1.0
+	return x
+
+func vector_math(n: int) -> Vector3:
+	var position := Vector3.ZERO
+	var velocity := Vector3(1, 2, 3)
+	var delta := 0.016
+	for i in n:
+		velocity = velocity - position * delta
+		position = position + velocity * delta
+	return position
+
+func array_fill(n: int) -> int:
+	var array: Array[int] = []
+	array.resize(n)
+	for i in n:
+		array[i] = i * 2 + 1
+	return array[n - 1]
+)";
+
+	const int n = 10000000;
+	for (const char *method : { "int_loop", "float_loop", "vector_math", "array_fill" }) {
+		uint64_t elapsed[2] = {};
+		Variant results[2];
+		for (int typed = 0; typed < 2; typed++) {
+			GDScriptByteCodeGenerator::typed_fast_paths = typed;
+			Ref<GDScript> gdscript = memnew(GDScript);
+			gdscript->set_source_code(source);
+			ERR_PRINT_OFF;
+			const Error error = gdscript->reload();
+			ERR_PRINT_ON;
+			REQUIRE(error == OK);
+
+			Ref<RefCounted> instance = memnew(RefCounted);
+			instance->set_script(gdscript);
+			const uint64_t start = OS::get_singleton()->get_ticks_usec();
+			results[typed] = instance->call(method, n);
+			elapsed[typed] = MAX(OS::get_singleton()->get_ticks_usec() - start, (uint64_t)1);
+		}
+		CHECK(results[0] == results[1]);
+		MESSAGE(vformat("%s: validated %d usec, typed %d usec (%.2fx).", method, (int64_t)elapsed[0], (int64_t)elapsed[1], (double)elapsed[0] / elapsed[1]));
+	}
+	GDScriptByteCodeGenerator::typed_fast_paths = true;
+}
+
+TEST_CASE("[Modules][GDScript][Benchmark] Superinstructions in tight loops" * doctest::skip()) {
+	GDScriptLanguage::get_singleton()->init();
+	const String source = R"(
+extends RefCounted
+
+func count_below(n: int) -> int:
+	var count := 0
+	var i := 0
+	while i < n:
+		if i % 7 < 3:
+			count += 1
+		i += 1
+	return count
+
+func integrate(n: int) -> float:
+	var x := 0.0
+	var speed := 1.0
+	var t := 0.0
+	while t < n:
+		speed -= x * 0.001
+		x += speed * 0.01
+		t += 1.0
+	return x
+
+func walk_grid(n: int) -> Vector2i:
+	var cell := Vector2i.ZERO
+	var step := Vector2i(1, 2)
+	var i := 0
+	while i < n:
+		cell += step
+		i += 1
+	return cell
+)";
+
+	const int n = 10000000;
+	for (const char *method : { "count_below", "integrate", "walk_grid" }) {
+		uint64_t elapsed[2] = {};
+		Variant results[2];
+		for (int fused = 0; fused < 2; fused++) {
+			GDScriptByteCodeGenerator::superinstructions = fused;
+			Ref<GDScript> gdscript = memnew(GDScript);
+			gdscript->set_source_code(source);
+			ERR_PRINT_OFF;
+			const Error error = gdscript->reload();
+			ERR_PRINT_ON;
+			REQUIRE(error == OK);
+
+			Ref<RefCounted> instance = memnew(RefCounted);
+			instance->set_script(gdscript);
+			const uint64_t start = OS::get_singleton()->get_ticks_usec();
+			results[fused] = instance->call(method, n);
+			elapsed[fused] = MAX(OS::get_singleton()->get_ticks_usec() - start, (uint64_t)1);
+		}
+		CHECK(results[0] == results[1]);
+		MESSAGE(vformat("%s: unfused %d usec, fused %d usec (%.2fx).", method, (int64_t)elapsed[0], (int64_t)elapsed[1], (double)elapsed[0] / elapsed[1]));
+	}
+	GDScriptByteCodeGenerator::superinstructions = true;
+}
+
+TEST_CASE("[Modules][GDScript][Benchmark] Batch parsing of a large project" * doctest::skip()) {
+	GDScriptLanguage::get_singleton()->init();
+
+	// Chains of scripts extending each other, each with enough code to make parsing dominate.
+	const int script_count = 400;
+	const int chain_length = 4;
+	const int function_count = 40;
+	Vector<String> paths;
+	for (int i = 0; i < script_count; i++) {
+		const String path = TestUtils::get_temp_path(vformat("gdscript_batch_benchmark_%d.gd", i));
+		String source = i % chain_length == 0 ? String("extends RefCounted\n") : vformat("extends \"%s\"\n", paths[i - 1]);
+		for (int j = 0; j < function_count; j++) {
+			source += vformat("\nvar value_%d_%d := %d\n\nfunc compute_%d_%d(count: int, scale: float) -> float:\n\tvar total := 0.0\n\tfor k in count:\n\t\ttotal += sin(k * scale) + value_%d_%d\n\treturn total\n", i, j, j, i, j, i, j);
+		}
+		Ref<FileAccess> fa = FileAccess::open(path, FileAccess::ModeFlags::WRITE);
+		fa->store_string(source);
+		paths.push_back(path);
+	}
+
+	uint64_t elapsed[2] = {};
+	for (int batch = 0; batch < 2; batch++) {
+		Vector<Ref<GDScriptParserRef>> parsers;
+		Error err = OK;
+		const uint64_t start = OS::get_singleton()->get_ticks_usec();
+		if (batch) {
+			parsers = GDScriptCache::get_parsers(paths, GDScriptParserRef::INTERFACE_SOLVED, err);
+		} else {
+			for (const String &path : paths) {
+				parsers.push_back(GDScriptCache::get_parser(path, GDScriptParserRef::INTERFACE_SOLVED, err));
+				REQUIRE(err == OK);
+			}
+		}
+		elapsed[batch] = MAX(OS::get_singleton()->get_ticks_usec() - start, (uint64_t)1);
+		CHECK(err == OK);
+		CHECK(parsers.size() == script_count);
+	}
+	MESSAGE(vformat("%d scripts: one at a time %d usec, batched %d usec (%.2fx).", script_count, (int64_t)elapsed[0], (int64_t)elapsed[1], (double)elapsed[0] / elapsed[1]));
+}
+
 } // namespace GDScriptTests
@@ -0,0 +1,63 @@
+# Operators fused with the jump or assignment that follows them.
+
+func test():
+	var count := 0
+	for n in 20:
+		if n < 5:
+			count += 1
+		if n >= 15:
+			count += 100
+		if n == 10:
+			count += 1000
+	print(count)
+
+	var i := 10
+	while i > 0:
+		i -= 3
+	print(i)
+
+	var x := 0.0
+	while x <= 2.0:
+		x += 0.5
+	print(x)
+
+	var scale := 3.0
+	scale *= 1.5
+	scale /= 2.0
+	scale -= 0.25
+	print(scale)
+
+	var product := 1
+	for n in range(1, 6):
+		product *= n
+	print(product)
+
+	# Operators without inline forms use validated operators.
+	var text := ""
+	while text.length() < 4:
+		text += "ab"
+	print(text)
+
+	var cell := Vector2i(0, 0)
+	cell += Vector2i(2, 3)
+	print(cell)
+
+	var done := false
+	var steps := 0
+	while not done:
+		steps += 1
+		done = steps == 3
+	print(steps)
+
+	# Untyped destinations receive the typed result.
+	var untyped
+	var a := 4
+	untyped = a + 2
+	print(untyped, " ", typeof(untyped) == TYPE_INT)
+
+	# Jumps landing between the fused instructions still test the condition.
+	var y := 2
+	if y > 1 and y < 3:
+		print("in range")
+	if y > 5 or y < 0:
+		print("out of range")
@@ -0,0 +1,41 @@
+# Operators and conditions on typed values use inline opcodes.
+
+func test():
+	var a := 7
+	var b := 3
+	print(a + b, " ", a - b, " ", a * b)
+	print(a == b, " ", a != b, " ", a < b, " ", a <= b, " ", a > b, " ", a >= b)
+
+	var x := 1.5
+	var y := 0.5
+	var zero := 0.0
+	print(x + y, " ", x - y, " ", x * y, " ", x / y, " ", x / zero)
+	print(x == y, " ", x != y, " ", x < y, " ", x <= y, " ", x > y, " ", x >= y)
+
+	var v := Vector2(1, 2)
+	var w := Vector2(3, 4)
+	print(v + w, " ", v - w, " ", v * w, " ", v * x)
+
+	var p := Vector3(1, 2, 3)
+	var q := Vector3(0.5, 0.5, 2)
+	print(p + q, " ", p - q, " ", p * q, " ", p * y)
+
+	var sum := 0
+	var i := 0
+	while i < 10:
+		sum += i
+		i += 1
+	print(sum)
+
+	var flag := a > b
+	if flag:
+		print("flag")
+	if not flag:
+		print("not flag")
+	print(flag and b > a, " ", flag or b > a)
+	var t := 1 if flag else 2
+	print(t)
+
+	# Mixed and untyped operands still use the generic paths.
+	var u = 5
+	print(u + a, " ", a < x)
@@ -536,6 +536,25 @@ RID GodotPhysicsServer2D::body_create() {
 	return rid;
 }
 
+Vector<RID> GodotPhysicsServer2D::bodies_create(int p_count) {
+	ERR_FAIL_COND_V(p_count < 0, Vector<RID>());
+	Vector<RID> rids;
+	rids.resize(p_count);
+	RID *rids_ptrw = rids.ptrw();
+	body_owner.allocate_rids(rids_ptrw, p_count);
+	for (int i = 0; i < p_count; i++) {
+		if (rids_ptrw[i].is_null()) {
+			// Element limit reached, already reported.
+			rids.resize(i);
+			break;
+		}
+		GodotBody2D *body = memnew(GodotBody2D);
+		body_owner.initialize_rid(rids_ptrw[i], body);
+		body->set_self(rids_ptrw[i]);
+	}
+	return rids;
+}
+
 void GodotPhysicsServer2D::body_set_space(RID p_body, RID p_space) {
 	GodotBody2D *body = body_owner.get_or_null(p_body);
 	ERR_FAIL_NULL(body);
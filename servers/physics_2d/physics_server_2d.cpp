@@ -625,6 +625,43 @@ bool PhysicsServer2D::_body_test_motion(RID p_body, RequiredParam<PhysicsTestMot
 	return body_test_motion(p_body, p_parameters->get_parameters(), result_ptr);
 }
 
+Vector<RID> PhysicsServer2D::bodies_create(int p_count) {
+	ERR_FAIL_COND_V(p_count < 0, Vector<RID>());
+	Vector<RID> bodies;
+	bodies.resize(p_count);
+	RID *bodies_ptrw = bodies.ptrw();
+	for (int i = 0; i < p_count; i++) {
+		bodies_ptrw[i] = body_create();
+	}
+	return bodies;
+}
+
+void PhysicsServer2D::free_rids(const Vector<RID> &p_rids) {
+	for (const RID &rid : p_rids) {
+		free_rid(rid);
+	}
+}
+
+TypedArray<RID> PhysicsServer2D::_bodies_create(int p_count) {
+	const Vector<RID> bodies = bodies_create(p_count);
+	TypedArray<RID> ret;
+	ret.resize(bodies.size());
+	for (int i = 0; i < bodies.size(); i++) {
+		ret[i] = bodies[i];
+	}
+	return ret;
+}
+
+void PhysicsServer2D::_free_rids(const TypedArray<RID> &p_rids) {
+	Vector<RID> rids;
+	rids.resize(p_rids.size());
+	RID *rids_ptrw = rids.ptrw();
+	for (int i = 0; i < p_rids.size(); i++) {
+		rids_ptrw[i] = p_rids[i];
+	}
+	free_rids(rids);
+}
+
 void PhysicsServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("world_boundary_shape_create"), &PhysicsServer2D::world_boundary_shape_create);
 	ClassDB::bind_method(D_METHOD("separation_ray_shape_create"), &PhysicsServer2D::separation_ray_shape_create);
@@ -686,6 +723,7 @@ void PhysicsServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("area_set_monitorable", "area", "monitorable"), &PhysicsServer2D::area_set_monitorable);
 
 	ClassDB::bind_method(D_METHOD("body_create"), &PhysicsServer2D::body_create);
+	ClassDB::bind_method(D_METHOD("bodies_create", "count"), &PhysicsServer2D::_bodies_create);
 
 	ClassDB::bind_method(D_METHOD("body_set_space", "body", "space"), &PhysicsServer2D::body_set_space);
 	ClassDB::bind_method(D_METHOD("body_get_space", "body"), &PhysicsServer2D::body_get_space);
@@ -798,6 +836,7 @@ void PhysicsServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("joint_get_type", "joint"), &PhysicsServer2D::joint_get_type);
 
 	ClassDB::bind_method(D_METHOD("free_rid", "rid"), &PhysicsServer2D::free_rid);
+	ClassDB::bind_method(D_METHOD("free_rids", "rids"), &PhysicsServer2D::_free_rids);
 
 	ClassDB::bind_method(D_METHOD("set_active", "active"), &PhysicsServer2D::set_active);
 
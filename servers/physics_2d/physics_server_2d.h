@@ -218,6 +218,9 @@ class PhysicsServer2D : public Object {
 
 	virtual bool _body_test_motion(RID p_body, RequiredParam<PhysicsTestMotionParameters2D> rp_parameters, const Ref<PhysicsTestMotionResult2D> &p_result = Ref<PhysicsTestMotionResult2D>());
 
+	TypedArray<RID> _bodies_create(int p_count);
+	void _free_rids(const TypedArray<RID> &p_rids);
+
 protected:
 	static void _bind_methods();
 
@@ -369,6 +372,8 @@ public:
 	};
 
 	virtual RID body_create() = 0;
+	// Creates p_count bodies at once, implementations may allocate them in one batch.
+	virtual Vector<RID> bodies_create(int p_count);
 
 	virtual void body_set_space(RID p_body, RID p_space) = 0;
 	virtual RID body_get_space(RID p_body) const = 0;
@@ -602,6 +607,7 @@ public:
 	/* MISC */
 
 	virtual void free_rid(RID p_rid) = 0;
+	virtual void free_rids(const Vector<RID> &p_rids);
 #ifndef DISABLE_DEPRECATED
 	[[deprecated("Use `free_rid()` instead.")]] void free(RID p_rid) {
 		free_rid(p_rid);
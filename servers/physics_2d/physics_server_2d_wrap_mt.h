@@ -176,6 +176,10 @@ public:
 	//FUNC2RID(body,BodyMode,bool);
 	FUNCRID(body)
 
+	virtual Vector<RID> bodies_create(int p_count) override {
+		return physics_server_2d->bodies_create(p_count);
+	}
+
 	FUNC2(body_set_space, RID, RID);
 	FUNC1RC(RID, body_get_space, RID);
 
@@ -311,6 +315,7 @@ public:
 	/* MISC */
 
 	FUNC1(free_rid, RID);
+	FUNC1(free_rids, const Vector<RID> &);
 	FUNC1(set_active, bool);
 
 	virtual void init() override;
@@ -736,6 +736,43 @@ RID PhysicsServer3D::shape_create(ShapeType p_shape) {
 	}
 }
 
+Vector<RID> PhysicsServer3D::bodies_create(int p_count) {
+	ERR_FAIL_COND_V(p_count < 0, Vector<RID>());
+	Vector<RID> bodies;
+	bodies.resize(p_count);
+	RID *bodies_ptrw = bodies.ptrw();
+	for (int i = 0; i < p_count; i++) {
+		bodies_ptrw[i] = body_create();
+	}
+	return bodies;
+}
+
+void PhysicsServer3D::free_rids(const Vector<RID> &p_rids) {
+	for (const RID &rid : p_rids) {
+		free_rid(rid);
+	}
+}
+
+TypedArray<RID> PhysicsServer3D::_bodies_create(int p_count) {
+	const Vector<RID> bodies = bodies_create(p_count);
+	TypedArray<RID> ret;
+	ret.resize(bodies.size());
+	for (int i = 0; i < bodies.size(); i++) {
+		ret[i] = bodies[i];
+	}
+	return ret;
+}
+
+void PhysicsServer3D::_free_rids(const TypedArray<RID> &p_rids) {
+	Vector<RID> rids;
+	rids.resize(p_rids.size());
+	RID *rids_ptrw = rids.ptrw();
+	for (int i = 0; i < p_rids.size(); i++) {
+		rids_ptrw[i] = p_rids[i];
+	}
+	free_rids(rids);
+}
+
 void PhysicsServer3D::_bind_methods() {
 #ifndef _3D_DISABLED
 
@@ -802,6 +839,7 @@ void PhysicsServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("area_set_ray_pickable", "area", "enable"), &PhysicsServer3D::area_set_ray_pickable);
 
 	ClassDB::bind_method(D_METHOD("body_create"), &PhysicsServer3D::body_create);
+	ClassDB::bind_method(D_METHOD("bodies_create", "count"), &PhysicsServer3D::_bodies_create);
 
 	ClassDB::bind_method(D_METHOD("body_set_space", "body", "space"), &PhysicsServer3D::body_set_space);
 	ClassDB::bind_method(D_METHOD("body_get_space", "body"), &PhysicsServer3D::body_get_space);
@@ -1086,6 +1124,7 @@ void PhysicsServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("generic_6dof_joint_get_flag", "joint", "axis", "flag"), &PhysicsServer3D::generic_6dof_joint_get_flag);
 
 	ClassDB::bind_method(D_METHOD("free_rid", "rid"), &PhysicsServer3D::free_rid);
+	ClassDB::bind_method(D_METHOD("free_rids", "rids"), &PhysicsServer3D::_free_rids);
 
 	ClassDB::bind_method(D_METHOD("set_active", "active"), &PhysicsServer3D::set_active);
 
@@ -243,6 +243,9 @@ class PhysicsServer3D : public Object {
 
 	virtual bool _body_test_motion(RID p_body, RequiredParam<PhysicsTestMotionParameters3D> rp_parameters, const Ref<PhysicsTestMotionResult3D> &p_result = Ref<PhysicsTestMotionResult3D>());
 
+	TypedArray<RID> _bodies_create(int p_count);
+	void _free_rids(const TypedArray<RID> &p_rids);
+
 protected:
 	static void _bind_methods();
 
@@ -403,6 +406,8 @@ public:
 	};
 
 	virtual RID body_create() = 0;
+	// Creates p_count bodies at once, implementations may allocate them in one batch.
+	virtual Vector<RID> bodies_create(int p_count);
 
 	virtual void body_set_space(RID p_body, RID p_space) = 0;
 	virtual RID body_get_space(RID p_body) const = 0;
@@ -808,6 +813,7 @@ public:
 	/* MISC */
 
 	virtual void free_rid(RID p_rid) = 0;
+	virtual void free_rids(const Vector<RID> &p_rids);
 #ifndef DISABLE_DEPRECATED
 	[[deprecated("Use `free_rid()` instead.")]] void free(RID p_rid) {
 		free_rid(p_rid);
@@ -185,6 +185,10 @@ public:
 	//FUNC2RID(body,BodyMode,bool);
 	FUNCRID(body)
 
+	virtual Vector<RID> bodies_create(int p_count) override {
+		return physics_server_3d->bodies_create(p_count);
+	}
+
 	FUNC2(body_set_space, RID, RID);
 	FUNC1RC(RID, body_get_space, RID);
 
@@ -400,6 +404,7 @@ public:
 	/* MISC */
 
 	FUNC1(free_rid, RID);
+	FUNC1(free_rids, const Vector<RID> &);
 	FUNC1(set_active, bool);
 
 	virtual void init() override;
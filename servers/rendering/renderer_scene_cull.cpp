@@ -542,6 +542,18 @@ void RendererSceneCull::instance_initialize(RID p_rid) {
 	instance->self = p_rid;
 }
 
+void RendererSceneCull::instances_allocate(RID *r_rids, uint32_t p_count) {
+	instance_owner.allocate_rids(r_rids, p_count);
+}
+
+void RendererSceneCull::instances_initialize(const Vector<RID> &p_rids) {
+	for (const RID &rid : p_rids) {
+		if (rid.is_valid()) {
+			instance_initialize(rid);
+		}
+	}
+}
+
 void RendererSceneCull::_instance_update_mesh_instance(Instance *p_instance) const {
 	bool needs_instance = RSG::mesh_storage->mesh_needs_instance(p_instance->base, p_instance->skeleton.is_valid());
 	if (needs_instance != p_instance->mesh_instance.is_valid()) {
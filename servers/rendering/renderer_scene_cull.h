@@ -1019,6 +1019,8 @@ public:
 
 	virtual RID instance_allocate();
 	virtual void instance_initialize(RID p_rid);
+	virtual void instances_allocate(RID *r_rids, uint32_t p_count);
+	virtual void instances_initialize(const Vector<RID> &p_rids);
 
 	virtual void instance_set_base(RID p_instance, RID p_base);
 	virtual void instance_set_scenario(RID p_instance, RID p_scenario);
@@ -76,6 +76,8 @@ public:
 
 	virtual RID instance_allocate() = 0;
 	virtual void instance_initialize(RID p_rid) = 0;
+	virtual void instances_allocate(RID *r_rids, uint32_t p_count) = 0;
+	virtual void instances_initialize(const Vector<RID> &p_rids) = 0;
 
 	virtual void instance_set_base(RID p_instance, RID p_base) = 0;
 	virtual void instance_set_scenario(RID p_instance, RID p_scenario) = 0;
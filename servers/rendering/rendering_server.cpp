@@ -3266,6 +3266,7 @@ void RenderingServer::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("instance_create2", "base", "scenario"), &RenderingServer::instance_create2);
 	ClassDB::bind_method(D_METHOD("instance_create"), &RenderingServer::instance_create);
+	ClassDB::bind_method(D_METHOD("instances_create", "count"), &RenderingServer::_instances_create);
 	ClassDB::bind_method(D_METHOD("instance_set_base", "instance", "base"), &RenderingServer::instance_set_base);
 	ClassDB::bind_method(D_METHOD("instance_set_scenario", "instance", "scenario"), &RenderingServer::instance_set_scenario);
 	ClassDB::bind_method(D_METHOD("instance_set_layer_mask", "instance", "mask"), &RenderingServer::instance_set_layer_mask);
@@ -3559,6 +3560,7 @@ void RenderingServer::_bind_methods() {
 
 	/* Free */
 	ClassDB::bind_method(D_METHOD("free_rid", "rid"), &RenderingServer::free_rid);
+	ClassDB::bind_method(D_METHOD("free_rids", "rids"), &RenderingServer::_free_rids);
 
 	/* Misc */
 
@@ -3677,6 +3679,43 @@ void RenderingServer::set_boot_image(const Ref<Image> &p_image, const Color &p_c
 }
 #endif
 
+Vector<RID> RenderingServer::instances_create(int p_count) {
+	ERR_FAIL_COND_V(p_count < 0, Vector<RID>());
+	Vector<RID> instances;
+	instances.resize(p_count);
+	RID *instances_ptrw = instances.ptrw();
+	for (int i = 0; i < p_count; i++) {
+		instances_ptrw[i] = instance_create();
+	}
+	return instances;
+}
+
+void RenderingServer::free_rids(const Vector<RID> &p_rids) {
+	for (const RID &rid : p_rids) {
+		free_rid(rid);
+	}
+}
+
+TypedArray<RID> RenderingServer::_instances_create(int p_count) {
+	const Vector<RID> instances = instances_create(p_count);
+	TypedArray<RID> ret;
+	ret.resize(instances.size());
+	for (int i = 0; i < instances.size(); i++) {
+		ret[i] = instances[i];
+	}
+	return ret;
+}
+
+void RenderingServer::_free_rids(const TypedArray<RID> &p_rids) {
+	Vector<RID> rids;
+	rids.resize(p_rids.size());
+	RID *rids_ptrw = rids.ptrw();
+	for (int i = 0; i < p_rids.size(); i++) {
+		rids_ptrw[i] = p_rids[i];
+	}
+	free_rids(rids);
+}
+
 RID RenderingServer::instance_create2(RID p_base, RID p_scenario) {
 	RID instance = instance_create();
 	instance_set_base(instance, p_base);
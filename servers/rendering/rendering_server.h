@@ -1520,6 +1520,9 @@ public:
 	virtual RID instance_create2(RID p_base, RID p_scenario);
 
 	virtual RID instance_create() = 0;
+	// Creates p_count instances at once. Implementations may allocate them in one batch
+	// and initialize them with a single command.
+	virtual Vector<RID> instances_create(int p_count);
 
 	virtual void instance_set_base(RID p_instance, RID p_base) = 0;
 	virtual void instance_set_scenario(RID p_instance, RID p_scenario) = 0;
@@ -1847,6 +1850,7 @@ public:
 	/* FREE */
 
 	virtual void free_rid(RID p_rid) = 0; // Free RIDs associated with the rendering server.
+	virtual void free_rids(const Vector<RID> &p_rids);
 #ifndef DISABLE_DEPRECATED
 	[[deprecated("Use `free_rid()` instead.")]] void free(RID p_rid) {
 		free_rid(p_rid);
@@ -2003,6 +2007,8 @@ private:
 	TypedArray<Dictionary> _canvas_item_get_instance_shader_parameter_list(RID p_item) const;
 	TypedArray<Image> _bake_render_uv2(RID p_base, const TypedArray<RID> &p_material_overrides, const Size2i &p_image_size);
 	void _particles_set_trail_bind_poses(RID p_particles, const TypedArray<Transform3D> &p_bind_poses);
+	TypedArray<RID> _instances_create(int p_count);
+	void _free_rids(const TypedArray<RID> &p_rids);
 #ifdef TOOLS_ENABLED
 	SurfaceUpgradeCallback surface_upgrade_callback = nullptr;
 	bool warn_on_surface_upgrade = true;
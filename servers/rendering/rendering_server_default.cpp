@@ -61,6 +61,12 @@ void RenderingServerDefault::_free(RID p_rid) {
 	}
 }
 
+void RenderingServerDefault::_free_rids(const Vector<RID> &p_rids) {
+	for (const RID &rid : p_rids) {
+		_free(rid);
+	}
+}
+
 /* EVENT QUEUING */
 
 void RenderingServerDefault::request_frame_drawn_callback(const Callable &p_callable) {
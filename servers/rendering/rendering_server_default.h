@@ -91,6 +91,7 @@ class RenderingServerDefault : public RenderingServer {
 	void _finish();
 
 	void _free(RID p_rid);
+	void _free_rids(const Vector<RID> &p_rids);
 
 	void _call_on_render_thread(const Callable &p_callable);
 
@@ -940,6 +941,27 @@ public:
 	/* INSTANCING API */
 	FUNCRIDSPLIT(instance)
 
+	virtual Vector<RID> instances_create(int p_count) override {
+		ERR_FAIL_COND_V(p_count < 0, Vector<RID>());
+		Vector<RID> ret;
+		ret.resize(p_count);
+		server_name->instances_allocate(ret.ptrw(), p_count);
+		for (int i = 0; i < p_count; i++) {
+			if (ret[i].is_null()) {
+				// Element limit reached, already reported.
+				ret.resize(i);
+				break;
+			}
+		}
+		// One command for the whole batch.
+		if (ASYNC_COND_PUSH) {
+			command_queue.push(server_name, &ServerName::instances_initialize, ret);
+		} else {
+			server_name->instances_initialize(ret);
+		}
+		return ret;
+	}
+
 	FUNC2(instance_set_base, RID, RID)
 	FUNC2(instance_set_scenario, RID, RID)
 	FUNC2(instance_set_layer_mask, RID, uint32_t)
@@ -1199,6 +1221,15 @@ public:
 		}
 	}
 
+	virtual void free_rids(const Vector<RID> &p_rids) override {
+		if (Thread::get_caller_id() == server_thread) {
+			command_queue.flush_if_pending();
+			_free_rids(p_rids);
+		} else {
+			command_queue.push(this, &RenderingServerDefault::_free_rids, p_rids);
+		}
+	}
+
 	/* INTERPOLATION */
 
 	virtual void set_physics_interpolation_enabled(bool p_enabled) override;
@@ -33,7 +33,10 @@
 TEST_FORCE_LINK(test_config_file)
 
 #include "core/io/config_file.h"
+#include "core/io/dir_access.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "tests/test_utils.h"
 
 namespace TestConfigFile {
 
@@ -159,4 +162,119 @@ antiAliasing=false
 			"The saved configuration file should match the expected format.");
 }
 
+TEST_CASE("[ConfigFile] Lazy loading") {
+	const String contents = String::utf8(R"(; Leading comment.
+top = 1
+
+[player]
+
+name = "Unnamed \"Player\"" ; Inline comment
+tagline="Waiting
+for
+Godot"
+position= Vector2(
+	3,
+	4
+)
+inventory = Array[int]([1, 2, 3])
+weights = Dictionary[String, float]({
+"a": 0.5, ; Comment inside a value.
+"b]": 1.5
+})
+"静音" = &"mute"
+color=#ff0000
+
+[bad \] section]
+
+broken = Vector2(1, 2, 3)
+last = null
+)");
+
+	const String path = TestUtils::get_temp_path("lazy_config.ini");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(contents);
+	}
+
+	ConfigFile eager;
+	REQUIRE(eager.load(path) == ERR_PARSE_ERROR);
+
+	ConfigFile config_file;
+	REQUIRE(config_file.load_lazy(path) == OK);
+	CHECK(config_file.get_sections() == Vector<String>({ "", "player", "bad ] section" }));
+	CHECK(config_file.get_section_keys("player") == Vector<String>({ "name", "tagline", "position", "inventory", "weights", String::utf8("静音"), "color" }));
+
+	CHECK(int(config_file.get_value("", "top")) == 1);
+	CHECK(String(config_file.get_value("player", "name")) == "Unnamed \"Player\"");
+	CHECK(String(config_file.get_value("player", "tagline")) == "Waiting\nfor\nGodot");
+	CHECK(Vector2(config_file.get_value("player", "position")).is_equal_approx(Vector2(3, 4)));
+	const Array inventory = config_file.get_value("player", "inventory");
+	CHECK(inventory.is_typed());
+	CHECK(inventory == Array({ 1, 2, 3 }));
+	const Dictionary weights = config_file.get_value("player", "weights");
+	CHECK(weights.is_typed());
+	CHECK(double(weights["b]"]) == 1.5);
+	CHECK(config_file.get_value("player", String::utf8("静音")) == Variant(StringName("mute")));
+	CHECK(Color(config_file.get_value("player", "color")).is_equal_approx(Color(1, 0, 0)));
+	// Like with load(), null values count as missing keys.
+	CHECK(config_file.get_value("bad ] section", "last", 5) == Variant(5));
+	CHECK_FALSE(config_file.has_section_key("bad ] section", "last"));
+
+	// Invalid values are only reported when they are read.
+	ERR_PRINT_OFF;
+	CHECK(config_file.get_value("bad ] section", "broken", Vector2(7, 7)) == Variant(Vector2(7, 7)));
+	ERR_PRINT_ON;
+
+	// Values that were never read are written back untouched.
+	ConfigFile reference;
+	reference.set_value("player", "position", Vector2(3, 4));
+	const String encoded = config_file.encode_to_text();
+	CHECK(encoded.contains("broken=Vector2(1, 2, 3)\n"));
+	CHECK(encoded.contains("tagline=\"Waiting\nfor\nGodot\"\n"));
+	CHECK(encoded.contains(reference.encode_to_text().get_slice("\n\n", 1)));
+
+	DirAccess::remove_absolute(path);
+}
+
+struct LazyReadData {
+	ConfigFile *config_file = nullptr;
+	SafeNumeric<uint32_t> mismatches;
+
+	void read(uint32_t p_index, void *p_userdata) {
+		const int key = p_index % 64;
+		if (int(config_file->get_value("values", itos(key))) != key * 3) {
+			mismatches.increment();
+		}
+	}
+};
+
+TEST_CASE("[ConfigFile] Reading lazily loaded values from several threads") {
+	String contents = "[values]\n\n";
+	for (int i = 0; i < 64; i++) {
+		contents += itos(i) + "=" + itos(i * 3) + "\n";
+	}
+
+	const String path = TestUtils::get_temp_path("lazy_config_threads.ini");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(contents);
+	}
+
+	ConfigFile config_file;
+	REQUIRE(config_file.load_lazy(path) == OK);
+
+	LazyReadData data;
+	data.config_file = &config_file;
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(&data, &LazyReadData::read, nullptr, 64 * 16);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	CHECK(data.mismatches.get() == 0);
+	// Values that were read are written back from their parsed result.
+	CHECK(config_file.encode_to_text().contains("\n5=15\n"));
+
+	DirAccess::remove_absolute(path);
+}
+
 } // namespace TestConfigFile
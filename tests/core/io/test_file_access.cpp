@@ -32,8 +32,11 @@
 
 TEST_FORCE_LINK(test_file_access)
 
+#include "core/io/compression.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
 #include "tests/test_utils.h"
 
 namespace TestFileAccess {
@@ -297,4 +300,271 @@ TEST_CASE("[FileAccess] Cursor positioning") {
 	}
 }
 
+TEST_CASE("[FileAccess] Memory-mapped buffer views") {
+	const String path = TestUtils::get_temp_path("file_access_mmap.bin");
+	const int64_t size = 256 * 1024 + 7;
+	{
+		Ref<FileAccess> fw = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(fw.is_valid());
+		for (int64_t i = 0; i < size; i++) {
+			fw->store_8(uint8_t(i * 31));
+		}
+	}
+
+	SUBCASE("Plain reads don't provide views") {
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_buffer_view(16).size() == 0);
+		CHECK(f->get_position() == 0);
+	}
+
+	SUBCASE("Views and reads match the file contents") {
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ | FileAccess::MMAP);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_length() == uint64_t(size));
+
+		f->seek(1000);
+		Span<uint8_t> view = f->get_buffer_view(4096);
+#if defined(UNIX_ENABLED) && !defined(WEB_ENABLED)
+		REQUIRE(view.size() == 4096);
+#endif
+		if (view.size() > 0) {
+			CHECK(f->get_position() == 1000 + 4096);
+			bool matches = true;
+			for (uint64_t i = 0; i < view.size(); i++) {
+				matches = matches && view[i] == uint8_t((1000 + i) * 31);
+			}
+			CHECK(matches);
+
+			// Views are all-or-nothing, the position stays put when the request can't be served.
+			f->seek_end(-10);
+			CHECK(f->get_buffer_view(11).size() == 0);
+			CHECK(f->get_position() == uint64_t(size - 10));
+			CHECK(f->get_buffer_view(10).size() == 10);
+			CHECK_FALSE(f->eof_reached());
+		}
+
+		f->seek(size - 4);
+		uint8_t tail[8] = {};
+		CHECK(f->get_buffer(tail, 8) == 4);
+		CHECK(tail[3] == uint8_t((size - 1) * 31));
+		CHECK(f->eof_reached());
+		CHECK(f->get_error() == ERR_FILE_EOF);
+
+		f->seek(0);
+		CHECK_FALSE(f->eof_reached());
+		CHECK(f->get_32() == (uint32_t(0) | uint32_t(31) << 8 | uint32_t(uint8_t(62)) << 16 | uint32_t(uint8_t(93)) << 24));
+	}
+
+	SUBCASE("Open instances of the same file share one mapping") {
+		Ref<FileAccess> a = FileAccess::open(path, FileAccess::READ | FileAccess::MMAP);
+		Ref<FileAccess> b = FileAccess::open(path, FileAccess::READ | FileAccess::MMAP);
+		REQUIRE(a.is_valid());
+		REQUIRE(b.is_valid());
+		Span<uint8_t> view_a = a->get_buffer_view(64);
+		Span<uint8_t> view_b = b->get_buffer_view(64);
+		if (view_a.size() > 0) {
+			CHECK(view_a.ptr() == view_b.ptr());
+
+			// The mapping stays alive while any instance still uses it.
+			a->close();
+			b->seek(size - 1);
+			CHECK(b->get_8() == uint8_t((size - 1) * 31));
+			CHECK(view_b[63] == uint8_t(63 * 31));
+		}
+	}
+
+	DirAccess::remove_absolute(path);
+}
+
+static Vector<uint8_t> make_compressible_data(int64_t p_size) {
+	Vector<uint8_t> data;
+	data.resize(p_size);
+	uint8_t *ptr = data.ptrw();
+	uint32_t seed = 12345;
+	for (int64_t i = 0; i < p_size; i++) {
+		// Runs of a repeated value with some noise, so every mode compresses it a bit.
+		if (i % 64 == 0) {
+			seed = seed * 1103515245 + 12345;
+		}
+		ptr[i] = (i % 7 == 0) ? uint8_t(i) : uint8_t(seed >> 16);
+	}
+	return data;
+}
+
+TEST_CASE("[FileAccess] Block compression") {
+	const Compression::Mode modes[] = { Compression::MODE_FASTLZ, Compression::MODE_DEFLATE, Compression::MODE_ZSTD, Compression::MODE_GZIP };
+	const uint32_t block_size = 4096;
+
+	for (Compression::Mode mode : modes) {
+		for (int64_t size : { int64_t(0), int64_t(100), int64_t(block_size * 16), int64_t(block_size * 37 + 123) }) {
+			const Vector<uint8_t> data = make_compressible_data(size);
+			const uint32_t block_count = size / block_size + 1;
+
+			LocalVector<uint8_t> compressed;
+			compressed.resize(Compression::get_max_compressed_blocks_size(size, block_size, block_count, mode));
+			LocalVector<uint32_t> sizes;
+			sizes.resize(block_count);
+			const int64_t compressed_size = Compression::compress_blocks(compressed.ptr(), sizes.ptr(), data.ptr(), size, block_size, block_count, mode);
+			REQUIRE(compressed_size > 0);
+
+			// Each block is a standalone stream, the same one the single block API produces.
+			uint8_t first[block_size];
+			const int64_t first_size = MIN(int64_t(block_size), size);
+			CHECK(Compression::decompress(first, first_size, compressed.ptr(), sizes[0], mode) == first_size);
+			CHECK(memcmp(first, data.ptr(), first_size) == 0);
+
+			Vector<uint8_t> decompressed;
+			decompressed.resize(size);
+			CHECK(Compression::decompress_blocks(decompressed.ptrw(), size, compressed.ptr(), sizes.ptr(), block_size, block_count, mode) == size);
+			CHECK(decompressed == data);
+		}
+	}
+
+	ERR_PRINT_OFF;
+	LocalVector<uint8_t> compressed;
+	uint32_t sizes[2] = {};
+	compressed.resize(Compression::get_max_compressed_blocks_size(block_size, block_size, 2, Compression::MODE_ZSTD));
+	const Vector<uint8_t> data = make_compressible_data(block_size * 4);
+	CHECK(Compression::compress_blocks(compressed.ptr(), sizes, data.ptr(), data.size(), block_size, 2, Compression::MODE_ZSTD) == -1);
+	ERR_PRINT_ON;
+}
+
+struct BlockCompressionJobs {
+	Vector<uint8_t> data;
+	uint32_t block_size = 0;
+	uint32_t block_count = 0;
+	SafeNumeric<uint32_t> succeeded;
+
+	static void run(void *p_userdata, uint32_t p_index) {
+		BlockCompressionJobs *jobs = (BlockCompressionJobs *)p_userdata;
+		const int64_t size = jobs->data.size();
+		LocalVector<uint8_t> compressed;
+		compressed.resize(Compression::get_max_compressed_blocks_size(size, jobs->block_size, jobs->block_count, Compression::MODE_ZSTD));
+		LocalVector<uint32_t> sizes;
+		sizes.resize(jobs->block_count);
+		if (Compression::compress_blocks(compressed.ptr(), sizes.ptr(), jobs->data.ptr(), size, jobs->block_size, jobs->block_count, Compression::MODE_ZSTD) <= 0) {
+			return;
+		}
+		Vector<uint8_t> decompressed;
+		decompressed.resize(size);
+		if (Compression::decompress_blocks(decompressed.ptrw(), size, compressed.ptr(), sizes.ptr(), jobs->block_size, jobs->block_count, Compression::MODE_ZSTD) == size && decompressed == jobs->data) {
+			jobs->succeeded.increment();
+		}
+	}
+};
+
+TEST_CASE("[FileAccess] Block compression from pool threads") {
+	// Every pool thread compresses at once, none of them may wait for the others.
+	BlockCompressionJobs jobs;
+	jobs.block_size = 4096;
+	jobs.block_count = MAX(Compression::parallel_min_blocks, 16);
+	jobs.data = make_compressible_data(int64_t(jobs.block_size) * jobs.block_count);
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	const uint32_t job_count = MAX(pool->get_thread_count(), 1) * 2;
+	WorkerThreadPool::GroupID group = pool->add_native_group_task(&BlockCompressionJobs::run, &jobs, job_count, -1, true);
+	pool->wait_for_group_task_completion(group);
+	CHECK(jobs.succeeded.get() == job_count);
+}
+
+TEST_CASE("[FileAccess] Compressed files") {
+	const String path = TestUtils::get_temp_path("file_access_compressed.bin");
+	const Vector<uint8_t> data = make_compressible_data(4096 * 40 + 57);
+
+	for (FileAccess::CompressionMode mode : { FileAccess::COMPRESSION_FASTLZ, FileAccess::COMPRESSION_DEFLATE, FileAccess::COMPRESSION_ZSTD, FileAccess::COMPRESSION_GZIP }) {
+		{
+			Ref<FileAccess> fw = FileAccess::open_compressed(path, FileAccess::WRITE, mode);
+			REQUIRE(fw.is_valid());
+			fw->store_buffer(data.ptr(), 1000);
+			fw->store_buffer(data.ptr() + 1000, data.size() - 1000);
+		}
+
+		Ref<FileAccess> f = FileAccess::open_compressed(path, FileAccess::READ, mode);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_length() == uint64_t(data.size()));
+
+		// A small read first, then a large one that spans many whole blocks.
+		Vector<uint8_t> read = f->get_buffer(10);
+		CHECK(read.size() == 10);
+		read.append_array(f->get_buffer(data.size() - 10));
+		CHECK(read == data);
+		CHECK(f->get_position() == uint64_t(data.size()));
+		CHECK_FALSE(f->eof_reached());
+
+		// Reading past the end reports EOF.
+		CHECK(f->get_buffer(10).size() == 0);
+		CHECK(f->eof_reached());
+
+		// The position stays consistent after a bulk read that ends on a block boundary.
+		f->seek(0);
+		CHECK(f->get_buffer(4096 * 8).size() == 4096 * 8);
+		CHECK(f->get_position() == 4096 * 8);
+		CHECK(f->get_8() == data[4096 * 8]);
+		f->seek(4096 * 8 - 3);
+		CHECK(f->get_8() == data[4096 * 8 - 3]);
+
+		f->seek(4096 * 5 + 1);
+		Vector<uint8_t> tail = f->get_buffer(data.size());
+		CHECK(tail == data.slice(4096 * 5 + 1));
+	}
+
+	DirAccess::remove_absolute(path);
+}
+
+TEST_CASE("[FileAccess] Compressed files spanning several compression batches") {
+	const String path = TestUtils::get_temp_path("file_access_compressed_batches.bin");
+	// Blocks are compressed a few per worker thread at a time, make sure several batches are needed.
+	const int64_t batch_blocks = MAX(Compression::parallel_min_blocks, MAX(WorkerThreadPool::get_singleton()->get_thread_count(), 1) * 4);
+
+	for (int64_t size : { 4096 * (batch_blocks * 3 + 2) + 57, 4096 * batch_blocks * 2 }) {
+		const Vector<uint8_t> data = make_compressible_data(size);
+		{
+			Ref<FileAccess> fw = FileAccess::open_compressed(path, FileAccess::WRITE, FileAccess::COMPRESSION_ZSTD);
+			REQUIRE(fw.is_valid());
+			fw->store_buffer(data.ptr(), data.size());
+		}
+
+		Ref<FileAccess> f = FileAccess::open_compressed(path, FileAccess::READ, FileAccess::COMPRESSION_ZSTD);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_length() == uint64_t(size));
+		CHECK(f->get_buffer(size) == data);
+
+		f->seek(4096 * batch_blocks + 5);
+		CHECK(f->get_8() == data[4096 * batch_blocks + 5]);
+	}
+
+	DirAccess::remove_absolute(path);
+}
+
+TEST_CASE("[FileAccess][Benchmark] Compressed file throughput" * doctest::skip()) {
+	const String path = TestUtils::get_temp_path("file_access_compressed_benchmark.bin");
+	const Vector<uint8_t> data = make_compressible_data(64 * 1024 * 1024);
+	const int parallel_min_blocks = Compression::parallel_min_blocks;
+
+	for (bool parallel : { false, true }) {
+		Compression::parallel_min_blocks = parallel ? parallel_min_blocks : INT32_MAX;
+
+		uint64_t start = OS::get_singleton()->get_ticks_usec();
+		{
+			Ref<FileAccess> fw = FileAccess::open_compressed(path, FileAccess::WRITE, FileAccess::COMPRESSION_ZSTD);
+			REQUIRE(fw.is_valid());
+			fw->store_buffer(data.ptr(), data.size());
+		}
+		const uint64_t write = MAX(OS::get_singleton()->get_ticks_usec() - start, (uint64_t)1);
+
+		start = OS::get_singleton()->get_ticks_usec();
+		Ref<FileAccess> f = FileAccess::open_compressed(path, FileAccess::READ, FileAccess::COMPRESSION_ZSTD);
+		REQUIRE(f.is_valid());
+		const Vector<uint8_t> read = f->get_buffer(data.size());
+		const uint64_t read_time = MAX(OS::get_singleton()->get_ticks_usec() - start, (uint64_t)1);
+		CHECK(read == data);
+
+		MESSAGE(vformat("%s: write %d usec (%d MiB/s), read %d usec (%d MiB/s).", parallel ? "parallel" : "serial", (int64_t)write, (int64_t)(uint64_t(data.size()) * 1000000 / write / 1048576), (int64_t)read_time, (int64_t)(uint64_t(data.size()) * 1000000 / read_time / 1048576)));
+	}
+
+	Compression::parallel_min_blocks = parallel_min_blocks;
+	DirAccess::remove_absolute(path);
+}
+
 } // namespace TestFileAccess
@@ -32,8 +32,14 @@
 
 TEST_FORCE_LINK(test_json)
 
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
 #include "core/io/json.h"
+#include "core/io/json_document.h"
+#include "core/io/json_writer.h"
+#include "core/os/os.h"
 #include "core/variant/typed_array.h"
+#include "tests/test_utils.h"
 
 namespace TestJSON {
 
@@ -425,4 +431,243 @@ TEST_CASE("[JSON] Serialization") {
 	}
 }
 
+static Error parse_utf8(JSON &r_json, const String &p_text) {
+	const CharString utf8 = p_text.utf8();
+	return r_json.parse_utf8((const uint8_t *)utf8.get_data(), utf8.length());
+}
+
+TEST_CASE("[JSON] UTF-8 parser matches the String parser") {
+	const String valid[] = {
+		"null",
+		" true ",
+		"-12.5e3",
+		"\"h\\u00e9llo \\ud83d\\ude00 w\\\"orld\\n\"",
+		"\"café 弓\"",
+		"[1, 2, [3, [4, []]], {}, \"x\",]",
+		"{\"a\": {\"b\": [true, false, null]}, \"c\": \"\\\\\", \"d\": 1e99999,}",
+		// Long enough to span several 64 byte blocks, with escapes across block boundaries.
+		"[\"" + String("ab\\\\\\\"cd").repeat(40) + "\", {\"key\": \"" + String("\\\\").repeat(33) + "\"}]",
+	};
+	for (const String &text : valid) {
+		JSON expected;
+		JSON actual;
+		REQUIRE(expected.parse(text) == OK);
+		CHECK_MESSAGE(parse_utf8(actual, text) == OK, vformat("UTF-8 parser should accept `%s`.", text));
+		CHECK(JSON::stringify(actual.get_data()) == JSON::stringify(expected.get_data()));
+	}
+
+	const String invalid[] = {
+		"",
+		"[1, 2",
+		"{\"a\" 1}",
+		"{\"a\": 1 \"b\": 2}",
+		"[1 2]",
+		"\"unterminated",
+		"\"bad \\x escape\"",
+		"\"\\ud800 lone surrogate\"",
+		"nul",
+		"12abc",
+		"[1]\n\n]",
+		"{1: 2}",
+	};
+	ERR_PRINT_OFF
+	for (const String &text : invalid) {
+		JSON expected;
+		JSON actual;
+		CHECK(expected.parse(text) != OK);
+		CHECK_MESSAGE(parse_utf8(actual, text) != OK, vformat("UTF-8 parser should reject `%s`.", text));
+		CHECK(actual.get_data() == Variant());
+	}
+	ERR_PRINT_ON
+
+	JSON json;
+	CHECK(parse_utf8(json, "{\n\"a\": 1,\n\"b\" 2}") == ERR_PARSE_ERROR);
+	CHECK(json.get_error_line() == 2);
+	CHECK(json.get_error_message() == "Expected ':'");
+}
+
+TEST_CASE("[JSON] Writer streams to a file") {
+	const String path = TestUtils::get_temp_path("json_writer.json");
+
+	Array entries;
+	for (int i = 0; i < 5000; i++) {
+		Dictionary entry;
+		entry["id"] = i;
+		entry["name"] = "entry \"" + itos(i) + "\" é";
+		entry["value"] = i * 0.25;
+		entries.push_back(entry);
+	}
+	const String expected = JSON::stringify(entries, "\t");
+	CHECK(expected.utf8().length() > (int)JSONWriter::FILE_CHUNK_SIZE);
+
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		JSONWriter writer("\t");
+		writer.set_file(f);
+		writer.write(entries);
+		CHECK(writer.flush() == OK);
+		CHECK(writer.get_size() == 0);
+	}
+
+	CHECK(FileAccess::get_file_as_string(path) == expected);
+	DirAccess::remove_absolute(path);
+}
+
+TEST_CASE("[JSONDocument] JSON pointer lookups") {
+	Ref<JSONDocument> document;
+	document.instantiate();
+	REQUIRE(document->parse(R"({
+	"name": "doc",
+	"items": [{"id": 1, "tags": ["a", "b"]}, {"id": 2, "tags": []},],
+	"a/b": {"m~n": true, "esc\"aped": "yes"},
+	"dup": 1,
+	"dup": 2,
+	"": 0
+})") == OK);
+
+	CHECK(document->get_value("/name") == Variant("doc"));
+	CHECK(document->get_value("/items/0/id") == Variant(1.0));
+	CHECK(document->get_value("/items/1/id") == Variant(2.0));
+	CHECK(document->get_value("/items/0/tags/1") == Variant("b"));
+	CHECK(document->get_value("/a~1b/m~0n") == Variant(true));
+	CHECK(document->get_value("/a~1b/esc\"aped") == Variant("yes"));
+	CHECK_MESSAGE(document->get_value("/dup") == Variant(2.0), "The last duplicate key should win, like in a parsed Dictionary.");
+	CHECK(document->get_value("/") == Variant(0.0));
+
+	// Subtrees are converted the same way JSON.parse() does it.
+	JSON json;
+	REQUIRE(json.parse("[{\"id\": 1, \"tags\": [\"a\", \"b\"]}, {\"id\": 2, \"tags\": []}]") == OK);
+	CHECK(JSON::stringify(document->get_value("/items")) == JSON::stringify(json.get_data()));
+	CHECK(Dictionary(document->get_value("")).size() == 5);
+
+	CHECK(document->has_value("/items/1/tags"));
+	CHECK_FALSE(document->has_value("/items/2"));
+	CHECK_FALSE(document->has_value("/items/01"));
+	CHECK_FALSE(document->has_value("/items/-"));
+	CHECK_FALSE(document->has_value("/name/0"));
+	CHECK_FALSE(document->has_value("/missing"));
+	CHECK(document->get_value("/missing", 42) == Variant(42));
+	CHECK(document->get_error_message() == "No value at JSON pointer \"/missing\"");
+
+	CHECK(document->get_keys() == PackedStringArray({ "name", "items", "a/b", "dup", "" }));
+	CHECK(document->get_keys("/a~1b") == PackedStringArray({ "m~n", "esc\"aped" }));
+	CHECK(document->get_size() == 5);
+	CHECK(document->get_size("/items") == 2);
+	CHECK(document->get_size("/items/1/tags") == 0);
+}
+
+TEST_CASE("[JSONDocument] Errors") {
+	Ref<JSONDocument> document;
+	document.instantiate();
+
+	ERR_PRINT_OFF
+	CHECK(document->parse("") == ERR_PARSE_ERROR);
+	CHECK(document->parse("[1, 2") == ERR_PARSE_ERROR);
+	CHECK(document->get_error_message() == "Expected ']'");
+	CHECK(document->parse("{\"a\": [1}") == ERR_PARSE_ERROR);
+	CHECK(document->parse("[1]\n\n]") == ERR_PARSE_ERROR);
+	CHECK(document->get_error_line() == 2);
+	CHECK(document->parse("{} {}") == ERR_PARSE_ERROR);
+	CHECK(document->get_error_message() == "Expected 'EOF'");
+	ERR_PRINT_ON
+
+	// Only the brackets are checked up front, errors elsewhere show up when they are read.
+	REQUIRE(document->parse("{\n\"good\": [1, 2],\n\"bad\": [1 2],\n\"nested\": {\"worse\" 3}\n}") == OK);
+	CHECK(document->get_value("/good/1") == Variant(2.0));
+	CHECK(document->get_value("/bad/0") == Variant(1.0));
+	CHECK(document->get_value("/bad", "default") == Variant("default"));
+	CHECK(document->get_error_message() == "Expected ','");
+	CHECK(document->get_error_line() == 2);
+	CHECK(document->get_value("/nested/worse", "default") == Variant("default"));
+	CHECK(document->get_error_message() == "Expected ':'");
+	CHECK(document->get_error_line() == 3);
+}
+
+TEST_CASE("[JSONDocument] Load from a file") {
+	const String path = TestUtils::get_data_path("json/save_game.json");
+	const String text = FileAccess::get_file_as_string(path);
+	REQUIRE_FALSE(text.is_empty());
+
+	JSON json;
+	REQUIRE(json.parse(text) == OK);
+	const Dictionary data = json.get_data();
+
+	Ref<JSONDocument> document;
+	document.instantiate();
+	REQUIRE(document->load(path) == OK);
+	const PackedStringArray keys = document->get_keys();
+	REQUIRE(keys.size() == data.size());
+	for (int i = 0; i < keys.size(); i++) {
+		CHECK(keys[i] == String(data.keys()[i]));
+	}
+	for (const Variant &key : data.keys()) {
+		CHECK(JSON::stringify(document->get_value("/" + String(key).replace("~", "~0").replace("/", "~1"))) == JSON::stringify(data[key]));
+	}
+
+	document->clear();
+	CHECK_FALSE(document->has_value(""));
+
+	SUBCASE("The file can be rewritten while the document is in use") {
+		const String copy_path = TestUtils::get_temp_path("json_document_rewrite.json");
+		{
+			Ref<FileAccess> f = FileAccess::open(copy_path, FileAccess::WRITE);
+			REQUIRE(f.is_valid());
+			f->store_string(text);
+		}
+		REQUIRE(document->load(copy_path) == OK);
+		{
+			Ref<FileAccess> f = FileAccess::open(copy_path, FileAccess::WRITE);
+			REQUIRE(f.is_valid());
+			f->store_string("{}");
+		}
+		CHECK(document->get_keys().size() == data.size());
+		DirAccess::remove_absolute(copy_path);
+	}
+}
+
+TEST_CASE("[JSON][Benchmark] Parse and stringify a large document" * doctest::skip()) {
+	const String sample = FileAccess::get_file_as_string(TestUtils::get_data_path("json/save_game.json"));
+	REQUIRE_FALSE(sample.is_empty());
+
+	// Roughly 6 MiB of save game data.
+	String text = "[";
+	for (int i = 0; i < 1000; i++) {
+		text += i == 0 ? sample : "," + sample;
+	}
+	text += "]";
+	const CharString utf8 = text.utf8();
+
+	JSON json;
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	REQUIRE(json.parse(text) == OK);
+	const uint64_t string_parse = OS::get_singleton()->get_ticks_usec() - start;
+
+	start = OS::get_singleton()->get_ticks_usec();
+	REQUIRE(json.parse_utf8((const uint8_t *)utf8.get_data(), utf8.length()) == OK);
+	const uint64_t utf8_parse = OS::get_singleton()->get_ticks_usec() - start;
+
+	start = OS::get_singleton()->get_ticks_usec();
+	const String stringified = JSON::stringify(json.get_data(), "\t");
+	const uint64_t stringify = OS::get_singleton()->get_ticks_usec() - start;
+
+	start = OS::get_singleton()->get_ticks_usec();
+	JSONWriter writer("\t");
+	writer.write(json.get_data());
+	const uint64_t write = OS::get_singleton()->get_ticks_usec() - start;
+
+	MESSAGE(vformat("%d bytes: parse(String) %d usec, parse_utf8 %d usec.", utf8.length(), (int64_t)string_parse, (int64_t)utf8_parse));
+	MESSAGE(vformat("stringify %d usec, JSONWriter %d usec (%d bytes).", (int64_t)stringify, (int64_t)write, (int64_t)writer.get_size()));
+
+	// Reading a single value near the end, without converting the rest of the document.
+	start = OS::get_singleton()->get_ticks_usec();
+	JSONDocument document;
+	REQUIRE(document.parse(text) == OK);
+	const Variant last = document.get_value("/999");
+	const uint64_t lookup = OS::get_singleton()->get_ticks_usec() - start;
+	CHECK(JSON::stringify(last) == JSON::stringify(Array(json.get_data())[999]));
+
+	MESSAGE(vformat("JSONDocument index and lookup %d usec.", (int64_t)lookup));
+}
+
 } // namespace TestJSON
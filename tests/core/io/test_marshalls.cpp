@@ -34,6 +34,7 @@ TEST_FORCE_LINK(test_marshalls)
 
 #include "core/io/marshalls.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
 
 namespace TestMarshalls {
 
@@ -490,4 +491,198 @@ TEST_CASE("[Marshalls] Typed dictionary decoding") {
 	CHECK(dictionary[Variant(uint64_t(0x0f123456789abcdef))] == Variant(uint64_t(0x0f123456789abcdef)));
 }
 
+static Vector<Variant> make_encoding_samples() {
+	Vector<Variant> samples;
+	samples.push_back(Variant());
+	samples.push_back(true);
+	samples.push_back(42);
+	samples.push_back(int64_t(0x0f123456789abcdef));
+	samples.push_back(0.5);
+	samples.push_back(1.0 / 3.0);
+	samples.push_back("abc");
+	samples.push_back(String::utf8("héllo wörld"));
+	samples.push_back(StringName("name"));
+	samples.push_back(NodePath("a/b:c"));
+	samples.push_back(Vector3(1, 2, 3));
+	samples.push_back(Transform3D());
+	samples.push_back(Color(0.1, 0.2, 0.3, 0.4));
+
+	PackedByteArray bytes;
+	for (int i = 0; i < 7; i++) {
+		bytes.push_back(i);
+	}
+	samples.push_back(bytes);
+	samples.push_back(PackedInt32Array({ 1, -2, 3 }));
+	samples.push_back(PackedInt64Array({ 1, -2, int64_t(1) << 40 }));
+	samples.push_back(PackedFloat32Array({ 0.5, -1.5 }));
+	samples.push_back(PackedFloat64Array({ 0.1, 1e100 }));
+	samples.push_back(PackedStringArray({ "a", "bc", "" }));
+	samples.push_back(PackedVector2Array({ Vector2(1, 2), Vector2(3, 4) }));
+	samples.push_back(PackedVector3Array({ Vector3(1, 2, 3) }));
+	samples.push_back(PackedVector4Array({ Vector4(1, 2, 3, 4) }));
+	samples.push_back(PackedColorArray({ Color(1, 0, 0), Color(0, 1, 0, 0.5) }));
+	samples.push_back(PackedByteArray());
+
+	Array typed;
+	typed.set_typed(Variant::INT, StringName(), Variant());
+	typed.push_back(1);
+	typed.push_back(2);
+	samples.push_back(typed);
+
+	Dictionary nested;
+	nested["text"] = "abcde";
+	nested[1] = Array({ 1, "two", PackedVector3Array({ Vector3(1, 2, 3) }) });
+	nested[Vector2i(1, 2)] = Dictionary();
+	samples.push_back(Array({ nested, Array(), "x" }));
+	return samples;
+}
+
+TEST_CASE("[Marshalls] Single pass encoding into a buffer") {
+	const Vector<Variant> samples = make_encoding_samples();
+
+	LocalVector<uint8_t> buffer;
+	LocalVector<uint8_t> expected_all;
+	for (const Variant &sample : samples) {
+		int len = 0;
+		REQUIRE(encode_variant(sample, nullptr, len) == OK);
+		Vector<uint8_t> expected;
+		expected.resize(len);
+		REQUIRE(encode_variant(sample, expected.ptrw(), len) == OK);
+
+		LocalVector<uint8_t> single;
+		REQUIRE(encode_variant(sample, single) == OK);
+		CHECK_MESSAGE(single.size() == uint32_t(len), vformat("Size mismatch for %s.", Variant::get_type_name(sample.get_type())));
+		CHECK_MESSAGE(memcmp(single.ptr(), expected.ptr(), MIN(uint32_t(len), single.size())) == 0, vformat("Content mismatch for %s.", Variant::get_type_name(sample.get_type())));
+
+		// Encodes are appended to what the buffer already holds.
+		REQUIRE(encode_variant(sample, buffer) == OK);
+		for (int i = 0; i < len; i++) {
+			expected_all.push_back(expected[i]);
+		}
+
+		Variant decoded;
+		REQUIRE(decode_variant(decoded, single.ptr(), single.size()) == OK);
+		CHECK(decoded == sample);
+	}
+	REQUIRE(buffer.size() == expected_all.size());
+	CHECK(memcmp(buffer.ptr(), expected_all.ptr(), buffer.size()) == 0);
+
+	SUBCASE("Encoding after an unaligned prefix") {
+		// Padding depends on the payload only, so the encoded bytes don't depend on what precedes them.
+		for (uint32_t prefix = 1; prefix <= 2; prefix++) {
+			for (const Variant &sample : samples) {
+				LocalVector<uint8_t> single;
+				REQUIRE(encode_variant(sample, single) == OK);
+
+				LocalVector<uint8_t> prefixed;
+				prefixed.resize(prefix);
+				memset(prefixed.ptr(), 0xff, prefix);
+				REQUIRE(encode_variant(sample, prefixed) == OK);
+				REQUIRE(prefixed.size() == prefix + single.size());
+				CHECK_MESSAGE(memcmp(prefixed.ptr() + prefix, single.ptr(), single.size()) == 0, vformat("Content mismatch for %s after %d bytes.", Variant::get_type_name(sample.get_type()), prefix));
+
+				Variant decoded;
+				int len = 0;
+				REQUIRE(decode_variant(decoded, prefixed.ptr() + prefix, prefixed.size() - prefix, &len) == OK);
+				CHECK(len == int(single.size()));
+				CHECK(decoded == sample);
+			}
+		}
+	}
+
+	SUBCASE("Values bigger than the size limit are rejected") {
+		PackedByteArray big;
+		big.resize(4096);
+		const uint32_t size = buffer.size();
+		CHECK(encode_variant(big, buffer, false, 0, size + 4096) == ERR_OUT_OF_MEMORY);
+		CHECK(buffer.size() == size);
+		CHECK(encode_variant(Array({ "abc", big }), buffer, false, 0, size + 4096) == ERR_OUT_OF_MEMORY);
+		CHECK(buffer.size() == size);
+		CHECK(encode_variant(big, buffer, false, 0, size + 4096 + 8) == OK);
+		CHECK(buffer.size() == size + 4096 + 8);
+	}
+
+	SUBCASE("Errors leave the buffer as it was") {
+		Array deep;
+		Array current = deep;
+		for (int i = 0; i <= Variant::MAX_RECURSION_DEPTH + 1; i++) {
+			Array next;
+			current.push_back(next);
+			current = next;
+		}
+		const uint32_t size = buffer.size();
+		ERR_PRINT_OFF;
+		CHECK(encode_variant(deep, buffer) == ERR_OUT_OF_MEMORY);
+		ERR_PRINT_ON;
+		CHECK(buffer.size() == size);
+	}
+}
+
+TEST_CASE("[Marshalls] Reused encode buffers") {
+	const Variant value = Array({ "abc", PackedFloat32Array({ 1, 2 }) });
+	VariantEncodeBuffer buffer;
+	REQUIRE(buffer.encode(value) == OK);
+	const Vector<uint8_t> bytes = buffer.to_bytes();
+
+	{
+		// A nested encode on the same thread doesn't clobber the outer one.
+		VariantEncodeBuffer nested;
+		REQUIRE(nested.encode(Array({ 1, 2, 3 })) == OK);
+		CHECK(nested.to_bytes() != bytes);
+	}
+	CHECK(buffer.to_bytes() == bytes);
+
+	// Encoding again replaces the previous content.
+	REQUIRE(buffer.encode(value) == OK);
+	CHECK(buffer.to_bytes() == bytes);
+
+	Variant decoded;
+	REQUIRE(decode_variant(decoded, buffer.ptr(), buffer.size()) == OK);
+	CHECK(decoded == value);
+}
+
+TEST_CASE("[Marshalls][Benchmark] Encoding and decoding packets" * doctest::skip()) {
+	Dictionary packet;
+	packet["type"] = "state";
+	packet["tick"] = 123456;
+	PackedVector3Array positions;
+	PackedFloat32Array angles;
+	for (int i = 0; i < 64; i++) {
+		positions.push_back(Vector3(i, i * 0.5, -i));
+		angles.push_back(i * 0.1);
+	}
+	packet["positions"] = positions;
+	packet["angles"] = angles;
+	packet["names"] = PackedStringArray({ "alpha", "beta", "gamma" });
+
+	const int iterations = 100000;
+
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		int len = 0;
+		encode_variant(packet, nullptr, len);
+		Vector<uint8_t> bytes;
+		bytes.resize(len);
+		encode_variant(packet, bytes.ptrw(), len);
+	}
+	const uint64_t two_pass = MAX(OS::get_singleton()->get_ticks_usec() - start, (uint64_t)1);
+
+	LocalVector<uint8_t> buffer;
+	start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		buffer.clear();
+		encode_variant(packet, buffer);
+	}
+	const uint64_t single_pass = MAX(OS::get_singleton()->get_ticks_usec() - start, (uint64_t)1);
+
+	start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		Variant decoded;
+		decode_variant(decoded, buffer.ptr(), buffer.size());
+	}
+	const uint64_t decode = MAX(OS::get_singleton()->get_ticks_usec() - start, (uint64_t)1);
+
+	MESSAGE(vformat("%d byte packets: two-pass encode %d usec, single pass %d usec, decode %d usec (%d iterations).", buffer.size(), (int64_t)two_pass, (int64_t)single_pass, (int64_t)decode, iterations));
+}
+
 } // namespace TestMarshalls
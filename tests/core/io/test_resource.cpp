@@ -33,8 +33,11 @@
 TEST_FORCE_LINK(test_resource)
 
 #include "core/io/resource.h"
+#include "core/io/resource_format_binary.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/math/random_number_generator.h"
+#include "core/os/os.h"
 #include "scene/main/node.h"
 #include "tests/test_utils.h"
 
@@ -627,4 +630,118 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	resource_c->remove_meta("next");
 }
 
+// A main resource with many sub-resources, which share a few deeper ones.
+static Ref<Resource> make_resource_tree(int p_children, int p_data_size) {
+	Ref<Resource> root = memnew(Resource);
+	root->set_name("root");
+	Array children;
+	for (int i = 0; i < p_children; i++) {
+		Ref<Resource> shared;
+		if (i % 4 == 0 || children.is_empty()) {
+			shared.instantiate();
+			shared->set_name(vformat("shared_%d", i));
+		} else {
+			shared = Ref<Resource>(children[children.size() - 1])->get_meta("shared");
+		}
+		PackedFloat32Array data;
+		data.resize(p_data_size);
+		for (int j = 0; j < p_data_size; j++) {
+			data.set(j, i + j * 0.5);
+		}
+		Ref<Resource> child;
+		child.instantiate();
+		child->set_name(vformat("child_%d", i));
+		child->set_meta("data", data);
+		child->set_meta("shared", shared);
+		children.push_back(child);
+	}
+	root->set_meta("children", children);
+	return root;
+}
+
+static void check_resource_tree(const Ref<Resource> &p_resource, int p_children, int p_data_size) {
+	REQUIRE(p_resource.is_valid());
+	CHECK(p_resource->get_name() == "root");
+	const Array children = p_resource->get_meta("children");
+	REQUIRE(children.size() == p_children);
+	for (int i = 0; i < p_children; i++) {
+		const Ref<Resource> child = children[i];
+		REQUIRE(child.is_valid());
+		CHECK(child->get_name() == vformat("child_%d", i));
+		const PackedFloat32Array data = child->get_meta("data");
+		REQUIRE(data.size() == p_data_size);
+		CHECK(data[p_data_size - 1] == float(i + (p_data_size - 1) * 0.5));
+		const Ref<Resource> shared = child->get_meta("shared");
+		REQUIRE(shared.is_valid());
+		CHECK(shared->get_name() == vformat("shared_%d", i - i % 4));
+		if (i % 4) {
+			// Shared sub-resources are still loaded once.
+			CHECK(Ref<Resource>(children[i - 1])->get_meta("shared") == Variant(shared));
+		}
+	}
+}
+
+TEST_CASE("[Resource] Loading sub-resources in parallel") {
+	const String save_path = TestUtils::get_temp_path("resource_tree.res");
+	REQUIRE(ResourceSaver::save(make_resource_tree(64, 256), save_path) == OK);
+
+	const int parallel_min_sub_resources = ResourceLoaderBinary::parallel_min_sub_resources;
+	ResourceLoaderBinary::parallel_min_sub_resources = 1;
+
+	Ref<ResourceFormatLoaderBinary> loader;
+	loader.instantiate();
+	for (bool use_sub_threads : { false, true }) {
+		Error err = FAILED;
+		float progress = 0;
+		const Ref<Resource> loaded = loader->load(save_path, save_path, &err, use_sub_threads, &progress, ResourceFormatLoader::CACHE_MODE_IGNORE);
+		CHECK(err == OK);
+		CHECK(progress == 1.0);
+		check_resource_tree(loaded, 64, 256);
+	}
+
+	SUBCASE("Objects in property values are created on the loading thread") {
+		const Ref<Resource> tree = make_resource_tree(16, 4);
+		const Array children = tree->get_meta("children");
+		for (int i = 0; i < children.size(); i += 5) {
+			Ref<RandomNumberGenerator> rng;
+			rng.instantiate();
+			rng->set_seed(i + 1000);
+			rng->set_state(i);
+			Ref<Resource>(children[i])->set_meta("rng", rng);
+		}
+		REQUIRE(ResourceSaver::save(tree, save_path) == OK);
+
+		Error err = FAILED;
+		const Ref<Resource> loaded = loader->load(save_path, save_path, &err, true, nullptr, ResourceFormatLoader::CACHE_MODE_IGNORE);
+		CHECK(err == OK);
+		check_resource_tree(loaded, 16, 4);
+		const Array loaded_children = loaded->get_meta("children");
+		for (int i = 0; i < loaded_children.size(); i += 5) {
+			const Ref<RandomNumberGenerator> rng = Ref<Resource>(loaded_children[i])->get_meta("rng");
+			REQUIRE(rng.is_valid());
+			CHECK(rng->get_seed() == uint64_t(i + 1000));
+			CHECK(rng->get_state() == uint64_t(i));
+		}
+	}
+
+	ResourceLoaderBinary::parallel_min_sub_resources = parallel_min_sub_resources;
+}
+
+TEST_CASE("[Resource][Benchmark] Loading sub-resources in parallel" * doctest::skip()) {
+	const String save_path = TestUtils::get_temp_path("resource_tree_benchmark.res");
+	REQUIRE(ResourceSaver::save(make_resource_tree(2000, 16384), save_path) == OK);
+
+	Ref<ResourceFormatLoaderBinary> loader;
+	loader.instantiate();
+	for (bool use_sub_threads : { false, true }) {
+		const uint64_t start = OS::get_singleton()->get_ticks_usec();
+		Error err = FAILED;
+		const Ref<Resource> loaded = loader->load(save_path, save_path, &err, use_sub_threads, nullptr, ResourceFormatLoader::CACHE_MODE_IGNORE);
+		const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - start;
+		CHECK(err == OK);
+		check_resource_tree(loaded, 2000, 16384);
+		MESSAGE(vformat("%s: %d usec.", use_sub_threads ? "parallel" : "sequential", (int64_t)elapsed));
+	}
+}
+
 } // namespace TestResource
@@ -0,0 +1,135 @@
+/**************************************************************************/
+/*  test_stream_peer_zstd.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_stream_peer_zstd)
+
+#include "core/io/stream_peer_zstd.h"
+
+namespace TestStreamPeerZSTD {
+
+const String hello = "Hello World!!!";
+
+static Vector<uint8_t> _read_all(const Ref<StreamPeerZSTD> &p_peer) {
+	Vector<uint8_t> data;
+	data.resize(p_peer->get_available_bytes());
+	CHECK_EQ(p_peer->get_data(data.ptrw(), data.size()), Error::OK);
+	return data;
+}
+
+TEST_CASE("[StreamPeerZSTD] Initialization") {
+	Ref<StreamPeerZSTD> spz;
+	spz.instantiate();
+	CHECK_EQ(spz->get_available_bytes(), 0);
+}
+
+TEST_CASE("[StreamPeerZSTD] Compress/Decompress") {
+	Ref<StreamPeerZSTD> spz;
+	spz.instantiate();
+
+	Ref<ZSTDDictionary> dictionary;
+
+	SUBCASE("Without dictionary") {
+	}
+
+	SUBCASE("With dictionary") {
+		dictionary.instantiate();
+		Vector<Vector<uint8_t>> samples;
+		for (int i = 0; i < 50; i++) {
+			samples.push_back(vformat("Hello World!!! Message number %d.", i).to_utf8_buffer());
+		}
+		REQUIRE_EQ(dictionary->train(samples, 1024), Error::OK);
+	}
+
+	CHECK_EQ(spz->start_compression(dictionary), Error::OK);
+	CHECK_EQ(spz->put_data(hello.to_ascii_buffer().ptr(), hello.to_ascii_buffer().size()), Error::OK);
+	CHECK_EQ(spz->finish(), Error::OK);
+	const Vector<uint8_t> hello_compressed = _read_all(spz);
+
+	spz->clear();
+
+	CHECK_EQ(spz->start_decompression(dictionary), Error::OK);
+	CHECK_EQ(spz->put_data(hello_compressed.ptr(), hello_compressed.size()), Error::OK);
+	CHECK_EQ(_read_all(spz), hello.to_ascii_buffer());
+
+	if (dictionary.is_valid()) {
+		// Frames made with a dictionary aren't readable without it.
+		spz->clear();
+		CHECK_EQ(spz->start_decompression(), Error::OK);
+		ERR_PRINT_OFF;
+		CHECK_EQ(spz->put_data(hello_compressed.ptr(), hello_compressed.size()), Error::FAILED);
+		ERR_PRINT_ON;
+	}
+}
+
+TEST_CASE("[StreamPeerZSTD] Compress/Decompress big chunks of data") {
+	Ref<StreamPeerZSTD> spz;
+	spz.instantiate();
+	CHECK_EQ(spz->start_compression(), Error::OK);
+
+	Vector<uint8_t> big_data;
+	big_data.resize(20000);
+	for (int i = 0; i < big_data.size(); i++) {
+		big_data.write[i] = Math::random(48, 122);
+	}
+	CHECK_EQ(spz->put_data(big_data.ptr(), big_data.size()), Error::OK);
+	CHECK_EQ(spz->finish(), Error::OK);
+	const Vector<uint8_t> big_data_compressed = _read_all(spz);
+
+	spz->clear();
+
+	CHECK_EQ(spz->start_decompression(), Error::OK);
+	CHECK_EQ(spz->put_data(big_data_compressed.ptr(), big_data_compressed.size()), Error::OK);
+	CHECK_EQ(_read_all(spz), big_data);
+}
+
+TEST_CASE("[StreamPeerZSTD] Can't start twice") {
+	Ref<StreamPeerZSTD> spz;
+	spz.instantiate();
+	CHECK_EQ(spz->start_compression(), Error::OK);
+
+	ERR_PRINT_OFF;
+	CHECK_EQ(spz->start_compression(), Error::ERR_ALREADY_IN_USE);
+	CHECK_EQ(spz->start_decompression(), Error::ERR_ALREADY_IN_USE);
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[StreamPeerZSTD] Can't finish while decompressing") {
+	Ref<StreamPeerZSTD> spz;
+	spz.instantiate();
+	CHECK_EQ(spz->start_decompression(), Error::OK);
+
+	ERR_PRINT_OFF;
+	CHECK_EQ(spz->finish(), Error::ERR_UNAVAILABLE);
+	ERR_PRINT_ON;
+}
+
+} // namespace TestStreamPeerZSTD
@@ -0,0 +1,279 @@
+/**************************************************************************/
+/*  test_variant_schema.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_variant_schema)
+
+#include "core/io/marshalls.h"
+#include "core/io/variant_schema.h"
+#include "core/os/os.h"
+#include "core/variant/typed_array.h"
+#include "core/variant/typed_dictionary.h"
+
+namespace TestVariantSchema {
+
+static Dictionary make_entity(int p_index, int p_points) {
+	TypedArray<Vector3> path;
+	for (int i = 0; i < p_points; i++) {
+		path.push_back(Vector3(p_index, i, -i * 0.5));
+	}
+	TypedArray<int> ids;
+	for (int i = 0; i < p_points; i++) {
+		ids.push_back(p_index * 1000 + i);
+	}
+	TypedDictionary<String, float> stats;
+	stats["health"] = 100.0 - p_index;
+	stats["speed"] = 2.5;
+
+	Dictionary entity;
+	entity["name"] = vformat("entity_%d", p_index);
+	entity["transform"] = Transform3D(Basis(), Vector3(p_index, 0, 1));
+	entity["alive"] = p_index % 2 == 0;
+	entity["path"] = path;
+	entity["ids"] = ids;
+	entity["stats"] = stats;
+	entity["weights"] = PackedFloat32Array({ 0.25f, 0.5f, 1.0f });
+	entity["extra"] = Array({ 1, "two", Vector2(3, 4) });
+	return entity;
+}
+
+static Vector<uint8_t> encode(const Ref<VariantSchema> &p_schema, const Variant &p_value) {
+	LocalVector<uint8_t> buffer;
+	if (p_schema->encode(p_value, buffer) != OK) {
+		return Vector<uint8_t>();
+	}
+	Vector<uint8_t> bytes;
+	bytes.resize(buffer.size());
+	memcpy(bytes.ptrw(), buffer.ptr(), buffer.size());
+	return bytes;
+}
+
+static Variant decode(const Ref<VariantSchema> &p_schema, const Vector<uint8_t> &p_bytes, Error *r_error = nullptr) {
+	Variant value;
+	int len = 0;
+	const Error err = p_schema->decode(p_bytes.ptr(), p_bytes.size(), value, &len);
+	if (r_error) {
+		*r_error = err;
+	}
+	if (err == OK) {
+		CHECK(len == p_bytes.size());
+	}
+	return value;
+}
+
+TEST_CASE("[VariantSchema] Compiling") {
+	Ref<VariantSchema> schema;
+	schema.instantiate();
+	CHECK_FALSE(schema->is_compiled());
+
+	REQUIRE(schema->compile(make_entity(0, 1)) == OK);
+	CHECK(schema->is_compiled());
+	CHECK(schema->get_layout() == "{ name: String, transform: Transform3D, alive: bool, path: Array[Vector3], ids: Array[int], stats: Dictionary[String, float], weights: PackedFloat32Array, extra: Variant }");
+
+	// The layout doesn't depend on the sample's values.
+	Ref<VariantSchema> other;
+	other.instantiate();
+	REQUIRE(other->compile(make_entity(42, 0)) == OK);
+	CHECK(other->get_hash() == schema->get_hash());
+
+	Dictionary renamed = make_entity(0, 1);
+	renamed.erase("alive");
+	renamed["dead"] = false;
+	REQUIRE(other->compile(renamed) == OK);
+	CHECK(other->get_hash() != schema->get_hash());
+
+	REQUIRE(other->compile(TypedArray<Vector2>()) == OK);
+	CHECK(other->get_layout() == "Array[Vector2]");
+	REQUIRE(other->compile(Array()) == OK);
+	CHECK(other->get_layout() == "Variant");
+	// Dictionaries with non-String keys aren't records.
+	REQUIRE(other->compile(Dictionary({ { 1, "one" } })) == OK);
+	CHECK(other->get_layout() == "Variant");
+}
+
+TEST_CASE("[VariantSchema] Round trip") {
+	Ref<VariantSchema> schema;
+	schema.instantiate();
+	REQUIRE(schema->compile(make_entity(0, 1)) == OK);
+
+	for (int points : { 0, 1, 100 }) {
+		const Dictionary entity = make_entity(7, points);
+		const Vector<uint8_t> bytes = encode(schema, entity);
+		REQUIRE(bytes.size() > 0);
+		const Variant decoded = decode(schema, bytes);
+		CHECK(decoded == Variant(entity));
+
+		// Containers keep their types.
+		const Dictionary decoded_entity = decoded;
+		const Array path = decoded_entity["path"];
+		CHECK(path.get_typed_builtin() == Variant::VECTOR3);
+		const Dictionary stats = decoded_entity["stats"];
+		CHECK(stats.get_typed_key_builtin() == Variant::STRING);
+		CHECK(stats.get_typed_value_builtin() == Variant::FLOAT);
+	}
+
+	SUBCASE("Smaller than encode_variant") {
+		const Dictionary entity = make_entity(7, 100);
+		int len = 0;
+		REQUIRE(encode_variant(entity, nullptr, len) == OK);
+		CHECK(encode(schema, entity).size() < len);
+	}
+
+	SUBCASE("Nested typed arrays") {
+		TypedArray<Array> grid;
+		for (int i = 0; i < 4; i++) {
+			TypedArray<Color> row;
+			row.push_back(Color(i, 0, 0));
+			row.push_back(Color(0, i, 0));
+			grid.push_back(row);
+		}
+		REQUIRE(schema->compile(grid) == OK);
+		CHECK(schema->get_layout() == "Array[Array[Color]]");
+		CHECK(decode(schema, encode(schema, grid)) == Variant(grid));
+	}
+
+	SUBCASE("Untyped values after unaligned fields") {
+		// The String field leaves the stream unaligned, the untyped Array after it goes through encode_variant().
+		for (const char *name : { "a", "ab", "abc", "abcd" }) {
+			Dictionary record;
+			record["name"] = String(name);
+			record["extra"] = Array({ "xyz", 5, PackedByteArray({ 1, 2, 3 }), "last" });
+			REQUIRE(schema->compile(record) == OK);
+			CHECK(schema->get_layout() == "{ name: String, extra: Variant }");
+			CHECK(decode(schema, encode(schema, record)) == Variant(record));
+		}
+	}
+
+	SUBCASE("Arrays of short packed arrays") {
+		// Each packed array takes its count, which can be less than one of its items.
+		for (Variant::Type type : { Variant::PACKED_COLOR_ARRAY, Variant::PACKED_VECTOR2_ARRAY, Variant::PACKED_VECTOR3_ARRAY, Variant::PACKED_VECTOR4_ARRAY, Variant::PACKED_INT64_ARRAY, Variant::PACKED_FLOAT64_ARRAY }) {
+			Variant empty;
+			Callable::CallError ce;
+			Variant::construct(type, empty, nullptr, 0, ce);
+			Array array;
+			array.set_typed(type, StringName(), Variant());
+			array.push_back(empty);
+			array.push_back(empty);
+			REQUIRE(schema->compile(array) == OK);
+			CHECK(schema->get_layout() == vformat("Array[%s]", Variant::get_type_name(type)));
+			CHECK(decode(schema, encode(schema, array)) == Variant(array));
+		}
+	}
+
+	SUBCASE("StringNames") {
+		TypedArray<StringName> names;
+		names.push_back(StringName("idle"));
+		names.push_back(StringName("walk"));
+		REQUIRE(schema->compile(names) == OK);
+		const Array decoded = decode(schema, encode(schema, names));
+		REQUIRE(decoded.size() == 2);
+		CHECK(decoded[1].get_type() == Variant::STRING_NAME);
+		CHECK(decoded == Array(names));
+	}
+}
+
+TEST_CASE("[VariantSchema] Mismatched values") {
+	Ref<VariantSchema> schema;
+	schema.instantiate();
+	REQUIRE(schema->compile(make_entity(0, 1)) == OK);
+	const Vector<uint8_t> bytes = encode(schema, make_entity(1, 10));
+	REQUIRE(bytes.size() > 0);
+
+	ERR_PRINT_OFF;
+	CHECK(encode(schema, Variant()).is_empty());
+
+	Dictionary missing = make_entity(1, 10);
+	missing.erase("name");
+	CHECK(encode(schema, missing).is_empty());
+
+	Dictionary wrong_type = make_entity(1, 10);
+	wrong_type["alive"] = 1;
+	CHECK(encode(schema, wrong_type).is_empty());
+
+	Dictionary untyped = make_entity(1, 10);
+	untyped["path"] = Array({ Vector3() });
+	CHECK(encode(schema, untyped).is_empty());
+
+	// A failed encode leaves the buffer as it was.
+	LocalVector<uint8_t> buffer;
+	buffer.push_back(42);
+	CHECK(schema->encode(wrong_type, buffer) == ERR_INVALID_DATA);
+	CHECK(buffer.size() == 1);
+
+	Error err;
+	Ref<VariantSchema> other;
+	other.instantiate();
+	REQUIRE(other->compile(TypedArray<int>()) == OK);
+	decode(other, bytes, &err);
+	CHECK(err == ERR_INVALID_DATA);
+
+	for (int64_t size : { (int64_t)0, (int64_t)3, (int64_t)4, bytes.size() / 2, bytes.size() - 1 }) {
+		decode(schema, bytes.slice(0, size), &err);
+		CHECK(err == ERR_INVALID_DATA);
+	}
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[VariantSchema][Benchmark] Typed data set encoding and decoding" * doctest::skip()) {
+	const int count = 2000;
+	TypedArray<Dictionary> entities;
+	for (int i = 0; i < count; i++) {
+		entities.push_back(make_entity(i, 64));
+	}
+	Ref<VariantSchema> schema;
+	schema.instantiate();
+	REQUIRE(schema->compile(entities) == OK);
+
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	LocalVector<uint8_t> variant_buffer;
+	REQUIRE(encode_variant(entities, variant_buffer) == OK);
+	const uint64_t variant_encode = MAX(OS::get_singleton()->get_ticks_usec() - start, (uint64_t)1);
+
+	start = OS::get_singleton()->get_ticks_usec();
+	Variant decoded;
+	REQUIRE(decode_variant(decoded, variant_buffer.ptr(), variant_buffer.size()) == OK);
+	const uint64_t variant_decode = MAX(OS::get_singleton()->get_ticks_usec() - start, (uint64_t)1);
+
+	start = OS::get_singleton()->get_ticks_usec();
+	LocalVector<uint8_t> schema_buffer;
+	REQUIRE(schema->encode(entities, schema_buffer) == OK);
+	const uint64_t schema_encode = MAX(OS::get_singleton()->get_ticks_usec() - start, (uint64_t)1);
+
+	start = OS::get_singleton()->get_ticks_usec();
+	REQUIRE(schema->decode(schema_buffer.ptr(), schema_buffer.size(), decoded) == OK);
+	const uint64_t schema_decode = MAX(OS::get_singleton()->get_ticks_usec() - start, (uint64_t)1);
+	CHECK(decoded == Variant(entities));
+
+	MESSAGE(vformat("encode_variant: %d bytes, encode %d usec, decode %d usec.", variant_buffer.size(), (int64_t)variant_encode, (int64_t)variant_decode));
+	MESSAGE(vformat("VariantSchema: %d bytes, encode %d usec (%.1fx), decode %d usec (%.1fx).", schema_buffer.size(), (int64_t)schema_encode, (double)variant_encode / schema_encode, (int64_t)schema_decode, (double)variant_decode / schema_decode));
+}
+
+} // namespace TestVariantSchema
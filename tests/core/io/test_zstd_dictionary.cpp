@@ -0,0 +1,203 @@
+/**************************************************************************/
+/*  test_zstd_dictionary.cpp                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_zstd_dictionary)
+
+#include "core/io/compression.h"
+#include "core/io/stream_peer_zstd.h"
+#include "core/io/zstd_dictionary.h"
+#include "core/os/os.h"
+
+namespace TestZSTDDictionary {
+
+// Small payloads sharing most of their structure, like per-entity network snapshots.
+static Vector<uint8_t> make_snapshot(int p_index) {
+	Dictionary snapshot;
+	snapshot["entity_id"] = p_index;
+	snapshot["kind"] = p_index % 3 == 0 ? "player" : "npc";
+	snapshot["position"] = Vector3(p_index * 0.5, 1.0, -p_index * 0.25);
+	snapshot["velocity"] = Vector3(0, -9.8, p_index % 5);
+	snapshot["health"] = 100 - p_index % 100;
+	snapshot["state"] = p_index % 2 ? "walking" : "idle";
+	return String(Variant(snapshot)).to_utf8_buffer();
+}
+
+static Vector<Vector<uint8_t>> make_samples(int p_count, int p_first = 0) {
+	Vector<Vector<uint8_t>> samples;
+	for (int i = 0; i < p_count; i++) {
+		samples.push_back(make_snapshot(p_first + i));
+	}
+	return samples;
+}
+
+TEST_CASE("[ZSTDDictionary] Training") {
+	Ref<ZSTDDictionary> dictionary;
+	dictionary.instantiate();
+	CHECK(dictionary->is_empty());
+
+	REQUIRE(dictionary->train(make_samples(500), 4096) == OK);
+	CHECK_FALSE(dictionary->is_empty());
+	CHECK(dictionary->get_data().size() <= 4096);
+	// Trained dictionaries are raw content, which has no ID.
+	CHECK(dictionary->get_id() == 0);
+
+	ERR_PRINT_OFF;
+	Ref<ZSTDDictionary> failed;
+	failed.instantiate();
+	CHECK(failed->train(Vector<Vector<uint8_t>>(), 4096) == ERR_INVALID_PARAMETER);
+	CHECK(failed->train(make_samples(10), 16) == ERR_INVALID_PARAMETER);
+	// Nothing in common between the samples.
+	Vector<Vector<uint8_t>> unique;
+	unique.push_back(String("abcdefghijklmnop").to_utf8_buffer());
+	unique.push_back(String("0123456789ABCDEF").to_utf8_buffer());
+	CHECK(failed->train(unique, 4096) == ERR_INVALID_DATA);
+	CHECK(failed->is_empty());
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[ZSTDDictionary] Compression") {
+	Ref<ZSTDDictionary> dictionary;
+	dictionary.instantiate();
+	REQUIRE(dictionary->train(make_samples(500), 4096) == OK);
+
+	// Payloads that weren't part of the training set.
+	const Vector<uint8_t> payload = make_snapshot(1234);
+	const Vector<uint8_t> compressed = dictionary->compress(payload);
+	REQUIRE(compressed.size() > 0);
+	CHECK(dictionary->decompress(compressed) == payload);
+
+	Vector<uint8_t> plain;
+	plain.resize(Compression::get_max_compressed_buffer_size(payload.size()));
+	plain.resize(Compression::compress(plain.ptrw(), payload.ptr(), payload.size()));
+	CHECK(compressed.size() < plain.size());
+
+	SUBCASE("Through the Compression API") {
+		Vector<uint8_t> dst;
+		dst.resize(Compression::get_max_compressed_buffer_size(payload.size()));
+		const int64_t size = Compression::compress(dst.ptrw(), payload.ptr(), payload.size(), Compression::MODE_ZSTD, dictionary.ptr());
+		REQUIRE(size > 0);
+
+		Vector<uint8_t> decompressed;
+		decompressed.resize(payload.size());
+		CHECK(Compression::decompress(decompressed.ptrw(), decompressed.size(), dst.ptr(), size, Compression::MODE_ZSTD, dictionary.ptr()) == payload.size());
+		CHECK(decompressed == payload);
+
+		ERR_PRINT_OFF;
+		CHECK(Compression::compress(dst.ptrw(), payload.ptr(), payload.size(), Compression::MODE_DEFLATE, dictionary.ptr()) == -1);
+		// The dictionary is required to decompress.
+		CHECK(Compression::decompress(decompressed.ptrw(), decompressed.size(), dst.ptr(), size, Compression::MODE_ZSTD) < 0);
+		ERR_PRINT_ON;
+	}
+
+	SUBCASE("Output limit") {
+		ERR_PRINT_OFF;
+		CHECK(dictionary->decompress(compressed, payload.size() - 1).is_empty());
+		ERR_PRINT_ON;
+		CHECK(dictionary->decompress(compressed, payload.size()) == payload);
+	}
+
+	SUBCASE("Compression level") {
+		dictionary->set_compression_level(19);
+		const Vector<uint8_t> high = dictionary->compress(payload);
+		CHECK(dictionary->decompress(high) == payload);
+	}
+
+	SUBCASE("Variants") {
+		Dictionary value;
+		value["name"] = "player";
+		value["position"] = Vector3(1, 2, 3);
+		const Vector<uint8_t> bytes = dictionary->encode_var(value);
+		REQUIRE(bytes.size() > 0);
+		CHECK(dictionary->decode_var(bytes) == Variant(value));
+
+		// The decoded size is bounded, whatever the frame header claims.
+		ERR_PRINT_OFF;
+		CHECK(dictionary->decode_var(bytes, false, 4) == Variant());
+		ERR_PRINT_ON;
+	}
+
+	SUBCASE("Digested dictionaries outlive changes to the dictionary") {
+		Ref<StreamPeerZSTD> stream;
+		stream.instantiate();
+		REQUIRE(stream->start_decompression(dictionary) == OK);
+
+		const Ref<ZSTDCompressionDictionary> cdict = dictionary->get_compression_dictionary();
+		REQUIRE(cdict.is_valid());
+		dictionary->set_compression_level(19);
+		CHECK(dictionary->get_compression_dictionary() != cdict);
+		CHECK(cdict->get() != nullptr);
+
+		// The stream still decompresses with the dictionary it was started with.
+		dictionary->set_data(make_snapshot(1));
+		REQUIRE(stream->put_data(compressed.ptr(), compressed.size()) == OK);
+		Vector<uint8_t> decompressed;
+		decompressed.resize(stream->get_available_bytes());
+		REQUIRE(stream->get_data(decompressed.ptrw(), decompressed.size()) == OK);
+		CHECK(decompressed == payload);
+	}
+
+	SUBCASE("Data round trip") {
+		Ref<ZSTDDictionary> copy;
+		copy.instantiate();
+		copy->set_data(dictionary->get_data());
+		CHECK(copy->decompress(compressed) == payload);
+	}
+}
+
+TEST_CASE("[ZSTDDictionary][Benchmark] Small payload compression ratio and throughput" * doctest::skip()) {
+	Ref<ZSTDDictionary> dictionary;
+	dictionary.instantiate();
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	REQUIRE(dictionary->train(make_samples(5000), 16384) == OK);
+	const uint64_t train = OS::get_singleton()->get_ticks_usec() - start;
+
+	const Vector<Vector<uint8_t>> payloads = make_samples(10000, 100000);
+	int64_t raw_size = 0;
+	for (const Vector<uint8_t> &payload : payloads) {
+		raw_size += payload.size();
+	}
+
+	Vector<uint8_t> dst;
+	dst.resize(Compression::get_max_compressed_buffer_size(4096));
+	for (bool use_dictionary : { false, true }) {
+		int64_t compressed_size = 0;
+		start = OS::get_singleton()->get_ticks_usec();
+		for (const Vector<uint8_t> &payload : payloads) {
+			compressed_size += Compression::compress(dst.ptrw(), payload.ptr(), payload.size(), Compression::MODE_ZSTD, use_dictionary ? dictionary.ptr() : nullptr);
+		}
+		const uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - start, (uint64_t)1);
+		MESSAGE(vformat("%s: %d -> %d bytes (%.1f%%), %d payloads in %d usec (%d per sec).", use_dictionary ? "dictionary" : "plain", raw_size, compressed_size, compressed_size * 100.0 / raw_size, payloads.size(), (int64_t)elapsed, (int64_t)(payloads.size() * 1000000 / elapsed)));
+	}
+	MESSAGE(vformat("Training a %d byte dictionary took %d usec.", dictionary->get_data().size(), (int64_t)train));
+}
+
+} // namespace TestZSTDDictionary
@@ -0,0 +1,123 @@
+/**************************************************************************/
+/*  test_message_queue.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_message_queue)
+
+#include "core/object/message_queue.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+
+namespace TestMessageQueue {
+
+static const int THREAD_COUNT = 4;
+static const int CALLS_PER_THREAD = 10000;
+
+static SafeNumeric<uint32_t> deferred_calls;
+static int last_value[THREAD_COUNT];
+static bool calls_in_order = true;
+
+static void deferred_call(int p_thread, int p_value) {
+	// Runs on the main thread during flush.
+	deferred_calls.increment();
+	if (p_value != last_value[p_thread] + 1) {
+		calls_in_order = false;
+	}
+	last_value[p_thread] = p_value;
+}
+
+static void push_thread(void *p_userdata) {
+	int thread_index = (int)(intptr_t)p_userdata;
+	Callable callable = callable_mp_static(&deferred_call);
+	for (int i = 0; i < CALLS_PER_THREAD; i++) {
+		MessageQueue::get_singleton()->push_callable(callable, thread_index, i);
+	}
+}
+
+TEST_CASE("[MessageQueue] Calls pushed from multiple threads are flushed in per-thread order") {
+	MessageQueue::get_singleton()->flush();
+
+	deferred_calls.set(0);
+	calls_in_order = true;
+	for (int &value : last_value) {
+		value = -1;
+	}
+
+	Thread threads[THREAD_COUNT];
+	for (int i = 0; i < THREAD_COUNT; i++) {
+		threads[i].start(push_thread, (void *)(intptr_t)i);
+	}
+	for (Thread &thread : threads) {
+		thread.wait_to_finish();
+	}
+
+	CHECK(MessageQueue::get_singleton()->has_messages());
+	MessageQueue::get_singleton()->flush();
+
+	CHECK(deferred_calls.get() == THREAD_COUNT * CALLS_PER_THREAD);
+	CHECK(calls_in_order);
+	CHECK_FALSE(MessageQueue::get_singleton()->has_messages());
+}
+
+static void noop_call(int p_value) {
+}
+
+static void push_noop_thread(void *p_userdata) {
+	Callable callable = callable_mp_static(&noop_call);
+	int count = (int)(intptr_t)p_userdata;
+	for (int i = 0; i < count; i++) {
+		MessageQueue::get_singleton()->push_callable(callable, i);
+	}
+}
+
+TEST_CASE("[MessageQueue][Benchmark] Deferred call push throughput by thread count" * doctest::skip()) {
+	const int max_threads = OS::get_singleton()->get_processor_count();
+	const int calls_per_thread = 20000;
+
+	for (int thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+		LocalVector<Thread> threads;
+		threads.resize(thread_count);
+		const uint64_t start = OS::get_singleton()->get_ticks_usec();
+		for (Thread &thread : threads) {
+			thread.start(push_noop_thread, (void *)(intptr_t)calls_per_thread);
+		}
+		for (Thread &thread : threads) {
+			thread.wait_to_finish();
+		}
+		const uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - start, (uint64_t)1);
+		MessageQueue::get_singleton()->flush();
+
+		const int64_t total = (int64_t)thread_count * calls_per_thread;
+		MESSAGE(vformat("%d threads: %d calls in %d usec (%d calls/sec).", thread_count, total, (int64_t)elapsed, (int64_t)(total * 1000000 / elapsed)));
+	}
+}
+
+} // namespace TestMessageQueue
@@ -35,6 +35,8 @@ TEST_FORCE_LINK(test_object)
 #include "core/object/class_db.h"
 #include "core/object/object.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
 #include "tests/signal_watcher.h"
 
 namespace TestObject {
@@ -690,4 +692,85 @@ TEST_CASE("[Object] RequiredResult") {
 	CHECK_EQ(ref, var);
 }
 
+struct ObjectDBStressData {
+	int objects_per_thread = 0;
+	SafeNumeric<uint32_t> failures;
+};
+
+static void objectdb_stress_thread(void *p_userdata) {
+	ObjectDBStressData *data = (ObjectDBStressData *)p_userdata;
+	LocalVector<Object *> objects;
+	LocalVector<ObjectID> ids;
+	objects.resize(data->objects_per_thread);
+	ids.resize(data->objects_per_thread);
+
+	for (int i = 0; i < data->objects_per_thread; i++) {
+		objects[i] = (i % 2) ? memnew(RefCounted) : memnew(Object);
+		ids[i] = objects[i]->get_instance_id();
+	}
+	for (int i = 0; i < data->objects_per_thread; i++) {
+		if (ObjectDB::get_instance(ids[i]) != objects[i] || ids[i].is_ref_counted() != bool(i % 2)) {
+			data->failures.increment();
+		}
+	}
+	for (int i = 0; i < data->objects_per_thread; i++) {
+		memdelete(objects[i]);
+	}
+	for (int i = 0; i < data->objects_per_thread; i++) {
+		if (ObjectDB::get_instance(ids[i]) != nullptr) {
+			data->failures.increment();
+		}
+	}
+}
+
+TEST_CASE("[Object] ObjectDB instances created and freed from multiple threads") {
+	const int thread_count = 8;
+	const int initial_count = ObjectDB::get_object_count();
+
+	ObjectDBStressData data;
+	data.objects_per_thread = 5000;
+
+	Thread threads[thread_count];
+	for (Thread &thread : threads) {
+		thread.start(objectdb_stress_thread, &data);
+	}
+	for (Thread &thread : threads) {
+		thread.wait_to_finish();
+	}
+
+	CHECK(data.failures.get() == 0);
+	CHECK(ObjectDB::get_object_count() == initial_count);
+}
+
+static void objectdb_churn_thread(void *p_userdata) {
+	ObjectDBStressData *data = (ObjectDBStressData *)p_userdata;
+	for (int i = 0; i < data->objects_per_thread; i++) {
+		Object *object = memnew(Object);
+		memdelete(object);
+	}
+}
+
+TEST_CASE("[Object][Benchmark] ObjectDB add/remove throughput by thread count" * doctest::skip()) {
+	const int max_threads = OS::get_singleton()->get_processor_count();
+
+	for (int thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+		ObjectDBStressData data;
+		data.objects_per_thread = 200000;
+
+		LocalVector<Thread> threads;
+		threads.resize(thread_count);
+		const uint64_t start = OS::get_singleton()->get_ticks_usec();
+		for (Thread &thread : threads) {
+			thread.start(objectdb_churn_thread, &data);
+		}
+		for (Thread &thread : threads) {
+			thread.wait_to_finish();
+		}
+		const uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - start, (uint64_t)1);
+
+		const int64_t total = (int64_t)thread_count * data.objects_per_thread;
+		MESSAGE(vformat("%d threads: %d objects in %d usec (%d objects/sec).", thread_count, total, (int64_t)elapsed, (int64_t)(total * 1000000 / elapsed)));
+	}
+}
+
 } // namespace TestObject
@@ -0,0 +1,196 @@
+/**************************************************************************/
+/*  test_memory.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_memory)
+
+#include "core/os/memory.h"
+#include "core/os/os.h"
+#include "core/os/small_allocator.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+
+namespace TestMemory {
+
+TEST_CASE("[Memory] SmallAllocator blocks fit every requested size") {
+	for (size_t size = 0; size <= SmallAllocator::MAX_SMALL_SIZE + 64; size++) {
+		uint8_t *mem = (uint8_t *)SmallAllocator::alloc(size);
+		REQUIRE(mem != nullptr);
+		CHECK(SmallAllocator::get_usable_size(mem) >= size);
+		CHECK(((uintptr_t)mem % Memory::MAX_ALIGN) == 0);
+		memset(mem, 0xAB, size);
+		SmallAllocator::free(mem);
+	}
+}
+
+TEST_CASE("[Memory] SmallAllocator zeroed allocation and realloc keep contents") {
+	uint8_t *mem = (uint8_t *)SmallAllocator::alloc_zeroed(100);
+	REQUIRE(mem != nullptr);
+	bool zeroed = true;
+	for (int i = 0; i < 100; i++) {
+		zeroed = zeroed && mem[i] == 0;
+		mem[i] = i;
+	}
+	CHECK(zeroed);
+
+	// Grow through a few size classes and into a large block, then shrink back.
+	const size_t sizes[] = { 120, 700, 3000, 10000, 50 };
+	for (size_t size : sizes) {
+		mem = (uint8_t *)SmallAllocator::realloc(mem, size);
+		REQUIRE(mem != nullptr);
+		bool kept = true;
+		for (int i = 0; i < 50; i++) {
+			kept = kept && mem[i] == i;
+		}
+		CHECK_MESSAGE(kept, vformat("Contents lost when reallocating to %d bytes.", (int64_t)size));
+	}
+	SmallAllocator::free(mem);
+}
+
+struct AllocStressData {
+	int rounds = 0;
+	int blocks_per_round = 0;
+	SafeNumeric<uint32_t> failures;
+};
+
+static void alloc_stress_thread(void *p_userdata) {
+	AllocStressData *data = (AllocStressData *)p_userdata;
+	LocalVector<uint8_t *> blocks;
+	blocks.resize(data->blocks_per_round);
+
+	for (int round = 0; round < data->rounds; round++) {
+		for (int i = 0; i < data->blocks_per_round; i++) {
+			size_t size = 1 + (i * 37 + round) % 2000;
+			blocks[i] = (uint8_t *)memalloc(size);
+			blocks[i][0] = uint8_t(i);
+			blocks[i][size - 1] = uint8_t(i);
+		}
+		for (int i = 0; i < data->blocks_per_round; i++) {
+			size_t size = 1 + (i * 37 + round) % 2000;
+			if (blocks[i][0] != uint8_t(i) || blocks[i][size - 1] != uint8_t(i)) {
+				data->failures.increment();
+			}
+			memfree(blocks[i]);
+		}
+	}
+}
+
+TEST_CASE("[Memory] Blocks allocated and freed from multiple threads") {
+	AllocStressData data;
+	data.rounds = 20;
+	data.blocks_per_round = 1000;
+
+	Thread threads[8];
+	for (Thread &thread : threads) {
+		thread.start(alloc_stress_thread, &data);
+	}
+	for (Thread &thread : threads) {
+		thread.wait_to_finish();
+	}
+
+	CHECK(data.failures.get() == 0);
+}
+
+#ifdef DEBUG_ENABLED
+TEST_CASE("[Memory] Usage accounting follows alloc, realloc and free") {
+	const uint64_t initial = Memory::get_mem_usage();
+
+	void *mem = memalloc(100);
+	CHECK(Memory::get_mem_usage() == initial + 100);
+	mem = memrealloc(mem, 5000);
+	CHECK(Memory::get_mem_usage() == initial + 5000);
+	mem = memrealloc(mem, 10);
+	CHECK(Memory::get_mem_usage() == initial + 10);
+	memfree(mem);
+	CHECK(Memory::get_mem_usage() == initial);
+	CHECK(Memory::get_mem_max_usage() >= initial + 5000);
+}
+#endif
+
+static void alloc_churn_thread(void *p_userdata) {
+	AllocStressData *data = (AllocStressData *)p_userdata;
+	void *blocks[64];
+	for (int round = 0; round < data->rounds; round++) {
+		for (int i = 0; i < 64; i++) {
+			blocks[i] = memalloc(16 + (i & 15) * 8);
+		}
+		for (int i = 0; i < 64; i++) {
+			memfree(blocks[i]);
+		}
+	}
+}
+
+TEST_CASE("[Memory][Benchmark] Small allocation throughput by thread count" * doctest::skip()) {
+	const int max_threads = OS::get_singleton()->get_processor_count();
+
+	for (int thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+		AllocStressData data;
+		data.rounds = 20000;
+
+		LocalVector<Thread> threads;
+		threads.resize(thread_count);
+		const uint64_t start = OS::get_singleton()->get_ticks_usec();
+		for (Thread &thread : threads) {
+			thread.start(alloc_churn_thread, &data);
+		}
+		for (Thread &thread : threads) {
+			thread.wait_to_finish();
+		}
+		const uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - start, (uint64_t)1);
+
+		const int64_t total = (int64_t)thread_count * data.rounds * 64;
+		MESSAGE(vformat("%d threads: %d alloc/free pairs in %d usec (%d pairs/sec).", thread_count, total, (int64_t)elapsed, (int64_t)(total * 1000000 / elapsed)));
+	}
+}
+
+TEST_CASE("[Memory][Benchmark] String and Vector churn" * doctest::skip()) {
+	const int iterations = 200000;
+
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		String s = itos(i);
+		s += " items";
+	}
+	const uint64_t string_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+	start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		Vector<int> v;
+		for (int j = 0; j < 8; j++) {
+			v.push_back(j);
+		}
+	}
+	const uint64_t vector_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+	MESSAGE(vformat("String: %d iterations in %d usec. Vector<int>: %d iterations in %d usec. Small allocator spans: %d bytes.", iterations, (int64_t)string_usec, iterations, (int64_t)vector_usec, (int64_t)SmallAllocator::get_span_bytes()));
+}
+
+} // namespace TestMemory
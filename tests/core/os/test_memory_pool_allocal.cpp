@@ -0,0 +1,194 @@
+/**************************************************************************/
+/*  test_memory_pool_allocal.cpp                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_memory_pool_allocal)
+
+#include "core/math/random_number_generator.h"
+#include "core/os/memory_pool_allocal.h"
+#include "core/os/os.h"
+
+namespace TestMemoryPoolAllocal {
+
+TEST_CASE("[MemoryPoolAllocal] Allocate, free and coalesce") {
+	Ref<MemoryPoolAllocal> pool;
+	pool.instantiate(1000);
+
+	MemoryPoolAllocal::Block *a = pool->allocate(100);
+	MemoryPoolAllocal::Block *b = pool->allocate(200);
+	MemoryPoolAllocal::Block *c = pool->allocate(300);
+	REQUIRE(a != nullptr);
+	REQUIRE(b != nullptr);
+	REQUIRE(c != nullptr);
+	CHECK(a->offset == 0);
+	CHECK(b->offset == 100);
+	CHECK(c->offset == 300);
+	CHECK(pool->get_used_memory_size() == 600);
+	CHECK(pool->get_free_memory_size() == 400);
+	CHECK(pool->allocate(500) == nullptr);
+
+	// Freeing the middle block leaves a hole, so the free space is split.
+	pool->free_block(b);
+	CHECK(pool->get_free_block_count() == 2);
+	CHECK(pool->get_largest_free_block_size() == 400);
+	CHECK(pool->get_fragmentation() == doctest::Approx(1.0 - 400.0 / 600.0));
+
+	// Freeing its neighbors merges everything back into one block.
+	pool->free_block(a);
+	pool->free_block(c->offset);
+	CHECK(pool->get_free_block_count() == 1);
+	CHECK(pool->get_used_block_count() == 0);
+	CHECK(pool->get_largest_free_block_size() == 1000);
+	CHECK(pool->get_fragmentation() == doctest::Approx(0.0));
+
+	MemoryPoolAllocal::Block *all = pool->allocate(1000);
+	REQUIRE(all != nullptr);
+	CHECK(all->offset == 0);
+}
+
+TEST_CASE("[MemoryPoolAllocal] Growing and shrinking") {
+	Ref<MemoryPoolAllocal> pool;
+	pool.instantiate(100);
+
+	MemoryPoolAllocal::Block *a = pool->allocate(80);
+	MemoryPoolAllocal::Block *b = pool->allocate(100, 256);
+	REQUIRE(b != nullptr);
+	CHECK(b->offset == 80);
+	CHECK(pool->get_total_memory_size() == 356);
+
+	pool->reduction_memory(a, 30);
+	CHECK(a->size == 50);
+	CHECK(pool->get_free_memory_size() == 356 - 150);
+
+	MemoryPoolAllocal::Block *c = pool->allocate(30);
+	REQUIRE(c != nullptr);
+	CHECK(c->offset == 50);
+}
+
+TEST_CASE("[MemoryPoolAllocal] Random allocations never overlap") {
+	Ref<MemoryPoolAllocal> pool;
+	pool.instantiate(1 << 20);
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(42);
+
+	LocalVector<MemoryPoolAllocal::Block *> blocks;
+	Vector<uint8_t> owner_map;
+	owner_map.resize(1 << 20);
+	owner_map.fill(0);
+	bool overlap = false;
+
+	for (int i = 0; i < 5000; i++) {
+		if (blocks.size() > 0 && rng->randi_range(0, 2) == 0) {
+			uint32_t index = rng->randi_range(0, blocks.size() - 1);
+			MemoryPoolAllocal::Block *block = blocks[index];
+			for (int j = block->start(); j < block->end(); j++) {
+				owner_map.write[j] = 0;
+			}
+			pool->free_block(block);
+			blocks.remove_at_unordered(index);
+		} else {
+			MemoryPoolAllocal::Block *block = pool->allocate(rng->randi_range(1, 2000));
+			if (block == nullptr) {
+				continue;
+			}
+			for (int j = block->start(); j < block->end(); j++) {
+				overlap = overlap || owner_map[j] != 0;
+				owner_map.write[j] = 1;
+			}
+			blocks.push_back(block);
+		}
+	}
+	CHECK_FALSE(overlap);
+
+	for (MemoryPoolAllocal::Block *block : blocks) {
+		pool->free_block(block);
+	}
+	CHECK(pool->get_free_block_count() == 1);
+	CHECK(pool->get_free_memory_size() == (1 << 20));
+}
+
+TEST_CASE("[MemoryPoolAllocal] Script handles are validated offsets") {
+	Ref<MemoryPoolAllocal> pool;
+	pool.instantiate(1000);
+
+	const int64_t a = pool->allocate_imp(100);
+	const int64_t b = pool->allocate_imp(200);
+	CHECK(a == 0);
+	CHECK(b == 100);
+	CHECK(pool->get_block_size(b) == 200);
+	CHECK(pool->get_block_offset(b) == 100);
+	CHECK(pool->get_block_end(b) == 300);
+	CHECK(pool->allocate_imp(5000) == -1);
+
+	ERR_PRINT_OFF;
+	// Offsets that aren't the start of an allocated block are rejected.
+	CHECK(pool->get_block_size(50) == 0);
+	CHECK(pool->get_block_size(300) == 0);
+	CHECK(pool->get_block_size(int64_t(1) << 40) == 0);
+	pool->free_imp(-1);
+	pool->free_imp(150);
+	CHECK(pool->get_used_memory_size() == 300);
+
+	pool->free_imp(b);
+	CHECK(pool->get_used_memory_size() == 100);
+	// Freeing twice is an error, not a corruption.
+	pool->free_imp(b);
+	CHECK(pool->get_block_size(b) == 0);
+	ERR_PRINT_ON;
+	CHECK(pool->get_used_memory_size() == 100);
+	CHECK(pool->get_block_size(a) == 100);
+}
+
+TEST_CASE("[MemoryPoolAllocal][Benchmark] Allocate and free with many live blocks" * doctest::skip()) {
+	for (int live_blocks = 1000; live_blocks <= 64000; live_blocks *= 4) {
+		Ref<MemoryPoolAllocal> pool;
+		pool.instantiate(live_blocks * 1024);
+
+		LocalVector<MemoryPoolAllocal::Block *> blocks;
+		for (int i = 0; i < live_blocks; i++) {
+			blocks.push_back(pool->allocate(1 + (i * 37) % 1024));
+		}
+
+		const int operations = 200000;
+		const uint64_t start = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < operations; i++) {
+			uint32_t index = (i * 7919) % live_blocks;
+			pool->free_block(blocks[index]);
+			blocks[index] = pool->allocate(1 + (i * 53) % 1024);
+		}
+		const uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - start, (uint64_t)1);
+
+		MESSAGE(vformat("%d live blocks: %d free/allocate pairs in %d usec, fragmentation %.3f.", live_blocks, operations, (int64_t)elapsed, pool->get_fragmentation()));
+	}
+}
+
+} // namespace TestMemoryPoolAllocal
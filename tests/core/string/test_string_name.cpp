@@ -0,0 +1,154 @@
+/**************************************************************************/
+/*  test_string_name.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_string_name)
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName a = String("string_name_test_interning");
+	const StringName b = "string_name_test_interning";
+	const StringName c = String("string_name_test_other");
+
+	CHECK(a == b);
+	CHECK(a.data_unique_pointer() == b.data_unique_pointer());
+	CHECK(a != c);
+	CHECK(a == String("string_name_test_interning"));
+	CHECK(a.hash() == String("string_name_test_interning").hash());
+	CHECK(StringName(String()).is_empty());
+}
+
+static const int THREAD_COUNT = 4;
+static const int NAME_COUNT = 512;
+static const int ROUNDS = 20;
+
+struct InternData {
+	bool consistent = true;
+};
+
+static void intern_thread(void *p_userdata) {
+	InternData *data = (InternData *)p_userdata;
+	for (int round = 0; round < ROUNDS; round++) {
+		// Names are created and released every round, so other threads race
+		// against both lookups and the final unref of each entry.
+		LocalVector<StringName> names;
+		names.reserve(NAME_COUNT);
+		for (int i = 0; i < NAME_COUNT; i++) {
+			names.push_back(StringName("string_name_test_thread_" + itos(i)));
+		}
+		for (int i = 0; i < NAME_COUNT; i++) {
+			if (names[i] != String("string_name_test_thread_" + itos(i))) {
+				data->consistent = false;
+			}
+		}
+	}
+}
+
+TEST_CASE("[StringName] Concurrent interning and release") {
+	// Keep the names alive on this thread so every worker must resolve to the same entry.
+	LocalVector<StringName> held;
+	for (int i = 0; i < NAME_COUNT; i++) {
+		held.push_back(StringName("string_name_test_thread_" + itos(i)));
+	}
+
+	InternData data[THREAD_COUNT];
+	Thread threads[THREAD_COUNT];
+	for (int i = 0; i < THREAD_COUNT; i++) {
+		threads[i].start(intern_thread, &data[i]);
+	}
+	for (int i = 0; i < THREAD_COUNT; i++) {
+		threads[i].wait_to_finish();
+		CHECK(data[i].consistent);
+	}
+
+	for (int i = 0; i < NAME_COUNT; i++) {
+		const StringName again = "string_name_test_thread_" + itos(i);
+		CHECK(again.data_unique_pointer() == held[i].data_unique_pointer());
+	}
+}
+
+struct BenchmarkData {
+	const Vector<String> *strings = nullptr;
+	int rounds = 0;
+};
+
+static void benchmark_thread(void *p_userdata) {
+	const BenchmarkData *data = (const BenchmarkData *)p_userdata;
+	const String *strings = data->strings->ptr();
+	const int count = data->strings->size();
+	for (int round = 0; round < data->rounds; round++) {
+		for (int i = 0; i < count; i++) {
+			StringName name = strings[i];
+		}
+	}
+}
+
+TEST_CASE("[StringName][Benchmark] Interning throughput by thread count" * doctest::skip()) {
+	const int max_threads = OS::get_singleton()->get_processor_count();
+
+	Vector<String> strings;
+	for (int i = 0; i < 4096; i++) {
+		strings.push_back("benchmark/node_" + itos(i) + "/property");
+	}
+	// Half of the names stay interned, the other half are created and freed on every use.
+	LocalVector<StringName> held;
+	for (int i = 0; i < strings.size(); i += 2) {
+		held.push_back(StringName(strings[i]));
+	}
+
+	BenchmarkData data;
+	data.strings = &strings;
+	data.rounds = 100;
+
+	for (int thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+		LocalVector<Thread> threads;
+		threads.resize(thread_count);
+		const uint64_t start = OS::get_singleton()->get_ticks_usec();
+		for (Thread &thread : threads) {
+			thread.start(benchmark_thread, &data);
+		}
+		for (Thread &thread : threads) {
+			thread.wait_to_finish();
+		}
+		const uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - start, (uint64_t)1);
+
+		const int64_t total = (int64_t)thread_count * data.rounds * strings.size();
+		MESSAGE(vformat("%d threads: %d StringNames in %d usec (%d per sec).", thread_count, total, (int64_t)elapsed, (int64_t)(total * 1000000 / elapsed)));
+	}
+}
+
+} // namespace TestStringName
@@ -0,0 +1,223 @@
+/**************************************************************************/
+/*  test_group_hash_map.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_group_hash_map)
+
+#include "core/os/os.h"
+#include "core/templates/a_hash_map.h"
+#include "core/templates/group_hash_map.h"
+#include "core/templates/hash_map.h"
+
+namespace TestGroupHashMap {
+
+TEST_CASE("[GroupHashMap] List initialization") {
+	GroupHashMap<int, String> map{ { 0, "A" }, { 1, "B" }, { 2, "C" }, { 3, "D" }, { 4, "E" } };
+
+	CHECK(map.size() == 5);
+	CHECK(map[0] == "A");
+	CHECK(map[1] == "B");
+	CHECK(map[2] == "C");
+	CHECK(map[3] == "D");
+	CHECK(map[4] == "E");
+}
+
+TEST_CASE("[GroupHashMap] Insert, overwrite and erase") {
+	GroupHashMap<int, int> map;
+	GroupHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+
+	map.insert(42, 1234);
+	CHECK(map.size() == 1);
+	CHECK(map[42] == 1234);
+
+	CHECK(map.erase(42));
+	CHECK_FALSE(map.erase(42));
+	CHECK_FALSE(map.has(42));
+	CHECK(map.getptr(42) == nullptr);
+	CHECK(map.is_empty());
+}
+
+TEST_CASE("[GroupHashMap] Insert, iterate and remove many elements") {
+	const int elem_max = 12345;
+	GroupHashMap<int, int> map;
+	for (int i = 0; i < elem_max; i++) {
+		map.insert(i, i);
+	}
+
+	//insert order should have been kept
+	int idx = 0;
+	for (const KeyValue<int, int> &K : map) {
+		CHECK(idx == K.key);
+		CHECK(idx == K.value);
+		idx++;
+	}
+
+	for (int i = 0; i < elem_max; i++) {
+		if ((i % 5) == 0) {
+			map.erase(i);
+		}
+	}
+
+	bool all_valid = true;
+	for (int i = 0; i < elem_max; i++) {
+		const int *value = map.getptr(i);
+		if ((i % 5) == 0) {
+			all_valid = all_valid && value == nullptr;
+		} else {
+			all_valid = all_valid && value != nullptr && *value == i;
+		}
+	}
+	CHECK(all_valid);
+	CHECK(map.size() == elem_max - (elem_max + 4) / 5);
+}
+
+TEST_CASE("[GroupHashMap] Repeated insert and erase reuses deleted slots") {
+	GroupHashMap<int, int> map;
+	for (int i = 0; i < 100000; i++) {
+		map.insert(i, i);
+		CHECK_FALSE(map.has(i - 1));
+		map.erase(i);
+	}
+	CHECK(map.is_empty());
+	CHECK(map.get_capacity() == GroupHashMap<int, int>::INITIAL_CAPACITY);
+}
+
+TEST_CASE("[GroupHashMap] Strings and replace key") {
+	GroupHashMap<String, String> map;
+	for (int i = 0; i < 432; i++) {
+		map.insert(itos(i), itos(i));
+	}
+	CHECK(map.replace_key("5", "five"));
+	CHECK_FALSE(map.has("5"));
+	CHECK(map["five"] == "5");
+	CHECK(map.get_by_index(5).key == "five");
+
+	for (int i = 0; i < 432; i += 2) {
+		map.erase(itos(i));
+	}
+	CHECK(map.size() == 216);
+	CHECK(map.has("five"));
+	CHECK(map.has("431"));
+	CHECK_FALSE(map.has("430"));
+}
+
+TEST_CASE("[GroupHashMap] Copy constructor and operator =") {
+	GroupHashMap<int, int> map0;
+	for (int i = 0; i < 100; i++) {
+		map0.insert(i, i * 2);
+	}
+	map0.erase(50);
+
+	GroupHashMap<int, int> map1(map0);
+	GroupHashMap<int, int> map2;
+	map2.insert(1234, 1234);
+	map2 = map0;
+
+	CHECK(map1.size() == 99);
+	CHECK(map2.size() == 99);
+	CHECK_FALSE(map2.has(1234));
+	CHECK_FALSE(map1.has(50));
+	CHECK(map1[99] == 198);
+	CHECK(map2[99] == 198);
+}
+
+TEST_CASE("[GroupHashMap] Array methods") {
+	GroupHashMap<int, int> map;
+	for (int i = 0; i < 100; i++) {
+		map.insert(100 - i, i);
+	}
+	for (int i = 0; i < 100; i++) {
+		CHECK(map.get_by_index(i).value == i);
+	}
+	int index = map.get_index(1);
+	CHECK(map.get_by_index(index).value == 99);
+	CHECK(map.erase_by_index(index));
+	CHECK(!map.erase_by_index(index));
+	CHECK(map.get_index(1) == -1);
+
+	// Erasing from the middle moves the last element into the hole.
+	CHECK(map.erase_by_index(0));
+	CHECK(map.get_by_index(0).key == 2);
+	CHECK(map.get_index(2) == 0);
+}
+
+template <typename TMap>
+static void benchmark_map(const char *p_name, const Vector<StringName> &p_keys, const Vector<StringName> &p_missing) {
+	const int key_count = p_keys.size();
+	TMap map;
+
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < key_count; i++) {
+		map.insert(p_keys[i], i);
+	}
+	const uint64_t insert_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+	int64_t found = 0;
+	start = OS::get_singleton()->get_ticks_usec();
+	for (int round = 0; round < 10; round++) {
+		for (int i = 0; i < key_count; i++) {
+			found += map.has(p_keys[i]);
+			found += map.has(p_missing[i]);
+		}
+	}
+	const uint64_t lookup_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+	start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < key_count; i++) {
+		map.erase(p_keys[i]);
+	}
+	const uint64_t erase_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+	MESSAGE(vformat("%s: %d keys, insert %d usec, lookup (hit and miss, x10) %d usec, erase %d usec (%d found).", p_name, key_count, (int64_t)insert_usec, (int64_t)lookup_usec, (int64_t)erase_usec, found));
+}
+
+TEST_CASE("[GroupHashMap][Benchmark] HashMap vs AHashMap vs GroupHashMap" * doctest::skip()) {
+	for (int key_count = 100; key_count <= 1000000; key_count *= 10) {
+		Vector<StringName> keys;
+		Vector<StringName> missing;
+		for (int i = 0; i < key_count; i++) {
+			keys.push_back(StringName("key_" + itos(i)));
+			missing.push_back(StringName("missing_" + itos(i)));
+		}
+
+		benchmark_map<HashMap<StringName, int>>("HashMap", keys, missing);
+		benchmark_map<AHashMap<StringName, int>>("AHashMap", keys, missing);
+		benchmark_map<GroupHashMap<StringName, int>>("GroupHashMap", keys, missing);
+	}
+}
+
+} // namespace TestGroupHashMap
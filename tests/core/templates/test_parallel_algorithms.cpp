@@ -0,0 +1,147 @@
+/**************************************************************************/
+/*  test_parallel_algorithms.cpp                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_parallel_algorithms)
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "core/templates/parallel_algorithms.h"
+
+namespace TestParallelAlgorithms {
+
+static LocalVector<int> make_random_array(int64_t p_len, uint64_t p_seed, uint32_t p_range) {
+	RandomPCG rng(p_seed);
+	LocalVector<int> array;
+	array.resize(p_len);
+	for (int64_t i = 0; i < p_len; i++) {
+		array[i] = rng.rand() % p_range;
+	}
+	return array;
+}
+
+TEST_CASE("[ParallelAlgorithms] parallel_for visits every index once") {
+	const int64_t lengths[] = { 0, 1, 1000, 100000 };
+	for (int64_t len : lengths) {
+		LocalVector<SafeNumeric<uint32_t>> visits;
+		visits.resize(len);
+		parallel_for(len, [&](int64_t p_begin, int64_t p_end) {
+			for (int64_t i = p_begin; i < p_end; i++) {
+				visits[i].increment();
+			}
+		},
+				16);
+
+		bool all_once = true;
+		for (int64_t i = 0; i < len; i++) {
+			all_once = all_once && visits[i].get() == 1;
+		}
+		CHECK_MESSAGE(all_once, vformat("Length %d.", len));
+	}
+}
+
+TEST_CASE("[ParallelAlgorithms] parallel_reduce matches a serial sum") {
+	LocalVector<int> array = make_random_array(250000, 7, 1000);
+	int64_t expected = 0;
+	for (int value : array) {
+		expected += value;
+	}
+
+	int64_t sum = parallel_reduce(
+			(int64_t)array.size(), (int64_t)0, [&](int64_t p_begin, int64_t p_end) {
+				int64_t partial = 0;
+				for (int64_t i = p_begin; i < p_end; i++) {
+					partial += array[i];
+				}
+				return partial;
+			},
+			[](int64_t p_a, int64_t p_b) { return p_a + p_b; }, 100);
+	CHECK(sum == expected);
+
+	int64_t empty_sum = parallel_reduce(
+			0, (int64_t)5, [](int64_t p_begin, int64_t p_end) { return (int64_t)1; }, [](int64_t p_a, int64_t p_b) { return p_a + p_b; });
+	CHECK(empty_sum == 5);
+}
+
+TEST_CASE("[ParallelAlgorithms] parallel_sort sorts like SortArray") {
+	const int64_t lengths[] = { 0, 1, 100, ParallelAlgorithms::SORT_SERIAL_THRESHOLD, 100003, 1000000 };
+	for (int64_t len : lengths) {
+		// A small value range, so there are many equal elements.
+		LocalVector<int> array = make_random_array(len, len, 5000);
+		LocalVector<int> expected(array);
+		SortArray<int> sorter;
+		sorter.sort(expected.ptr(), len);
+
+		parallel_sort(array.ptr(), len);
+
+		bool same = true;
+		for (int64_t i = 0; i < len; i++) {
+			same = same && array[i] == expected[i];
+		}
+		CHECK_MESSAGE(same, vformat("Length %d.", len));
+	}
+}
+
+struct GreaterComparator {
+	_FORCE_INLINE_ bool operator()(int p_a, int p_b) const { return p_a > p_b; }
+};
+
+TEST_CASE("[ParallelAlgorithms] parallel_sort with a custom comparator") {
+	LocalVector<int> array = make_random_array(200000, 3, 1000000);
+	parallel_sort<int, GreaterComparator>(array.ptr(), array.size());
+
+	bool sorted = true;
+	for (uint32_t i = 1; i < array.size(); i++) {
+		sorted = sorted && array[i - 1] >= array[i];
+	}
+	CHECK(sorted);
+}
+
+TEST_CASE("[ParallelAlgorithms][Benchmark] parallel_sort vs SortArray" * doctest::skip()) {
+	for (int64_t len = 10000; len <= 10000000; len *= 10) {
+		LocalVector<int> source = make_random_array(len, 1, UINT32_MAX >> 1);
+
+		LocalVector<int> array(source);
+		uint64_t start = OS::get_singleton()->get_ticks_usec();
+		SortArray<int> sorter;
+		sorter.sort(array.ptr(), len);
+		const uint64_t serial_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+		array = source;
+		start = OS::get_singleton()->get_ticks_usec();
+		parallel_sort(array.ptr(), len);
+		const uint64_t parallel_usec = MAX(OS::get_singleton()->get_ticks_usec() - start, (uint64_t)1);
+
+		MESSAGE(vformat("%d elements: SortArray %d usec, parallel_sort %d usec (%.2fx).", len, (int64_t)serial_usec, (int64_t)parallel_usec, (double)serial_usec / parallel_usec));
+	}
+}
+
+} // namespace TestParallelAlgorithms
@@ -105,7 +105,155 @@ TEST_CASE("[RID] 'get_local_index'") {
 	CHECK(RID::from_uint64(4'294'967'297).get_local_index() == 1);
 }
 
+TEST_CASE("[RID_Owner] Validators in thread-safe mode") {
+	RID_Owner<int, true> owner(sizeof(int) * 4, 64);
+
+	LocalVector<RID> rids;
+	for (int i = 0; i < 64; i++) {
+		rids.push_back(owner.make_rid(i));
+	}
+	CHECK(owner.get_rid_count() == 64);
+	CHECK(owner.get_owned_list().size() == 64);
+	for (int i = 0; i < 64; i++) {
+		REQUIRE(owner.get_or_null(rids[i]) != nullptr);
+		CHECK(*owner.get_or_null(rids[i]) == i);
+	}
+
+	// Freed slots are cached and reused, but the old RIDs stay invalid.
+	const RID stale = rids[10];
+	owner.free(stale);
+	CHECK_FALSE(owner.owns(stale));
+	CHECK(owner.get_or_null(stale) == nullptr);
+	const RID reused = owner.make_rid(100);
+	CHECK(reused.get_local_index() == stale.get_local_index());
+	CHECK(owner.get_or_null(stale) == nullptr);
+	CHECK(*owner.get_or_null(reused) == 100);
+
+	ERR_PRINT_OFF;
+	owner.free(stale);
+	ERR_PRINT_ON;
+	CHECK(owner.owns(reused));
+
+	// Uninitialized RIDs are owned, but can't be used until initialized.
+	const RID uninitialized = owner.allocate_rid();
+	CHECK(owner.owns(uninitialized));
+	ERR_PRINT_OFF;
+	CHECK(owner.get_or_null(uninitialized) == nullptr);
+	ERR_PRINT_ON;
+	owner.initialize_rid(uninitialized, 7);
+	CHECK(*owner.get_or_null(uninitialized) == 7);
+
+	owner.free(uninitialized);
+	owner.free(reused);
+	for (int i = 0; i < 64; i++) {
+		if (i != 10) {
+			owner.free(rids[i]);
+		}
+	}
+	CHECK(owner.get_rid_count() == 0);
+	CHECK(owner.get_owned_list().is_empty());
+}
+
+TEST_CASE("[RID_Owner] Batch allocation") {
+	RID_Owner<int, true> owner(sizeof(int) * 16, 100);
+
+	RID first[40];
+	owner.allocate_rids(first, 40);
+	for (int i = 0; i < 40; i++) {
+		REQUIRE(first[i].is_valid());
+		// Fresh chunks hand out consecutive slots.
+		CHECK(first[i].get_local_index() == uint64_t(i));
+		CHECK(owner.owns(first[i]));
+		owner.initialize_rid(first[i], i);
+	}
+	CHECK(owner.get_rid_count() == 40);
+	CHECK(*owner.get_or_null(first[39]) == 39);
+
+	// Past the element limit, the remaining RIDs are null.
+	RID second[100];
+	ERR_PRINT_OFF;
+	owner.allocate_rids(second, 100);
+	ERR_PRINT_ON;
+	uint32_t valid = 0;
+	for (int i = 0; i < 100; i++) {
+		if (second[i].is_valid()) {
+			CHECK(i == int(valid));
+			owner.initialize_rid(second[i], i);
+			valid++;
+		}
+	}
+	CHECK(valid > 0);
+	CHECK(valid < 100);
+	CHECK(owner.get_rid_count() == 40 + valid);
+
+	for (int i = 0; i < 40; i++) {
+		owner.free(first[i]);
+	}
+	for (uint32_t i = 0; i < valid; i++) {
+		owner.free(second[i]);
+	}
+	CHECK(owner.get_rid_count() == 0);
+
+	RID_Owner<int> unsafe_owner;
+	RID third[10];
+	unsafe_owner.allocate_rids(third, 10);
+	for (int i = 0; i < 10; i++) {
+		unsafe_owner.initialize_rid(third[i], i);
+		CHECK(*unsafe_owner.get_or_null(third[i]) == i);
+	}
+	for (int i = 0; i < 10; i++) {
+		unsafe_owner.free(third[i]);
+	}
+	CHECK(unsafe_owner.get_rid_count() == 0);
+}
+
 #ifdef THREADS_ENABLED
+TEST_CASE("[RID_Owner] Concurrent allocation and lookups") {
+	struct Tester {
+		RID_Owner<uint64_t, true> owner;
+		SafeNumeric<uint32_t> failures{ 0 };
+	};
+	Tester tester;
+
+	const uint32_t thread_count = MAX(2, OS::get_singleton()->get_processor_count());
+	TightLocalVector<Thread> threads;
+	threads.resize(thread_count);
+	for (uint32_t i = 0; i < thread_count; i++) {
+		threads[i].start(
+				[](void *p_data) {
+					Tester *t = (Tester *)p_data;
+					// Enough RIDs per thread to move slots between the caches and the shared free list.
+					LocalVector<RID> mine;
+					for (uint32_t round = 0; round < 20; round++) {
+						for (uint64_t j = 0; j < 100; j++) {
+							mine.push_back(t->owner.make_rid(j));
+						}
+						for (uint32_t j = 0; j < mine.size(); j++) {
+							uint64_t *value = t->owner.get_or_null(mine[j]);
+							if (!value || *value != j % 100 || !t->owner.owns(mine[j])) {
+								t->failures.increment();
+							}
+						}
+						// Free every other one, then the rest, so slots get reused out of order.
+						for (uint32_t j = 0; j < mine.size(); j += 2) {
+							t->owner.free(mine[j]);
+						}
+						for (uint32_t j = 1; j < mine.size(); j += 2) {
+							t->owner.free(mine[j]);
+						}
+						mine.clear();
+					}
+				},
+				&tester);
+	}
+	for (uint32_t i = 0; i < thread_count; i++) {
+		threads[i].wait_to_finish();
+	}
+
+	CHECK(tester.failures.get() == 0);
+	CHECK(tester.owner.get_rid_count() == 0);
+}
+
 // This case would let sanitizers realize data races.
 // Additionally, on purely weakly ordered architectures, it would detect synchronization issues
 // if RID_Alloc failed to impose proper memory ordering and the test's threads are distributed
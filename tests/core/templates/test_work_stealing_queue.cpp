@@ -0,0 +1,137 @@
+/**************************************************************************/
+/*  test_work_stealing_queue.cpp                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_work_stealing_queue)
+
+#include "core/os/thread.h"
+#include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_queue.h"
+
+namespace TestWorkStealingQueue {
+
+TEST_CASE("[WorkStealingQueue] Owner pops LIFO, thieves steal FIFO") {
+	WorkStealingQueue<int64_t, 8> queue;
+	int64_t value = 0;
+
+	CHECK(queue.is_empty());
+	CHECK_FALSE(queue.pop(value));
+	CHECK_FALSE(queue.steal(value));
+
+	for (int64_t i = 0; i < 4; i++) {
+		CHECK(queue.push(i));
+	}
+	CHECK_FALSE(queue.is_empty());
+
+	CHECK(queue.pop(value));
+	CHECK(value == 3);
+	CHECK(queue.steal(value));
+	CHECK(value == 0);
+	CHECK(queue.pop(value));
+	CHECK(value == 2);
+	CHECK(queue.steal(value));
+	CHECK(value == 1);
+	CHECK(queue.is_empty());
+}
+
+TEST_CASE("[WorkStealingQueue] Push fails when full") {
+	WorkStealingQueue<int64_t, 4> queue;
+	int64_t value = 0;
+
+	for (int64_t i = 0; i < 4; i++) {
+		CHECK(queue.push(i));
+	}
+	CHECK_FALSE(queue.push(4));
+
+	CHECK(queue.steal(value));
+	CHECK(queue.push(4));
+
+	// Indices wrap around the ring buffer.
+	for (int64_t i = 4; i >= 1; i--) {
+		CHECK(queue.pop(value));
+		CHECK(value == i);
+	}
+	CHECK(queue.is_empty());
+}
+
+struct StealData {
+	WorkStealingQueue<int64_t, 64> *queue = nullptr;
+	SafeFlag *done = nullptr;
+	SafeNumeric<int64_t> *sum = nullptr;
+};
+
+static void steal_function(void *p_userdata) {
+	StealData *data = (StealData *)p_userdata;
+	int64_t value = 0;
+	while (!data->done->is_set() || !data->queue->is_empty()) {
+		if (data->queue->steal(value)) {
+			data->sum->add(value);
+		}
+	}
+}
+
+TEST_CASE("[WorkStealingQueue] Every element is taken exactly once under contention") {
+	const int64_t count = 100000;
+
+	WorkStealingQueue<int64_t, 64> queue;
+	SafeFlag done;
+	SafeNumeric<int64_t> sum;
+	StealData data;
+	data.queue = &queue;
+	data.done = &done;
+	data.sum = &sum;
+
+	Thread thieves[3];
+	for (Thread &thief : thieves) {
+		thief.start(steal_function, &data);
+	}
+
+	int64_t value = 0;
+	for (int64_t i = 1; i <= count; i++) {
+		while (!queue.push(i)) {
+			if (queue.pop(value)) {
+				sum.add(value);
+			}
+		}
+	}
+	while (queue.pop(value)) {
+		sum.add(value);
+	}
+
+	done.set();
+	for (Thread &thief : thieves) {
+		thief.wait_to_finish();
+	}
+
+	CHECK(sum.get() == count * (count + 1) / 2);
+}
+
+} // namespace TestWorkStealingQueue
@@ -0,0 +1,132 @@
+/**************************************************************************/
+/*  test_worker_task_pool.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_worker_task_pool)
+
+#include "core/object/worker_thread_pool.h"
+#include "core/variant/typed_array.h"
+
+namespace TestWorkerTaskPool {
+
+TEST_CASE("[WorkerTaskPool] Dependent jobs run after their dependencies complete") {
+	const int elements = 64;
+	SafeNumeric<uint32_t> first_count;
+	SafeNumeric<uint32_t> second_count;
+	SafeNumeric<uint32_t> second_early;
+
+	WorkerTaskPool *pool = WorkerTaskPool::get_singleton();
+	Ref<TaskJobHandle> first = pool->add_labada_group_task(SNAME("first"), [&](int p_index) { first_count.increment(); }, elements, 4, nullptr);
+	Ref<TaskJobHandle> second = pool->add_labada_group_task(
+			SNAME("second"), [&](int p_index) {
+				if (first_count.get() != (uint32_t)elements) {
+					second_early.increment();
+				}
+				second_count.increment();
+			},
+			elements, 4, first.ptr());
+
+	second->wait_completion();
+
+	CHECK(first->is_completed());
+	CHECK(second->is_completed());
+	CHECK(second_count.get() == (uint32_t)elements);
+	CHECK_MESSAGE(second_early.get() == 0, "No element of the dependent job should run before its dependency completed.");
+}
+
+TEST_CASE("[WorkerTaskPool] Combined handles release dependents once all inputs complete") {
+	const int jobs = 8;
+	const int elements = 32;
+	SafeNumeric<uint32_t> count;
+	SafeNumeric<uint32_t> last_early;
+
+	WorkerTaskPool *pool = WorkerTaskPool::get_singleton();
+	TypedArray<TaskJobHandle> handles;
+	for (int i = 0; i < jobs; i++) {
+		handles.push_back(pool->add_labada_group_task(SNAME("input"), [&](int p_index) { count.increment(); }, elements, 1, nullptr));
+	}
+	Ref<TaskJobHandle> combined = pool->combined_job_handle(handles);
+	Ref<TaskJobHandle> last = pool->add_labada_group_task(
+			SNAME("last"), [&](int p_index) {
+				if (count.get() != (uint32_t)(jobs * elements)) {
+					last_early.increment();
+				}
+			},
+			1, 1, combined.ptr());
+
+	last->wait_completion();
+
+	CHECK(combined->is_completed());
+	CHECK(last->is_completed());
+	CHECK(count.get() == (uint32_t)(jobs * elements));
+	CHECK(last_early.get() == 0);
+}
+
+TEST_CASE("[WorkerTaskPool] Empty jobs complete once their dependencies do") {
+	SafeNumeric<uint32_t> count;
+
+	WorkerTaskPool *pool = WorkerTaskPool::get_singleton();
+	Ref<TaskJobHandle> first = pool->add_labada_group_task(SNAME("first"), [&](int p_index) { count.increment(); }, 16, 4, nullptr);
+	Ref<TaskJobHandle> empty = pool->add_labada_group_task(SNAME("empty"), [&](int p_index) { count.increment(); }, 0, 1, first.ptr());
+
+	empty->wait_completion();
+
+	CHECK(empty->is_completed());
+	CHECK(count.get() == 16);
+}
+
+TEST_CASE("[WorkerTaskPool] Dependents of a never submitted handle wait for its collected dependencies") {
+	const int elements = 32;
+	SafeNumeric<uint32_t> count;
+	SafeNumeric<uint32_t> last_early;
+
+	WorkerTaskPool *pool = WorkerTaskPool::get_singleton();
+	Ref<TaskJobHandle> first = pool->add_labada_group_task(SNAME("first"), [&](int p_index) { count.increment(); }, elements, 4, nullptr);
+	Ref<TaskJobHandle> gather;
+	gather.instantiate();
+	gather->push_depend(first.ptr());
+	Ref<TaskJobHandle> last = pool->add_labada_group_task(
+			SNAME("last"), [&](int p_index) {
+				if (count.get() != (uint32_t)elements) {
+					last_early.increment();
+				}
+			},
+			1, 1, gather.ptr());
+
+	last->wait_completion();
+
+	CHECK(last->is_completed());
+	CHECK(gather->is_completed());
+	CHECK(count.get() == (uint32_t)elements);
+	CHECK(last_early.get() == 0);
+}
+
+} // namespace TestWorkerTaskPool
@@ -172,4 +172,153 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static void static_notified_yielder(void *p_arg) {
+	counter[0].set(1);
+	while (!exit.is_set()) {
+		OS::get_singleton()->delay_usec(1);
+	}
+	// Notified while running, the yield ends right away.
+	WorkerThreadPool::get_singleton()->yield();
+	counter[1].set(1);
+}
+
+TEST_CASE("[WorkerThreadPool] A yield-over notified before yielding is kept by the task") {
+	exit.clear();
+	counter.clear();
+	counter.resize(2);
+
+	WorkerThreadPool::TaskID task_id = WorkerThreadPool::get_singleton()->add_native_task(static_notified_yielder, nullptr, true);
+	while (counter[0].get() == 0) {
+		OS::get_singleton()->delay_usec(1);
+	}
+	WorkerThreadPool::get_singleton()->notify_yield_over(task_id);
+	exit.set();
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+	CHECK(counter[1].get() == 1);
+}
+
+static const int NESTED_SUBTASKS = 16;
+
+struct NestedTaskData {
+	WorkerThreadPool *pool = nullptr;
+	SafeNumeric<uint32_t> *executed = nullptr;
+};
+
+static void static_nested_leaf(void *p_arg) {
+	NestedTaskData *data = (NestedTaskData *)p_arg;
+	data->executed->increment();
+}
+
+static void static_nested_root(void *p_arg) {
+	NestedTaskData *data = (NestedTaskData *)p_arg;
+	// Tasks posted from a pool thread go to its local queue, so they're taken by this thread or stolen by others.
+	WorkerThreadPool::TaskID subtasks[NESTED_SUBTASKS];
+	for (int i = 0; i < NESTED_SUBTASKS; i++) {
+		subtasks[i] = data->pool->add_native_task(static_nested_leaf, data, true);
+	}
+	for (int i = 0; i < NESTED_SUBTASKS; i++) {
+		data->pool->wait_for_task_completion(subtasks[i]);
+	}
+	data->executed->increment();
+}
+
+TEST_CASE("[WorkerThreadPool] Process tasks posted from pool threads") {
+	SafeNumeric<uint32_t> executed;
+	NestedTaskData data;
+	data.pool = WorkerThreadPool::get_singleton();
+	data.executed = &executed;
+
+	for (int iterations = 0; iterations < 50; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(0.0f, 5.0f));
+		executed.set(0);
+
+		LocalVector<WorkerThreadPool::TaskID> roots;
+		roots.resize(count);
+		for (int i = 0; i < count; i++) {
+			roots[i] = data.pool->add_native_task(static_nested_root, &data, Math::rand() % 2);
+		}
+		for (int i = 0; i < count; i++) {
+			data.pool->wait_for_task_completion(roots[i]);
+		}
+
+		CHECK(executed.get() == (uint32_t)(count * (NESTED_SUBTASKS + 1)));
+	}
+}
+
+struct NestedGroupData {
+	NestedTaskData *data = nullptr;
+	WorkerThreadPool::GroupID group = WorkerThreadPool::INVALID_TASK_ID;
+};
+
+static void static_nested_group_element(void *p_arg, uint32_t p_index) {
+	NestedTaskData *data = (NestedTaskData *)p_arg;
+	data->executed->increment();
+}
+
+static void static_nested_group_root(void *p_arg) {
+	NestedGroupData *root = (NestedGroupData *)p_arg;
+	// Group tasks posted from a pool thread also go to its local queue.
+	// They're awaited from the main thread, so no pool thread blocks on them.
+	root->group = root->data->pool->add_native_group_task(static_nested_group_element, root->data, NESTED_SUBTASKS, 4, true);
+	root->data->executed->increment();
+}
+
+TEST_CASE("[WorkerThreadPool] Process group tasks posted from pool threads") {
+	SafeNumeric<uint32_t> executed;
+	NestedTaskData data;
+	data.pool = WorkerThreadPool::get_singleton();
+	data.executed = &executed;
+
+	for (int iterations = 0; iterations < 50; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(0.0f, 5.0f));
+		executed.set(0);
+
+		LocalVector<NestedGroupData> roots_data;
+		LocalVector<WorkerThreadPool::TaskID> roots;
+		roots_data.resize(count);
+		roots.resize(count);
+		for (int i = 0; i < count; i++) {
+			roots_data[i].data = &data;
+			roots[i] = data.pool->add_native_task(static_nested_group_root, &roots_data[i], true);
+		}
+		for (int i = 0; i < count; i++) {
+			CHECK(data.pool->wait_for_task_completion(roots[i]) == OK);
+			data.pool->wait_for_group_task_completion(roots_data[i].group);
+		}
+
+		CHECK(executed.get() == (uint32_t)(count * (NESTED_SUBTASKS + 1)));
+	}
+}
+
+TEST_CASE("[WorkerThreadPool][Benchmark] Tasks per second by thread count" * doctest::skip()) {
+	const int root_count = 2048;
+	const int max_threads = OS::get_singleton()->get_processor_count();
+
+	for (int thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+		WorkerThreadPool pool("Benchmark", false);
+		pool.init(thread_count);
+
+		SafeNumeric<uint32_t> executed;
+		NestedTaskData data;
+		data.pool = &pool;
+		data.executed = &executed;
+
+		const uint64_t start = OS::get_singleton()->get_ticks_usec();
+		LocalVector<WorkerThreadPool::TaskID> roots;
+		roots.resize(root_count);
+		for (int i = 0; i < root_count; i++) {
+			roots[i] = pool.add_native_task(static_nested_root, &data, true);
+		}
+		for (int i = 0; i < root_count; i++) {
+			pool.wait_for_task_completion(roots[i]);
+		}
+		const uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - start, (uint64_t)1);
+
+		CHECK(executed.get() == (uint32_t)(root_count * (NESTED_SUBTASKS + 1)));
+		MESSAGE(vformat("%d threads: %d tasks in %d usec (%d tasks/sec).", thread_count, executed.get(), (int64_t)elapsed, (int64_t)(executed.get() * 1000000ull / elapsed)));
+
+		pool.finish();
+	}
+}
+
 } // namespace TestWorkerThreadPool